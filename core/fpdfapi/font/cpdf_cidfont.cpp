@@ -8,6 +8,7 @@
 
 #include <algorithm>
 #include <limits>
+#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -29,6 +30,7 @@
 #include "core/fxcrt/fx_safe_types.h"
 #include "core/fxcrt/fx_unicode.h"
 #include "core/fxcrt/stl_util.h"
+#include "core/fxge/cfx_gemodule.h"
 #include "core/fxge/fx_font.h"
 #include "third_party/base/check.h"
 #include "third_party/base/check_op.h"
@@ -474,6 +476,7 @@ bool CPDF_CIDFont::Load() {
       m_Font.GetFace()->SelectCharMap(fxge::FontEncoding::kUnicode);
     else
       FT_UseCIDCharmap(m_Font.GetFace(), m_pCMap->GetCoding());
+    m_CharMap = m_Font.GetFace()->GetCurrentCharMap();
   }
   m_DefaultWidth = pCIDFontDict->GetIntegerFor("DW", 1000);
   RetainPtr<const CPDF_Array> pWidthArray = pCIDFontDict->GetArrayFor("W");
@@ -807,6 +810,13 @@ int CPDF_CIDFont::GlyphFromCharCode(uint32_t charcode, bool* pVertGlyph) {
       return cid;
     }
 
+    if (!m_CharMap) {
+      return cid;
+    }
+
+    // Other fonts sharing the face may have selected other charmaps since.
+    std::lock_guard<std::recursive_mutex> lock(CFX_GEModule::GetFontLock());
+    m_Font.GetFace()->SetCharMap(m_CharMap);
     absl::optional<fxge::FontEncoding> charmap =
         m_Font.GetFace()->GetCurrentCharMapEncoding();
     if (!charmap.has_value()) {
@@ -80,6 +80,9 @@ class CPDF_CIDFont final : public CPDF_Font {
   UnownedPtr<const CPDF_CID2UnicodeMap> m_pCID2UnicodeMap;
   RetainPtr<CPDF_StreamAcc> m_pStreamAcc;
   std::unique_ptr<CFX_CTTGSUBTable> m_pTTGSUBTable;
+  // Selected on the face when loading, and again for glyph lookups, as the
+  // face may be shared with other fonts.
+  CFX_Face::CharMap m_CharMap = nullptr;
   CIDFontType m_FontType = CIDFontType::kTrueType;
   bool m_bCIDIsGID = false;
   bool m_bAnsiWidthsFixed = false;
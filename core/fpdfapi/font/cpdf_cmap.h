@@ -32,7 +32,9 @@ enum class CIDCoding : uint8_t {
   kUTF16,
 };
 
-class CPDF_CMap final : public Retainable {
+// Predefined CMaps are shared by all documents, so the ref count is
+// thread-safe.
+class CPDF_CMap final : public RetainableThreadSafe {
  public:
   static constexpr size_t kDirectMapTableSize = 65536;
 
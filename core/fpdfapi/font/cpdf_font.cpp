@@ -8,6 +8,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -30,6 +31,7 @@
 #include "core/fxcrt/fx_safe_types.h"
 #include "core/fxcrt/stl_util.h"
 #include "core/fxge/cfx_fontmapper.h"
+#include "core/fxge/cfx_gemodule.h"
 #include "core/fxge/cfx_substfont.h"
 #include "core/fxge/freetype/fx_freetype.h"
 #include "core/fxge/fx_font.h"
@@ -324,6 +326,10 @@ RetainPtr<CPDF_Font> CPDF_Font::Create(CPDF_Document* pDoc,
   } else {
     pFont = pdfium::MakeRetain<CPDF_Type1Font>(pDoc, std::move(pFontDict));
   }
+
+  // Loading selects charmaps on the font's face, which may be shared with
+  // fonts of other documents, see CFX_FontMgr::GetSharedEmbeddedFace().
+  std::lock_guard<std::recursive_mutex> lock(CFX_GEModule::GetFontLock());
   if (!pFont->Load())
     return nullptr;
 
@@ -16,6 +16,7 @@
 #include "core/fpdfapi/font/cpdf_cid2unicodemap.h"
 #include "core/fpdfapi/font/cpdf_cmap.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
+#include "core/fxge/cfx_gemodule.h"
 #include "third_party/base/check.h"
 #include "third_party/base/containers/contains.h"
 
@@ -31,6 +32,16 @@ RetainPtr<const CPDF_CMap> LoadPredefinedCMap(ByteStringView name) {
 
 }  // namespace
 
+CPDF_FontGlobals::ScopedSharedAccess::ScopedSharedAccess(
+    const CPDF_Document* pDoc) {
+  if (pDoc && pDoc->IsSharedAccessEnabled()) {
+    m_Lock = std::unique_lock<std::recursive_mutex>(
+        CFX_GEModule::GetFontLock());
+  }
+}
+
+CPDF_FontGlobals::ScopedSharedAccess::~ScopedSharedAccess() = default;
+
 // static
 void CPDF_FontGlobals::Create() {
   DCHECK(!g_FontGlobals);
@@ -64,6 +75,7 @@ void CPDF_FontGlobals::LoadEmbeddedMaps() {
 RetainPtr<CPDF_Font> CPDF_FontGlobals::Find(
     CPDF_Document* pDoc,
     CFX_FontMapper::StandardFont index) {
+  std::lock_guard<std::recursive_mutex> lock(CFX_GEModule::GetFontLock());
   auto it = m_StockMap.find(pDoc);
   if (it == m_StockMap.end() || !it->second)
     return nullptr;
@@ -74,6 +86,7 @@ RetainPtr<CPDF_Font> CPDF_FontGlobals::Find(
 void CPDF_FontGlobals::Set(CPDF_Document* pDoc,
                            CFX_FontMapper::StandardFont index,
                            RetainPtr<CPDF_Font> pFont) {
+  std::lock_guard<std::recursive_mutex> lock(CFX_GEModule::GetFontLock());
   UnownedPtr<CPDF_Document> pKey(pDoc);
   if (!pdfium::Contains(m_StockMap, pKey))
     m_StockMap[pKey] = std::make_unique<CFX_StockFontArray>();
@@ -81,6 +94,7 @@ void CPDF_FontGlobals::Set(CPDF_Document* pDoc,
 }
 
 void CPDF_FontGlobals::Clear(CPDF_Document* pDoc) {
+  std::lock_guard<std::recursive_mutex> lock(CFX_GEModule::GetFontLock());
   // Avoid constructing smart-pointer key as erase() doesn't invoke
   // transparent lookup in the same way find() does.
   auto it = m_StockMap.find(pDoc);
@@ -116,6 +130,7 @@ void CPDF_FontGlobals::LoadEmbeddedKorea1CMaps() {
 
 RetainPtr<const CPDF_CMap> CPDF_FontGlobals::GetPredefinedCMap(
     const ByteString& name) {
+  std::lock_guard<std::recursive_mutex> lock(CFX_GEModule::GetFontLock());
   auto it = m_CMaps.find(name);
   if (it != m_CMaps.end())
     return it->second;
@@ -128,6 +143,7 @@ RetainPtr<const CPDF_CMap> CPDF_FontGlobals::GetPredefinedCMap(
 }
 
 CPDF_CID2UnicodeMap* CPDF_FontGlobals::GetCID2UnicodeMap(CIDSet charset) {
+  std::lock_guard<std::recursive_mutex> lock(CFX_GEModule::GetFontLock());
   if (!m_CID2UnicodeMaps[charset]) {
     m_CID2UnicodeMaps[charset] = std::make_unique<CPDF_CID2UnicodeMap>(charset);
   }
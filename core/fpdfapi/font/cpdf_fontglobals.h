@@ -11,18 +11,36 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 
 #include "core/fpdfapi/cmaps/fpdf_cmaps.h"
 #include "core/fpdfapi/font/cpdf_cidfont.h"
+#include "core/fxcrt/fx_memory.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxge/cfx_fontmapper.h"
 #include "third_party/base/containers/span.h"
 
 class CFX_StockFontArray;
+class CPDF_Document;
 class CPDF_Font;
 
 class CPDF_FontGlobals {
  public:
+  // Holds CFX_GEModule::GetFontLock() while in scope, if `pDoc` is shared
+  // between threads. Does nothing otherwise, or if `pDoc` is null. Must be
+  // held while using the fonts of a shared document, after the document's
+  // own CPDF_Document::ScopedSharedAccess.
+  class ScopedSharedAccess {
+   public:
+    FX_STACK_ALLOCATED();
+
+    explicit ScopedSharedAccess(const CPDF_Document* pDoc);
+    ~ScopedSharedAccess();
+
+   private:
+    std::unique_lock<std::recursive_mutex> m_Lock;
+  };
+
   // Per-process singleton which must be managed by callers.
   static void Create();
   static void Destroy();
@@ -9,11 +9,15 @@
 #include <utility>
 
 #include "core/fpdfapi/page/test_with_page_module.h"
+#include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_name.h"
+#include "core/fpdfapi/parser/cpdf_number.h"
 #include "core/fpdfapi/parser/cpdf_stream.h"
 #include "core/fpdfapi/parser/cpdf_test_document.h"
 #include "core/fxcrt/retain_ptr.h"
+#include "core/fxge/cfx_face.h"
+#include "core/fxge/cfx_font.h"
 #include "core/fxge/fontdata/chromefontdata/chromefontdata.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -54,3 +58,50 @@ TEST_F(CPDFSimpleFontTest, BaseFontNameWithSubsetting) {
   ASSERT_TRUE(font->Load());
   EXPECT_EQ("Swiss", font->GetBaseFontName());
 }
+
+TEST_F(CPDFSimpleFontTest, SameEmbeddedFontWithDifferentEncodings) {
+  CPDF_TestDocument doc;
+
+  // Both fonts embed the same font program, each in its own stream.
+  auto make_font_dict = [](RetainPtr<CPDF_Object> encoding) {
+    auto font_file_stream = pdfium::MakeRetain<CPDF_Stream>(
+        DataVector<uint8_t>(std::begin(kFoxitSansFontData),
+                            std::end(kFoxitSansFontData)),
+        pdfium::MakeRetain<CPDF_Dictionary>());
+    auto font_descriptor_dict = pdfium::MakeRetain<CPDF_Dictionary>();
+    font_descriptor_dict->SetFor("FontFile", std::move(font_file_stream));
+
+    auto font_dict = pdfium::MakeRetain<CPDF_Dictionary>();
+    font_dict->SetNewFor<CPDF_Name>("Subtype", "Type1");
+    font_dict->SetNewFor<CPDF_Name>("BaseFont", "Sans");
+    font_dict->SetFor("FontDescriptor", std::move(font_descriptor_dict));
+    font_dict->SetFor("Encoding", std::move(encoding));
+    return font_dict;
+  };
+
+  RetainPtr<CPDF_Font> font = CPDF_Font::Create(
+      &doc, make_font_dict(pdfium::MakeRetain<CPDF_Name>(nullptr,
+                                                         "WinAnsiEncoding")),
+      nullptr);
+  ASSERT_TRUE(font);
+  const int glyph_a = font->GlyphFromCharCode('A', nullptr);
+  const int glyph_b = font->GlyphFromCharCode('B', nullptr);
+  ASSERT_NE(glyph_a, glyph_b);
+  RetainPtr<CFX_Face> face = font->GetFont()->GetFace();
+  ASSERT_TRUE(face);
+
+  // Maps 'A' to the glyph named "B".
+  auto encoding = pdfium::MakeRetain<CPDF_Dictionary>();
+  auto differences = encoding->SetNewFor<CPDF_Array>("Differences");
+  differences->AppendNew<CPDF_Number>('A');
+  differences->AppendNew<CPDF_Name>("B");
+  RetainPtr<CPDF_Font> other_font =
+      CPDF_Font::Create(&doc, make_font_dict(std::move(encoding)), nullptr);
+  ASSERT_TRUE(other_font);
+  EXPECT_EQ(glyph_b, other_font->GlyphFromCharCode('A', nullptr));
+
+  // The fonts share the face, but each one maps its own char codes.
+  EXPECT_EQ(face, other_font->GetFont()->GetFace());
+  EXPECT_EQ(glyph_a, font->GlyphFromCharCode('A', nullptr));
+  EXPECT_EQ(glyph_b, font->GlyphFromCharCode('B', nullptr));
+}
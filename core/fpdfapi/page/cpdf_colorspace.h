@@ -52,7 +52,9 @@ class PatternValue {
   std::array<float, kMaxPatternColorComps> m_Comps{};
 };
 
-class CPDF_ColorSpace : public Retainable, public Observable {
+// The ref count is thread-safe, as the stock color spaces are shared by all
+// documents, including documents used on different threads at once.
+class CPDF_ColorSpace : public RetainableThreadSafe, public Observable {
  public:
   enum class Family {
     kUnknown = 0,
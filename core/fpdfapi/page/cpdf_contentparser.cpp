@@ -11,9 +11,11 @@
 #include "constants/page_object.h"
 #include "core/fpdfapi/font/cpdf_type3char.h"
 #include "core/fpdfapi/page/cpdf_allstates.h"
+#include "core/fpdfapi/page/cpdf_docpagedata.h"
 #include "core/fpdfapi/page/cpdf_page.h"
 #include "core/fpdfapi/page/cpdf_pageobject.h"
 #include "core/fpdfapi/page/cpdf_path.h"
+#include "core/fpdfapi/page/cpdf_streamprefetcher.h"
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_stream.h"
@@ -27,6 +29,27 @@
 #include "third_party/base/check.h"
 #include "third_party/base/check_op.h"
 
+namespace {
+
+// Returns the accessor CPDF_StreamPrefetcher loaded for `pStream`, if any, or
+// loads a new one.
+RetainPtr<CPDF_StreamAcc> LoadStreamAcc(CPDF_Document* pDoc,
+                                        RetainPtr<const CPDF_Stream> pStream) {
+  CPDF_DocPageData* pPageData =
+      pDoc ? CPDF_DocPageData::FromDocument(pDoc) : nullptr;
+  RetainPtr<CPDF_StreamAcc> pStreamAcc =
+      pPageData && pStream ? pPageData->TakePrefetchedStreamAcc(pStream.Get())
+                           : nullptr;
+  if (pStreamAcc)
+    return pStreamAcc;
+
+  pStreamAcc = pdfium::MakeRetain<CPDF_StreamAcc>(std::move(pStream));
+  pStreamAcc->LoadAllDataFiltered();
+  return pStreamAcc;
+}
+
+}  // namespace
+
 CPDF_ContentParser::CPDF_ContentParser(CPDF_Page* pPage)
     : m_CurrentStage(Stage::kGetContent), m_pPageObjectHolder(pPage) {
   DCHECK(pPage);
@@ -43,6 +66,8 @@ CPDF_ContentParser::CPDF_ContentParser(CPDF_Page* pPage)
     return;
   }
 
+  CPDF_StreamPrefetcher::Prefetch(pPage);
+
   const CPDF_Stream* pStream = pContent->AsStream();
   if (pStream) {
     HandlePageContentStream(pStream);
@@ -111,8 +136,8 @@ CPDF_ContentParser::CPDF_ContentParser(
     state.SetFillAlpha(1.0f);
     state.SetSoftMask(nullptr);
   }
-  m_pSingleStream = pdfium::MakeRetain<CPDF_StreamAcc>(std::move(pStream));
-  m_pSingleStream->LoadAllDataFiltered();
+  m_pSingleStream = LoadStreamAcc(m_pPageObjectHolder->GetDocument(),
+                                  std::move(pStream));
   m_Data = m_pSingleStream->GetSpan();
 }
 
@@ -153,8 +178,7 @@ CPDF_ContentParser::Stage CPDF_ContentParser::GetContent() {
   RetainPtr<const CPDF_Stream> pStreamObj = ToStream(
       pContent ? pContent->GetDirectObjectAt(m_CurrentOffset) : nullptr);
   m_StreamArray[m_CurrentOffset] =
-      pdfium::MakeRetain<CPDF_StreamAcc>(std::move(pStreamObj));
-  m_StreamArray[m_CurrentOffset]->LoadAllDataFiltered();
+      LoadStreamAcc(m_pPageObjectHolder->GetDocument(), std::move(pStreamObj));
   m_CurrentOffset++;
 
   return m_CurrentOffset == m_nStreams ? Stage::kPrepareContent
@@ -253,9 +277,8 @@ CPDF_ContentParser::Stage CPDF_ContentParser::CheckClip() {
 }
 
 void CPDF_ContentParser::HandlePageContentStream(const CPDF_Stream* pStream) {
-  m_pSingleStream =
-      pdfium::MakeRetain<CPDF_StreamAcc>(pdfium::WrapRetain(pStream));
-  m_pSingleStream->LoadAllDataFiltered();
+  m_pSingleStream = LoadStreamAcc(m_pPageObjectHolder->GetDocument(),
+                                  pdfium::WrapRetain(pStream));
   m_CurrentStage = Stage::kPrepareContent;
 }
 
@@ -537,8 +537,15 @@ CPDF_DIB::LoadState CPDF_DIB::CreateDecoder(uint8_t resolution_levels_to_skip) {
     m_pDecoder = BasicModule::CreateRunLengthDecoder(
         src_span, m_Width, m_Height, m_nComponents, m_bpc);
   } else if (decoder == "DCTDecode") {
-    if (!CreateDCTDecoder(src_span, pParams))
+    const uint8_t jpeg_levels_to_skip = std::min(
+        resolution_levels_to_skip, JpegModule::kMaxResolutionLevelsToSkip);
+    if (!CreateDCTDecoder(src_span, pParams, jpeg_levels_to_skip))
       return LoadState::kFail;
+
+    // Like JPX images, JPEG images may get decoded at a reduced size. The
+    // decoder rounds up, so it provides at least as many pixels.
+    m_Height >>= jpeg_levels_to_skip;
+    m_Width >>= jpeg_levels_to_skip;
   }
   if (!m_pDecoder)
     return LoadState::kFail;
@@ -557,10 +564,12 @@ CPDF_DIB::LoadState CPDF_DIB::CreateDecoder(uint8_t resolution_levels_to_skip) {
 }
 
 bool CPDF_DIB::CreateDCTDecoder(pdfium::span<const uint8_t> src_span,
-                                const CPDF_Dictionary* pParams) {
+                                const CPDF_Dictionary* pParams,
+                                uint8_t resolution_levels_to_skip) {
   m_pDecoder = JpegModule::CreateDecoder(
       src_span, m_Width, m_Height, m_nComponents,
-      !pParams || pParams->GetIntegerFor("ColorTransform", 1));
+      !pParams || pParams->GetIntegerFor("ColorTransform", 1),
+      resolution_levels_to_skip);
   if (m_pDecoder)
     return true;
 
@@ -580,8 +589,9 @@ bool CPDF_DIB::CreateDCTDecoder(pdfium::span<const uint8_t> src_span,
 
   if (m_nComponents == static_cast<uint32_t>(info.num_components)) {
     m_bpc = info.bits_per_components;
-    m_pDecoder = JpegModule::CreateDecoder(src_span, m_Width, m_Height,
-                                           m_nComponents, info.color_transform);
+    m_pDecoder = JpegModule::CreateDecoder(
+        src_span, m_Width, m_Height, m_nComponents, info.color_transform,
+        resolution_levels_to_skip);
     return true;
   }
 
@@ -626,7 +636,8 @@ bool CPDF_DIB::CreateDCTDecoder(pdfium::span<const uint8_t> src_span,
 
   m_bpc = info.bits_per_components;
   m_pDecoder = JpegModule::CreateDecoder(src_span, m_Width, m_Height,
-                                         m_nComponents, info.color_transform);
+                                         m_nComponents, info.color_transform,
+                                         resolution_levels_to_skip);
   return true;
 }
 
@@ -815,8 +826,17 @@ bool CPDF_DIB::LoadInternal(const CPDF_Dictionary* pFormResources,
   if (!src_size.IsValid())
     return false;
 
-  m_pStreamAcc = pdfium::MakeRetain<CPDF_StreamAcc>(m_pStream);
-  m_pStreamAcc->LoadAllDataImageAcc(src_size.ValueOrDie());
+  // Streams CPDF_StreamPrefetcher decoded are only of use if they hold the
+  // whole image. Otherwise the usual decoding deals with the damage.
+  CPDF_DocPageData* pPageData =
+      m_pDocument ? CPDF_DocPageData::FromDocument(m_pDocument) : nullptr;
+  m_pStreamAcc = pPageData ? pPageData->TakePrefetchedStreamAcc(m_pStream.Get())
+                           : nullptr;
+  if (!m_pStreamAcc || !m_pStreamAcc->GetImageDecoder().IsEmpty() ||
+      m_pStreamAcc->GetSize() < src_size.ValueOrDie()) {
+    m_pStreamAcc = pdfium::MakeRetain<CPDF_StreamAcc>(m_pStream);
+    m_pStreamAcc->LoadAllDataImageAcc(src_size.ValueOrDie());
+  }
   return !m_pStreamAcc->GetSpan().empty();
 }
 
@@ -165,6 +165,22 @@ CPDF_DocPageData* CPDF_DocPageData::FromDocument(const CPDF_Document* pDoc) {
   return static_cast<CPDF_DocPageData*>(pDoc->GetPageData());
 }
 
+// static
+uint32_t CPDF_DocPageData::GetFontFileEstimatedSize(
+    const CPDF_Stream* pFontStream) {
+  RetainPtr<const CPDF_Dictionary> pFontDict = pFontStream->GetDict();
+  int32_t len1 = pFontDict->GetIntegerFor("Length1");
+  int32_t len2 = pFontDict->GetIntegerFor("Length2");
+  int32_t len3 = pFontDict->GetIntegerFor("Length3");
+  if (len1 < 0 || len2 < 0 || len3 < 0)
+    return 0;
+
+  FX_SAFE_UINT32 safe_org_size = len1;
+  safe_org_size += len2;
+  safe_org_size += len3;
+  return safe_org_size.ValueOrDefault(0);
+}
+
 CPDF_DocPageData::CPDF_DocPageData() = default;
 
 CPDF_DocPageData::~CPDF_DocPageData() {
@@ -447,24 +463,45 @@ RetainPtr<CPDF_StreamAcc> CPDF_DocPageData::GetFontFileStreamAcc(
   if (it != m_FontFileMap.end())
     return it->second;
 
-  RetainPtr<const CPDF_Dictionary> pFontDict = pFontStream->GetDict();
-  int32_t len1 = pFontDict->GetIntegerFor("Length1");
-  int32_t len2 = pFontDict->GetIntegerFor("Length2");
-  int32_t len3 = pFontDict->GetIntegerFor("Length3");
-  uint32_t org_size = 0;
-  if (len1 >= 0 && len2 >= 0 && len3 >= 0) {
-    FX_SAFE_UINT32 safe_org_size = len1;
-    safe_org_size += len2;
-    safe_org_size += len3;
-    org_size = safe_org_size.ValueOrDefault(0);
+  RetainPtr<CPDF_StreamAcc> pFontAcc =
+      TakePrefetchedStreamAcc(pFontStream.Get());
+  if (!pFontAcc) {
+    pFontAcc = pdfium::MakeRetain<CPDF_StreamAcc>(pFontStream);
+    pFontAcc->LoadAllDataFilteredWithEstimatedSize(
+        GetFontFileEstimatedSize(pFontStream.Get()));
   }
-
-  auto pFontAcc = pdfium::MakeRetain<CPDF_StreamAcc>(pFontStream);
-  pFontAcc->LoadAllDataFilteredWithEstimatedSize(org_size);
   m_FontFileMap[std::move(pFontStream)] = pFontAcc;
   return pFontAcc;
 }
 
+bool CPDF_DocPageData::HasFontFileStreamAcc(
+    const CPDF_Stream* pFontStream) const {
+  return m_FontFileMap.find(pFontStream) != m_FontFileMap.end();
+}
+
+void CPDF_DocPageData::SetPrefetchedStreamAccs(
+    std::vector<RetainPtr<CPDF_StreamAcc>> stream_accs) {
+  m_PrefetchedStreamMap.clear();
+  for (auto& pStreamAcc : stream_accs) {
+    RetainPtr<const CPDF_Stream> pStream = pStreamAcc->GetStream();
+    const uint32_t data_version = pStream->GetDataVersion();
+    m_PrefetchedStreamMap[std::move(pStream)] = {std::move(pStreamAcc),
+                                                 data_version};
+  }
+}
+
+RetainPtr<CPDF_StreamAcc> CPDF_DocPageData::TakePrefetchedStreamAcc(
+    const CPDF_Stream* pStream) {
+  auto it = m_PrefetchedStreamMap.find(pStream);
+  if (it == m_PrefetchedStreamMap.end())
+    return nullptr;
+
+  RetainPtr<CPDF_StreamAcc> pStreamAcc = std::move(it->second.pStreamAcc);
+  const bool is_current = it->second.data_version == pStream->GetDataVersion();
+  m_PrefetchedStreamMap.erase(it);
+  return is_current ? pStreamAcc : nullptr;
+}
+
 void CPDF_DocPageData::MaybePurgeFontFileStreamAcc(
     RetainPtr<CPDF_StreamAcc>&& pStreamAcc) {
   if (!pStreamAcc)
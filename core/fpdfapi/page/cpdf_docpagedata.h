@@ -7,9 +7,13 @@
 #ifndef CORE_FPDFAPI_PAGE_CPDF_DOCPAGEDATA_H_
 #define CORE_FPDFAPI_PAGE_CPDF_DOCPAGEDATA_H_
 
+#include <stdint.h>
+
+#include <functional>
 #include <map>
 #include <memory>
 #include <set>
+#include <vector>
 
 #include "core/fpdfapi/font/cpdf_font.h"
 #include "core/fpdfapi/page/cpdf_colorspace.h"
@@ -35,6 +39,10 @@ class CPDF_DocPageData final : public CPDF_Document::PageDataIface,
  public:
   static CPDF_DocPageData* FromDocument(const CPDF_Document* pDoc);
 
+  // Returns the size of the decoded font data in `pFontStream`, according to
+  // its dictionary, or 0 if it does not say.
+  static uint32_t GetFontFileEstimatedSize(const CPDF_Stream* pFontStream);
+
   CPDF_DocPageData();
   ~CPDF_DocPageData() override;
 
@@ -87,7 +95,25 @@ class CPDF_DocPageData final : public CPDF_Document::PageDataIface,
   RetainPtr<CPDF_IccProfile> GetIccProfile(
       RetainPtr<const CPDF_Stream> pProfileStream);
 
+  bool HasFontFileStreamAcc(const CPDF_Stream* pFontStream) const;
+
+  // Keeps the loaded `stream_accs` until TakePrefetchedStreamAcc() hands them
+  // out. Drops the ones from the previous call that were never taken, so only
+  // one page's worth is kept at a time.
+  void SetPrefetchedStreamAccs(
+      std::vector<RetainPtr<CPDF_StreamAcc>> stream_accs);
+
+  // Returns the loaded accessor for `pStream` passed to
+  // SetPrefetchedStreamAccs(), if any, and forgets about it. Returns nullptr
+  // if the stream data changed since then.
+  RetainPtr<CPDF_StreamAcc> TakePrefetchedStreamAcc(const CPDF_Stream* pStream);
+
  private:
+  struct PrefetchedStream {
+    RetainPtr<CPDF_StreamAcc> pStreamAcc;
+    uint32_t data_version;
+  };
+
   struct HashIccProfileKey {
     HashIccProfileKey(ByteString digest, uint32_t components);
     ~HashIccProfileKey();
@@ -122,8 +148,12 @@ class CPDF_DocPageData final : public CPDF_Document::PageDataIface,
   std::map<HashIccProfileKey, RetainPtr<const CPDF_Stream>> m_HashIccProfileMap;
   std::map<RetainPtr<const CPDF_Array>, ObservedPtr<CPDF_ColorSpace>>
       m_ColorSpaceMap;
-  std::map<RetainPtr<const CPDF_Stream>, RetainPtr<CPDF_StreamAcc>>
+  std::map<RetainPtr<const CPDF_Stream>,
+           RetainPtr<CPDF_StreamAcc>,
+           std::less<>>
       m_FontFileMap;
+  std::map<RetainPtr<const CPDF_Stream>, PrefetchedStream, std::less<>>
+      m_PrefetchedStreamMap;
   std::map<RetainPtr<const CPDF_Stream>, ObservedPtr<CPDF_IccProfile>>
       m_IccProfileMap;
   std::map<RetainPtr<const CPDF_Object>, ObservedPtr<CPDF_Pattern>>
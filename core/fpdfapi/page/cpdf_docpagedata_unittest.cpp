@@ -0,0 +1,76 @@
+// Copyright 2024 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/page/cpdf_docpagedata.h"
+
+#include <utility>
+#include <vector>
+
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fpdfapi/parser/cpdf_stream_acc.h"
+#include "core/fxcrt/data_vector.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+RetainPtr<CPDF_StreamAcc> LoadStreamAcc(RetainPtr<const CPDF_Stream> stream) {
+  auto stream_acc = pdfium::MakeRetain<CPDF_StreamAcc>(std::move(stream));
+  stream_acc->LoadAllDataFiltered();
+  return stream_acc;
+}
+
+}  // namespace
+
+TEST(CPDFDocPageDataTest, TakePrefetchedStreamAcc) {
+  auto stream1 = pdfium::MakeRetain<CPDF_Stream>(
+      DataVector<uint8_t>(10), pdfium::MakeRetain<CPDF_Dictionary>());
+  auto stream2 = pdfium::MakeRetain<CPDF_Stream>(
+      DataVector<uint8_t>(20), pdfium::MakeRetain<CPDF_Dictionary>());
+  RetainPtr<CPDF_StreamAcc> stream_acc1 = LoadStreamAcc(stream1);
+
+  CPDF_DocPageData page_data;
+  std::vector<RetainPtr<CPDF_StreamAcc>> stream_accs;
+  stream_accs.push_back(stream_acc1);
+  page_data.SetPrefetchedStreamAccs(std::move(stream_accs));
+
+  EXPECT_FALSE(page_data.TakePrefetchedStreamAcc(stream2.Get()));
+  EXPECT_EQ(stream_acc1, page_data.TakePrefetchedStreamAcc(stream1.Get()));
+
+  // Every accessor gets handed out once.
+  EXPECT_FALSE(page_data.TakePrefetchedStreamAcc(stream1.Get()));
+}
+
+TEST(CPDFDocPageDataTest, PrefetchedStreamAccsReplaced) {
+  auto stream1 = pdfium::MakeRetain<CPDF_Stream>(
+      DataVector<uint8_t>(10), pdfium::MakeRetain<CPDF_Dictionary>());
+  auto stream2 = pdfium::MakeRetain<CPDF_Stream>(
+      DataVector<uint8_t>(20), pdfium::MakeRetain<CPDF_Dictionary>());
+
+  CPDF_DocPageData page_data;
+  std::vector<RetainPtr<CPDF_StreamAcc>> stream_accs;
+  stream_accs.push_back(LoadStreamAcc(stream1));
+  page_data.SetPrefetchedStreamAccs(std::move(stream_accs));
+  stream_accs.clear();
+  RetainPtr<CPDF_StreamAcc> stream_acc2 = LoadStreamAcc(stream2);
+  stream_accs.push_back(stream_acc2);
+  page_data.SetPrefetchedStreamAccs(std::move(stream_accs));
+
+  EXPECT_FALSE(page_data.TakePrefetchedStreamAcc(stream1.Get()));
+  EXPECT_EQ(stream_acc2, page_data.TakePrefetchedStreamAcc(stream2.Get()));
+}
+
+TEST(CPDFDocPageDataTest, PrefetchedStreamAccDroppedOnSetData) {
+  auto stream = pdfium::MakeRetain<CPDF_Stream>(
+      DataVector<uint8_t>(10), pdfium::MakeRetain<CPDF_Dictionary>());
+
+  CPDF_DocPageData page_data;
+  std::vector<RetainPtr<CPDF_StreamAcc>> stream_accs;
+  stream_accs.push_back(LoadStreamAcc(stream));
+  page_data.SetPrefetchedStreamAccs(std::move(stream_accs));
+
+  // The accessor holds the old data, so it must not be handed out anymore.
+  stream->SetData(DataVector<uint8_t>(30));
+  EXPECT_FALSE(page_data.TakePrefetchedStreamAcc(stream.Get()));
+}
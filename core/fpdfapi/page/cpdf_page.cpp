@@ -210,6 +210,10 @@ void CPDF_Page::ClearRenderContext() {
   m_pRenderContext.reset();
 }
 
+void CPDF_Page::SetDisplayList(std::unique_ptr<DisplayListIface> pDisplayList) {
+  m_pDisplayList = std::move(pDisplayList);
+}
+
 void CPDF_Page::ClearView() {
   if (m_pView)
     m_pView->ClearPage(this);
@@ -39,6 +39,12 @@ class CPDF_Page final : public IPDF_Page, public CPDF_PageObjectHolder {
     virtual ~RenderContextIface() = default;
   };
 
+  // Data for the render layer to reuse across renders of this page.
+  class DisplayListIface {
+   public:
+    virtual ~DisplayListIface() = default;
+  };
+
   class RenderContextClearer {
    public:
     FX_STACK_ALLOCATED();
@@ -89,6 +95,11 @@ class CPDF_Page final : public IPDF_Page, public CPDF_PageObjectHolder {
   void SetRenderContext(std::unique_ptr<RenderContextIface> pContext);
   void ClearRenderContext();
 
+  DisplayListIface* GetDisplayList() { return m_pDisplayList.get(); }
+
+  // Replaces the display list. Pass nullptr to drop it.
+  void SetDisplayList(std::unique_ptr<DisplayListIface> pDisplayList);
+
   void SetView(View* pView) { m_pView.Reset(pView); }
   void ClearView();
   void UpdateDimensions();
@@ -106,6 +117,7 @@ class CPDF_Page final : public IPDF_Page, public CPDF_PageObjectHolder {
   UnownedPtr<CPDF_Document> const m_pPDFDocument;
   std::unique_ptr<CPDF_PageImageCache> m_pPageImageCache;
   std::unique_ptr<RenderContextIface> m_pRenderContext;
+  std::unique_ptr<DisplayListIface> m_pDisplayList;
   ObservedPtr<View> m_pView;
 };
 
@@ -10,6 +10,7 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -112,6 +113,43 @@ RetainPtr<CFX_DIBBase> MakeCachedImage(RetainPtr<CFX_DIBBase> image,
 
 }  // namespace
 
+struct CPDF_PageImageCache::GlobalCache {
+  // Guards the members below.
+  std::mutex lock;
+  size_t budget = 0;
+  size_t size = 0;
+  Stats stats;
+  // Entries with decoded images, most recently used first.
+  std::list<Entry*> entries;
+};
+
+// static
+CPDF_PageImageCache::GlobalCache* CPDF_PageImageCache::GetGlobalCache() {
+  static GlobalCache* s_cache = new GlobalCache();
+  return s_cache;
+}
+
+// static
+void CPDF_PageImageCache::SetGlobalBudget(size_t bytes) {
+  GlobalCache* cache = GetGlobalCache();
+  std::lock_guard<std::mutex> lock(cache->lock);
+  cache->budget = bytes;
+}
+
+// static
+size_t CPDF_PageImageCache::GetGlobalCacheSize() {
+  GlobalCache* cache = GetGlobalCache();
+  std::lock_guard<std::mutex> lock(cache->lock);
+  return cache->size;
+}
+
+// static
+CPDF_PageImageCache::Stats CPDF_PageImageCache::GetGlobalStats() {
+  GlobalCache* cache = GetGlobalCache();
+  std::lock_guard<std::mutex> lock(cache->lock);
+  return cache->stats;
+}
+
 CPDF_PageImageCache::CPDF_PageImageCache(CPDF_Page* pPage) : m_pPage(pPage) {}
 
 CPDF_PageImageCache::~CPDF_PageImageCache() = default;
@@ -180,7 +218,7 @@ bool CPDF_PageImageCache::StartGetCachedBitmap(
   if (m_bCurFindCache) {
     m_pCurImageCacheEntry = it->second.get();
   } else {
-    m_pCurImageCacheEntry = std::make_unique<Entry>(std::move(pImage));
+    m_pCurImageCacheEntry = std::make_unique<Entry>(this, std::move(pImage));
   }
   CPDF_DIB::LoadState ret = m_pCurImageCacheEntry->StartGetCachedBitmap(
       this, pFormResources, pPageResources, bStdCS, eFamily, bLoadMask,
@@ -236,16 +274,29 @@ RetainPtr<CFX_DIBBase> CPDF_PageImageCache::DetachCurMask() {
   return m_pCurImageCacheEntry->DetachMask();
 }
 
-CPDF_PageImageCache::Entry::Entry(RetainPtr<CPDF_Image> pImage)
-    : m_pImage(std::move(pImage)) {}
+CPDF_PageImageCache::Entry::Entry(CPDF_PageImageCache* pOwner,
+                                  RetainPtr<CPDF_Image> pImage)
+    : m_pOwner(pOwner), m_pImage(std::move(pImage)) {}
 
-CPDF_PageImageCache::Entry::~Entry() = default;
+CPDF_PageImageCache::Entry::~Entry() {
+  RemoveFromGlobalCache();
+}
 
 void CPDF_PageImageCache::Entry::Reset() {
   m_pCachedBitmap.Reset();
   CalcSize();
 }
 
+void CPDF_PageImageCache::Entry::Evict() {
+  GetGlobalCache()->size -= m_dwCacheSize;
+  m_bInGlobalCache = false;
+  m_pOwner->m_nCacheSize -= std::min(m_pOwner->m_nCacheSize, m_dwCacheSize);
+  m_pCachedBitmap.Reset();
+  m_pCachedMask.Reset();
+  m_bEvicted = true;
+  m_dwCacheSize = 0;
+}
+
 RetainPtr<CFX_DIBBase> CPDF_PageImageCache::Entry::DetachBitmap() {
   return std::move(m_pCurBitmap);
 }
@@ -265,9 +316,17 @@ CPDF_DIB::LoadState CPDF_PageImageCache::Entry::StartGetCachedBitmap(
   if (m_pCachedBitmap && IsCacheValid(max_size_required)) {
     m_pCurBitmap = m_pCachedBitmap;
     m_pCurMask = m_pCachedMask;
+    CalcSize();
     return CPDF_DIB::LoadState::kSuccess;
   }
 
+  if (m_bEvicted) {
+    GlobalCache* cache = GetGlobalCache();
+    std::lock_guard<std::mutex> lock(cache->lock);
+    ++cache->stats.redecodes;
+    m_bEvicted = false;
+  }
+
   m_pCurBitmap = m_pImage->CreateNewDIB();
   CPDF_DIB::LoadState ret = m_pCurBitmap.AsRaw<CPDF_DIB>()->StartLoadDIBBase(
       true, pFormResources, pPageResources, bStdCS, eFamily, bLoadMask,
@@ -320,11 +379,56 @@ void CPDF_PageImageCache::Entry::ContinueGetCachedBitmap(
 }
 
 void CPDF_PageImageCache::Entry::CalcSize() {
+  RemoveFromGlobalCache();
   m_dwCacheSize = 0;
   if (m_pCachedBitmap)
     m_dwCacheSize += m_pCachedBitmap->GetEstimatedImageMemoryBurden();
   if (m_pCachedMask)
     m_dwCacheSize += m_pCachedMask->GetEstimatedImageMemoryBurden();
+  if (!m_pCachedBitmap)
+    return;
+
+  GlobalCache* cache = GetGlobalCache();
+  std::lock_guard<std::mutex> lock(cache->lock);
+  cache->entries.push_front(this);
+  m_GlobalPos = cache->entries.begin();
+  m_bInGlobalCache = true;
+  cache->size += m_dwCacheSize;
+  if (cache->budget)
+    EvictOverBudget();
+}
+
+void CPDF_PageImageCache::Entry::EvictOverBudget() {
+  GlobalCache* cache = GetGlobalCache();
+  auto it = cache->entries.end();
+  while (cache->size > cache->budget && it != cache->entries.begin()) {
+    Entry* entry = *--it;
+    // Never evict this entry, as its image is about to be drawn.
+    if (entry == this)
+      continue;
+
+    // Skip entries of shared documents in use on other threads. This thread
+    // already holds the lock of its own document, if shared.
+    CPDF_Document::ScopedSharedAccess shared_access(
+        entry->m_pOwner->GetPage()->GetDocument(), std::try_to_lock);
+    if (!shared_access.acquired())
+      continue;
+
+    it = cache->entries.erase(it);
+    entry->Evict();
+    ++cache->stats.evictions;
+  }
+}
+
+void CPDF_PageImageCache::Entry::RemoveFromGlobalCache() {
+  GlobalCache* cache = GetGlobalCache();
+  std::lock_guard<std::mutex> lock(cache->lock);
+  if (!m_bInGlobalCache)
+    return;
+
+  cache->entries.erase(m_GlobalPos);
+  cache->size -= m_dwCacheSize;
+  m_bInGlobalCache = false;
 }
 
 bool CPDF_PageImageCache::Entry::IsCacheValid(
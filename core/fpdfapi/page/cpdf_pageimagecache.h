@@ -7,9 +7,11 @@
 #ifndef CORE_FPDFAPI_PAGE_CPDF_PAGEIMAGECACHE_H_
 #define CORE_FPDFAPI_PAGE_CPDF_PAGEIMAGECACHE_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <functional>
+#include <list>
 #include <map>
 #include <memory>
 
@@ -26,6 +28,20 @@ class PauseIndicatorIface;
 
 class CPDF_PageImageCache {
  public:
+  struct Stats {
+    size_t evictions = 0;
+    size_t redecodes = 0;
+  };
+
+  // Sets the budget for the decoded images of all pages of all documents.
+  // Once they exceed it, the least recently used ones are released, and get
+  // decoded again when drawn again. 0, the default, means no limit. Images of
+  // shared documents that another thread is using are only released once
+  // that thread is done with the document.
+  static void SetGlobalBudget(size_t bytes);
+  static size_t GetGlobalCacheSize();
+  static Stats GetGlobalStats();
+
   explicit CPDF_PageImageCache(CPDF_Page* pPage);
   ~CPDF_PageImageCache();
 
@@ -51,10 +67,13 @@ class CPDF_PageImageCache {
  private:
   class Entry {
    public:
-    explicit Entry(RetainPtr<CPDF_Image> pImage);
+    Entry(CPDF_PageImageCache* pOwner, RetainPtr<CPDF_Image> pImage);
     ~Entry();
 
     void Reset();
+    // Releases the decoded image to stay within the global budget. Called
+    // with the global cache's lock held, after removing the entry from it.
+    void Evict();
     uint32_t EstimateSize() const { return m_dwCacheSize; }
     uint32_t GetMatteColor() const { return m_MatteColor; }
     uint32_t GetTimeCount() const { return m_dwTimeCount; }
@@ -79,9 +98,15 @@ class CPDF_PageImageCache {
 
    private:
     void ContinueGetCachedBitmap(CPDF_PageImageCache* pPageImageCache);
+    // Also updates the global cache size and makes this entry the most
+    // recently used one.
     void CalcSize();
     bool IsCacheValid(const CFX_Size& max_size_required) const;
+    void RemoveFromGlobalCache();
+    // Called with the global cache's lock held.
+    void EvictOverBudget();
 
+    UnownedPtr<CPDF_PageImageCache> const m_pOwner;
     uint32_t m_dwTimeCount = 0;
     uint32_t m_MatteColor = 0;
     uint32_t m_dwCacheSize = 0;
@@ -91,8 +116,15 @@ class CPDF_PageImageCache {
     RetainPtr<CFX_DIBBase> m_pCachedBitmap;
     RetainPtr<CFX_DIBBase> m_pCachedMask;
     bool m_bCachedSetMaxSizeRequired = false;
+    bool m_bEvicted = false;
+    bool m_bInGlobalCache = false;
+    std::list<Entry*>::iterator m_GlobalPos;
   };
 
+  struct GlobalCache;
+
+  static GlobalCache* GetGlobalCache();
+
   void ClearImageCacheEntry(const CPDF_Stream* pStream);
 
   UnownedPtr<CPDF_Page> const m_pPage;
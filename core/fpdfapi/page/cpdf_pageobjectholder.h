@@ -68,6 +68,14 @@ class CPDF_PageObjectHolder {
   void ContinueParse(PauseIndicatorIface* pPause);
   ParseState GetParseState() const { return m_ParseState; }
 
+  // When set before parsing, page objects that fall entirely outside `rect`
+  // are not created. The object list is then incomplete, so such a holder is
+  // only good for rendering within `rect`.
+  void SetCullRect(const CFX_FloatRect& rect) { m_CullRect = rect; }
+  const absl::optional<CFX_FloatRect>& GetCullRect() const {
+    return m_CullRect;
+  }
+
   CPDF_Document* GetDocument() const { return m_pDocument; }
   RetainPtr<const CPDF_Dictionary> GetDict() const { return m_pDict; }
   RetainPtr<CPDF_Dictionary> GetMutableDict() { return m_pDict; }
@@ -132,6 +140,7 @@ class CPDF_PageObjectHolder {
  private:
   bool m_bBackgroundAlphaNeeded = false;
   ParseState m_ParseState = ParseState::kNotParsed;
+  absl::optional<CFX_FloatRect> m_CullRect;
   RetainPtr<CPDF_Dictionary> const m_pDict;
   UnownedPtr<CPDF_Document> m_pDocument;
   std::vector<CFX_FloatRect> m_MaskBoundingBoxes;
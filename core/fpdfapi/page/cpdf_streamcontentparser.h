@@ -40,9 +40,6 @@ class CPDF_TextObject;
 
 class CPDF_StreamContentParser {
  public:
-  static void InitializeGlobals();
-  static void DestroyGlobals();
-
   CPDF_StreamContentParser(CPDF_Document* pDoc,
                            RetainPtr<CPDF_Dictionary> pPageResources,
                            RetainPtr<CPDF_Dictionary> pParentResources,
@@ -136,9 +133,14 @@ class CPDF_StreamContentParser {
   RetainPtr<CPDF_Object> FindResourceObj(const ByteString& type,
                                          const ByteString& name);
 
-  // Takes ownership of |pImageObj|, returns unowned pointer to it.
+  // Takes ownership of |pImageObj|, returns unowned pointer to it, or nullptr
+  // if it got culled.
   CPDF_ImageObject* AddImageObject(std::unique_ptr<CPDF_ImageObject> pImageObj);
 
+  // Whether `rect` falls outside the object holder's cull rect, if any, so
+  // the object it bounds does not need to be created.
+  bool IsOutsideCullRect(const CFX_FloatRect& rect) const;
+
   std::vector<float> GetColors() const;
   std::vector<float> GetNamedColors() const;
   int32_t GetCurrentStreamIndex();
@@ -99,7 +99,8 @@ uint32_t DecodeInlineStream(pdfium::span<const uint8_t> src_span,
   if (decoder == "DCTDecode") {
     std::unique_ptr<ScanlineDecoder> pDecoder = JpegModule::CreateDecoder(
         src_span, width, height, 0,
-        !pParam || pParam->GetIntegerFor("ColorTransform", 1));
+        !pParam || pParam->GetIntegerFor("ColorTransform", 1),
+        /*resolution_levels_to_skip=*/0);
     return DecodeAllScanlines(std::move(pDecoder));
   }
   if (decoder == "CCITTFaxDecode") {
@@ -325,7 +326,7 @@ RetainPtr<CPDF_Object> CPDF_StreamParser::ReadNextObject(
     if (m_WordSize == 1)
       return pdfium::MakeRetain<CPDF_String>(m_pPool, ReadHexString(), true);
 
-    auto pDict = pdfium::MakeRetain<CPDF_Dictionary>(m_pPool);
+    CPDF_Dictionary::DictMap entries;
     while (true) {
       GetNextWord(bIsNumber);
       if (m_WordSize == 2 && m_WordBuffer[0] == '>')
@@ -340,8 +341,10 @@ RetainPtr<CPDF_Object> CPDF_StreamParser::ReadNextObject(
       if (!pObj)
         return nullptr;
 
-      pDict->SetFor(key, std::move(pObj));
+      entries.emplace_back(std::move(key), std::move(pObj));
     }
+    auto pDict = pdfium::MakeRetain<CPDF_Dictionary>(m_pPool);
+    pDict->SetEntries(std::move(entries));
     return pDict;
   }
 
@@ -0,0 +1,212 @@
+// Copyright 2024 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/page/cpdf_streamprefetcher.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "constants/page_object.h"
+#include "core/fpdfapi/page/cpdf_docpagedata.h"
+#include "core/fpdfapi/page/cpdf_page.h"
+#include "core/fpdfapi/parser/cpdf_array.h"
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_document.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fpdfapi/parser/cpdf_stream_acc.h"
+#include "core/fpdfapi/parser/fpdf_parser_decode.h"
+#include "core/fxcrt/parallel_for.h"
+#include "third_party/base/containers/contains.h"
+
+namespace {
+
+size_t g_prefetch_thread_count = 1;
+
+// CPDF_DIB leaves a final Flate or RunLength filter to a ScanlineDecoder,
+// and only uses data that got decoded in full as is. The two agree, except
+// for RunLength, and for Flate with the TIFF predictor, which the
+// ScanlineDecoder applies per image row.
+bool IsImageDecodedSameInFull(const DecoderArray& decoder_array) {
+  const ByteString& decoder = decoder_array.back().first;
+  if (decoder == "RunLengthDecode" || decoder == "RL")
+    return false;
+
+  if (decoder != "FlateDecode" && decoder != "Fl")
+    return true;
+
+  const CPDF_Object* pParams = decoder_array.back().second.Get();
+  return !pParams || !pParams->IsDictionary() ||
+         pParams->AsDictionary()->GetIntegerFor("Predictor") != 2;
+}
+
+}  // namespace
+
+// static
+void CPDF_StreamPrefetcher::SetThreadCount(size_t count) {
+  g_prefetch_thread_count = std::max<size_t>(count, 1);
+}
+
+// static
+size_t CPDF_StreamPrefetcher::GetThreadCount() {
+  return g_prefetch_thread_count;
+}
+
+// static
+void CPDF_StreamPrefetcher::Prefetch(CPDF_Page* pPage) {
+  if (g_prefetch_thread_count <= 1 || !pPage->GetDocument())
+    return;
+
+  // With a cull rect, the content parser skips the images and forms outside
+  // of it, so decoding all of them up front would mostly be wasted.
+  if (pPage->GetCullRect().has_value())
+    return;
+
+  CPDF_DocPageData* pPageData =
+      CPDF_DocPageData::FromDocument(pPage->GetDocument());
+  if (!pPageData)
+    return;
+
+  CPDF_StreamPrefetcher prefetcher(pPageData);
+  prefetcher.AddContents(pPage);
+  prefetcher.AddResources(pPage->GetPageResources().Get());
+  prefetcher.Run();
+}
+
+CPDF_StreamPrefetcher::CPDF_StreamPrefetcher(CPDF_DocPageData* pPageData)
+    : m_pPageData(pPageData) {}
+
+CPDF_StreamPrefetcher::~CPDF_StreamPrefetcher() = default;
+
+void CPDF_StreamPrefetcher::AddContents(const CPDF_Page* pPage) {
+  RetainPtr<const CPDF_Object> pContent =
+      pPage->GetDict()->GetDirectObjectFor(pdfium::page_object::kContents);
+  if (!pContent)
+    return;
+
+  if (const CPDF_Stream* pStream = pContent->AsStream()) {
+    AddStream(pStream, 0, /*bImage=*/false);
+    return;
+  }
+
+  const CPDF_Array* pArray = pContent->AsArray();
+  if (!pArray)
+    return;
+
+  for (size_t i = 0; i < pArray->size(); ++i) {
+    RetainPtr<const CPDF_Stream> pStream =
+        ToStream(pArray->GetDirectObjectAt(i));
+    AddStream(pStream.Get(), 0, /*bImage=*/false);
+  }
+}
+
+void CPDF_StreamPrefetcher::AddResources(const CPDF_Dictionary* pResources) {
+  if (!pResources || pdfium::Contains(m_VisitedResources, pResources))
+    return;
+
+  m_VisitedResources.insert(pResources);
+  RetainPtr<const CPDF_Dictionary> pXObjects =
+      pResources->GetDictFor("XObject");
+  if (pXObjects)
+    AddXObjects(pXObjects.Get());
+
+  RetainPtr<const CPDF_Dictionary> pFonts = pResources->GetDictFor("Font");
+  if (pFonts)
+    AddFonts(pFonts.Get());
+}
+
+void CPDF_StreamPrefetcher::AddXObjects(const CPDF_Dictionary* pXObjects) {
+  CPDF_DictionaryLocker locker(pXObjects);
+  for (const auto& it : locker) {
+    RetainPtr<const CPDF_Stream> pStream = ToStream(it.second->GetDirect());
+    if (!pStream)
+      continue;
+
+    RetainPtr<const CPDF_Dictionary> pDict = pStream->GetDict();
+    ByteString subtype = pDict->GetNameFor("Subtype");
+    if (subtype == "Image") {
+      AddStream(pStream.Get(), 0, /*bImage=*/true);
+      RetainPtr<const CPDF_Stream> pMask = pDict->GetStreamFor("SMask");
+      AddStream(pMask.Get(), 0, /*bImage=*/true);
+    } else if (subtype == "Form") {
+      AddStream(pStream.Get(), 0, /*bImage=*/false);
+      RetainPtr<const CPDF_Dictionary> pResources =
+          pDict->GetDictFor("Resources");
+      AddResources(pResources.Get());
+    }
+  }
+}
+
+void CPDF_StreamPrefetcher::AddFonts(const CPDF_Dictionary* pFonts) {
+  CPDF_DictionaryLocker locker(pFonts);
+  for (const auto& it : locker) {
+    RetainPtr<const CPDF_Dictionary> pFontDict =
+        ToDictionary(it.second->GetDirect());
+    if (pFontDict)
+      AddFontFile(pFontDict.Get());
+  }
+}
+
+void CPDF_StreamPrefetcher::AddFontFile(const CPDF_Dictionary* pFontDict) {
+  RetainPtr<const CPDF_Dictionary> pDescendant;
+  if (pFontDict->GetNameFor("Subtype") == "Type0") {
+    RetainPtr<const CPDF_Array> pDescendants =
+        pFontDict->GetArrayFor("DescendantFonts");
+    pDescendant = pDescendants ? pDescendants->GetDictAt(0) : nullptr;
+    if (!pDescendant)
+      return;
+    pFontDict = pDescendant.Get();
+  }
+
+  RetainPtr<const CPDF_Dictionary> pFontDesc =
+      pFontDict->GetDictFor("FontDescriptor");
+  if (!pFontDesc)
+    return;
+
+  // Same order as CPDF_Font::LoadFontDescriptor().
+  RetainPtr<const CPDF_Stream> pFontFile = pFontDesc->GetStreamFor("FontFile");
+  if (!pFontFile)
+    pFontFile = pFontDesc->GetStreamFor("FontFile2");
+  if (!pFontFile)
+    pFontFile = pFontDesc->GetStreamFor("FontFile3");
+  if (!pFontFile || m_pPageData->HasFontFileStreamAcc(pFontFile.Get()))
+    return;
+
+  AddStream(pFontFile.Get(),
+            CPDF_DocPageData::GetFontFileEstimatedSize(pFontFile.Get()),
+            /*bImage=*/false);
+}
+
+void CPDF_StreamPrefetcher::AddStream(const CPDF_Stream* pStream,
+                                      uint32_t estimated_size,
+                                      bool bImage) {
+  // Streams without filters load without decoding, so there is nothing to
+  // gain from loading them here.
+  if (!pStream || !pStream->HasFilter() ||
+      pdfium::Contains(m_AddedStreams, pStream)) {
+    return;
+  }
+
+  m_AddedStreams.insert(pStream);
+  absl::optional<DecoderArray> decoder_array =
+      GetDecoderArray(pStream->GetDict());
+  if (!decoder_array.has_value() || decoder_array.value().empty() ||
+      !HasOnlyDataFilters(decoder_array.value())) {
+    return;
+  }
+  if (bImage && !IsImageDecodedSameInFull(decoder_array.value()))
+    return;
+
+  auto pStreamAcc =
+      pdfium::MakeRetain<CPDF_StreamAcc>(pdfium::WrapRetain(pStream));
+  pStreamAcc->StartLoadFiltered(estimated_size);
+  m_StreamAccs.push_back(std::move(pStreamAcc));
+}
+
+void CPDF_StreamPrefetcher::Run() {
+  ParallelFor(m_StreamAccs.size(), g_prefetch_thread_count,
+              [this](size_t i) { m_StreamAccs[i]->DecodeFiltered(); });
+  for (auto& pStreamAcc : m_StreamAccs)
+    pStreamAcc->FinishLoadFiltered();
+  m_pPageData->SetPrefetchedStreamAccs(std::move(m_StreamAccs));
+}
@@ -0,0 +1,60 @@
+// Copyright 2024 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_PAGE_CPDF_STREAMPREFETCHER_H_
+#define CORE_FPDFAPI_PAGE_CPDF_STREAMPREFETCHER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <set>
+#include <vector>
+
+#include "core/fxcrt/retain_ptr.h"
+#include "core/fxcrt/unowned_ptr.h"
+
+class CPDF_DocPageData;
+class CPDF_Dictionary;
+class CPDF_Page;
+class CPDF_Stream;
+class CPDF_StreamAcc;
+
+// Decodes the streams a page is about to load - its content streams, and those
+// of the images, forms and embedded fonts in its resources - on several
+// threads at once. The results go to the document's CPDF_DocPageData, where
+// the content parser, the font loader and CPDF_DIB pick them up instead of
+// decoding the streams themselves.
+class CPDF_StreamPrefetcher {
+ public:
+  // Sets how many threads Prefetch() may use. Not thread-safe; call this
+  // before loading pages. Defaults to 1, which turns prefetching off.
+  static void SetThreadCount(size_t count);
+  static size_t GetThreadCount();
+
+  // Does nothing if the thread count is 1, or if `pPage` has a cull rect.
+  // Like the rest of page loading, this must not run concurrently with other
+  // users of the page's document.
+  static void Prefetch(CPDF_Page* pPage);
+
+ private:
+  explicit CPDF_StreamPrefetcher(CPDF_DocPageData* pPageData);
+  ~CPDF_StreamPrefetcher();
+
+  void AddContents(const CPDF_Page* pPage);
+  void AddResources(const CPDF_Dictionary* pResources);
+  void AddXObjects(const CPDF_Dictionary* pXObjects);
+  void AddFonts(const CPDF_Dictionary* pFonts);
+  void AddFontFile(const CPDF_Dictionary* pFontDict);
+  void AddStream(const CPDF_Stream* pStream,
+                 uint32_t estimated_size,
+                 bool bImage);
+  void Run();
+
+  UnownedPtr<CPDF_DocPageData> const m_pPageData;
+  std::set<const CPDF_Dictionary*> m_VisitedResources;
+  std::set<const CPDF_Stream*> m_AddedStreams;
+  std::vector<RetainPtr<CPDF_StreamAcc>> m_StreamAccs;
+};
+
+#endif  // CORE_FPDFAPI_PAGE_CPDF_STREAMPREFETCHER_H_
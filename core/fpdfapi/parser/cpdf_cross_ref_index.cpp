@@ -0,0 +1,210 @@
+// Copyright 2024 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/parser/cpdf_cross_ref_index.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "core/fdrm/fx_crypt.h"
+#include "core/fpdfapi/parser/cpdf_parser.h"
+#include "core/fxcrt/binary_buffer.h"
+#include "core/fxcrt/fixed_uninit_data_vector.h"
+#include "core/fxcrt/fx_stream.h"
+#include "third_party/base/numerics/safe_conversions.h"
+
+namespace {
+
+// "PDFXRIDX" in native byte order, followed by the format version.
+constexpr uint32_t kMagic[2] = {0x58464450, 0x58444952};
+constexpr uint32_t kVersion = 1;
+
+// How much of the end of a file DigestFileTail() covers.
+constexpr FX_FILESIZE kTailSize = 1024;
+
+constexpr uint8_t kXRefStreamFlag = 1 << 0;
+constexpr uint8_t kXRefTableRebuiltFlag = 1 << 1;
+
+void AppendUint64(BinaryBuffer* buffer, uint64_t value) {
+  buffer->AppendSpan({reinterpret_cast<uint8_t*>(&value), sizeof(value)});
+}
+
+// Reads values in the order BinaryBuffer appended them. Once a read fails,
+// all further reads fail as well.
+class IndexReader {
+ public:
+  explicit IndexReader(pdfium::span<const uint8_t> data) : data_(data) {}
+
+  bool ok() const { return ok_; }
+  bool at_end() const { return ok_ && data_.empty(); }
+
+  template <typename T>
+  T Read() {
+    T value = 0;
+    if (!ok_ || data_.size() < sizeof(value)) {
+      ok_ = false;
+      return value;
+    }
+    memcpy(&value, data_.data(), sizeof(value));
+    data_ = data_.subspan(sizeof(value));
+    return value;
+  }
+
+  pdfium::span<const uint8_t> ReadSpan(size_t size) {
+    if (!ok_ || data_.size() < size) {
+      ok_ = false;
+      return {};
+    }
+    pdfium::span<const uint8_t> result = data_.first(size);
+    data_ = data_.subspan(size);
+    return result;
+  }
+
+ private:
+  pdfium::span<const uint8_t> data_;
+  bool ok_ = true;
+};
+
+bool IsValidObjectNumber(uint32_t obj_num) {
+  return obj_num < CPDF_Parser::kMaxObjectNumber;
+}
+
+}  // namespace
+
+// static
+absl::optional<CPDF_CrossRefIndex::Digest> CPDF_CrossRefIndex::DigestFileTail(
+    IFX_SeekableReadStream* file) {
+  const FX_FILESIZE file_size = file->GetSize();
+  const FX_FILESIZE tail_size = std::min(file_size, kTailSize);
+  FixedUninitDataVector<uint8_t> tail(static_cast<size_t>(tail_size));
+  if (!tail.empty() &&
+      !file->ReadBlockAtOffset(tail.writable_span(), file_size - tail_size)) {
+    return absl::nullopt;
+  }
+
+  Digest digest;
+  CRYPT_MD5Generate(tail.span(), digest.data());
+  return digest;
+}
+
+// static
+std::unique_ptr<CPDF_CrossRefIndex> CPDF_CrossRefIndex::Parse(
+    pdfium::span<const uint8_t> data) {
+  IndexReader reader(data);
+  if (reader.Read<uint32_t>() != kMagic[0] ||
+      reader.Read<uint32_t>() != kMagic[1] ||
+      reader.Read<uint32_t>() != kVersion) {
+    return nullptr;
+  }
+
+  auto index = std::make_unique<CPDF_CrossRefIndex>();
+  index->file_size = reader.Read<int64_t>();
+  pdfium::span<const uint8_t> digest =
+      reader.ReadSpan(index->tail_digest.size());
+  if (!reader.ok())
+    return nullptr;
+  std::copy(digest.begin(), digest.end(), index->tail_digest.begin());
+
+  index->last_xref_offset = reader.Read<int64_t>();
+  const uint8_t flags = reader.Read<uint8_t>();
+  index->xref_stream = flags & kXRefStreamFlag;
+  index->xref_table_rebuilt = flags & kXRefTableRebuiltFlag;
+  index->trailer_object_number = reader.Read<uint32_t>();
+  index->trailer =
+      ByteString(ByteStringView(reader.ReadSpan(reader.Read<uint32_t>())));
+
+  const uint32_t object_count = reader.Read<uint32_t>();
+  for (uint32_t i = 0; i < object_count && reader.ok(); ++i) {
+    const uint32_t obj_num = reader.Read<uint32_t>();
+    const uint8_t type = reader.Read<uint8_t>();
+    CPDF_CrossRefTable::ObjectInfo info;
+    info.is_object_stream_flag = reader.Read<uint8_t>() != 0;
+    info.gennum = reader.Read<uint16_t>();
+    if (!IsValidObjectNumber(obj_num) ||
+        type > static_cast<uint8_t>(CPDF_CrossRefTable::ObjectType::kNull)) {
+      return nullptr;
+    }
+    info.type = static_cast<CPDF_CrossRefTable::ObjectType>(type);
+    if (info.type == CPDF_CrossRefTable::ObjectType::kCompressed) {
+      info.archive.obj_num = reader.Read<uint32_t>();
+      info.archive.obj_index = reader.Read<uint32_t>();
+      if (!IsValidObjectNumber(info.archive.obj_num))
+        return nullptr;
+    } else {
+      info.pos = reader.Read<int64_t>();
+    }
+    index->objects[obj_num] = info;
+  }
+
+  const uint32_t object_stream_count = reader.Read<uint32_t>();
+  for (uint32_t i = 0; i < object_stream_count && reader.ok(); ++i) {
+    const uint32_t stream_obj_num = reader.Read<uint32_t>();
+    const uint32_t count = reader.Read<uint32_t>();
+    if (!IsValidObjectNumber(stream_obj_num) ||
+        count >= CPDF_Parser::kMaxObjectNumber) {
+      return nullptr;
+    }
+    std::vector<CPDF_ObjectStream::ObjectInfo> object_info;
+    for (uint32_t j = 0; j < count && reader.ok(); ++j) {
+      const uint32_t obj_num = reader.Read<uint32_t>();
+      const uint32_t obj_offset = reader.Read<uint32_t>();
+      object_info.emplace_back(obj_num, obj_offset);
+    }
+    index->object_streams[stream_obj_num] = std::move(object_info);
+  }
+
+  if (!reader.at_end() || index->trailer.IsEmpty())
+    return nullptr;
+
+  return index;
+}
+
+CPDF_CrossRefIndex::CPDF_CrossRefIndex() = default;
+
+CPDF_CrossRefIndex::~CPDF_CrossRefIndex() = default;
+
+DataVector<uint8_t> CPDF_CrossRefIndex::Serialize() const {
+  BinaryBuffer buffer;
+  buffer.AppendUint32(kMagic[0]);
+  buffer.AppendUint32(kMagic[1]);
+  buffer.AppendUint32(kVersion);
+  AppendUint64(&buffer, file_size);
+  buffer.AppendSpan({tail_digest.data(), tail_digest.size()});
+  AppendUint64(&buffer, last_xref_offset);
+  buffer.AppendUint8((xref_stream ? kXRefStreamFlag : 0) |
+                     (xref_table_rebuilt ? kXRefTableRebuiltFlag : 0));
+  buffer.AppendUint32(trailer_object_number);
+  buffer.AppendUint32(
+      pdfium::base::checked_cast<uint32_t>(trailer.GetLength()));
+  buffer.AppendString(trailer);
+
+  buffer.AppendUint32(pdfium::base::checked_cast<uint32_t>(objects.size()));
+  for (const auto& [obj_num, info] : objects) {
+    buffer.AppendUint32(obj_num);
+    buffer.AppendUint8(static_cast<uint8_t>(info.type));
+    buffer.AppendUint8(info.is_object_stream_flag);
+    buffer.AppendUint16(info.gennum);
+    if (info.type == CPDF_CrossRefTable::ObjectType::kCompressed) {
+      buffer.AppendUint32(info.archive.obj_num);
+      buffer.AppendUint32(info.archive.obj_index);
+    } else {
+      AppendUint64(&buffer, info.pos);
+    }
+  }
+
+  buffer.AppendUint32(
+      pdfium::base::checked_cast<uint32_t>(object_streams.size()));
+  for (const auto& [stream_obj_num, object_info] : object_streams) {
+    buffer.AppendUint32(stream_obj_num);
+    buffer.AppendUint32(
+        pdfium::base::checked_cast<uint32_t>(object_info.size()));
+    for (const auto& info : object_info) {
+      buffer.AppendUint32(info.obj_num);
+      buffer.AppendUint32(info.obj_offset);
+    }
+  }
+  return buffer.DetachBuffer();
+}
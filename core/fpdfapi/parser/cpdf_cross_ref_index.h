@@ -0,0 +1,63 @@
+// Copyright 2024 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_PARSER_CPDF_CROSS_REF_INDEX_H_
+#define CORE_FPDFAPI_PARSER_CPDF_CROSS_REF_INDEX_H_
+
+#include <stdint.h>
+
+#include <array>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "core/fpdfapi/parser/cpdf_cross_ref_table.h"
+#include "core/fpdfapi/parser/cpdf_object_stream.h"
+#include "core/fxcrt/bytestring.h"
+#include "core/fxcrt/data_vector.h"
+#include "core/fxcrt/fx_types.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+#include "third_party/base/containers/span.h"
+
+class IFX_SeekableReadStream;
+
+// What CPDF_Parser learns from a file's cross-reference sections and object
+// stream headers, in a form that can be saved and handed back to the parser
+// on later opens of the same, unmodified file. The binary form is in native
+// byte order and is only meant to be read back by the same PDFium version.
+struct CPDF_CrossRefIndex {
+  using Digest = std::array<uint8_t, 16>;
+
+  // Returns the digest of the end of `file`, which contains the trailer with
+  // the file's /ID and the final startxref offset, or nullopt on read errors.
+  // Together with the file size, this identifies the file an index belongs to.
+  static absl::optional<Digest> DigestFileTail(IFX_SeekableReadStream* file);
+
+  // Returns nullptr if `data` is not a well-formed index.
+  static std::unique_ptr<CPDF_CrossRefIndex> Parse(
+      pdfium::span<const uint8_t> data);
+
+  CPDF_CrossRefIndex();
+  ~CPDF_CrossRefIndex();
+
+  DataVector<uint8_t> Serialize() const;
+
+  FX_FILESIZE file_size = 0;
+  Digest tail_digest = {};
+  FX_FILESIZE last_xref_offset = 0;
+  bool xref_stream = false;
+  bool xref_table_rebuilt = false;
+  uint32_t trailer_object_number = 0;
+
+  // The trailer dictionary, in PDF syntax.
+  ByteString trailer;
+
+  std::map<uint32_t, CPDF_CrossRefTable::ObjectInfo> objects;
+
+  // The headers of the object streams, keyed by their object numbers.
+  std::map<uint32_t, std::vector<CPDF_ObjectStream::ObjectInfo>>
+      object_streams;
+};
+
+#endif  // CORE_FPDFAPI_PARSER_CPDF_CROSS_REF_INDEX_H_
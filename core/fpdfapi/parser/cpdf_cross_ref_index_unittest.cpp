@@ -0,0 +1,148 @@
+// Copyright 2024 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/parser/cpdf_cross_ref_index.h"
+
+#include <memory>
+
+#include "core/fpdfapi/parser/cpdf_parser.h"
+#include "core/fxcrt/cfx_read_only_span_stream.h"
+#include "core/fxcrt/data_vector.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using testing::ElementsAre;
+
+namespace {
+
+CPDF_CrossRefIndex MakeIndex() {
+  CPDF_CrossRefIndex index;
+  index.file_size = 12345;
+  index.tail_digest[0] = 0xab;
+  index.tail_digest[15] = 0xcd;
+  index.last_xref_offset = 12000;
+  index.xref_stream = true;
+  index.trailer_object_number = 7;
+  index.trailer = "<</Root 1 0 R/Size 8>>";
+
+  CPDF_CrossRefTable::ObjectInfo normal;
+  normal.type = CPDF_CrossRefTable::ObjectType::kNormal;
+  normal.gennum = 2;
+  normal.pos = 15;
+  index.objects[1] = normal;
+
+  CPDF_CrossRefTable::ObjectInfo object_stream;
+  object_stream.type = CPDF_CrossRefTable::ObjectType::kNormal;
+  object_stream.is_object_stream_flag = true;
+  object_stream.pos = 300;
+  index.objects[5] = object_stream;
+
+  CPDF_CrossRefTable::ObjectInfo compressed;
+  compressed.type = CPDF_CrossRefTable::ObjectType::kCompressed;
+  compressed.archive.obj_num = 5;
+  compressed.archive.obj_index = 1;
+  index.objects[6] = compressed;
+
+  index.object_streams[5] = {{4, 0}, {6, 12}};
+  return index;
+}
+
+}  // namespace
+
+TEST(CrossRefIndexTest, RoundTrip) {
+  DataVector<uint8_t> data = MakeIndex().Serialize();
+  std::unique_ptr<CPDF_CrossRefIndex> index = CPDF_CrossRefIndex::Parse(data);
+  ASSERT_TRUE(index);
+
+  EXPECT_EQ(12345, index->file_size);
+  EXPECT_EQ(MakeIndex().tail_digest, index->tail_digest);
+  EXPECT_EQ(12000, index->last_xref_offset);
+  EXPECT_TRUE(index->xref_stream);
+  EXPECT_FALSE(index->xref_table_rebuilt);
+  EXPECT_EQ(7u, index->trailer_object_number);
+  EXPECT_EQ("<</Root 1 0 R/Size 8>>", index->trailer);
+
+  ASSERT_EQ(3u, index->objects.size());
+  const CPDF_CrossRefTable::ObjectInfo& normal = index->objects[1];
+  EXPECT_EQ(CPDF_CrossRefTable::ObjectType::kNormal, normal.type);
+  EXPECT_FALSE(normal.is_object_stream_flag);
+  EXPECT_EQ(2, normal.gennum);
+  EXPECT_EQ(15, normal.pos);
+  const CPDF_CrossRefTable::ObjectInfo& object_stream = index->objects[5];
+  EXPECT_TRUE(object_stream.is_object_stream_flag);
+  EXPECT_EQ(300, object_stream.pos);
+  const CPDF_CrossRefTable::ObjectInfo& compressed = index->objects[6];
+  EXPECT_EQ(CPDF_CrossRefTable::ObjectType::kCompressed, compressed.type);
+  EXPECT_EQ(5u, compressed.archive.obj_num);
+  EXPECT_EQ(1u, compressed.archive.obj_index);
+
+  ASSERT_EQ(1u, index->object_streams.size());
+  EXPECT_THAT(index->object_streams[5],
+              ElementsAre(CPDF_ObjectStream::ObjectInfo(4, 0),
+                          CPDF_ObjectStream::ObjectInfo(6, 12)));
+
+  EXPECT_EQ(data, index->Serialize());
+}
+
+TEST(CrossRefIndexTest, RejectsMalformedData) {
+  EXPECT_FALSE(CPDF_CrossRefIndex::Parse({}));
+
+  static constexpr uint8_t kGarbage[] = "%PDF-1.7 not an index at all";
+  EXPECT_FALSE(CPDF_CrossRefIndex::Parse(kGarbage));
+
+  DataVector<uint8_t> data = MakeIndex().Serialize();
+  for (size_t size = 0; size < data.size(); ++size) {
+    EXPECT_FALSE(
+        CPDF_CrossRefIndex::Parse(pdfium::make_span(data).first(size)));
+  }
+
+  data.push_back(0);
+  EXPECT_FALSE(CPDF_CrossRefIndex::Parse(data));
+}
+
+TEST(CrossRefIndexTest, RejectsInvalidObjectNumbers) {
+  CPDF_CrossRefIndex index = MakeIndex();
+  index.objects[CPDF_Parser::kMaxObjectNumber] = index.objects[1];
+  EXPECT_FALSE(CPDF_CrossRefIndex::Parse(index.Serialize()));
+
+  index = MakeIndex();
+  index.objects[6].archive.obj_num = CPDF_Parser::kMaxObjectNumber;
+  EXPECT_FALSE(CPDF_CrossRefIndex::Parse(index.Serialize()));
+
+  index = MakeIndex();
+  index.object_streams[CPDF_Parser::kMaxObjectNumber] = {{4, 0}};
+  EXPECT_FALSE(CPDF_CrossRefIndex::Parse(index.Serialize()));
+}
+
+TEST(CrossRefIndexTest, RejectsEmptyTrailer) {
+  CPDF_CrossRefIndex index = MakeIndex();
+  index.trailer.clear();
+  EXPECT_FALSE(CPDF_CrossRefIndex::Parse(index.Serialize()));
+}
+
+TEST(CrossRefIndexTest, DigestFileTail) {
+  static constexpr uint8_t kData[] = "trailer <</ID [<01> <02>]>>";
+  auto stream = pdfium::MakeRetain<CFX_ReadOnlySpanStream>(kData);
+  absl::optional<CPDF_CrossRefIndex::Digest> digest =
+      CPDF_CrossRefIndex::DigestFileTail(stream.Get());
+  ASSERT_TRUE(digest.has_value());
+
+  static constexpr uint8_t kOtherData[] = "trailer <</ID [<01> <03>]>>";
+  auto other_stream = pdfium::MakeRetain<CFX_ReadOnlySpanStream>(kOtherData);
+  absl::optional<CPDF_CrossRefIndex::Digest> other_digest =
+      CPDF_CrossRefIndex::DigestFileTail(other_stream.Get());
+  ASSERT_TRUE(other_digest.has_value());
+  EXPECT_NE(digest.value(), other_digest.value());
+
+  // Only the end of large files matters.
+  DataVector<uint8_t> large_data(4096, 'x');
+  auto large_stream = pdfium::MakeRetain<CFX_ReadOnlySpanStream>(large_data);
+  digest = CPDF_CrossRefIndex::DigestFileTail(large_stream.Get());
+  large_data[0] = 'y';
+  other_digest = CPDF_CrossRefIndex::DigestFileTail(large_stream.Get());
+  ASSERT_TRUE(digest.has_value());
+  ASSERT_TRUE(other_digest.has_value());
+  EXPECT_EQ(digest.value(), other_digest.value());
+}
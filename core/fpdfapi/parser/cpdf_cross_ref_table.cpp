@@ -32,6 +32,14 @@ CPDF_CrossRefTable::CPDF_CrossRefTable(RetainPtr<CPDF_Dictionary> trailer,
     : trailer_(std::move(trailer)),
       trailer_object_number_(trailer_object_number) {}
 
+CPDF_CrossRefTable::CPDF_CrossRefTable(
+    RetainPtr<CPDF_Dictionary> trailer,
+    uint32_t trailer_object_number,
+    std::map<uint32_t, ObjectInfo> objects_info)
+    : trailer_(std::move(trailer)),
+      trailer_object_number_(trailer_object_number),
+      objects_info_(std::move(objects_info)) {}
+
 CPDF_CrossRefTable::~CPDF_CrossRefTable() = default;
 
 void CPDF_CrossRefTable::AddCompressed(uint32_t obj_num,
@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_cross_ref_avail.h"
@@ -890,6 +891,38 @@ CPDF_DataAvail::DocAvailStatus CPDF_DataAvail::IsPageAvail(
   return kDataAvailable;
 }
 
+CPDF_DataAvail::DocAvailStatus CPDF_DataAvail::RequestPageData(
+    uint32_t dwPage,
+    DownloadHints* pHints) {
+  if (!m_pDocument || !m_pLinearized || !m_pHintTables)
+    return kDataError;
+
+  std::vector<DataRange> ranges;
+  if (dwPage == m_pLinearized->GetFirstPageNo()) {
+    ranges.push_back(
+        {0, static_cast<size_t>(m_pLinearized->GetFirstPageEndOffset())});
+  } else {
+    // Other pages also need the main cross reference table, which comes last.
+    const CPDF_Dictionary* trailer =
+        m_pDocument->GetParser() ? m_pDocument->GetParser()->GetTrailer()
+                                 : nullptr;
+    if (!m_bMainXRefLoadTried && trailer) {
+      const FX_FILESIZE main_xref_offset = trailer->GetIntegerFor("Prev");
+      if (main_xref_offset > 0 && main_xref_offset < m_dwFileLen) {
+        ranges.push_back({main_xref_offset,
+                          static_cast<size_t>(m_dwFileLen - main_xref_offset)});
+      }
+    }
+    if (!m_pHintTables->GetPageRanges(dwPage, &ranges))
+      return kDataError;
+  }
+
+  const HintsScope hints_scope(GetValidator(), pHints);
+  return GetValidator()->CheckDataRangesAndRequestIfUnavailable(ranges)
+             ? kDataAvailable
+             : kDataNotAvailable;
+}
+
 CPDF_DataAvail::DocAvailStatus CPDF_DataAvail::CheckResources(
     RetainPtr<CPDF_Dictionary> page) {
   DCHECK(page);
@@ -58,6 +58,12 @@ class CPDF_DataAvail final : public Observable::ObserverIface {
     kFormNotExist = 2,      // PDF_FORM_NOTEXIST
   };
 
+  // A range of bytes in the file.
+  struct DataRange {
+    FX_FILESIZE offset;
+    size_t size;
+  };
+
   class FileAvail {
    public:
     virtual ~FileAvail();
@@ -79,6 +85,14 @@ class CPDF_DataAvail final : public Observable::ObserverIface {
 
   DocAvailStatus IsDocAvail(DownloadHints* pHints);
   DocAvailStatus IsPageAvail(uint32_t dwPage, DownloadHints* pHints);
+
+  // Requests all of the data that page `dwPage` of a linearized document
+  // needs according to its hint tables at once, with ranges that overlap or
+  // touch merged, rather than one range at a time as IsPageAvail() finds them
+  // missing. Returns kDataAvailable if all of the data is there, but the page
+  // still gets loaded by IsPageAvail(). Returns kDataError if there are no
+  // usable hint tables.
+  DocAvailStatus RequestPageData(uint32_t dwPage, DownloadHints* pHints);
   DocFormStatus IsFormAvail(DownloadHints* pHints);
   DocLinearizationStatus IsLinearizedPDF();
   int GetPageCount() const;
@@ -6,6 +6,8 @@
 
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 
+#include <algorithm>
+#include <iterator>
 #include <set>
 #include <utility>
 
@@ -22,6 +24,19 @@
 #include "third_party/base/check.h"
 #include "third_party/base/containers/contains.h"
 
+namespace {
+
+// Dictionaries up to this size are searched linearly, which beats a binary
+// search for the short keys typical of PDF dictionaries.
+constexpr size_t kMaxLinearSearchSize = 8;
+
+bool EntryKeyLess(const std::pair<ByteString, RetainPtr<CPDF_Object>>& entry,
+                  ByteStringView key) {
+  return entry.first < key;
+}
+
+}  // namespace
+
 CPDF_Dictionary::CPDF_Dictionary()
     : CPDF_Dictionary(WeakPtr<ByteStringPool>()) {}
 
@@ -55,13 +70,15 @@ RetainPtr<CPDF_Object> CPDF_Dictionary::CloneNonCyclic(
     std::set<const CPDF_Object*>* pVisited) const {
   pVisited->insert(this);
   auto pCopy = pdfium::MakeRetain<CPDF_Dictionary>(m_pPool);
+  pCopy->m_Map.reserve(m_Map.size());
   CPDF_DictionaryLocker locker(this);
   for (const auto& it : locker) {
     if (!pdfium::Contains(*pVisited, it.second.Get())) {
       std::set<const CPDF_Object*> visited(*pVisited);
       auto obj = it.second->CloneNonCyclic(bDirect, &visited);
+      // Entries are visited in order, so the copy stays sorted.
       if (obj)
-        pCopy->m_Map.insert(std::make_pair(it.first, std::move(obj)));
+        pCopy->m_Map.emplace_back(it.first, std::move(obj));
     }
   }
   return pCopy;
@@ -69,7 +86,7 @@ RetainPtr<CPDF_Object> CPDF_Dictionary::CloneNonCyclic(
 
 const CPDF_Object* CPDF_Dictionary::GetObjectForInternal(
     const ByteString& key) const {
-  auto it = m_Map.find(key);
+  auto it = Find(key.AsStringView());
   return it != m_Map.end() ? it->second.Get() : nullptr;
 }
 
@@ -253,7 +270,7 @@ CFX_Matrix CPDF_Dictionary::GetMatrixFor(const ByteString& key) const {
 }
 
 bool CPDF_Dictionary::KeyExist(const ByteString& key) const {
-  return pdfium::Contains(m_Map, key);
+  return Find(key.AsStringView()) != m_Map.end();
 }
 
 std::vector<ByteString> CPDF_Dictionary::GetKeys() const {
@@ -269,24 +286,99 @@ void CPDF_Dictionary::SetFor(const ByteString& key,
   (void)SetForInternal(key, std::move(pObj));
 }
 
+void CPDF_Dictionary::SetEntries(DictMap entries) {
+  CHECK(!IsLocked());
+  CHECK(m_Map.empty());
+  for (auto& entry : entries) {
+    DCHECK(entry.second);
+    DCHECK(entry.second->IsInline());
+    entry.first = MaybeIntern(entry.first);
+  }
+  auto key_less = [](const DictMap::value_type& a,
+                     const DictMap::value_type& b) {
+    return a.first < b.first;
+  };
+  if (!std::is_sorted(entries.begin(), entries.end(), key_less))
+    std::stable_sort(entries.begin(), entries.end(), key_less);
+
+  // Keep the last of each run of equal keys, which the stable sort left in
+  // their original order.
+  m_Map = std::move(entries);
+  auto out = m_Map.begin();
+  for (auto it = m_Map.begin(); it != m_Map.end(); ++it) {
+    if (out != m_Map.begin() && (out - 1)->first == it->first) {
+      (out - 1)->second = std::move(it->second);
+      continue;
+    }
+    if (out != it)
+      *out = std::move(*it);
+    ++out;
+  }
+  m_Map.erase(out, m_Map.end());
+}
+
 CPDF_Object* CPDF_Dictionary::SetForInternal(const ByteString& key,
                                              RetainPtr<CPDF_Object> pObj) {
   CHECK(!IsLocked());
   if (!pObj) {
-    m_Map.erase(key);
+    auto it = Find(key.AsStringView());
+    if (it != m_Map.end())
+      m_Map.erase(it);
     return nullptr;
   }
   DCHECK(pObj->IsInline());
   CPDF_Object* pRet = pObj.Get();
-  m_Map[MaybeIntern(key)] = std::move(pObj);
+  InsertOrAssign(key, std::move(pObj));
   return pRet;
 }
 
+CPDF_Dictionary::DictMap::iterator CPDF_Dictionary::LowerBound(
+    ByteStringView key) {
+  return std::lower_bound(m_Map.begin(), m_Map.end(), key, EntryKeyLess);
+}
+
+CPDF_Dictionary::DictMap::const_iterator CPDF_Dictionary::LowerBound(
+    ByteStringView key) const {
+  return std::lower_bound(m_Map.begin(), m_Map.end(), key, EntryKeyLess);
+}
+
+CPDF_Dictionary::DictMap::iterator CPDF_Dictionary::Find(ByteStringView key) {
+  auto it = static_cast<const CPDF_Dictionary*>(this)->Find(key);
+  return m_Map.begin() + std::distance(m_Map.cbegin(), it);
+}
+
+CPDF_Dictionary::DictMap::const_iterator CPDF_Dictionary::Find(
+    ByteStringView key) const {
+  if (m_Map.size() <= kMaxLinearSearchSize) {
+    return std::find_if(m_Map.begin(), m_Map.end(), [key](const auto& entry) {
+      return entry.first == key;
+    });
+  }
+  auto it = LowerBound(key);
+  return it != m_Map.end() && it->first == key ? it : m_Map.end();
+}
+
+void CPDF_Dictionary::InsertOrAssign(const ByteString& key,
+                                     RetainPtr<CPDF_Object> pObj) {
+  // Keys that arrive in sorted order, e.g. from CPDF_Creator output, are
+  // appended without a search.
+  if (m_Map.empty() || m_Map.back().first < key) {
+    m_Map.emplace_back(MaybeIntern(key), std::move(pObj));
+    return;
+  }
+  auto it = LowerBound(key.AsStringView());
+  if (it != m_Map.end() && it->first == key) {
+    it->second = std::move(pObj);
+    return;
+  }
+  m_Map.emplace(it, MaybeIntern(key), std::move(pObj));
+}
+
 void CPDF_Dictionary::ConvertToIndirectObjectFor(
     const ByteString& key,
     CPDF_IndirectObjectHolder* pHolder) {
   CHECK(!IsLocked());
-  auto it = m_Map.find(key);
+  auto it = Find(key.AsStringView());
   if (it == m_Map.end() || it->second->IsReference())
     return;
 
@@ -297,7 +389,7 @@ void CPDF_Dictionary::ConvertToIndirectObjectFor(
 RetainPtr<CPDF_Object> CPDF_Dictionary::RemoveFor(ByteStringView key) {
   CHECK(!IsLocked());
   RetainPtr<CPDF_Object> result;
-  auto it = m_Map.find(key);
+  auto it = Find(key);
   if (it != m_Map.end()) {
     result = std::move(it->second);
     m_Map.erase(it);
@@ -308,16 +400,13 @@ RetainPtr<CPDF_Object> CPDF_Dictionary::RemoveFor(ByteStringView key) {
 void CPDF_Dictionary::ReplaceKey(const ByteString& oldkey,
                                  const ByteString& newkey) {
   CHECK(!IsLocked());
-  auto old_it = m_Map.find(oldkey);
-  if (old_it == m_Map.end())
-    return;
-
-  auto new_it = m_Map.find(newkey);
-  if (new_it == old_it)
+  auto old_it = Find(oldkey.AsStringView());
+  if (old_it == m_Map.end() || oldkey == newkey)
     return;
 
-  m_Map[MaybeIntern(newkey)] = std::move(old_it->second);
+  RetainPtr<CPDF_Object> pObj = std::move(old_it->second);
   m_Map.erase(old_it);
+  InsertOrAssign(newkey, std::move(pObj));
 }
 
 void CPDF_Dictionary::SetRectFor(const ByteString& key,
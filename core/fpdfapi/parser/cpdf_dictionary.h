@@ -7,8 +7,6 @@
 #ifndef CORE_FPDFAPI_PARSER_CPDF_DICTIONARY_H_
 #define CORE_FPDFAPI_PARSER_CPDF_DICTIONARY_H_
 
-#include <functional>
-#include <map>
 #include <set>
 #include <utility>
 #include <vector>
@@ -27,7 +25,9 @@ class CPDF_IndirectObjectHolder;
 // will return nullptr to indicate non-existent keys.
 class CPDF_Dictionary final : public CPDF_Object {
  public:
-  using DictMap = std::map<ByteString, RetainPtr<CPDF_Object>, std::less<>>;
+  // Entries sorted by key. Most dictionaries hold a handful of entries, so a
+  // flat vector needs far less memory and fewer allocations than a tree.
+  using DictMap = std::vector<std::pair<ByteString, RetainPtr<CPDF_Object>>>;
   using const_iterator = DictMap::const_iterator;
 
   CONSTRUCT_VIA_MAKE_RETAIN;
@@ -82,7 +82,7 @@ class CPDF_Dictionary final : public CPDF_Object {
   std::vector<ByteString> GetKeys() const;
 
   // Creates a new object owned by the dictionary and returns an unowned
-  // pointer to it. Invalidates iterators for the element with the key |key|.
+  // pointer to it. Invalidates iterators.
   // Prefer using these templates over calls to SetFor(), since by creating
   // a new object with no previous references, they ensure cycles can not be
   // introduced.
@@ -100,10 +100,16 @@ class CPDF_Dictionary final : public CPDF_Object {
   }
 
   // If |pObj| is null, then |key| is erased from the map. Otherwise, takes
-  // ownership of |pObj| and stores in in the map. Invalidates iterators for
-  // the element with the key |key|.
+  // ownership of |pObj| and stores in in the map. Invalidates iterators.
   void SetFor(const ByteString& key, RetainPtr<CPDF_Object> pObj);
 
+  // Replaces the entries of this empty dictionary with |entries|, which may
+  // be in any order and may repeat keys. As with one SetFor() call per entry,
+  // the last entry for a key wins. Sorts once instead of inserting each key
+  // into place, so parsers should prefer it for dictionaries of any size.
+  // All objects in |entries| must be non-null.
+  void SetEntries(DictMap entries);
+
   // Convenience functions to convert native objects to array form.
   void SetRectFor(const ByteString& key, const CFX_FloatRect& rect);
   void SetMatrixFor(const ByteString& key, const CFX_Matrix& matrix);
@@ -111,10 +117,10 @@ class CPDF_Dictionary final : public CPDF_Object {
   void ConvertToIndirectObjectFor(const ByteString& key,
                                   CPDF_IndirectObjectHolder* pHolder);
 
-  // Invalidates iterators for the element with the key |key|.
+  // Invalidates iterators.
   RetainPtr<CPDF_Object> RemoveFor(ByteStringView key);
 
-  // Invalidates iterators for the element with the key |oldkey|.
+  // Invalidates iterators.
   void ReplaceKey(const ByteString& oldkey, const ByteString& newkey);
 
   WeakPtr<ByteStringPool> GetByteStringPool() const { return m_pPool; }
@@ -137,6 +143,17 @@ class CPDF_Dictionary final : public CPDF_Object {
   CPDF_Object* SetForInternal(const ByteString& key,
                               RetainPtr<CPDF_Object> pObj);
 
+  // Returns the first entry whose key is not less than |key|.
+  DictMap::iterator LowerBound(ByteStringView key);
+  DictMap::const_iterator LowerBound(ByteStringView key) const;
+
+  // Returns end() if |key| does not exist.
+  DictMap::iterator Find(ByteStringView key);
+  DictMap::const_iterator Find(ByteStringView key) const;
+
+  // Adds |pObj| for |key|, or replaces the existing object for |key|.
+  void InsertOrAssign(const ByteString& key, RetainPtr<CPDF_Object> pObj);
+
   ByteString MaybeIntern(const ByteString& str);
   const CPDF_Dictionary* GetDictInternal() const override;
   RetainPtr<CPDF_Object> CloneNonCyclic(
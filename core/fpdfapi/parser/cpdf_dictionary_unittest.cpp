@@ -4,7 +4,9 @@
 
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 
+#include <memory>
 #include <utility>
+#include <vector>
 
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_number.h"
@@ -42,3 +44,115 @@ TEST(DictionaryTest, Iterators) {
   ++it;
   EXPECT_EQ(it, locked_dict.end());
 }
+
+TEST(DictionaryTest, ManyKeys) {
+  // Enough keys to go past the linear search, added out of order.
+  constexpr int kCount = 50;
+  auto dict = pdfium::MakeRetain<CPDF_Dictionary>();
+  for (int i = 0; i < kCount; ++i) {
+    int value = (i * 7) % kCount;
+    dict->SetNewFor<CPDF_Number>(ByteString::Format("Key%02d", value), value);
+  }
+  ASSERT_EQ(static_cast<size_t>(kCount), dict->size());
+  for (int i = 0; i < kCount; ++i)
+    EXPECT_EQ(i, dict->GetIntegerFor(ByteString::Format("Key%02d", i)));
+  EXPECT_FALSE(dict->KeyExist("Key"));
+  EXPECT_FALSE(dict->KeyExist("Key50"));
+
+  {
+    CPDF_DictionaryLocker locked_dict(dict);
+    int expected = 0;
+    for (const auto& it : locked_dict) {
+      EXPECT_EQ(ByteString::Format("Key%02d", expected), it.first);
+      EXPECT_EQ(expected, it.second->GetInteger());
+      ++expected;
+    }
+    EXPECT_EQ(kCount, expected);
+  }
+
+  dict->SetNewFor<CPDF_Number>("Key10", 100);
+  EXPECT_EQ(100, dict->GetIntegerFor("Key10"));
+  EXPECT_EQ(static_cast<size_t>(kCount), dict->size());
+
+  RetainPtr<CPDF_Object> removed = dict->RemoveFor("Key20");
+  ASSERT_TRUE(removed);
+  EXPECT_EQ(20, removed->GetInteger());
+  EXPECT_FALSE(dict->KeyExist("Key20"));
+  EXPECT_FALSE(dict->RemoveFor("Key20"));
+
+  dict->SetFor("Key30", nullptr);
+  EXPECT_FALSE(dict->KeyExist("Key30"));
+  EXPECT_EQ(static_cast<size_t>(kCount - 2), dict->size());
+}
+
+TEST(DictionaryTest, SetEntries) {
+  CPDF_Dictionary::DictMap entries;
+  for (int i = 0; i < 50; ++i) {
+    int value = (i * 7) % 50;
+    entries.emplace_back(ByteString::Format("Key%02d", value % 20),
+                         pdfium::MakeRetain<CPDF_Number>(value));
+  }
+  auto dict = pdfium::MakeRetain<CPDF_Dictionary>();
+  dict->SetEntries(std::move(entries));
+
+  // Each of the 20 keys keeps the last value given for it.
+  ASSERT_EQ(20u, dict->size());
+  CPDF_DictionaryLocker locked_dict(dict);
+  int expected_key = 0;
+  for (const auto& it : locked_dict) {
+    EXPECT_EQ(ByteString::Format("Key%02d", expected_key), it.first);
+    int last_value = -1;
+    for (int i = 0; i < 50; ++i) {
+      int value = (i * 7) % 50;
+      if (value % 20 == expected_key)
+        last_value = value;
+    }
+    EXPECT_EQ(last_value, it.second->GetInteger());
+    ++expected_key;
+  }
+}
+
+TEST(DictionaryTest, SetEntriesSorted) {
+  CPDF_Dictionary::DictMap entries;
+  entries.emplace_back("A", pdfium::MakeRetain<CPDF_Number>(1));
+  entries.emplace_back("B", pdfium::MakeRetain<CPDF_Number>(2));
+  entries.emplace_back("B", pdfium::MakeRetain<CPDF_Number>(3));
+  entries.emplace_back("C", pdfium::MakeRetain<CPDF_Number>(4));
+  auto dict = pdfium::MakeRetain<CPDF_Dictionary>();
+  dict->SetEntries(std::move(entries));
+  EXPECT_EQ(std::vector<ByteString>({"A", "B", "C"}), dict->GetKeys());
+  EXPECT_EQ(3, dict->GetIntegerFor("B"));
+  EXPECT_EQ(4, dict->GetIntegerFor("C"));
+}
+
+TEST(DictionaryTest, ReplaceKey) {
+  auto dict = pdfium::MakeRetain<CPDF_Dictionary>();
+  dict->SetNewFor<CPDF_Number>("A", 1);
+  dict->SetNewFor<CPDF_Number>("B", 2);
+  dict->SetNewFor<CPDF_Number>("C", 3);
+
+  dict->ReplaceKey("A", "D");
+  EXPECT_EQ(std::vector<ByteString>({"B", "C", "D"}), dict->GetKeys());
+  EXPECT_EQ(1, dict->GetIntegerFor("D"));
+
+  // Replacing onto an existing key drops the old value.
+  dict->ReplaceKey("D", "B");
+  EXPECT_EQ(std::vector<ByteString>({"B", "C"}), dict->GetKeys());
+  EXPECT_EQ(1, dict->GetIntegerFor("B"));
+
+  dict->ReplaceKey("B", "B");
+  dict->ReplaceKey("Z", "A");
+  EXPECT_EQ(std::vector<ByteString>({"B", "C"}), dict->GetKeys());
+}
+
+TEST(DictionaryTest, InternedKeys) {
+  WeakPtr<ByteStringPool> pool(std::make_unique<ByteStringPool>());
+  auto dict = pdfium::MakeRetain<CPDF_Dictionary>(pool);
+  dict->SetNewFor<CPDF_Number>("Type", 1);
+  ByteString interned = pool->Intern("Type");
+
+  CPDF_DictionaryLocker locked_dict(dict);
+  EXPECT_EQ(interned.raw_str(), locked_dict.begin()->first.raw_str());
+  EXPECT_EQ(1, dict->GetIntegerFor(interned));
+  EXPECT_EQ(1, dict->GetIntegerFor("Type"));
+}
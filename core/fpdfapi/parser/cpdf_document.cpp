@@ -35,6 +35,8 @@ namespace {
 
 const int kMaxPageLevel = 1024;
 
+bool g_object_arena_enabled = false;
+
 enum class NodeType : bool {
   kBranch,  // /Type /Pages, AKA page tree node.
   kLeaf,    // /Type /Page, AKA page object.
@@ -172,6 +174,8 @@ CPDF_Document::CPDF_Document(std::unique_ptr<RenderDataIface> pRenderData,
       m_StockFontClearer(m_pDocPage.get()) {
   m_pDocRender->SetDocument(this);
   m_pDocPage->SetDocument(this);
+  if (g_object_arena_enabled)
+    EnableObjectArena();
 }
 
 CPDF_Document::~CPDF_Document() {
@@ -182,6 +186,15 @@ CPDF_Document::~CPDF_Document() {
   m_pExtension.reset();
 }
 
+// static
+void CPDF_Document::SetObjectArenaEnabled(bool enabled) {
+  g_object_arena_enabled = enabled;
+}
+
+void CPDF_Document::EnableSharedAccess() {
+  m_bSharedAccess = true;
+}
+
 // static
 bool CPDF_Document::IsValidPageObject(const CPDF_Object* obj) {
   // See ISO 32000-1:2008 spec, table 30.
@@ -204,6 +217,14 @@ bool CPDF_Document::TryInit() {
   return GetRoot() && GetPageCount() > 0;
 }
 
+pdfium::span<const uint8_t> CPDF_Document::GetCrossRefIndex() {
+  if (!m_CrossRefIndex.has_value()) {
+    m_CrossRefIndex = m_pParser ? m_pParser->SerializeCrossRefIndex()
+                                : DataVector<uint8_t>();
+  }
+  return m_CrossRefIndex.value();
+}
+
 CPDF_Parser::Error CPDF_Document::LoadDoc(
     RetainPtr<IFX_SeekableReadStream> pFileAccess,
     const ByteString& password) {
@@ -214,6 +235,17 @@ CPDF_Parser::Error CPDF_Document::LoadDoc(
       m_pParser->StartParse(std::move(pFileAccess), password));
 }
 
+CPDF_Parser::Error CPDF_Document::LoadDocWithCrossRefIndex(
+    RetainPtr<IFX_SeekableReadStream> pFileAccess,
+    const ByteString& password,
+    pdfium::span<const uint8_t> cross_ref_index) {
+  if (!m_pParser)
+    SetParser(std::make_unique<CPDF_Parser>(this));
+
+  return HandleLoadResult(m_pParser->StartParseWithCrossRefIndex(
+      std::move(pFileAccess), password, cross_ref_index));
+}
+
 CPDF_Parser::Error CPDF_Document::LoadLinearizedDoc(
     RetainPtr<CPDF_ReadValidator> validator,
     const ByteString& password) {
@@ -686,6 +718,26 @@ void CPDF_Document::ResizePageListForTesting(size_t size) {
   m_PageList.resize(size);
 }
 
+CPDF_Document::ScopedSharedAccess::ScopedSharedAccess(
+    const CPDF_Document* pDoc)
+    : m_bShared(pDoc && pDoc->m_bSharedAccess) {
+  if (m_bShared) {
+    m_Lock = std::unique_lock<std::recursive_mutex>(pDoc->m_SharedAccessLock);
+  }
+}
+
+CPDF_Document::ScopedSharedAccess::ScopedSharedAccess(
+    const CPDF_Document* pDoc,
+    std::try_to_lock_t)
+    : m_bShared(pDoc && pDoc->m_bSharedAccess) {
+  if (m_bShared) {
+    m_Lock = std::unique_lock<std::recursive_mutex>(pDoc->m_SharedAccessLock,
+                                                    std::try_to_lock);
+  }
+}
+
+CPDF_Document::ScopedSharedAccess::~ScopedSharedAccess() = default;
+
 CPDF_Document::StockFontClearer::StockFontClearer(
     CPDF_Document::PageDataIface* pPageData)
     : m_pPageData(pPageData) {}
@@ -8,16 +8,19 @@
 #define CORE_FPDFAPI_PARSER_CPDF_DOCUMENT_H_
 
 #include <memory>
+#include <mutex>
 #include <set>
 #include <utility>
 #include <vector>
 
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_parser.h"
+#include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fx_memory.h"
 #include "core/fxcrt/observed_ptr.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/unowned_ptr.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 #include "third_party/base/containers/span.h"
 
 class CPDF_ReadValidator;
@@ -80,10 +83,37 @@ class CPDF_Document : public Observable,
     UnownedPtr<CPDF_Document> m_pDoc;
   };
 
+  // Holds the lock of `pDoc` while in scope, if `pDoc` is shared between
+  // threads. Does nothing otherwise, or if `pDoc` is null. Each shared
+  // document has its own lock. Caches shared by all documents, such as the
+  // font caches, have their own locks.
+  class ScopedSharedAccess {
+   public:
+    FX_STACK_ALLOCATED();
+
+    explicit ScopedSharedAccess(const CPDF_Document* pDoc);
+
+    // Does not wait if another thread holds the lock, see acquired().
+    ScopedSharedAccess(const CPDF_Document* pDoc, std::try_to_lock_t);
+
+    ~ScopedSharedAccess();
+
+    // False if `pDoc` is shared and another thread holds its lock.
+    bool acquired() const { return !m_bShared || m_Lock.owns_lock(); }
+
+   private:
+    const bool m_bShared;
+    std::unique_lock<std::recursive_mutex> m_Lock;
+  };
+
   static constexpr int kPageMaxNum = 0xFFFFF;
 
   static bool IsValidPageObject(const CPDF_Object* obj);
 
+  // Sets whether documents created afterwards allocate their parsed objects
+  // from a CPDF_ObjectArena. Off by default.
+  static void SetObjectArenaEnabled(bool enabled);
+
   CPDF_Document(std::unique_ptr<RenderDataIface> pRenderData,
                 std::unique_ptr<PageDataIface> pPageData);
   ~CPDF_Document() override;
@@ -93,7 +123,19 @@ class CPDF_Document : public Observable,
     m_pExtension = std::move(pExt);
   }
 
+  // Makes the document share its parsed objects and caches between threads,
+  // which then must hold a ScopedSharedAccess while using the document or its
+  // pages. Must be called before other threads get to use the document, and
+  // cannot be undone.
+  void EnableSharedAccess();
+  bool IsSharedAccessEnabled() const { return m_bSharedAccess; }
+
   CPDF_Parser* GetParser() const { return m_pParser.get(); }
+
+  // Returns the parser's SerializeCrossRefIndex(), which only gets computed
+  // the first time, as it decodes all object streams.
+  pdfium::span<const uint8_t> GetCrossRefIndex();
+
   const CPDF_Dictionary* GetRoot() const { return m_pRootDict.Get(); }
   RetainPtr<CPDF_Dictionary> GetMutableRoot() { return m_pRootDict; }
   RetainPtr<CPDF_Dictionary> GetInfo();
@@ -141,6 +183,10 @@ class CPDF_Document : public Observable,
 
   CPDF_Parser::Error LoadDoc(RetainPtr<IFX_SeekableReadStream> pFileAccess,
                              const ByteString& password);
+  CPDF_Parser::Error LoadDocWithCrossRefIndex(
+      RetainPtr<IFX_SeekableReadStream> pFileAccess,
+      const ByteString& password,
+      pdfium::span<const uint8_t> cross_ref_index);
   CPDF_Parser::Error LoadLinearizedDoc(RetainPtr<CPDF_ReadValidator> validator,
                                        const ByteString& password);
   bool has_valid_cross_reference_table() const {
@@ -207,6 +253,15 @@ class CPDF_Document : public Observable,
   // reference table.
   bool m_bHasValidCrossReferenceTable = false;
 
+  // Cached result of GetCrossRefIndex().
+  absl::optional<DataVector<uint8_t>> m_CrossRefIndex;
+
+  // True if EnableSharedAccess() was called.
+  bool m_bSharedAccess = false;
+
+  // Held by ScopedSharedAccess if `m_bSharedAccess`.
+  mutable std::recursive_mutex m_SharedAccessLock;
+
   // Index of the next page that will be traversed from the page tree.
   bool m_bReachedMaxPageLevel = false;
   int m_iNextPageToTraverse = 0;
@@ -406,38 +406,46 @@ bool CPDF_HintTables::GetPagePos(uint32_t index,
   return true;
 }
 
-CPDF_DataAvail::DocAvailStatus CPDF_HintTables::CheckPage(uint32_t index) {
-  if (index == m_pLinearized->GetFirstPageNo())
-    return CPDF_DataAvail::kDataAvailable;
-
+bool CPDF_HintTables::GetPageRanges(
+    uint32_t index,
+    std::vector<CPDF_DataAvail::DataRange>* ranges) const {
   if (index >= m_pLinearized->GetPageCount())
-    return CPDF_DataAvail::kDataError;
+    return false;
 
-  const uint32_t dwLength = m_PageInfos[index].page_length();
-  if (!dwLength)
-    return CPDF_DataAvail::kDataError;
+  const PageInfo& page_info = m_PageInfos[index];
+  if (!page_info.page_length())
+    return false;
 
-  if (!m_pValidator->CheckDataRangeAndRequestIfUnavailable(
-          m_PageInfos[index].page_offset(), dwLength)) {
-    return CPDF_DataAvail::kDataNotAvailable;
-  }
+  ranges->push_back({page_info.page_offset(), page_info.page_length()});
 
-  // Download data of shared objects in the page.
-  for (const uint32_t dwIndex : m_PageInfos[index].Identifiers()) {
+  // Data of shared objects in the page.
+  for (const uint32_t dwIndex : page_info.Identifiers()) {
     if (dwIndex >= m_SharedObjGroupInfos.size())
       continue;
     const SharedObjGroupInfo& shared_group_info =
         m_SharedObjGroupInfos[dwIndex];
 
     if (!shared_group_info.m_szOffset || !shared_group_info.m_dwLength)
-      return CPDF_DataAvail::kDataError;
+      return false;
 
-    if (!m_pValidator->CheckDataRangeAndRequestIfUnavailable(
-            shared_group_info.m_szOffset, shared_group_info.m_dwLength)) {
-      return CPDF_DataAvail::kDataNotAvailable;
-    }
+    ranges->push_back(
+        {shared_group_info.m_szOffset, shared_group_info.m_dwLength});
   }
-  return CPDF_DataAvail::kDataAvailable;
+  return true;
+}
+
+CPDF_DataAvail::DocAvailStatus CPDF_HintTables::CheckPage(uint32_t index) {
+  if (index == m_pLinearized->GetFirstPageNo())
+    return CPDF_DataAvail::kDataAvailable;
+
+  std::vector<CPDF_DataAvail::DataRange> ranges;
+  if (!GetPageRanges(index, &ranges))
+    return CPDF_DataAvail::kDataError;
+
+  // Request all missing data of the page at once.
+  return m_pValidator->CheckDataRangesAndRequestIfUnavailable(ranges)
+             ? CPDF_DataAvail::kDataAvailable
+             : CPDF_DataAvail::kDataNotAvailable;
 }
 
 bool CPDF_HintTables::LoadHintStream(CPDF_Stream* pHintStream) {
@@ -81,6 +81,15 @@ class CPDF_HintTables {
                   FX_FILESIZE* szPageLength,
                   uint32_t* dwObjNum) const;
 
+  // Appends the ranges of the file that page `index` and the shared object
+  // groups it uses take up to `ranges`. Returns false if the hint tables have
+  // no valid ranges for the page.
+  bool GetPageRanges(uint32_t index,
+                     std::vector<CPDF_DataAvail::DataRange>* ranges) const;
+
+  // Requests all missing ranges of page `index` and its shared object groups
+  // at once. Returns kDataError if any of the ranges is invalid, even if
+  // others are also missing.
   CPDF_DataAvail::DocAvailStatus CheckPage(uint32_t index);
 
   bool LoadHintStream(CPDF_Stream* pHintStream);
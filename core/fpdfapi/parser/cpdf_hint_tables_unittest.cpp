@@ -7,6 +7,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "core/fpdfapi/page/test_with_page_module.h"
 #include "core/fpdfapi/parser/cpdf_data_avail.h"
@@ -40,6 +41,32 @@ std::unique_ptr<CPDF_DataAvail> MakeDataAvailFromFile(
                                           MakeValidatorFromFile(file_name));
 }
 
+class MockFileAvail final : public CPDF_DataAvail::FileAvail {
+ public:
+  bool IsDataAvail(FX_FILESIZE offset, size_t size) override {
+    return available_;
+  }
+
+  void set_available(bool available) { available_ = available; }
+
+ private:
+  bool available_ = true;
+};
+
+class MockDownloadHints final : public CPDF_DataAvail::DownloadHints {
+ public:
+  void AddSegment(FX_FILESIZE offset, size_t size) override {
+    segments_.emplace_back(offset, offset + size);
+  }
+
+  const std::vector<std::pair<FX_FILESIZE, FX_FILESIZE>>& segments() const {
+    return segments_;
+  }
+
+ private:
+  std::vector<std::pair<FX_FILESIZE, FX_FILESIZE>> segments_;
+};
+
 class TestLinearizedHeader final : public CPDF_LinearizedHeader {
  public:
   TestLinearizedHeader(const CPDF_Dictionary* pDict,
@@ -171,3 +198,36 @@ TEST_F(HintTablesTest, FirstPageOffset) {
   // 127546 is predefined real value from original file.
   EXPECT_EQ(127546, hint_tables->GetFirstPageObjOffset());
 }
+
+TEST_F(HintTablesTest, CheckPageRequestsAllRanges) {
+  std::string file_path =
+      PathService::GetTestFilePath("feature_linearized_loading.pdf");
+  ASSERT_FALSE(file_path.empty());
+  MockFileAvail file_avail;
+  auto validator = pdfium::MakeRetain<CPDF_ReadValidator>(
+      IFX_SeekableReadStream::CreateFromFilename(file_path.c_str()),
+      &file_avail);
+  CPDF_SyntaxParser parser(validator, 0);
+  std::unique_ptr<CPDF_LinearizedHeader> linearized_header =
+      CPDF_LinearizedHeader::Parse(&parser);
+  ASSERT_TRUE(linearized_header);
+  std::unique_ptr<CPDF_HintTables> hint_tables =
+      CPDF_HintTables::Parse(&parser, linearized_header.get());
+  ASSERT_TRUE(hint_tables);
+
+  MockDownloadHints hints;
+  validator->SetDownloadHints(&hints);
+  file_avail.set_available(false);
+  EXPECT_EQ(CPDF_DataAvail::kDataNotAvailable, hint_tables->CheckPage(1));
+
+  // The second page is at 5105 and uses shared object groups 2, 5 and 3, see
+  // the PageAndGroupInfos test. All of them get requested at once, not just
+  // the page, with the groups next to each other merged.
+  const std::vector<std::pair<FX_FILESIZE, FX_FILESIZE>> kExpectedSegments = {
+      {1024, 3072}, {4608, 6656}, {10752, 11671}};
+  EXPECT_EQ(kExpectedSegments, hints.segments());
+
+  file_avail.set_available(true);
+  EXPECT_EQ(CPDF_DataAvail::kDataAvailable, hint_tables->CheckPage(1));
+  validator->SetDownloadHints(nullptr);
+}
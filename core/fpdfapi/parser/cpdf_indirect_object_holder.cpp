@@ -65,7 +65,11 @@ CPDF_Object* CPDF_IndirectObjectHolder::GetOrParseIndirectObjectInternal(
     return const_cast<CPDF_Object*>(
         FilterInvalidObjNum(insert_result.first->second.Get()));
   }
-  RetainPtr<CPDF_Object> pNewObj = ParseIndirectObject(objnum);
+  RetainPtr<CPDF_Object> pNewObj;
+  {
+    CPDF_ObjectArena::ScopedUse arena_scope(m_pObjectArena.get());
+    pNewObj = ParseIndirectObject(objnum);
+  }
   if (!pNewObj) {
     m_IndirectObjs.erase(insert_result.first);
     return nullptr;
@@ -84,6 +88,11 @@ RetainPtr<CPDF_Object> CPDF_IndirectObjectHolder::ParseIndirectObject(
   return nullptr;
 }
 
+void CPDF_IndirectObjectHolder::EnableObjectArena() {
+  if (!m_pObjectArena)
+    m_pObjectArena = std::make_unique<CPDF_ObjectArena>();
+}
+
 uint32_t CPDF_IndirectObjectHolder::AddIndirectObject(
     RetainPtr<CPDF_Object> pObj) {
   CHECK(!pObj->GetObjNum());
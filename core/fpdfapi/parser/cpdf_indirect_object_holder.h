@@ -10,10 +10,12 @@
 #include <stdint.h>
 
 #include <map>
+#include <memory>
 #include <type_traits>
 #include <utility>
 
 #include "core/fpdfapi/parser/cpdf_object.h"
+#include "core/fpdfapi/parser/cpdf_object_arena.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/string_pool_template.h"
 #include "core/fxcrt/weak_ptr.h"
@@ -69,6 +71,13 @@ class CPDF_IndirectObjectHolder {
     return m_pByteStringPool;
   }
 
+  // Makes ParseIndirectObject() allocate the objects it creates from now on
+  // from an arena. See CPDF_ObjectArena.
+  void EnableObjectArena();
+  const CPDF_ObjectArena* GetObjectArena() const {
+    return m_pObjectArena.get();
+  }
+
   const_iterator begin() const { return m_IndirectObjs.begin(); }
   const_iterator end() const { return m_IndirectObjs.end(); }
 
@@ -84,6 +93,7 @@ class CPDF_IndirectObjectHolder {
   uint32_t m_LastObjNum = 0;
   std::map<uint32_t, RetainPtr<CPDF_Object>> m_IndirectObjs;
   WeakPtr<ByteStringPool> m_pByteStringPool;
+  std::unique_ptr<CPDF_ObjectArena> m_pObjectArena;
 };
 
 #endif  // CORE_FPDFAPI_PARSER_CPDF_INDIRECT_OBJECT_HOLDER_H_
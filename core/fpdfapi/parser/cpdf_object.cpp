@@ -9,14 +9,39 @@
 #include <algorithm>
 
 #include "core/fpdfapi/parser/cpdf_array.h"
+#include "core/fpdfapi/parser/cpdf_boolean.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_indirect_object_holder.h"
+#include "core/fpdfapi/parser/cpdf_name.h"
+#include "core/fpdfapi/parser/cpdf_null.h"
+#include "core/fpdfapi/parser/cpdf_number.h"
+#include "core/fpdfapi/parser/cpdf_object_arena.h"
 #include "core/fpdfapi/parser/cpdf_parser.h"
 #include "core/fpdfapi/parser/cpdf_reference.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fpdfapi/parser/cpdf_string.h"
 #include "core/fxcrt/fx_string.h"
 #include "third_party/base/check.h"
 #include "third_party/base/notreached.h"
 
+// CPDF_ObjectArena only guarantees this much alignment.
+static_assert(alignof(CPDF_Array) <= 8 && alignof(CPDF_Boolean) <= 8 &&
+                  alignof(CPDF_Dictionary) <= 8 && alignof(CPDF_Name) <= 8 &&
+                  alignof(CPDF_Null) <= 8 && alignof(CPDF_Number) <= 8 &&
+                  alignof(CPDF_Reference) <= 8 && alignof(CPDF_Stream) <= 8 &&
+                  alignof(CPDF_String) <= 8,
+              "CPDF_ObjectArena needs a bigger alignment");
+
+// static
+void* CPDF_Object::operator new(size_t size) {
+  return CPDF_ObjectArena::AllocateObject(size);
+}
+
+// static
+void CPDF_Object::operator delete(void* ptr) {
+  CPDF_ObjectArena::FreeObject(ptr);
+}
+
 CPDF_Object::~CPDF_Object() = default;
 
 static_assert(sizeof(uint64_t) >= sizeof(CPDF_Object*),
@@ -50,6 +50,11 @@ class IFX_ArchiveStream;
 class CPDF_Object : public Retainable {
  public:
   static constexpr uint32_t kInvalidObjNum = static_cast<uint32_t>(-1);
+
+  // Objects may come from a CPDF_ObjectArena.
+  static void* operator new(size_t size);
+  static void operator delete(void* ptr);
+
   enum Type {
     kBoolean = 1,
     kNumber,
@@ -0,0 +1,201 @@
+// Copyright 2024 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/parser/cpdf_object_arena.h"
+
+#include <atomic>
+#include <new>
+
+namespace {
+
+constexpr int kBlockShift = 16;
+constexpr size_t kBlockSize = size_t{1} << kBlockShift;
+
+// Larger objects come from the heap, to not waste the rest of a block.
+constexpr size_t kMaxArenaAllocationSize = kBlockSize / 16;
+
+// Alignment of all objects. Enough for every CPDF_Object subclass, see the
+// static_asserts in cpdf_object.cpp.
+constexpr size_t kObjectAlignment = 8;
+
+// Starts every block, which is aligned to kBlockSize. Counts the objects in
+// the block, plus one while the arena allocates from it.
+struct BlockHeader {
+  std::atomic<uint32_t> ref_count{1};
+};
+
+constexpr size_t kBlockHeaderSize = kObjectAlignment;
+static_assert(sizeof(BlockHeader) <= kBlockHeaderSize,
+              "Objects after the header must stay aligned");
+
+// The block map records one bit per kBlockSize-aligned address range, set
+// for arena blocks. It covers the low 2^48 bytes of the address space as a
+// two-level table, with leaves allocated on first use and never freed.
+// Lookups take no lock.
+constexpr int kAddressBits = 48;
+constexpr int kLeafBits = 18;
+constexpr size_t kRootSize = size_t{1}
+                             << (kAddressBits - kBlockShift - kLeafBits);
+constexpr size_t kLeafWords = (size_t{1} << kLeafBits) / 64;
+
+using BlockMapLeaf = std::atomic<uint64_t>;
+
+std::atomic<BlockMapLeaf*> g_block_map[kRootSize];
+std::atomic<size_t> g_live_block_count{0};
+
+uint64_t BlockIndex(const void* ptr) {
+  return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr)) >>
+         kBlockShift;
+}
+
+bool IsMappable(uint64_t block_index) {
+  return block_index >> (kAddressBits - kBlockShift) == 0;
+}
+
+BlockMapLeaf* GetLeaf(uint64_t block_index, bool create) {
+  std::atomic<BlockMapLeaf*>& slot = g_block_map[block_index >> kLeafBits];
+  BlockMapLeaf* leaf = slot.load(std::memory_order_acquire);
+  if (leaf || !create)
+    return leaf;
+
+  BlockMapLeaf* new_leaf = new BlockMapLeaf[kLeafWords]();
+  if (slot.compare_exchange_strong(leaf, new_leaf, std::memory_order_acq_rel))
+    return new_leaf;
+
+  // Another thread got there first, `leaf` now holds its leaf.
+  delete[] new_leaf;
+  return leaf;
+}
+
+BlockMapLeaf& GetWord(BlockMapLeaf* leaf, uint64_t block_index) {
+  return leaf[(block_index & ((uint64_t{1} << kLeafBits) - 1)) / 64];
+}
+
+uint64_t GetBit(uint64_t block_index) {
+  return uint64_t{1} << (block_index % 64);
+}
+
+bool IsArenaBlock(const void* ptr) {
+  const uint64_t block_index = BlockIndex(ptr);
+  if (!IsMappable(block_index))
+    return false;
+
+  BlockMapLeaf* leaf = GetLeaf(block_index, /*create=*/false);
+  return leaf && (GetWord(leaf, block_index).load(std::memory_order_acquire) &
+                  GetBit(block_index));
+}
+
+uint8_t* NewBlock() {
+  void* memory = ::operator new(kBlockSize, std::align_val_t(kBlockSize),
+                                std::nothrow);
+  if (!memory)
+    return nullptr;
+
+  const uint64_t block_index = BlockIndex(memory);
+  if (!IsMappable(block_index)) {
+    ::operator delete(memory, std::align_val_t(kBlockSize));
+    return nullptr;
+  }
+  new (memory) BlockHeader();
+  GetWord(GetLeaf(block_index, /*create=*/true), block_index)
+      .fetch_or(GetBit(block_index), std::memory_order_release);
+  g_live_block_count.fetch_add(1, std::memory_order_relaxed);
+  return static_cast<uint8_t*>(memory);
+}
+
+void ReleaseBlock(uint8_t* block) {
+  auto* header = reinterpret_cast<BlockHeader*>(block);
+  if (header->ref_count.fetch_sub(1, std::memory_order_acq_rel) != 1)
+    return;
+
+  // Unmap the block before freeing it, so that heap objects that later get
+  // its address are not mistaken for arena objects.
+  const uint64_t block_index = BlockIndex(block);
+  GetWord(GetLeaf(block_index, /*create=*/false), block_index)
+      .fetch_and(~GetBit(block_index), std::memory_order_release);
+  g_live_block_count.fetch_sub(1, std::memory_order_relaxed);
+  header->~BlockHeader();
+  ::operator delete(block, std::align_val_t(kBlockSize));
+}
+
+}  // namespace
+
+// static
+thread_local CPDF_ObjectArena* CPDF_ObjectArena::s_Current = nullptr;
+
+CPDF_ObjectArena::ScopedUse::ScopedUse(CPDF_ObjectArena* arena)
+    : previous_(s_Current) {
+  s_Current = arena;
+}
+
+CPDF_ObjectArena::ScopedUse::~ScopedUse() {
+  s_Current = previous_;
+}
+
+// static
+void* CPDF_ObjectArena::AllocateObject(size_t size) {
+  if (s_Current && size <= kMaxArenaAllocationSize) {
+    void* memory =
+        s_Current->Allocate(FxAlignToBoundary<kObjectAlignment>(size));
+    if (memory)
+      return memory;
+  }
+  return ::operator new(size);
+}
+
+// static
+void CPDF_ObjectArena::FreeObject(void* ptr) {
+  if (!ptr)
+    return;
+
+  if (!IsArenaBlock(ptr)) {
+    ::operator delete(ptr);
+    return;
+  }
+  // The memory stays in the block, which goes once it is empty.
+  const uintptr_t block_mask = ~static_cast<uintptr_t>(kBlockSize - 1);
+  ReleaseBlock(reinterpret_cast<uint8_t*>(reinterpret_cast<uintptr_t>(ptr) &
+                                          block_mask));
+}
+
+// static
+bool CPDF_ObjectArena::IsArenaObjectForTesting(const void* ptr) {
+  return IsArenaBlock(ptr);
+}
+
+// static
+size_t CPDF_ObjectArena::GetLiveBlockCountForTesting() {
+  return g_live_block_count.load(std::memory_order_relaxed);
+}
+
+CPDF_ObjectArena::CPDF_ObjectArena() = default;
+
+CPDF_ObjectArena::~CPDF_ObjectArena() {
+  if (current_block_)
+    ReleaseBlock(current_block_);
+}
+
+void* CPDF_ObjectArena::Allocate(size_t size) {
+  if (out_of_blocks_)
+    return nullptr;
+
+  if (!current_block_ || kBlockSize - block_used_ < size) {
+    uint8_t* block = NewBlock();
+    if (!block) {
+      out_of_blocks_ = true;
+      return nullptr;
+    }
+    if (current_block_)
+      ReleaseBlock(current_block_);
+    current_block_ = block;
+    block_used_ = kBlockHeaderSize;
+    ++block_count_;
+  }
+  reinterpret_cast<BlockHeader*>(current_block_)
+      ->ref_count.fetch_add(1, std::memory_order_relaxed);
+  void* result = current_block_ + block_used_;
+  block_used_ += size;
+  ++object_count_;
+  return result;
+}
@@ -0,0 +1,75 @@
+// Copyright 2024 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_PARSER_CPDF_OBJECT_ARENA_H_
+#define CORE_FPDFAPI_PARSER_CPDF_OBJECT_ARENA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "core/fxcrt/fx_memory.h"
+
+// Hands out memory for CPDF_Objects from large blocks, so that parsing a
+// document does not make one heap allocation per object, and closing it
+// does not make one heap free per object.
+//
+// Objects are still ref-counted and destroyed individually. Each block
+// counts the objects in it, and goes back to the heap once they are all
+// gone and the arena has moved on to another block or been destroyed. So
+// objects can outlive their document like before, and such an object only
+// keeps its own block alive. Memory of objects destroyed early is not
+// reused until the rest of their block goes. That suits objects parsed from
+// a file, which mostly live as long as their document.
+//
+// Objects carry no header. FreeObject() tells arena objects from heap
+// objects by looking up the block-aligned part of their address in a
+// process-wide map of arena blocks.
+class CPDF_ObjectArena {
+ public:
+  // While in scope, CPDF_Objects created on the current thread come from
+  // `arena`, or from the heap if `arena` is null.
+  class ScopedUse {
+   public:
+    FX_STACK_ALLOCATED();
+
+    explicit ScopedUse(CPDF_ObjectArena* arena);
+    ~ScopedUse();
+
+   private:
+    CPDF_ObjectArena* const previous_;
+  };
+
+  // Implement CPDF_Object's operator new and operator delete.
+  static void* AllocateObject(size_t size);
+  static void FreeObject(void* ptr);
+
+  static bool IsArenaObjectForTesting(const void* ptr);
+  static size_t GetLiveBlockCountForTesting();
+
+  CPDF_ObjectArena();
+  CPDF_ObjectArena(const CPDF_ObjectArena&) = delete;
+  CPDF_ObjectArena& operator=(const CPDF_ObjectArena&) = delete;
+  ~CPDF_ObjectArena();
+
+  // Number of objects allocated from the arena so far.
+  size_t object_count() const { return object_count_; }
+
+  // Number of heap allocations made for them.
+  size_t block_count() const { return block_count_; }
+
+ private:
+  // Returns null if no block can be allocated where the block map can
+  // record it, in which case the caller falls back to the heap.
+  void* Allocate(size_t size);
+
+  static thread_local CPDF_ObjectArena* s_Current;
+
+  uint8_t* current_block_ = nullptr;
+  size_t block_used_ = 0;
+  size_t object_count_ = 0;
+  size_t block_count_ = 0;
+  bool out_of_blocks_ = false;
+};
+
+#endif  // CORE_FPDFAPI_PARSER_CPDF_OBJECT_ARENA_H_
@@ -0,0 +1,154 @@
+// Copyright 2024 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/parser/cpdf_object_arena.h"
+
+#include <utility>
+
+#include "core/fpdfapi/parser/cpdf_array.h"
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_indirect_object_holder.h"
+#include "core/fpdfapi/parser/cpdf_number.h"
+#include "core/fpdfapi/parser/cpdf_syntax_parser.h"
+#include "core/fxcrt/bytestring.h"
+#include "core/fxcrt/cfx_read_only_span_stream.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+// Parses every indirect object from `contents`, ignoring the object number.
+class TestIndirectObjectHolder final : public CPDF_IndirectObjectHolder {
+ public:
+  explicit TestIndirectObjectHolder(ByteString contents)
+      : contents_(std::move(contents)) {}
+  ~TestIndirectObjectHolder() override = default;
+
+ protected:
+  RetainPtr<CPDF_Object> ParseIndirectObject(uint32_t objnum) override {
+    CPDF_SyntaxParser parser(
+        pdfium::MakeRetain<CFX_ReadOnlySpanStream>(contents_.raw_span()));
+    return parser.GetObjectBody(this);
+  }
+
+ private:
+  const ByteString contents_;
+};
+
+// One dictionary, one array, two names and three numbers.
+constexpr char kContents[] = "<</Type /Test /Array [1 2 3] /Name /Foo>>";
+constexpr size_t kObjectCount = 7;
+
+}  // namespace
+
+TEST(ObjectArenaTest, ParsedObjectsComeFromArena) {
+  TestIndirectObjectHolder holder(kContents);
+  holder.EnableObjectArena();
+  const CPDF_ObjectArena* arena = holder.GetObjectArena();
+  ASSERT_TRUE(arena);
+
+  RetainPtr<const CPDF_Dictionary> dict =
+      ToDictionary(holder.GetOrParseIndirectObject(1));
+  ASSERT_TRUE(dict);
+  EXPECT_EQ(kObjectCount, arena->object_count());
+  EXPECT_EQ(1u, arena->block_count());
+  EXPECT_EQ("Test", dict->GetNameFor("Type"));
+  EXPECT_EQ(3u, dict->GetArrayFor("Array")->size());
+  EXPECT_TRUE(CPDF_ObjectArena::IsArenaObjectForTesting(dict.Get()));
+  EXPECT_TRUE(CPDF_ObjectArena::IsArenaObjectForTesting(
+      dict->GetArrayFor("Array").Get()));
+
+  // Objects created outside of parsing come from the heap.
+  CPDF_Number* number = holder.NewIndirect<CPDF_Number>(42);
+  EXPECT_EQ(kObjectCount, arena->object_count());
+  EXPECT_FALSE(CPDF_ObjectArena::IsArenaObjectForTesting(number));
+}
+
+TEST(ObjectArenaTest, ParsedObjectsWithoutArena) {
+  TestIndirectObjectHolder holder(kContents);
+  EXPECT_FALSE(holder.GetObjectArena());
+  RetainPtr<const CPDF_Dictionary> dict =
+      ToDictionary(holder.GetOrParseIndirectObject(1));
+  ASSERT_TRUE(dict);
+  EXPECT_FALSE(CPDF_ObjectArena::IsArenaObjectForTesting(dict.Get()));
+}
+
+TEST(ObjectArenaTest, ObjectsOutliveHolder) {
+  RetainPtr<CPDF_Dictionary> dict;
+  {
+    TestIndirectObjectHolder holder(kContents);
+    holder.EnableObjectArena();
+    dict = ToDictionary(holder.GetOrParseIndirectObject(1));
+    ASSERT_TRUE(dict);
+  }
+  EXPECT_EQ("Foo", dict->GetNameFor("Name"));
+  RetainPtr<const CPDF_Array> array = dict->GetArrayFor("Array");
+  ASSERT_TRUE(array);
+  EXPECT_EQ(2, array->GetIntegerAt(1));
+
+  // Edits still work, with the new objects coming from the heap.
+  dict->SetNewFor<CPDF_Number>("Count", 5);
+  EXPECT_EQ(5, dict->GetIntegerFor("Count"));
+}
+
+TEST(ObjectArenaTest, ManyObjects) {
+  // The allocations that parsing many small objects takes, with and without
+  // the arena.
+  ByteString contents = "[";
+  for (int i = 0; i < 10000; ++i)
+    contents += "<</N 1>> ";
+  contents += "]";
+
+  for (bool use_arena : {false, true}) {
+    SCOPED_TRACE(use_arena);
+    const size_t live_blocks =
+        CPDF_ObjectArena::GetLiveBlockCountForTesting();
+    TestIndirectObjectHolder holder(contents);
+    if (use_arena)
+      holder.EnableObjectArena();
+    RetainPtr<const CPDF_Array> array =
+        ToArray(holder.GetOrParseIndirectObject(1));
+    ASSERT_TRUE(array);
+    EXPECT_EQ(10000u, array->size());
+    EXPECT_EQ(1, array->GetDictAt(9999)->GetIntegerFor("N"));
+    EXPECT_EQ(use_arena, CPDF_ObjectArena::IsArenaObjectForTesting(
+                             array->GetDictAt(0).Get()));
+
+    const CPDF_ObjectArena* arena = holder.GetObjectArena();
+    if (!use_arena) {
+      EXPECT_FALSE(arena);
+      EXPECT_EQ(live_blocks, CPDF_ObjectArena::GetLiveBlockCountForTesting());
+      continue;
+    }
+    ASSERT_TRUE(arena);
+    EXPECT_EQ(20001u, arena->object_count());
+    EXPECT_GT(arena->block_count(), 1u);
+    EXPECT_LT(arena->block_count(), 50u);
+    EXPECT_EQ(live_blocks + arena->block_count(),
+              CPDF_ObjectArena::GetLiveBlockCountForTesting());
+  }
+}
+
+TEST(ObjectArenaTest, EscapedObjectKeepsOnlyItsBlock) {
+  ByteString contents = "[";
+  for (int i = 0; i < 10000; ++i)
+    contents += "<</N 1>> ";
+  contents += "]";
+
+  const size_t live_blocks = CPDF_ObjectArena::GetLiveBlockCountForTesting();
+  RetainPtr<const CPDF_Dictionary> escaped;
+  {
+    TestIndirectObjectHolder holder(contents);
+    holder.EnableObjectArena();
+    RetainPtr<const CPDF_Array> array =
+        ToArray(holder.GetOrParseIndirectObject(1));
+    ASSERT_TRUE(array);
+    ASSERT_GT(holder.GetObjectArena()->block_count(), 1u);
+    escaped = array->GetDictAt(0);
+  }
+  EXPECT_EQ(live_blocks + 1, CPDF_ObjectArena::GetLiveBlockCountForTesting());
+  EXPECT_EQ(1, escaped->GetIntegerFor("N"));
+
+  escaped.Reset();
+  EXPECT_EQ(live_blocks, CPDF_ObjectArena::GetLiveBlockCountForTesting());
+}
@@ -17,7 +17,6 @@
 #include "core/fxcrt/cfx_read_only_span_stream.h"
 #include "core/fxcrt/fx_safe_types.h"
 #include "third_party/base/check.h"
-#include "third_party/base/memory/ptr_util.h"
 
 namespace {
 
@@ -53,24 +52,43 @@ bool IsObjectStream(const CPDF_Object* object) {
 }  // namespace
 
 //  static
-std::unique_ptr<CPDF_ObjectStream> CPDF_ObjectStream::Create(
+RetainPtr<CPDF_ObjectStream> CPDF_ObjectStream::Create(
     RetainPtr<const CPDF_Stream> stream) {
   if (!IsObjectStream(stream.Get()))
     return nullptr;
 
-  // Protected constructor.
-  return pdfium::WrapUnique(new CPDF_ObjectStream(std::move(stream)));
+  auto object_stream = pdfium::MakeRetain<CPDF_ObjectStream>(stream);
+  object_stream->Init(stream.Get());
+  return object_stream;
+}
+
+//  static
+RetainPtr<CPDF_ObjectStream> CPDF_ObjectStream::CreateWithObjectInfo(
+    RetainPtr<const CPDF_Stream> stream,
+    std::vector<ObjectInfo> object_info) {
+  if (!IsObjectStream(stream.Get()))
+    return nullptr;
+
+  auto object_stream = pdfium::MakeRetain<CPDF_ObjectStream>(std::move(stream));
+  object_stream->object_info_ = std::move(object_info);
+  return object_stream;
 }
 
 CPDF_ObjectStream::CPDF_ObjectStream(RetainPtr<const CPDF_Stream> obj_stream)
     : stream_acc_(pdfium::MakeRetain<CPDF_StreamAcc>(obj_stream)),
       first_object_offset_(obj_stream->GetDict()->GetIntegerFor("First")) {
   DCHECK(IsObjectStream(obj_stream.Get()));
-  Init(obj_stream.Get());
+  stream_acc_->LoadAllDataFiltered();
+  data_stream_ =
+      pdfium::MakeRetain<CFX_ReadOnlySpanStream>(stream_acc_->GetSpan());
 }
 
 CPDF_ObjectStream::~CPDF_ObjectStream() = default;
 
+size_t CPDF_ObjectStream::GetDecodedSize() const {
+  return stream_acc_->GetSize();
+}
+
 RetainPtr<CPDF_Object> CPDF_ObjectStream::ParseObject(
     CPDF_IndirectObjectHolder* pObjList,
     uint32_t obj_number,
@@ -90,10 +108,6 @@ RetainPtr<CPDF_Object> CPDF_ObjectStream::ParseObject(
 }
 
 void CPDF_ObjectStream::Init(const CPDF_Stream* stream) {
-  stream_acc_->LoadAllDataFiltered();
-  data_stream_ =
-      pdfium::MakeRetain<CFX_ReadOnlySpanStream>(stream_acc_->GetSpan());
-
   CPDF_SyntaxParser syntax(data_stream_);
   const int object_count = stream->GetDict()->GetIntegerFor("N");
   for (int32_t i = object_count; i > 0; --i) {
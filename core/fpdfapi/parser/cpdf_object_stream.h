@@ -5,7 +5,8 @@
 #ifndef CORE_FPDFAPI_PARSER_CPDF_OBJECT_STREAM_H_
 #define CORE_FPDFAPI_PARSER_CPDF_OBJECT_STREAM_H_
 
-#include <memory>
+#include <stddef.h>
+
 #include <vector>
 
 #include "core/fpdfapi/parser/cpdf_object.h"
@@ -18,7 +19,7 @@ class IFX_SeekableReadStream;
 
 // Implementation of logic of PDF "Object Streams".
 // See ISO 32000-1:2008 spec, section 7.5.7.
-class CPDF_ObjectStream {
+class CPDF_ObjectStream final : public Retainable {
  public:
   struct ObjectInfo {
     ObjectInfo(uint32_t obj_num, uint32_t obj_offset)
@@ -32,18 +33,28 @@ class CPDF_ObjectStream {
     uint32_t obj_offset;
   };
 
-  static std::unique_ptr<CPDF_ObjectStream> Create(
+  static RetainPtr<CPDF_ObjectStream> Create(
       RetainPtr<const CPDF_Stream> stream);
 
-  ~CPDF_ObjectStream();
+  // Like Create(), but trusts `object_info` instead of parsing the stream's
+  // header, e.g. because it came from a previous object_info() call.
+  static RetainPtr<CPDF_ObjectStream> CreateWithObjectInfo(
+      RetainPtr<const CPDF_Stream> stream,
+      std::vector<ObjectInfo> object_info);
 
   RetainPtr<CPDF_Object> ParseObject(CPDF_IndirectObjectHolder* pObjList,
                                      uint32_t obj_number,
                                      uint32_t archive_obj_index) const;
   const std::vector<ObjectInfo>& object_info() const { return object_info_; }
 
+  // Size of the decoded stream data this object keeps in memory.
+  size_t GetDecodedSize() const;
+
  private:
+  CONSTRUCT_VIA_MAKE_RETAIN;
+
   explicit CPDF_ObjectStream(RetainPtr<const CPDF_Stream> stream);
+  ~CPDF_ObjectStream() override;
 
   void Init(const CPDF_Stream* stream);
   RetainPtr<CPDF_Object> ParseObjectAtOffset(
@@ -0,0 +1,62 @@
+// Copyright 2024 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/parser/cpdf_object_stream_cache.h"
+
+#include "third_party/base/check.h"
+
+CPDF_ObjectStreamCache::CPDF_ObjectStreamCache(size_t budget)
+    : budget_(budget) {}
+
+CPDF_ObjectStreamCache::~CPDF_ObjectStreamCache() = default;
+
+RetainPtr<const CPDF_ObjectStream> CPDF_ObjectStreamCache::Get(
+    uint32_t obj_num) {
+  auto it = entries_by_obj_num_.find(obj_num);
+  if (it == entries_by_obj_num_.end()) {
+    ++stats_.misses;
+    return nullptr;
+  }
+
+  ++stats_.hits;
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return it->second->second;
+}
+
+void CPDF_ObjectStreamCache::Add(uint32_t obj_num,
+                                 RetainPtr<const CPDF_ObjectStream> stream) {
+  DCHECK(stream);
+  auto it = entries_by_obj_num_.find(obj_num);
+  if (it != entries_by_obj_num_.end()) {
+    cached_bytes_ -= it->second->second->GetDecodedSize();
+    entries_.erase(it->second);
+    entries_by_obj_num_.erase(it);
+  }
+
+  cached_bytes_ += stream->GetDecodedSize();
+  entries_.emplace_front(obj_num, std::move(stream));
+  entries_by_obj_num_[obj_num] = entries_.begin();
+  EvictOverBudget();
+}
+
+void CPDF_ObjectStreamCache::Clear() {
+  entries_by_obj_num_.clear();
+  entries_.clear();
+  cached_bytes_ = 0;
+}
+
+void CPDF_ObjectStreamCache::EvictOverBudget() {
+  if (!budget_)
+    return;
+
+  // Always keep the most recently used object stream, even if it alone
+  // exceeds the budget.
+  while (cached_bytes_ > budget_ && entries_.size() > 1) {
+    const Entry& entry = entries_.back();
+    cached_bytes_ -= entry.second->GetDecodedSize();
+    entries_by_obj_num_.erase(entry.first);
+    entries_.pop_back();
+    ++stats_.evictions;
+  }
+}
@@ -0,0 +1,64 @@
+// Copyright 2024 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_PARSER_CPDF_OBJECT_STREAM_CACHE_H_
+#define CORE_FPDFAPI_PARSER_CPDF_OBJECT_STREAM_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <list>
+#include <map>
+#include <utility>
+
+#include "core/fpdfapi/parser/cpdf_object_stream.h"
+#include "core/fxcrt/retain_ptr.h"
+
+// Keeps the decoded object streams of a document, so that parsing objects
+// from the same object stream does not decode it again. With a budget, only
+// the most recently used object streams whose decoded data fits into the
+// budget are kept, and the others get decoded again when needed.
+class CPDF_ObjectStreamCache {
+ public:
+  struct Stats {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t evictions = 0;
+  };
+
+  // A `budget` of 0 means no limit.
+  explicit CPDF_ObjectStreamCache(size_t budget);
+  ~CPDF_ObjectStreamCache();
+
+  // Returns the object stream with object number `obj_num` and makes it the
+  // most recently used one, or returns nullptr if it is not cached.
+  RetainPtr<const CPDF_ObjectStream> Get(uint32_t obj_num);
+
+  // Adds `stream` as the most recently used object stream, and evicts the
+  // least recently used others until the cache fits the budget again. Callers
+  // that still hold an evicted object stream can keep using it.
+  void Add(uint32_t obj_num, RetainPtr<const CPDF_ObjectStream> stream);
+
+  void Clear();
+
+  size_t budget() const { return budget_; }
+  size_t cached_bytes() const { return cached_bytes_; }
+  size_t size() const { return entries_.size(); }
+  const Stats& stats() const { return stats_; }
+
+ private:
+  using Entry = std::pair<uint32_t, RetainPtr<const CPDF_ObjectStream>>;
+
+  void EvictOverBudget();
+
+  const size_t budget_;
+  size_t cached_bytes_ = 0;
+  Stats stats_;
+
+  // Most recently used first.
+  std::list<Entry> entries_;
+  std::map<uint32_t, std::list<Entry>::iterator> entries_by_obj_num_;
+};
+
+#endif  // CORE_FPDFAPI_PARSER_CPDF_OBJECT_STREAM_CACHE_H_
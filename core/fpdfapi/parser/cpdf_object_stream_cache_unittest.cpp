@@ -0,0 +1,119 @@
+// Copyright 2024 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/parser/cpdf_object_stream_cache.h"
+
+#include <utility>
+
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_indirect_object_holder.h"
+#include "core/fpdfapi/parser/cpdf_name.h"
+#include "core/fpdfapi/parser/cpdf_number.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fxcrt/bytestring.h"
+#include "core/fxcrt/data_vector.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+constexpr char kStreamContent[] = "10 0 <</Name /Foo>>";
+constexpr int kStreamContentOffset = 5;
+constexpr size_t kStreamSize = sizeof(kStreamContent) - 1;
+
+RetainPtr<const CPDF_ObjectStream> CreateObjectStream() {
+  auto dict = pdfium::MakeRetain<CPDF_Dictionary>();
+  dict->SetNewFor<CPDF_Name>("Type", "ObjStm");
+  dict->SetNewFor<CPDF_Number>("N", 1);
+  dict->SetNewFor<CPDF_Number>("First", kStreamContentOffset);
+
+  ByteStringView contents_view(kStreamContent);
+  auto stream = pdfium::MakeRetain<CPDF_Stream>(
+      DataVector<uint8_t>(contents_view.begin(), contents_view.end()), dict);
+  return CPDF_ObjectStream::Create(std::move(stream));
+}
+
+}  // namespace
+
+TEST(ObjectStreamCacheTest, HitsAndMisses) {
+  CPDF_ObjectStreamCache cache(0);
+  EXPECT_FALSE(cache.Get(1));
+
+  RetainPtr<const CPDF_ObjectStream> obj_stream = CreateObjectStream();
+  ASSERT_TRUE(obj_stream);
+  EXPECT_EQ(kStreamSize, obj_stream->GetDecodedSize());
+  cache.Add(1, obj_stream);
+  EXPECT_EQ(obj_stream, cache.Get(1));
+  EXPECT_EQ(obj_stream, cache.Get(1));
+  EXPECT_FALSE(cache.Get(2));
+
+  EXPECT_EQ(2u, cache.stats().hits);
+  EXPECT_EQ(2u, cache.stats().misses);
+  EXPECT_EQ(0u, cache.stats().evictions);
+  EXPECT_EQ(kStreamSize, cache.cached_bytes());
+
+  cache.Clear();
+  EXPECT_EQ(0u, cache.size());
+  EXPECT_EQ(0u, cache.cached_bytes());
+  EXPECT_FALSE(cache.Get(1));
+  EXPECT_EQ(3u, cache.stats().misses);
+}
+
+TEST(ObjectStreamCacheTest, Unlimited) {
+  CPDF_ObjectStreamCache cache(0);
+  for (uint32_t i = 1; i <= 100; ++i)
+    cache.Add(i, CreateObjectStream());
+
+  EXPECT_EQ(100u, cache.size());
+  EXPECT_EQ(100 * kStreamSize, cache.cached_bytes());
+  EXPECT_EQ(0u, cache.stats().evictions);
+}
+
+TEST(ObjectStreamCacheTest, EvictsLeastRecentlyUsed) {
+  CPDF_ObjectStreamCache cache(3 * kStreamSize);
+  cache.Add(1, CreateObjectStream());
+  cache.Add(2, CreateObjectStream());
+  cache.Add(3, CreateObjectStream());
+  EXPECT_EQ(3u, cache.size());
+
+  // Using 1 makes 2 the least recently used one.
+  EXPECT_TRUE(cache.Get(1));
+  cache.Add(4, CreateObjectStream());
+  EXPECT_EQ(3u, cache.size());
+  EXPECT_EQ(3 * kStreamSize, cache.cached_bytes());
+  EXPECT_EQ(1u, cache.stats().evictions);
+  EXPECT_TRUE(cache.Get(1));
+  EXPECT_FALSE(cache.Get(2));
+  EXPECT_TRUE(cache.Get(3));
+  EXPECT_TRUE(cache.Get(4));
+
+  // Adding an object stream again replaces it.
+  cache.Add(4, CreateObjectStream());
+  EXPECT_EQ(3u, cache.size());
+  EXPECT_EQ(1u, cache.stats().evictions);
+}
+
+TEST(ObjectStreamCacheTest, KeepsMostRecentlyUsedOverBudget) {
+  CPDF_ObjectStreamCache cache(1);
+  cache.Add(1, CreateObjectStream());
+  EXPECT_EQ(1u, cache.size());
+  EXPECT_TRUE(cache.Get(1));
+
+  cache.Add(2, CreateObjectStream());
+  EXPECT_EQ(1u, cache.size());
+  EXPECT_FALSE(cache.Get(1));
+  EXPECT_TRUE(cache.Get(2));
+}
+
+TEST(ObjectStreamCacheTest, EvictedStreamStaysUsable) {
+  CPDF_ObjectStreamCache cache(1);
+  RetainPtr<const CPDF_ObjectStream> obj_stream = CreateObjectStream();
+  cache.Add(1, obj_stream);
+  cache.Add(2, CreateObjectStream());
+  EXPECT_FALSE(cache.Get(1));
+
+  CPDF_IndirectObjectHolder holder;
+  RetainPtr<CPDF_Object> obj10 = obj_stream->ParseObject(&holder, 10, 0);
+  ASSERT_TRUE(obj10);
+  EXPECT_EQ("Foo", obj10->GetDict()->GetNameFor("Name"));
+}
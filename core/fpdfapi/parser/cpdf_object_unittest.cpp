@@ -887,6 +887,24 @@ TEST(PDFStreamTest, SetDataAndRemoveFilter) {
   EXPECT_FALSE(stream->GetDict()->KeyExist(pdfium::stream::kDecodeParms));
 }
 
+TEST(PDFStreamTest, DataVersion) {
+  auto stream = pdfium::MakeRetain<CPDF_Stream>(
+      DataVector<uint8_t>(100), pdfium::MakeRetain<CPDF_Dictionary>());
+  const uint32_t version = stream->GetDataVersion();
+
+  // Changing the dictionary leaves the data alone.
+  stream->GetMutableDict()->SetNewFor<CPDF_String>(pdfium::stream::kFilter,
+                                                   L"SomeFilter");
+  EXPECT_EQ(version, stream->GetDataVersion());
+
+  stream->SetData(DataVector<uint8_t>(100));
+  const uint32_t new_version = stream->GetDataVersion();
+  EXPECT_NE(version, new_version);
+
+  stream->SetDataAndRemoveFilter({});
+  EXPECT_NE(new_version, stream->GetDataVersion());
+}
+
 TEST(PDFStreamTest, LengthInDictionaryOnCreate) {
   static constexpr uint32_t kBufSize = 100;
   // The length field should be created on stream create.
@@ -10,10 +10,12 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <sstream>
 #include <utility>
 #include <vector>
 
 #include "core/fpdfapi/parser/cpdf_array.h"
+#include "core/fpdfapi/parser/cpdf_cross_ref_index.h"
 #include "core/fpdfapi/parser/cpdf_crypto_handler.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
@@ -28,15 +30,20 @@
 #include "core/fpdfapi/parser/cpdf_syntax_parser.h"
 #include "core/fpdfapi/parser/fpdf_parser_utility.h"
 #include "core/fxcrt/autorestorer.h"
+#include "core/fxcrt/cfx_borrowed_span_stream.h"
+#include "core/fxcrt/cfx_read_only_span_stream.h"
 #include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fx_extension.h"
 #include "core/fxcrt/fx_safe_types.h"
+#include "core/fxcrt/fx_string_wrappers.h"
+#include "core/fxcrt/parallel_for.h"
 #include "core/fxcrt/scoped_set_insertion.h"
 #include "third_party/base/check.h"
 #include "third_party/base/check_op.h"
 #include "third_party/base/containers/contains.h"
 #include "third_party/base/containers/span.h"
 #include "third_party/base/notreached.h"
+#include "third_party/base/numerics/safe_conversions.h"
 
 using ObjectType = CPDF_CrossRefTable::ObjectType;
 using ObjectInfo = CPDF_CrossRefTable::ObjectInfo;
@@ -150,11 +157,193 @@ class ObjectsHolderStub final : public CPDF_Parser::ParsedObjectsHolder {
   bool TryInit() override { return true; }
 };
 
+// RebuildCrossRef() parses objects ahead of its serial scan in chunks of this
+// size. Files smaller than two chunks are always rebuilt serially.
+constexpr size_t kRebuildChunkSize = 256 * 1024;
+
+// How many chunks each RebuildCrossRef() thread gets at a time, to even out
+// the load when objects are distributed unevenly.
+constexpr size_t kRebuildChunksPerThread = 4;
+
+size_t g_rebuild_cross_ref_thread_count = 1;
+
+size_t g_object_stream_cache_budget = 0;
+
+// What RebuildCrossRef() learns from parsing the indirect object at a given
+// position. This only depends on the file contents, so it can be computed
+// ahead of time by any CPDF_SyntaxParser over the same file.
+struct RebuildObjectResult {
+  // Where the parser ends up after reading the object.
+  FX_FILESIZE end_pos = 0;
+
+  // Set if the object is a cross-reference stream.
+  RetainPtr<CPDF_Dictionary> xref_dict;
+  uint32_t xref_obj_num = 0;
+
+  // If the object is an object stream, the object numbers it contains, in
+  // order.
+  std::vector<uint32_t> compressed_obj_nums;
+};
+
+RebuildObjectResult ParseObjectForRebuild(CPDF_SyntaxParser* syntax,
+                                          FX_FILESIZE obj_pos) {
+  RebuildObjectResult result;
+  syntax->SetPos(obj_pos);
+  RetainPtr<CPDF_Stream> stream = ToStream(syntax->GetIndirectObject(
+      nullptr, CPDF_SyntaxParser::ParseType::kStrict));
+  result.end_pos = syntax->GetPos();
+  if (!stream)
+    return result;
+
+  if (stream->GetDict()->GetNameFor("Type") == "XRef") {
+    result.xref_dict = ToDictionary(stream->GetDict()->Clone());
+    result.xref_obj_num = stream->GetObjNum();
+  }
+
+  const auto object_stream = CPDF_ObjectStream::Create(std::move(stream));
+  if (object_stream) {
+    for (const auto& info : object_stream->object_info())
+      result.compressed_obj_nums.push_back(info.obj_num);
+  }
+  return result;
+}
+
+bool IsTokenBoundary(pdfium::span<const uint8_t> data, size_t pos) {
+  return pos >= data.size() || PDFCharIsWhitespace(data[pos]) ||
+         PDFCharIsDelimiter(data[pos]);
+}
+
+// Returns the positions of everything in `data` that looks like an "N G obj"
+// object header, and whose "obj" keyword starts in [begin, end). This is a
+// cheap approximation of what RebuildCrossRef() finds by tokenizing; false
+// positives and misses only cost time, not correctness.
+std::vector<FX_FILESIZE> FindObjectHeaders(pdfium::span<const uint8_t> data,
+                                           size_t begin,
+                                           size_t end) {
+  std::vector<FX_FILESIZE> positions;
+  for (size_t i = begin; i < end && i + 3 <= data.size(); ++i) {
+    if (data[i] != 'o' || data[i + 1] != 'b' || data[i + 2] != 'j' ||
+        !IsTokenBoundary(data, i + 3)) {
+      continue;
+    }
+
+    // Walk backwards over whitespace, the generation number, whitespace and
+    // the object number.
+    size_t pos = i;
+    bool matched = true;
+    for (int field = 0; field < 2 && matched; ++field) {
+      const size_t field_end = pos;
+      while (pos > 0 && PDFCharIsWhitespace(data[pos - 1]))
+        --pos;
+      const size_t digits_end = pos;
+      while (pos > 0 && PDFCharIsNumeric(data[pos - 1]))
+        --pos;
+      matched = pos < digits_end && digits_end < field_end;
+    }
+    if (matched && (pos == 0 || IsTokenBoundary(data, pos - 1)))
+      positions.push_back(pos);
+  }
+  return positions;
+}
+
+// Parses what looks like indirect objects in a file ahead of
+// RebuildCrossRef()'s serial scan, on several threads. Works through the file
+// a window of chunks at a time, starting at the chunk the scan asks about, so
+// only the results for the part of the file the scan is in are kept.
+class RebuildObjectPrefetcher {
+ public:
+  // Positions are relative to `header_offset`, like CPDF_SyntaxParser
+  // positions. `file` must stay valid and unchanged while this is in use.
+  RebuildObjectPrefetcher(pdfium::span<const uint8_t> file,
+                          FX_FILESIZE header_offset,
+                          size_t thread_count)
+      : m_File(file),
+        m_Document(
+            file.subspan(pdfium::base::checked_cast<size_t>(header_offset))),
+        m_HeaderOffset(header_offset),
+        m_ThreadCount(thread_count) {}
+
+  bool IsEnabled() const {
+    return m_ThreadCount > 1 && m_Document.size() >= 2 * kRebuildChunkSize;
+  }
+
+  // Moves the result for the object at `obj_pos` into `result` and returns
+  // true, if it got parsed ahead of time. Results before `obj_pos` are
+  // dropped, so positions should be passed in increasing order.
+  bool Take(FX_FILESIZE obj_pos, RebuildObjectResult* result) {
+    if (obj_pos < 0 || static_cast<uint64_t>(obj_pos) >= m_Document.size())
+      return false;
+
+    const size_t pos = static_cast<size_t>(obj_pos);
+    if (pos < m_WindowBegin)
+      return false;
+    if (pos >= m_WindowEnd)
+      ParseWindow(pos / kRebuildChunkSize);
+
+    while (m_NextResult < m_Results.size() &&
+           m_Results[m_NextResult].first < obj_pos) {
+      m_Results[m_NextResult++].second = RebuildObjectResult();
+    }
+    if (m_NextResult == m_Results.size() ||
+        m_Results[m_NextResult].first != obj_pos) {
+      return false;
+    }
+    *result = std::move(m_Results[m_NextResult++].second);
+    return true;
+  }
+
+ private:
+  void ParseWindow(size_t first_chunk) {
+    const size_t total_chunks =
+        (m_Document.size() + kRebuildChunkSize - 1) / kRebuildChunkSize;
+    const size_t chunk_count = std::min(m_ThreadCount * kRebuildChunksPerThread,
+                                        total_chunks - first_chunk);
+    m_WindowBegin = first_chunk * kRebuildChunkSize;
+    m_WindowEnd = std::min(m_Document.size(),
+                           (first_chunk + chunk_count) * kRebuildChunkSize);
+
+    std::vector<std::vector<std::pair<FX_FILESIZE, RebuildObjectResult>>>
+        chunk_results(chunk_count);
+    ParallelFor(chunk_count, m_ThreadCount, [&](size_t chunk) {
+      // Each thread needs its own objects all the way down to the file
+      // stream, as ref-counting is not thread-safe.
+      CPDF_SyntaxParser syntax(
+          pdfium::MakeRetain<CPDF_ReadValidator>(
+              pdfium::MakeRetain<CFX_BorrowedSpanStream>(m_File), nullptr),
+          m_HeaderOffset);
+      const size_t begin = m_WindowBegin + chunk * kRebuildChunkSize;
+      const size_t end = std::min(m_WindowEnd, begin + kRebuildChunkSize);
+      for (FX_FILESIZE pos : FindObjectHeaders(m_Document, begin, end)) {
+        chunk_results[chunk].emplace_back(pos,
+                                          ParseObjectForRebuild(&syntax, pos));
+      }
+    });
+
+    // Chunks are in file order, and so are the results within them.
+    m_Results.clear();
+    m_NextResult = 0;
+    for (auto& chunk : chunk_results) {
+      for (auto& result : chunk)
+        m_Results.push_back(std::move(result));
+    }
+  }
+
+  const pdfium::span<const uint8_t> m_File;
+  const pdfium::span<const uint8_t> m_Document;
+  const FX_FILESIZE m_HeaderOffset;
+  const size_t m_ThreadCount;
+  size_t m_WindowBegin = 0;
+  size_t m_WindowEnd = 0;
+  std::vector<std::pair<FX_FILESIZE, RebuildObjectResult>> m_Results;
+  size_t m_NextResult = 0;
+};
+
 }  // namespace
 
 CPDF_Parser::CPDF_Parser(ParsedObjectsHolder* holder)
     : m_pObjectsHolder(holder),
-      m_CrossRefTable(std::make_unique<CPDF_CrossRefTable>()) {
+      m_CrossRefTable(std::make_unique<CPDF_CrossRefTable>()),
+      m_ObjectStreamCache(g_object_stream_cache_budget) {
   if (!holder) {
     m_pOwnedObjectsHolder = std::make_unique<ObjectsHolderStub>();
     m_pObjectsHolder = m_pOwnedObjectsHolder.get();
@@ -241,6 +430,169 @@ CPDF_Parser::Error CPDF_Parser::StartParse(
   return StartParseInternal();
 }
 
+CPDF_Parser::Error CPDF_Parser::StartParseWithCrossRefIndex(
+    RetainPtr<IFX_SeekableReadStream> pFile,
+    const ByteString& password,
+    pdfium::span<const uint8_t> cross_ref_index) {
+  if (!InitSyntaxParser(
+          pdfium::MakeRetain<CPDF_ReadValidator>(std::move(pFile), nullptr)))
+    return FORMAT_ERROR;
+  SetPassword(password);
+  if (!LoadCrossRefIndex(cross_ref_index))
+    return StartParseInternal();
+
+  m_bHasParsed = true;
+  return FinishParse();
+}
+
+bool CPDF_Parser::LoadCrossRefIndex(pdfium::span<const uint8_t> data) {
+  std::unique_ptr<CPDF_CrossRefIndex> index = CPDF_CrossRefIndex::Parse(data);
+  if (!index)
+    return false;
+
+  RetainPtr<CPDF_ReadValidator> file = m_pSyntax->GetValidator();
+  if (index->file_size != file->GetSize() ||
+      CPDF_CrossRefIndex::DigestFileTail(file.Get()) != index->tail_digest) {
+    return false;
+  }
+
+  CPDF_SyntaxParser trailer_syntax(
+      pdfium::MakeRetain<CFX_ReadOnlySpanStream>(index->trailer.raw_span()));
+  RetainPtr<CPDF_Dictionary> trailer =
+      ToDictionary(trailer_syntax.GetObjectBody(m_pObjectsHolder));
+  if (!trailer || !IsValidCrossRefIndex(*index, trailer.Get()))
+    return false;
+
+  m_CrossRefTable = std::make_unique<CPDF_CrossRefTable>(
+      std::move(trailer), index->trailer_object_number,
+      std::move(index->objects));
+  m_IndexedObjectStreamInfo = std::move(index->object_streams);
+  m_LastXRefOffset = index->last_xref_offset;
+  m_bXRefStream = index->xref_stream;
+  m_bXRefTableRebuilt = index->xref_table_rebuilt;
+  return true;
+}
+
+bool CPDF_Parser::IsValidCrossRefIndex(const CPDF_CrossRefIndex& index,
+                                       const CPDF_Dictionary* trailer) {
+  // Objects whose headers get checked against the file: those the trailer
+  // refers to, which every load parses, and a sample spread over the rest.
+  // Checking every object would cost about as much as parsing the
+  // cross-reference table.
+  constexpr size_t kMaxSampledObjectHeaders = 64;
+  std::set<uint32_t> checked_obj_nums;
+  for (const char* key : {"Root", "Info", "Encrypt"}) {
+    RetainPtr<const CPDF_Reference> ref =
+        ToReference(trailer->GetObjectFor(key));
+    if (ref)
+      checked_obj_nums.insert(ref->GetRefObjNum());
+  }
+
+  const FX_FILESIZE document_size = m_pSyntax->GetDocumentSize();
+  const size_t sample_step =
+      std::max<size_t>(index.objects.size() / kMaxSampledObjectHeaders, 1);
+  size_t entry_index = 0;
+  for (const auto& [obj_num, info] : index.objects) {
+    if (obj_num >= kMaxObjectNumber)
+      return false;
+
+    switch (info.type) {
+      case ObjectType::kFree:
+        if (info.is_object_stream_flag)
+          return false;
+        break;
+      case ObjectType::kNormal:
+        if (info.pos <= 0 || info.pos >= document_size)
+          return false;
+        if (entry_index % sample_step == 0)
+          checked_obj_nums.insert(obj_num);
+        break;
+      case ObjectType::kCompressed: {
+        if (info.is_object_stream_flag)
+          return false;
+        auto archive_it = index.objects.find(info.archive.obj_num);
+        if (archive_it == index.objects.end() ||
+            archive_it->second.type != ObjectType::kNormal ||
+            !archive_it->second.is_object_stream_flag) {
+          return false;
+        }
+        auto headers_it = index.object_streams.find(info.archive.obj_num);
+        if (headers_it != index.object_streams.end() &&
+            (info.archive.obj_index >= headers_it->second.size() ||
+             headers_it->second[info.archive.obj_index].obj_num != obj_num)) {
+          return false;
+        }
+        break;
+      }
+    }
+    ++entry_index;
+  }
+
+  for (const auto& it : index.object_streams) {
+    auto object_it = index.objects.find(it.first);
+    if (object_it == index.objects.end() ||
+        !object_it->second.is_object_stream_flag) {
+      return false;
+    }
+  }
+
+  for (uint32_t obj_num : checked_obj_nums) {
+    auto it = index.objects.find(obj_num);
+    if (it == index.objects.end() || it->second.type != ObjectType::kNormal)
+      continue;
+    if (!HasObjectHeaderAt(it->second.pos, obj_num, it->second.gennum))
+      return false;
+  }
+  return true;
+}
+
+bool CPDF_Parser::HasObjectHeaderAt(FX_FILESIZE pos,
+                                    uint32_t obj_num,
+                                    uint16_t gen_num) {
+  const FX_FILESIZE saved_pos = m_pSyntax->GetPos();
+  m_pSyntax->SetPos(pos);
+  const CPDF_SyntaxParser::WordResult num_word = m_pSyntax->GetNextWord();
+  const CPDF_SyntaxParser::WordResult gen_word = m_pSyntax->GetNextWord();
+  const bool result = num_word.is_number && gen_word.is_number &&
+                      FXSYS_atoui(num_word.word.c_str()) == obj_num &&
+                      FXSYS_atoui(gen_word.word.c_str()) == gen_num &&
+                      m_pSyntax->GetKeyword() == "obj";
+  m_pSyntax->SetPos(saved_pos);
+  return result;
+}
+
+DataVector<uint8_t> CPDF_Parser::SerializeCrossRefIndex() {
+  if (!m_bHasParsed || m_pLinearized || !GetTrailer())
+    return DataVector<uint8_t>();
+
+  CPDF_CrossRefIndex index;
+  RetainPtr<CPDF_ReadValidator> file = m_pSyntax->GetValidator();
+  const absl::optional<CPDF_CrossRefIndex::Digest> tail_digest =
+      CPDF_CrossRefIndex::DigestFileTail(file.Get());
+  if (!tail_digest.has_value())
+    return DataVector<uint8_t>();
+
+  index.file_size = file->GetSize();
+  index.tail_digest = tail_digest.value();
+  index.last_xref_offset = m_LastXRefOffset;
+  index.xref_stream = m_bXRefStream;
+  index.xref_table_rebuilt = m_bXRefTableRebuilt;
+  index.trailer_object_number = m_CrossRefTable->trailer_object_number();
+  fxcrt::ostringstream trailer_buf;
+  trailer_buf << GetTrailer();
+  index.trailer = ByteString(trailer_buf);
+  index.objects = m_CrossRefTable->objects_info();
+  for (const auto& [obj_num, info] : index.objects) {
+    if (!info.is_object_stream_flag)
+      continue;
+
+    RetainPtr<const CPDF_ObjectStream> object_stream = GetObjectStream(obj_num);
+    if (object_stream)
+      index.object_streams[obj_num] = object_stream->object_info();
+  }
+  return index.Serialize();
+}
+
 CPDF_Parser::Error CPDF_Parser::StartParseInternal() {
   DCHECK(!m_bHasParsed);
   DCHECK(!m_bXRefTableRebuilt);
@@ -263,6 +615,10 @@ CPDF_Parser::Error CPDF_Parser::StartParseInternal() {
 
     m_bXRefTableRebuilt = true;
   }
+  return FinishParse();
+}
+
+CPDF_Parser::Error CPDF_Parser::FinishParse() {
   Error eRet = SetEncryptHandler();
   if (eRet != SUCCESS)
     return eRet;
@@ -687,7 +1043,7 @@ bool CPDF_Parser::LoadAllCrossRefV5(FX_FILESIZE xref_offset) {
     if (pdfium::Contains(seen_xref_offset, xref_offset))
       return false;
   }
-  m_ObjectStreamMap.clear();
+  m_ObjectStreamCache.Clear();
   m_bXRefStream = true;
   return true;
 }
@@ -699,6 +1055,27 @@ bool CPDF_Parser::RebuildCrossRef() {
   m_pSyntax->SetReadBufferSize(kBufferSize);
   m_pSyntax->SetPos(0);
 
+  // When the whole file is in memory, parse the objects on other threads
+  // ahead of the serial scan below. The scan then only has to look up the
+  // results, and since it still decides which objects to use and in what
+  // order, the table is the same as if it had parsed them itself.
+  std::unique_ptr<RebuildObjectPrefetcher> prefetcher;
+  if (g_rebuild_cross_ref_thread_count > 1) {
+    RetainPtr<CPDF_ReadValidator> validator = m_pSyntax->GetValidator();
+    const FX_FILESIZE file_size = validator->GetSize();
+    if (pdfium::base::IsValueInRangeForNumericType<size_t>(file_size)) {
+      pdfium::span<const uint8_t> file = validator->BorrowBlockAtOffset(
+          0, static_cast<size_t>(file_size));
+      if (!file.empty()) {
+        prefetcher = std::make_unique<RebuildObjectPrefetcher>(
+            file, m_pSyntax->GetHeaderOffset(),
+            g_rebuild_cross_ref_thread_count);
+        if (!prefetcher->IsEnabled())
+          prefetcher.reset();
+      }
+    }
+  }
+
   std::vector<std::pair<uint32_t, FX_FILESIZE>> numbers;
   for (CPDF_SyntaxParser::WordResult result = m_pSyntax->GetNextWord();
        !result.word.IsEmpty(); result = m_pSyntax->GetNextWord()) {
@@ -735,31 +1112,27 @@ bool CPDF_Parser::RebuildCrossRef() {
       const uint32_t obj_num = numbers[0].first;
       const uint32_t gen_num = numbers[1].first;
 
-      m_pSyntax->SetPos(obj_pos);
-      const RetainPtr<CPDF_Stream> pStream =
-          ToStream(m_pSyntax->GetIndirectObject(
-              nullptr, CPDF_SyntaxParser::ParseType::kStrict));
+      RebuildObjectResult parsed;
+      if (prefetcher && prefetcher->Take(obj_pos, &parsed)) {
+        m_pSyntax->SetPos(parsed.end_pos);
+      } else {
+        parsed = ParseObjectForRebuild(m_pSyntax.get(), obj_pos);
+      }
 
-      if (pStream && pStream->GetDict()->GetNameFor("Type") == "XRef") {
+      if (parsed.xref_dict) {
         cross_ref_table = CPDF_CrossRefTable::MergeUp(
             std::move(cross_ref_table),
-            std::make_unique<CPDF_CrossRefTable>(
-                ToDictionary(pStream->GetDict()->Clone()),
-                pStream->GetObjNum()));
+            std::make_unique<CPDF_CrossRefTable>(std::move(parsed.xref_dict),
+                                                 parsed.xref_obj_num));
       }
 
       if (obj_num < kMaxObjectNumber) {
         cross_ref_table->AddNormal(obj_num, gen_num, /*is_object_stream=*/false,
                                    obj_pos);
-        const auto object_stream =
-            CPDF_ObjectStream::Create(std::move(pStream));
-        if (object_stream) {
-          const auto& object_info = object_stream->object_info();
-          for (size_t i = 0; i < object_info.size(); ++i) {
-            const auto& info = object_info[i];
-            if (info.obj_num < kMaxObjectNumber)
-              cross_ref_table->AddCompressed(info.obj_num, obj_num, i);
-          }
+        for (size_t i = 0; i < parsed.compressed_obj_nums.size(); ++i) {
+          const uint32_t compressed_obj_num = parsed.compressed_obj_nums[i];
+          if (compressed_obj_num < kMaxObjectNumber)
+            cross_ref_table->AddCompressed(compressed_obj_num, obj_num, i);
         }
       }
     }
@@ -774,6 +1147,16 @@ bool CPDF_Parser::RebuildCrossRef() {
   return GetTrailer() && !m_CrossRefTable->objects_info().empty();
 }
 
+// static
+void CPDF_Parser::SetRebuildCrossRefThreadCount(size_t count) {
+  g_rebuild_cross_ref_thread_count = std::max<size_t>(count, 1);
+}
+
+// static
+void CPDF_Parser::SetObjectStreamCacheBudget(size_t bytes) {
+  g_object_stream_cache_budget = bytes;
+}
+
 bool CPDF_Parser::LoadCrossRefV5(FX_FILESIZE* pos,
                                  bool is_main_xref,
                                  bool overwrite_existing) {
@@ -1017,7 +1400,9 @@ RetainPtr<CPDF_Object> CPDF_Parser::ParseIndirectObject(uint32_t objnum) {
   }
 
   const auto& info = *m_CrossRefTable->GetObjectInfo(objnum);
-  const CPDF_ObjectStream* pObjStream = GetObjectStream(info.archive.obj_num);
+  // Hold on to the object stream, as parsing may evict it from the cache.
+  RetainPtr<const CPDF_ObjectStream> pObjStream =
+      GetObjectStream(info.archive.obj_num);
   if (!pObjStream)
     return nullptr;
 
@@ -1025,14 +1410,16 @@ RetainPtr<CPDF_Object> CPDF_Parser::ParseIndirectObject(uint32_t objnum) {
                                  info.archive.obj_index);
 }
 
-const CPDF_ObjectStream* CPDF_Parser::GetObjectStream(uint32_t object_number) {
+RetainPtr<const CPDF_ObjectStream> CPDF_Parser::GetObjectStream(
+    uint32_t object_number) {
   // Prevent circular parsing the same object.
   if (pdfium::Contains(m_ParsingObjNums, object_number))
     return nullptr;
 
-  auto it = m_ObjectStreamMap.find(object_number);
-  if (it != m_ObjectStreamMap.end())
-    return it->second.get();
+  RetainPtr<const CPDF_ObjectStream> cached =
+      m_ObjectStreamCache.Get(object_number);
+  if (cached)
+    return cached;
 
   const auto* info = m_CrossRefTable->GetObjectInfo(object_number);
   if (!info || !info->is_object_stream_flag) {
@@ -1051,12 +1438,17 @@ const CPDF_ObjectStream* CPDF_Parser::GetObjectStream(uint32_t object_number) {
   if (!object)
     return nullptr;
 
-  std::unique_ptr<CPDF_ObjectStream> objs_stream =
-      CPDF_ObjectStream::Create(ToStream(object));
-  const CPDF_ObjectStream* result = objs_stream.get();
-  m_ObjectStreamMap[object_number] = std::move(objs_stream);
-
-  return result;
+  RetainPtr<CPDF_ObjectStream> objs_stream;
+  auto indexed_it = m_IndexedObjectStreamInfo.find(object_number);
+  if (indexed_it != m_IndexedObjectStreamInfo.end()) {
+    objs_stream = CPDF_ObjectStream::CreateWithObjectInfo(ToStream(object),
+                                                          indexed_it->second);
+  } else {
+    objs_stream = CPDF_ObjectStream::Create(ToStream(object));
+  }
+  if (objs_stream)
+    m_ObjectStreamCache.Add(object_number, objs_stream);
+  return objs_stream;
 }
 
 RetainPtr<CPDF_Object> CPDF_Parser::ParseIndirectObjectAt(FX_FILESIZE pos,
@@ -1217,7 +1609,7 @@ bool CPDF_Parser::LoadLinearizedAllCrossRefV5(FX_FILESIZE main_xref_offset) {
     if (pdfium::Contains(seen_xref_offset, xref_offset))
       return false;
   }
-  m_ObjectStreamMap.clear();
+  m_ObjectStreamCache.Clear();
   m_bXRefStream = true;
   return true;
 }
@@ -1233,7 +1625,7 @@ CPDF_Parser::Error CPDF_Parser::LoadLinearizedMainXRefTable() {
 
   const AutoRestorer<uint32_t> save_metadata_objnum(&m_MetadataObjnum);
   m_MetadataObjnum = 0;
-  m_ObjectStreamMap.clear();
+  m_ObjectStreamCache.Clear();
 
   if (!LoadLinearizedAllCrossRefV4(main_xref_offset) &&
       !LoadLinearizedAllCrossRefV5(main_xref_offset)) {
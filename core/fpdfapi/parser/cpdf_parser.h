@@ -18,21 +18,25 @@
 
 #include "core/fpdfapi/parser/cpdf_cross_ref_table.h"
 #include "core/fpdfapi/parser/cpdf_indirect_object_holder.h"
+#include "core/fpdfapi/parser/cpdf_object_stream.h"
+#include "core/fpdfapi/parser/cpdf_object_stream_cache.h"
 #include "core/fxcrt/bytestring.h"
+#include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fx_types.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/unowned_ptr.h"
+#include "third_party/base/containers/span.h"
 
 class CPDF_Array;
 class CPDF_Dictionary;
 class CPDF_LinearizedHeader;
 class CPDF_Object;
-class CPDF_ObjectStream;
 class CPDF_ReadValidator;
 class CPDF_SecurityHandler;
 class CPDF_SyntaxParser;
 class IFX_ArchiveStream;
 class IFX_SeekableReadStream;
+struct CPDF_CrossRefIndex;
 
 class CPDF_Parser {
  public:
@@ -58,6 +62,16 @@ class CPDF_Parser {
 
   static constexpr size_t kInvalidPos = std::numeric_limits<size_t>::max();
 
+  // Sets how many threads RebuildCrossRef() may use. Only documents whose
+  // whole file can be borrowed from the stream, e.g. memory-mapped ones, are
+  // rebuilt in parallel. Not thread-safe; call this before loading documents.
+  // Defaults to 1, which means no extra threads.
+  static void SetRebuildCrossRefThreadCount(size_t count);
+
+  // Sets how many bytes of decoded object streams parsers created afterwards
+  // keep in memory. Not thread-safe. Defaults to 0, which means no limit.
+  static void SetObjectStreamCacheBudget(size_t bytes);
+
   explicit CPDF_Parser(ParsedObjectsHolder* holder);
   CPDF_Parser();
   ~CPDF_Parser();
@@ -67,6 +81,23 @@ class CPDF_Parser {
   Error StartLinearizedParse(RetainPtr<CPDF_ReadValidator> validator,
                              const ByteString& password);
 
+  // Like StartParse(), but takes the cross-reference table and object stream
+  // headers from `cross_ref_index` instead of parsing them, if the index was
+  // created by SerializeCrossRefIndex() for the same file. Otherwise parses
+  // the file as usual.
+  Error StartParseWithCrossRefIndex(
+      RetainPtr<IFX_SeekableReadStream> pFile,
+      const ByteString& password,
+      pdfium::span<const uint8_t> cross_ref_index);
+
+  // Returns an index for StartParseWithCrossRefIndex(), or an empty vector if
+  // the document was not loaded with StartParse(). Loads all object streams.
+  DataVector<uint8_t> SerializeCrossRefIndex();
+
+  const CPDF_ObjectStreamCache::Stats& GetObjectStreamCacheStats() const {
+    return m_ObjectStreamCache.stats();
+  }
+
   void SetPassword(const ByteString& password) { m_Password = password; }
   ByteString GetPassword() const { return m_Password; }
 
@@ -129,7 +160,15 @@ class CPDF_Parser {
  protected:
   bool LoadCrossRefV4(FX_FILESIZE pos, bool bSkip);
   bool RebuildCrossRef();
+  // Checks that the entries of `index` agree with each other, and that a
+  // sample of them agrees with the file, so that a damaged or stale index
+  // gets ignored.
+  bool IsValidCrossRefIndex(const CPDF_CrossRefIndex& index,
+                            const CPDF_Dictionary* trailer);
   Error StartParseInternal();
+  // Sets up decryption and checks the document root once the cross-reference
+  // table is loaded, rebuilding the table if it turns out to be unusable.
+  Error FinishParse();
   FX_FILESIZE ParseStartXRef();
   std::unique_ptr<CPDF_LinearizedHeader> ParseLinearizedHeader();
 
@@ -143,6 +182,8 @@ class CPDF_Parser {
     CPDF_CrossRefTable::ObjectInfo info;
   };
 
+  bool LoadCrossRefIndex(pdfium::span<const uint8_t> data);
+  bool HasObjectHeaderAt(FX_FILESIZE pos, uint32_t obj_num, uint16_t gen_num);
   bool LoadAllCrossRefV4(FX_FILESIZE xref_offset);
   bool LoadAllCrossRefV5(FX_FILESIZE xref_offset);
   bool LoadCrossRefV5(FX_FILESIZE* pos,
@@ -158,7 +199,7 @@ class CPDF_Parser {
   bool LoadLinearizedAllCrossRefV4(FX_FILESIZE main_xref_offset);
   bool LoadLinearizedAllCrossRefV5(FX_FILESIZE main_xref_offset);
   Error LoadLinearizedMainXRefTable();
-  const CPDF_ObjectStream* GetObjectStream(uint32_t object_number);
+  RetainPtr<const CPDF_ObjectStream> GetObjectStream(uint32_t object_number);
   // A simple check whether the cross reference table matches with
   // the objects.
   bool VerifyCrossRefV4();
@@ -193,8 +234,13 @@ class CPDF_Parser {
   ByteString m_Password;
   std::unique_ptr<CPDF_LinearizedHeader> m_pLinearized;
 
-  // A map of object numbers to indirect streams.
-  std::map<uint32_t, std::unique_ptr<CPDF_ObjectStream>> m_ObjectStreamMap;
+  // Decoded object streams, by object number.
+  CPDF_ObjectStreamCache m_ObjectStreamCache;
+
+  // Object stream headers from LoadCrossRefIndex(). Kept after decoding, as
+  // object streams evicted from `m_ObjectStreamCache` may get decoded again.
+  std::map<uint32_t, std::vector<CPDF_ObjectStream::ObjectInfo>>
+      m_IndexedObjectStreamInfo;
 
   // All indirect object numbers that are being parsed.
   std::set<uint32_t> m_ParsingObjNums;
@@ -11,10 +11,13 @@
 #include <utility>
 #include <vector>
 
+#include "core/fpdfapi/parser/cpdf_cross_ref_index.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_linearized_header.h"
 #include "core/fpdfapi/parser/cpdf_object.h"
+#include "core/fpdfapi/parser/cpdf_reference.h"
 #include "core/fpdfapi/parser/cpdf_syntax_parser.h"
+#include "core/fxcrt/cfx_borrowed_span_stream.h"
 #include "core/fxcrt/cfx_read_only_span_stream.h"
 #include "core/fxcrt/fx_extension.h"
 #include "core/fxcrt/fx_stream.h"
@@ -127,7 +130,15 @@ class CPDF_TestParser final : public CPDF_Parser {
     return InitTestFromBufferWithOffset(buffer, 0 /*header_offset*/);
   }
 
+  // Setup reading from a buffer that the parser may borrow from, like it would
+  // from a memory-mapped file.
+  void InitTestFromBorrowedBuffer(pdfium::span<const uint8_t> buffer) {
+    SetSyntaxParserForTesting(CPDF_SyntaxParser::CreateForTesting(
+        pdfium::MakeRetain<CFX_BorrowedSpanStream>(buffer), 0));
+  }
+
   // Expose protected CPDF_Parser methods for testing.
+  using CPDF_Parser::IsValidCrossRefIndex;
   using CPDF_Parser::LoadCrossRefV4;
   using CPDF_Parser::ParseLinearizedHeader;
   using CPDF_Parser::ParseStartXRef;
@@ -170,6 +181,141 @@ TEST(ParserTest, RebuildCrossRefFailed) {
   ASSERT_FALSE(parser.RebuildCrossRef());
 }
 
+TEST(ParserTest, RebuildCrossRefInParallel) {
+  // A document without an xref table, large enough to be parsed ahead in
+  // several windows of chunks.
+  const std::string padding(240, 'x');
+  std::string data = "%PDF-1.7\n";
+  for (int i = 1; i <= 20000; ++i) {
+    data += std::to_string(i) + " 0 obj\n<< /Index " + std::to_string(i) +
+            " /Padding (" + padding + ") >>\nendobj\n";
+    if (i == 10000) {
+      // An object stream, a stream that looks like it contains an object, and
+      // a trailer that a later one overrides.
+      data +=
+          "30001 0 obj\n<< /Type /ObjStm /N 2 /First 16 /Length 23 >>\n"
+          "stream\n40001 0 40002 4 (a) (b)\nendstream\nendobj\n"
+          "30002 0 obj\n<< /Length 16 >>\nstream\n7 0 obj (fake)\n\n"
+          "endstream\nendobj\n"
+          "trailer\n<< /Root 1 0 R /Size 10 >>\n";
+    }
+    if (i == 15000) {
+      // A stream that spans several chunks, which the serial scan skips.
+      std::string stream_data;
+      while (stream_data.size() < 1024 * 1024)
+        stream_data += "8 0 obj (fake) endobj\n";
+      data += "30003 0 obj\n<< /Length " +
+              std::to_string(stream_data.size()) + " >>\nstream\n" +
+              stream_data + "\nendstream\nendobj\n";
+    }
+  }
+  // Redefine an object with a new generation number.
+  data += "5 1 obj\n(updated)\nendobj\n";
+  data += "trailer\n<< /Root 1 0 R /Size 40003 >>\n%%EOF\n";
+  const pdfium::span<const uint8_t> span(
+      reinterpret_cast<const uint8_t*>(data.data()), data.size());
+
+  CPDF_TestParser serial_parser;
+  serial_parser.InitTestFromBorrowedBuffer(span);
+  ASSERT_TRUE(serial_parser.RebuildCrossRef());
+  const auto& serial_objects =
+      serial_parser.GetCrossRefTable()->objects_info();
+  ASSERT_EQ(20005u, serial_objects.size());
+
+  for (size_t thread_count : {2, 4}) {
+    SCOPED_TRACE(thread_count);
+    CPDF_Parser::SetRebuildCrossRefThreadCount(thread_count);
+    CPDF_TestParser parallel_parser;
+    parallel_parser.InitTestFromBorrowedBuffer(span);
+    const bool parallel_result = parallel_parser.RebuildCrossRef();
+    CPDF_Parser::SetRebuildCrossRefThreadCount(1);
+    ASSERT_TRUE(parallel_result);
+
+    const auto& parallel_objects =
+        parallel_parser.GetCrossRefTable()->objects_info();
+    ASSERT_EQ(serial_objects.size(), parallel_objects.size());
+    for (const auto& [obj_num, info] : serial_objects) {
+      auto it = parallel_objects.find(obj_num);
+      ASSERT_NE(it, parallel_objects.end()) << obj_num;
+      EXPECT_EQ(info.type, it->second.type) << obj_num;
+      EXPECT_EQ(info.gennum, it->second.gennum) << obj_num;
+      if (info.type == CPDF_CrossRefTable::ObjectType::kCompressed) {
+        EXPECT_EQ(info.archive.obj_num, it->second.archive.obj_num)
+            << obj_num;
+        EXPECT_EQ(info.archive.obj_index, it->second.archive.obj_index)
+            << obj_num;
+      } else {
+        EXPECT_EQ(info.pos, it->second.pos) << obj_num;
+      }
+    }
+
+    EXPECT_EQ(1u, GetObjInfo(parallel_parser, 5).gennum);
+    const CPDF_CrossRefTable::ObjectInfo compressed =
+        GetObjInfo(parallel_parser, 40002);
+    EXPECT_EQ(CPDF_CrossRefTable::ObjectType::kCompressed, compressed.type);
+    EXPECT_EQ(30001u, compressed.archive.obj_num);
+    EXPECT_EQ(1u, compressed.archive.obj_index);
+    EXPECT_EQ(40003, parallel_parser.GetTrailer()->GetIntegerFor("Size"));
+  }
+}
+
+TEST(ParserTest, ValidateCrossRefIndex) {
+  static const char kData[] =
+      "%PDF-1.7\n"
+      "1 0 obj\n<< /Type /Catalog >>\nendobj\n"
+      "2 3 obj\n<< /Type /ObjStm /N 1 /First 4 /Length 8 >>\n"
+      "stream\n4 0 (a)\nendstream\nendobj\n";
+  const std::string data(kData);
+  CPDF_TestParser parser;
+  ASSERT_TRUE(parser.InitTestFromBuffer(
+      pdfium::make_span(reinterpret_cast<const uint8_t*>(kData), data.size())));
+  auto trailer = pdfium::MakeRetain<CPDF_Dictionary>();
+  trailer->SetNewFor<CPDF_Reference>("Root", nullptr, 1);
+
+  auto make_index = [&data]() {
+    CPDF_CrossRefIndex index;
+    CPDF_CrossRefTable::ObjectInfo& catalog = index.objects[1];
+    catalog.type = CPDF_CrossRefTable::ObjectType::kNormal;
+    catalog.pos = data.find("1 0 obj");
+    CPDF_CrossRefTable::ObjectInfo& object_stream = index.objects[2];
+    object_stream.type = CPDF_CrossRefTable::ObjectType::kNormal;
+    object_stream.is_object_stream_flag = true;
+    object_stream.gennum = 3;
+    object_stream.pos = data.find("2 3 obj");
+    CPDF_CrossRefTable::ObjectInfo& compressed = index.objects[4];
+    compressed.type = CPDF_CrossRefTable::ObjectType::kCompressed;
+    compressed.archive.obj_num = 2;
+    compressed.archive.obj_index = 0;
+    index.object_streams[2] = {{4, 0}};
+    return index;
+  };
+  EXPECT_TRUE(parser.IsValidCrossRefIndex(make_index(), trailer.Get()));
+
+  // Objects that are not where the index says they are.
+  CPDF_CrossRefIndex index = make_index();
+  index.objects[1].pos += 1;
+  EXPECT_FALSE(parser.IsValidCrossRefIndex(index, trailer.Get()));
+  index = make_index();
+  index.objects[1].pos = data.size();
+  EXPECT_FALSE(parser.IsValidCrossRefIndex(index, trailer.Get()));
+  index = make_index();
+  index.objects[2].gennum = 0;
+  EXPECT_FALSE(parser.IsValidCrossRefIndex(index, trailer.Get()));
+
+  // Compressed objects that are not in an object stream.
+  index = make_index();
+  index.objects[4].archive.obj_num = 1;
+  EXPECT_FALSE(parser.IsValidCrossRefIndex(index, trailer.Get()));
+  index = make_index();
+  index.objects[4].archive.obj_index = 1;
+  EXPECT_FALSE(parser.IsValidCrossRefIndex(index, trailer.Get()));
+
+  // Object stream headers for an object that is not an object stream.
+  index = make_index();
+  index.object_streams[1] = {{5, 0}};
+  EXPECT_FALSE(parser.IsValidCrossRefIndex(index, trailer.Get()));
+}
+
 TEST(ParserTest, LoadCrossRefV4) {
   {
     static const unsigned char kXrefTable[] =
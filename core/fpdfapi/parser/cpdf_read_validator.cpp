@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "core/fpdfapi/parser/cpdf_stream.h"
 #include "core/fxcrt/fx_safe_types.h"
@@ -79,32 +80,68 @@ bool CPDF_ReadValidator::ReadBlockAtOffset(pdfium::span<uint8_t> buffer,
   return false;
 }
 
+pdfium::span<const uint8_t> CPDF_ReadValidator::BorrowBlockAtOffset(
+    FX_FILESIZE offset,
+    size_t size) {
+  // Never lend out data while downloading progressively. Objects that borrow
+  // from `this` keep it alive, and must not outlive `file_avail_`.
+  if (file_avail_)
+    return {};
+
+  return file_read_->BorrowBlockAtOffset(offset, size);
+}
+
 FX_FILESIZE CPDF_ReadValidator::GetSize() {
   return file_size_;
 }
 
+absl::optional<CPDF_ReadValidator::Segment>
+CPDF_ReadValidator::GetCheckedSegment(FX_FILESIZE offset, size_t size) const {
+  FX_SAFE_FILESIZE end_offset = offset;
+  end_offset += size;
+  // Increase checked range to allow CPDF_SyntaxParser read whole buffer.
+  end_offset += CPDF_Stream::kFileBufSize;
+  if (!end_offset.IsValid())
+    return absl::nullopt;
+
+  const FX_FILESIZE end = std::min(
+      file_size_, static_cast<FX_FILESIZE>(end_offset.ValueOrDie()));
+  FX_SAFE_SIZE_T length = end;
+  length -= offset;
+  if (!length.IsValid())
+    return absl::nullopt;
+
+  return Segment(offset, end);
+}
+
+CPDF_ReadValidator::Segment CPDF_ReadValidator::GetAlignedSegment(
+    const Segment& segment) const {
+  return Segment(AlignDown(segment.first),
+                 std::min(file_size_, AlignUp(segment.second)));
+}
+
 void CPDF_ReadValidator::ScheduleDownload(FX_FILESIZE offset, size_t size) {
   has_unavailable_data_ = true;
   if (!hints_ || size == 0)
     return;
 
-  const FX_FILESIZE start_segment_offset = AlignDown(offset);
-  FX_SAFE_FILESIZE end_segment_offset = offset;
-  end_segment_offset += size;
-  if (!end_segment_offset.IsValid()) {
+  FX_SAFE_FILESIZE end_offset = offset;
+  end_offset += size;
+  if (!end_offset.IsValid()) {
     NOTREACHED();
     return;
   }
-  end_segment_offset =
-      std::min(file_size_, AlignUp(end_segment_offset.ValueOrDie()));
+  RequestSegment(GetAlignedSegment(Segment(offset, end_offset.ValueOrDie())));
+}
 
-  FX_SAFE_SIZE_T segment_size = end_segment_offset;
-  segment_size -= start_segment_offset;
+void CPDF_ReadValidator::RequestSegment(const Segment& segment) {
+  FX_SAFE_SIZE_T segment_size = segment.second;
+  segment_size -= segment.first;
   if (!segment_size.IsValid()) {
     NOTREACHED();
     return;
   }
-  hints_->AddSegment(start_segment_offset, segment_size.ValueOrDie());
+  hints_->AddSegment(segment.first, segment_size.ValueOrDie());
 }
 
 bool CPDF_ReadValidator::IsDataRangeAvailable(FX_FILESIZE offset,
@@ -128,27 +165,62 @@ bool CPDF_ReadValidator::CheckDataRangeAndRequestIfUnavailable(
   if (offset > file_size_)
     return true;
 
-  FX_SAFE_FILESIZE end_segment_offset = offset;
-  end_segment_offset += size;
-  // Increase checked range to allow CPDF_SyntaxParser read whole buffer.
-  end_segment_offset += CPDF_Stream::kFileBufSize;
-  if (!end_segment_offset.IsValid()) {
-    NOTREACHED();
-    return false;
-  }
-  end_segment_offset = std::min(
-      file_size_, static_cast<FX_FILESIZE>(end_segment_offset.ValueOrDie()));
-  FX_SAFE_SIZE_T segment_size = end_segment_offset;
-  segment_size -= offset;
-  if (!segment_size.IsValid()) {
+  const absl::optional<Segment> segment = GetCheckedSegment(offset, size);
+  if (!segment.has_value()) {
     NOTREACHED();
     return false;
   }
+  const size_t segment_size =
+      static_cast<size_t>(segment.value().second - offset);
+  if (IsDataRangeAvailable(offset, segment_size))
+    return true;
+
+  ScheduleDownload(offset, segment_size);
+  return false;
+}
 
-  if (IsDataRangeAvailable(offset, segment_size.ValueOrDie()))
+bool CPDF_ReadValidator::CheckDataRangesAndRequestIfUnavailable(
+    pdfium::span<const CPDF_DataAvail::DataRange> ranges) {
+  // Aligned segments to request.
+  std::vector<Segment> segments;
+  for (const CPDF_DataAvail::DataRange& range : ranges) {
+    if (range.offset < 0 || range.offset > file_size_)
+      continue;
+
+    const absl::optional<Segment> segment =
+        GetCheckedSegment(range.offset, range.size);
+    if (!segment.has_value()) {
+      NOTREACHED();
+      return false;
+    }
+    if (IsDataRangeAvailable(
+            range.offset,
+            static_cast<size_t>(segment.value().second - range.offset))) {
+      continue;
+    }
+    segments.push_back(GetAlignedSegment(segment.value()));
+  }
+  if (segments.empty())
     return true;
 
-  ScheduleDownload(offset, segment_size.ValueOrDie());
+  has_unavailable_data_ = true;
+  if (!hints_)
+    return false;
+
+  std::sort(segments.begin(), segments.end());
+  auto merged = segments.begin();
+  for (auto it = segments.begin() + 1; it != segments.end(); ++it) {
+    if (it->first <= merged->second) {
+      merged->second = std::max(merged->second, it->second);
+    } else {
+      ++merged;
+      *merged = *it;
+    }
+  }
+  segments.erase(merged + 1, segments.end());
+
+  for (const Segment& segment : segments)
+    RequestSegment(segment);
   return false;
 }
 
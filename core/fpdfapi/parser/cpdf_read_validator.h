@@ -5,11 +5,15 @@
 #ifndef CORE_FPDFAPI_PARSER_CPDF_READ_VALIDATOR_H_
 #define CORE_FPDFAPI_PARSER_CPDF_READ_VALIDATOR_H_
 
+#include <utility>
+
 #include "core/fpdfapi/parser/cpdf_data_avail.h"
 #include "core/fxcrt/fx_memory.h"
 #include "core/fxcrt/fx_stream.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/unowned_ptr.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+#include "third_party/base/containers/span.h"
 
 class CPDF_ReadValidator : public IFX_SeekableReadStream {
  public:
@@ -42,11 +46,19 @@ class CPDF_ReadValidator : public IFX_SeekableReadStream {
   void ResetErrors();
   bool IsWholeFileAvailable();
   bool CheckDataRangeAndRequestIfUnavailable(FX_FILESIZE offset, size_t size);
+
+  // Like CheckDataRangeAndRequestIfUnavailable() for each of `ranges`, but
+  // requests the unavailable ones sorted, with ranges that overlap or touch
+  // merged into one request.
+  bool CheckDataRangesAndRequestIfUnavailable(
+      pdfium::span<const CPDF_DataAvail::DataRange> ranges);
   bool CheckWholeFileAndRequestIfUnavailable();
 
   // IFX_SeekableReadStream overrides:
   bool ReadBlockAtOffset(pdfium::span<uint8_t> buffer,
                          FX_FILESIZE offset) override;
+  pdfium::span<const uint8_t> BorrowBlockAtOffset(FX_FILESIZE offset,
+                                                  size_t size) override;
   FX_FILESIZE GetSize() override;
 
  protected:
@@ -55,7 +67,21 @@ class CPDF_ReadValidator : public IFX_SeekableReadStream {
   ~CPDF_ReadValidator() override;
 
  private:
+  // Start and end offsets of a part of the file.
+  using Segment = std::pair<FX_FILESIZE, FX_FILESIZE>;
+
+  // Returns the segment that CheckDataRangeAndRequestIfUnavailable() checks
+  // for `size` bytes at `offset`, which includes what CPDF_SyntaxParser reads
+  // ahead. Returns absl::nullopt if its offsets or size overflow.
+  absl::optional<Segment> GetCheckedSegment(FX_FILESIZE offset,
+                                            size_t size) const;
+
+  // Returns the segment to download for `segment`, which is aligned to the
+  // download block size and ends at the end of the file at the latest.
+  Segment GetAlignedSegment(const Segment& segment) const;
+
   void ScheduleDownload(FX_FILESIZE offset, size_t size);
+  void RequestSegment(const Segment& segment);
   bool IsDataRangeAvailable(FX_FILESIZE offset, size_t size) const;
 
   RetainPtr<IFX_SeekableReadStream> const file_read_;
@@ -8,6 +8,7 @@
 
 #include <limits>
 #include <utility>
+#include <vector>
 
 #include "core/fxcrt/cfx_read_only_span_stream.h"
 #include "core/fxcrt/cfx_read_only_vector_stream.h"
@@ -53,16 +54,26 @@ class MockDownloadHints final : public CPDF_DataAvail::DownloadHints {
   void AddSegment(FX_FILESIZE offset, size_t size) override {
     last_requested_range_.first = offset;
     last_requested_range_.second = offset + size;
+    requested_ranges_.push_back(last_requested_range_);
   }
 
   const std::pair<FX_FILESIZE, FX_FILESIZE>& GetLastRequstedRange() const {
     return last_requested_range_;
   }
 
-  void Reset() { last_requested_range_ = MakeRange(0, 0); }
+  const std::vector<std::pair<FX_FILESIZE, FX_FILESIZE>>& GetRequestedRanges()
+      const {
+    return requested_ranges_;
+  }
+
+  void Reset() {
+    last_requested_range_ = MakeRange(0, 0);
+    requested_ranges_.clear();
+  }
 
  private:
   std::pair<FX_FILESIZE, FX_FILESIZE> last_requested_range_;
+  std::vector<std::pair<FX_FILESIZE, FX_FILESIZE>> requested_ranges_;
 };
 
 }  // namespace
@@ -296,3 +307,38 @@ TEST(ReadValidatorTest, CheckDataRangeAndRequestIfUnavailable) {
 
   validator->SetDownloadHints(nullptr);
 }
+
+TEST(ReadValidatorTest, CheckDataRangesAndRequestIfUnavailable) {
+  DataVector<uint8_t> test_data(kTestDataSize);
+  auto file =
+      pdfium::MakeRetain<CFX_ReadOnlyVectorStream>(std::move(test_data));
+  MockFileAvail file_avail;
+  file_avail.SetAvailableRange(4608, 5632);
+  auto validator =
+      pdfium::MakeRetain<CPDF_ReadValidator>(std::move(file), &file_avail);
+
+  MockDownloadHints hints;
+  validator->SetDownloadHints(&hints);
+
+  const CPDF_DataAvail::DataRange kRanges[] = {
+      {20000, 100}, {5000, 100}, {1000, 100}, {1600, 100}, {20100, 2000}};
+  EXPECT_FALSE(validator->CheckDataRangesAndRequestIfUnavailable(kRanges));
+  EXPECT_FALSE(validator->read_error());
+  EXPECT_TRUE(validator->has_unavailable_data());
+
+  // Unavailable ranges should be enlarged, aligned, sorted and merged. The
+  // available one should not be requested.
+  const std::vector<std::pair<FX_FILESIZE, FX_FILESIZE>> kExpectedRanges = {
+      MakeRange(512, 2560), MakeRange(19968, 23040)};
+  EXPECT_EQ(kExpectedRanges, hints.GetRequestedRanges());
+
+  hints.Reset();
+  validator->ResetErrors();
+  const CPDF_DataAvail::DataRange kAvailableRanges[] = {{5000, 100}};
+  EXPECT_TRUE(
+      validator->CheckDataRangesAndRequestIfUnavailable(kAvailableRanges));
+  EXPECT_TRUE(hints.GetRequestedRanges().empty());
+  EXPECT_FALSE(validator->has_unavailable_data());
+
+  validator->SetDownloadHints(nullptr);
+}
@@ -75,6 +75,7 @@ void CPDF_Stream::InitStreamFromFile(RetainPtr<IFX_SeekableReadStream> pFile,
                                      RetainPtr<CPDF_Dictionary> pDict) {
   data_ = pFile;
   dict_ = std::move(pDict);
+  ++data_version_;
   SetLengthInDict(pdfium::base::checked_cast<int>(pFile->GetSize()));
 }
 
@@ -125,6 +126,7 @@ void CPDF_Stream::SetData(pdfium::span<const uint8_t> pData) {
 void CPDF_Stream::TakeData(DataVector<uint8_t> data) {
   const size_t size = data.size();
   data_ = std::move(data);
+  ++data_version_;
   SetLengthInDict(pdfium::base::checked_cast<int>(size));
 }
 
@@ -150,6 +152,16 @@ DataVector<uint8_t> CPDF_Stream::ReadAllRawData() const {
   return result;
 }
 
+RetainPtr<IFX_SeekableReadStream> CPDF_Stream::GetBorrowableFile() const {
+  CHECK(IsFileBased());
+
+  auto underlying_stream = absl::get<RetainPtr<IFX_SeekableReadStream>>(data_);
+  if (underlying_stream->BorrowBlockAtOffset(0, GetRawSize()).empty())
+    return nullptr;
+
+  return underlying_stream;
+}
+
 bool CPDF_Stream::HasFilter() const {
   return dict_ && dict_->KeyExist("Filter");
 }
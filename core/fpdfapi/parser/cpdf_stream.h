@@ -58,6 +58,12 @@ class CPDF_Stream final : public CPDF_Object {
   // Can only be called when a stream is not memory-based.
   DataVector<uint8_t> ReadAllRawData() const;
 
+  // Can only be called when a stream is file-based. Returns the file if it can
+  // lend out the raw data without copying, e.g. because it is memory-mapped,
+  // or nullptr otherwise. Like GetInMemoryRawData(), this is meant to be used
+  // by CPDF_StreamAcc only.
+  RetainPtr<IFX_SeekableReadStream> GetBorrowableFile() const;
+
   bool IsUninitialized() const {
     return absl::holds_alternative<absl::monostate>(data_);
   }
@@ -69,6 +75,10 @@ class CPDF_Stream final : public CPDF_Object {
   }
   bool HasFilter() const;
 
+  // Changes whenever the data gets replaced, so holders of data decoded from
+  // this stream can tell that it is out of date.
+  uint32_t GetDataVersion() const { return data_version_; }
+
  private:
   friend class CPDF_Dictionary;
 
@@ -93,6 +103,7 @@ class CPDF_Stream final : public CPDF_Object {
                 DataVector<uint8_t>>
       data_;
   RetainPtr<CPDF_Dictionary> dict_;
+  uint32_t data_version_ = 0;
 };
 
 inline CPDF_Stream* ToStream(CPDF_Object* obj) {
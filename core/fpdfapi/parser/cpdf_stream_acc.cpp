@@ -6,14 +6,51 @@
 
 #include "core/fpdfapi/parser/cpdf_stream_acc.h"
 
+#include <algorithm>
+#include <memory>
 #include <utility>
 
 #include "core/fdrm/fx_crypt.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_stream.h"
 #include "core/fpdfapi/parser/fpdf_parser_decode.h"
+#include "core/fxcodec/streaming_decoder.h"
 #include "core/fxcrt/data_vector.h"
+#include "core/fxcrt/fx_stream.h"
 #include "third_party/base/check_op.h"
+#include "third_party/base/numerics/safe_conversions.h"
+
+namespace {
+
+// Copies `decoder_array` without sharing any strings or objects with it, as
+// their ref-counting is not thread-safe.
+DecoderArray CopyDecoderArray(const DecoderArray& decoder_array) {
+  DecoderArray copy;
+  for (const auto& decoder : decoder_array) {
+    copy.emplace_back(
+        ByteString(decoder.first.AsStringView()),
+        decoder.second ? decoder.second->CloneDirectObject() : nullptr);
+  }
+  return copy;
+}
+
+}  // namespace
+
+struct CPDF_StreamAcc::PendingDecode {
+  uint32_t estimated_size = 0;
+  bool bImageAcc = false;
+  absl::variant<pdfium::span<const uint8_t>, DataVector<uint8_t>> src_data;
+  pdfium::span<const uint8_t> src_span;
+  // Empty if there is nothing to decode.
+  DecoderArray decoder_array;
+  // What `decoder_array` is a copy of, if it is one.
+  DecoderArray original_decoder_array;
+  bool bDecoded = false;
+  std::unique_ptr<uint8_t, FxFreeDeleter> pDecodedData;
+  uint32_t dwDecodedSize = 0;
+  ByteString image_decoder;
+  RetainPtr<const CPDF_Dictionary> pImageParam;
+};
 
 CPDF_StreamAcc::CPDF_StreamAcc(RetainPtr<const CPDF_Stream> pStream)
     : m_pStream(std::move(pStream)) {}
@@ -55,6 +92,18 @@ void CPDF_StreamAcc::LoadAllDataRaw() {
   LoadAllData(true, 0, false);
 }
 
+void CPDF_StreamAcc::StartLoadFiltered(uint32_t estimated_size) {
+  if (!m_pStream)
+    return;
+
+  if (!m_pStream->HasFilter()) {
+    ProcessRawData();
+    return;
+  }
+  PrepareFilteredData(estimated_size, /*bImageAcc=*/false,
+                      /*bCopyFilters=*/true);
+}
+
 RetainPtr<const CPDF_Stream> CPDF_StreamAcc::GetStream() const {
   return m_pStream;
 }
@@ -76,6 +125,8 @@ pdfium::span<const uint8_t> CPDF_StreamAcc::GetSpan() const {
     return absl::get<DataVector<uint8_t>>(m_Data);
   if (m_pStream && m_pStream->IsMemoryBased())
     return m_pStream->GetInMemoryRawData();
+  if (m_pBorrowedFile)
+    return absl::get<pdfium::span<const uint8_t>>(m_Data);
   return {};
 }
 
@@ -98,6 +149,19 @@ DataVector<uint8_t> CPDF_StreamAcc::DetachData() {
   return DataVector<uint8_t>(span.begin(), span.end());
 }
 
+std::unique_ptr<fxcodec::StreamingDecoder>
+CPDF_StreamAcc::CreateStreamingDecoder() const {
+  if (!m_pStream)
+    return nullptr;
+
+  absl::optional<DecoderArray> decoder_array =
+      GetDecoderArray(m_pStream->GetDict());
+  if (!decoder_array.has_value())
+    return nullptr;
+
+  return ::CreateStreamingDecoder(GetSpan(), decoder_array.value());
+}
+
 void CPDF_StreamAcc::ProcessRawData() {
   if (m_pStream->IsUninitialized())
     return;
@@ -111,6 +175,12 @@ void CPDF_StreamAcc::ProcessRawData() {
     return;
   }
 
+  pdfium::span<const uint8_t> borrowed = BorrowRawStream();
+  if (!borrowed.empty()) {
+    m_Data = borrowed;
+    return;
+  }
+
   DataVector<uint8_t> data = ReadRawStream();
   if (data.empty())
     return;
@@ -120,6 +190,14 @@ void CPDF_StreamAcc::ProcessRawData() {
 
 void CPDF_StreamAcc::ProcessFilteredData(uint32_t estimated_size,
                                          bool bImageAcc) {
+  PrepareFilteredData(estimated_size, bImageAcc, /*bCopyFilters=*/false);
+  DecodeFiltered();
+  FinishLoadFiltered();
+}
+
+void CPDF_StreamAcc::PrepareFilteredData(uint32_t estimated_size,
+                                         bool bImageAcc,
+                                         bool bCopyFilters) {
   if (m_pStream->IsUninitialized())
     return;
 
@@ -127,40 +205,86 @@ void CPDF_StreamAcc::ProcessFilteredData(uint32_t estimated_size,
   if (dwSrcSize == 0)
     return;
 
-  absl::variant<pdfium::span<const uint8_t>, DataVector<uint8_t>> src_data;
-  pdfium::span<const uint8_t> src_span;
+  auto pending = std::make_unique<PendingDecode>();
   if (m_pStream->IsMemoryBased()) {
-    src_span = m_pStream->GetInMemoryRawData();
-    src_data = src_span;
+    pending->src_span = m_pStream->GetInMemoryRawData();
+    pending->src_data = pending->src_span;
   } else {
-    DataVector<uint8_t> temp_src_data = ReadRawStream();
-    if (temp_src_data.empty())
-      return;
+    pending->src_span = BorrowRawStream();
+    if (!pending->src_span.empty()) {
+      pending->src_data = pending->src_span;
+    } else {
+      DataVector<uint8_t> temp_src_data = ReadRawStream();
+      if (temp_src_data.empty())
+        return;
+
+      pending->src_span = pdfium::make_span(temp_src_data);
+      pending->src_data = std::move(temp_src_data);
+    }
+  }
 
-    src_span = pdfium::make_span(temp_src_data);
-    src_data = std::move(temp_src_data);
+  RetainPtr<const CPDF_Dictionary> pDict = m_pStream->GetDict();
+  if (!estimated_size) {
+    // The decoded length the stream declares only sizes buffers, so it does
+    // not matter if it is wrong.
+    estimated_size = pdfium::base::saturated_cast<uint32_t>(
+        std::max(pDict->GetIntegerFor("DL"), 0));
+  }
+  pending->estimated_size = estimated_size;
+  pending->bImageAcc = bImageAcc;
+
+  absl::optional<DecoderArray> decoder_array = GetDecoderArray(pDict);
+  if (decoder_array.has_value()) {
+    if (bCopyFilters) {
+      pending->decoder_array = CopyDecoderArray(decoder_array.value());
+      pending->original_decoder_array = std::move(decoder_array.value());
+    } else {
+      pending->decoder_array = std::move(decoder_array.value());
+    }
   }
+  m_pPendingDecode = std::move(pending);
+}
 
-  std::unique_ptr<uint8_t, FxFreeDeleter> pDecodedData;
-  uint32_t dwDecodedSize = 0;
+void CPDF_StreamAcc::DecodeFiltered() {
+  PendingDecode* pending = m_pPendingDecode.get();
+  if (!pending || pending->decoder_array.empty())
+    return;
 
-  absl::optional<DecoderArray> decoder_array =
-      GetDecoderArray(m_pStream->GetDict());
-  if (!decoder_array.has_value() || decoder_array.value().empty() ||
-      !PDF_DataDecode(src_span, estimated_size, bImageAcc,
-                      decoder_array.value(), &pDecodedData, &dwDecodedSize,
-                      &m_ImageDecoder, &m_pImageParam)) {
-    m_Data = std::move(src_data);
+  pending->bDecoded = PDF_DataDecode(
+      pending->src_span, pending->estimated_size, pending->bImageAcc,
+      pending->decoder_array, &pending->pDecodedData, &pending->dwDecodedSize,
+      &pending->image_decoder, &pending->pImageParam);
+}
+
+void CPDF_StreamAcc::FinishLoadFiltered() {
+  std::unique_ptr<PendingDecode> pending = std::move(m_pPendingDecode);
+  if (!pending)
+    return;
+
+  if (!pending->bDecoded) {
+    m_Data = std::move(pending->src_data);
     return;
   }
 
-  if (pDecodedData) {
-    DCHECK_NE(pDecodedData.get(), src_span.data());
+  m_ImageDecoder = std::move(pending->image_decoder);
+  m_pImageParam = std::move(pending->pImageParam);
+  for (size_t i = 0; i < pending->original_decoder_array.size(); ++i) {
+    // Hand out the stream's own parameters, not the copy.
+    if (m_pImageParam &&
+        pending->decoder_array[i].second.Get() == m_pImageParam.Get()) {
+      m_pImageParam = pending->original_decoder_array[i].second->GetDict();
+      break;
+    }
+  }
+
+  if (pending->pDecodedData) {
+    DCHECK_NE(pending->pDecodedData.get(), pending->src_span.data());
     // TODO(crbug.com/pdfium/1872): Avoid copying.
-    m_Data = DataVector<uint8_t>(pDecodedData.get(),
-                                 pDecodedData.get() + dwDecodedSize);
+    m_Data = DataVector<uint8_t>(
+        pending->pDecodedData.get(),
+        pending->pDecodedData.get() + pending->dwDecodedSize);
   } else {
-    m_Data = std::move(src_data);
+    m_Data = std::move(pending->src_data);
   }
 }
 
@@ -169,3 +293,16 @@ DataVector<uint8_t> CPDF_StreamAcc::ReadRawStream() const {
   DCHECK(m_pStream->IsFileBased());
   return m_pStream->ReadAllRawData();
 }
+
+pdfium::span<const uint8_t> CPDF_StreamAcc::BorrowRawStream() {
+  DCHECK(m_pStream);
+  DCHECK(m_pStream->IsFileBased());
+  RetainPtr<IFX_SeekableReadStream> file = m_pStream->GetBorrowableFile();
+  if (!file)
+    return {};
+
+  pdfium::span<const uint8_t> borrowed =
+      file->BorrowBlockAtOffset(0, m_pStream->GetRawSize());
+  m_pBorrowedFile = std::move(file);
+  return borrowed;
+}
@@ -19,6 +19,11 @@
 
 class CPDF_Dictionary;
 class CPDF_Stream;
+class IFX_SeekableReadStream;
+
+namespace fxcodec {
+class StreamingDecoder;
+}
 
 class CPDF_StreamAcc final : public Retainable {
  public:
@@ -32,6 +37,16 @@ class CPDF_StreamAcc final : public Retainable {
   void LoadAllDataImageAcc(uint32_t estimated_size);
   void LoadAllDataRaw();
 
+  // Same as LoadAllDataFilteredWithEstimatedSize(), in steps, so that the
+  // decoding can run on another thread. StartLoadFiltered() and
+  // FinishLoadFiltered() use the stream and its document, so they must run
+  // where those are used. DecodeFiltered() only uses copies that
+  // StartLoadFiltered() made, so it may run on any thread in between, as long
+  // as nothing else uses this object meanwhile.
+  void StartLoadFiltered(uint32_t estimated_size);
+  void DecodeFiltered();
+  void FinishLoadFiltered();
+
   RetainPtr<const CPDF_Stream> GetStream() const;
   RetainPtr<const CPDF_Dictionary> GetImageParam() const;
 
@@ -42,19 +57,39 @@ class CPDF_StreamAcc final : public Retainable {
   ByteString GetImageDecoder() const { return m_ImageDecoder; }
   DataVector<uint8_t> DetachData();
 
+  // Returns a decoder for the stream's filtered data, which decodes it as it
+  // gets read, instead of all at once. Must be called after LoadAllDataRaw(),
+  // and must not outlive this object. Returns nullptr if the stream has an
+  // image filter, or filters that are not valid.
+  std::unique_ptr<fxcodec::StreamingDecoder> CreateStreamingDecoder() const;
+
   int GetLength1ForTest() const;
 
  private:
   explicit CPDF_StreamAcc(RetainPtr<const CPDF_Stream> pStream);
   ~CPDF_StreamAcc() override;
 
+  // The state of a load between StartLoadFiltered() and FinishLoadFiltered().
+  struct PendingDecode;
+
   void LoadAllData(bool bRawAccess, uint32_t estimated_size, bool bImageAcc);
   void ProcessRawData();
   void ProcessFilteredData(uint32_t estimated_size, bool bImageAcc);
+  // Sets up `m_pPendingDecode`, if there is anything to decode. With
+  // `bCopyFilters`, the filters and their parameters get copied, so that
+  // DecodeFiltered() can use them on another thread.
+  void PrepareFilteredData(uint32_t estimated_size,
+                           bool bImageAcc,
+                           bool bCopyFilters);
 
   // Returns the raw data from `m_pStream`, or no data on failure.
   DataVector<uint8_t> ReadRawStream() const;
 
+  // Returns a view of the raw data of file-based `m_pStream` if its file can
+  // lend it out, and keeps the file alive in `m_pBorrowedFile`. Otherwise
+  // returns an empty span.
+  pdfium::span<const uint8_t> BorrowRawStream();
+
   bool is_owned() const {
     return absl::holds_alternative<DataVector<uint8_t>>(m_Data);
   }
@@ -63,7 +98,10 @@ class CPDF_StreamAcc final : public Retainable {
   RetainPtr<const CPDF_Dictionary> m_pImageParam;
   // Needs to outlive `m_Data` when the data is not owned.
   RetainPtr<const CPDF_Stream> const m_pStream;
+  // Needs to outlive `m_Data` when the data is borrowed from the file.
+  RetainPtr<IFX_SeekableReadStream> m_pBorrowedFile;
   absl::variant<pdfium::span<const uint8_t>, DataVector<uint8_t>> m_Data;
+  std::unique_ptr<PendingDecode> m_pPendingDecode;
 };
 
 #endif  // CORE_FPDFAPI_PARSER_CPDF_STREAM_ACC_H_
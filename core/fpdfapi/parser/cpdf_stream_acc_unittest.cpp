@@ -5,10 +5,15 @@
 #include "core/fpdfapi/parser/cpdf_stream_acc.h"
 
 #include <algorithm>
+#include <thread>
 #include <utility>
 
+#include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_name.h"
+#include "core/fpdfapi/parser/cpdf_number.h"
 #include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fxcodec/flate/flatemodule.h"
 #include "core/fxcrt/fx_stream.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/invalid_seekable_read_stream.h"
@@ -36,3 +41,66 @@ TEST(StreamAccTest, DataStreamLifeTime) {
   EXPECT_TRUE(
       std::equal(std::begin(kData), std::end(kData), span.begin(), span.end()));
 }
+
+// /DL only sizes buffers, so any value must give the same data.
+TEST(StreamAccTest, DecodedLengthHint) {
+  constexpr uint8_t kData[] = "BT /F1 12 Tf 72 712 Td (Hello) Tj ET";
+  for (int length : {-1, 0, 1, 36, 37, 1000000, 2000000000}) {
+    auto dict = pdfium::MakeRetain<CPDF_Dictionary>();
+    dict->SetNewFor<CPDF_Name>("Filter", "FlateDecode");
+    dict->SetNewFor<CPDF_Number>("DL", length);
+    auto stream = pdfium::MakeRetain<CPDF_Stream>(FlateModule::Encode(kData),
+                                                  std::move(dict));
+    auto stream_acc = pdfium::MakeRetain<CPDF_StreamAcc>(std::move(stream));
+    stream_acc->LoadAllDataFiltered();
+    auto span = stream_acc->GetSpan();
+    EXPECT_TRUE(std::equal(std::begin(kData), std::end(kData), span.begin(),
+                           span.end()))
+        << " for /DL " << length;
+  }
+}
+
+// Loading in steps, with the decoding on another thread, gives the same data
+// as loading at once.
+TEST(StreamAccTest, LoadFilteredInSteps) {
+  constexpr uint8_t kData[] = "48656C6C6F20776F726C64>";
+  constexpr uint8_t kDecoded[] = "Hello world";
+  auto dict = pdfium::MakeRetain<CPDF_Dictionary>();
+  auto filters = dict->SetNewFor<CPDF_Array>("Filter");
+  filters->AppendNew<CPDF_Name>("ASCIIHexDecode");
+  filters->AppendNew<CPDF_Name>("Crypt");
+  auto params = dict->SetNewFor<CPDF_Array>("DecodeParms");
+  params->AppendNew<CPDF_Dictionary>();
+  params->AppendNew<CPDF_Dictionary>()->SetNewFor<CPDF_Name>("Name",
+                                                             "Identity");
+  auto stream = pdfium::MakeRetain<CPDF_Stream>(
+      DataVector<uint8_t>(std::begin(kData), std::end(kData) - 1),
+      std::move(dict));
+
+  auto stream_acc = pdfium::MakeRetain<CPDF_StreamAcc>(stream);
+  stream_acc->StartLoadFiltered(0);
+  std::thread([&stream_acc] { stream_acc->DecodeFiltered(); }).join();
+  stream_acc->FinishLoadFiltered();
+  auto span = stream_acc->GetSpan();
+  EXPECT_TRUE(std::equal(std::begin(kDecoded), std::end(kDecoded) - 1,
+                         span.begin(), span.end()));
+
+  auto expected_acc = pdfium::MakeRetain<CPDF_StreamAcc>(stream);
+  expected_acc->LoadAllDataFiltered();
+  EXPECT_TRUE(std::equal(span.begin(), span.end(),
+                         expected_acc->GetSpan().begin(),
+                         expected_acc->GetSpan().end()));
+}
+
+TEST(StreamAccTest, LoadFilteredInStepsWithoutFilter) {
+  constexpr uint8_t kData[] = {'a', 'b', 'c'};
+  auto stream = pdfium::MakeRetain<CPDF_Stream>();
+  stream->SetData(kData);
+  auto stream_acc = pdfium::MakeRetain<CPDF_StreamAcc>(std::move(stream));
+  stream_acc->StartLoadFiltered(0);
+  stream_acc->DecodeFiltered();
+  stream_acc->FinishLoadFiltered();
+  auto span = stream_acc->GetSpan();
+  EXPECT_TRUE(
+      std::equal(std::begin(kData), std::end(kData), span.begin(), span.end()));
+}
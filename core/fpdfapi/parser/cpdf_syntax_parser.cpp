@@ -7,6 +7,7 @@
 #include "core/fpdfapi/parser/cpdf_syntax_parser.h"
 
 #include <ctype.h>
+#include <string.h>
 
 #include <algorithm>
 #include <utility>
@@ -25,11 +26,13 @@
 #include "core/fpdfapi/parser/fpdf_parser_utility.h"
 #include "core/fxcrt/autorestorer.h"
 #include "core/fxcrt/cfx_read_only_vector_stream.h"
+#include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fixed_uninit_data_vector.h"
 #include "core/fxcrt/fx_extension.h"
 #include "core/fxcrt/fx_safe_types.h"
 #include "third_party/base/check.h"
 #include "third_party/base/check_op.h"
+#include "third_party/base/numerics/safe_conversions.h"
 
 namespace {
 
@@ -65,6 +68,16 @@ class ReadableSubStream final : public IFX_SeekableReadStream {
     return m_pFileRead->ReadBlockAtOffset(buffer, m_PartOffset + offset);
   }
 
+  pdfium::span<const uint8_t> BorrowBlockAtOffset(FX_FILESIZE offset,
+                                                  size_t size) override {
+    FX_SAFE_FILESIZE safe_end = offset;
+    safe_end += size;
+    if (offset < 0 || !safe_end.IsValid() || safe_end.ValueOrDie() > m_PartSize)
+      return {};
+
+    return m_pFileRead->BorrowBlockAtOffset(m_PartOffset + offset, size);
+  }
+
   FX_FILESIZE GetSize() override { return m_PartSize; }
 
  private:
@@ -76,7 +89,7 @@ class ReadableSubStream final : public IFX_SeekableReadStream {
 }  // namespace
 
 // static
-int CPDF_SyntaxParser::s_CurrentRecursionDepth = 0;
+thread_local int CPDF_SyntaxParser::s_CurrentRecursionDepth = 0;
 
 // static
 std::unique_ptr<CPDF_SyntaxParser> CPDF_SyntaxParser::CreateForTesting(
@@ -113,6 +126,21 @@ bool CPDF_SyntaxParser::GetCharAt(FX_FILESIZE pos, uint8_t& ch) {
 bool CPDF_SyntaxParser::ReadBlockAt(FX_FILESIZE read_pos) {
   if (read_pos >= m_FileLen)
     return false;
+
+  // If the whole file can be borrowed, e.g. because it is memory-mapped, view
+  // all of it at once. Then IsPositionRead() always succeeds and there is
+  // nothing left to copy or refill.
+  if (pdfium::base::IsValueInRangeForNumericType<size_t>(m_FileLen)) {
+    pdfium::span<const uint8_t> borrowed = m_pFileAccess->BorrowBlockAtOffset(
+        0, static_cast<size_t>(m_FileLen));
+    if (!borrowed.empty()) {
+      m_pFileBuf.clear();
+      m_FileView = borrowed;
+      m_BufOffset = 0;
+      return true;
+    }
+  }
+
   size_t read_size = m_ReadBufferSize;
   FX_SAFE_FILESIZE safe_end = read_pos;
   safe_end += read_size;
@@ -122,9 +150,11 @@ bool CPDF_SyntaxParser::ReadBlockAt(FX_FILESIZE read_pos) {
   m_pFileBuf.resize(read_size);
   if (!m_pFileAccess->ReadBlockAtOffset(m_pFileBuf, read_pos)) {
     m_pFileBuf.clear();
+    m_FileView = {};
     return false;
   }
 
+  m_FileView = m_pFileBuf;
   m_BufOffset = read_pos;
   return true;
 }
@@ -137,11 +167,22 @@ bool CPDF_SyntaxParser::GetNextChar(uint8_t& ch) {
   if (!IsPositionRead(pos) && !ReadBlockAt(pos))
     return false;
 
-  ch = m_pFileBuf[pos - m_BufOffset];
+  ch = m_FileView[pos - m_BufOffset];
   m_Pos++;
   return true;
 }
 
+pdfium::span<const uint8_t> CPDF_SyntaxParser::GetBufferedBytes() {
+  FX_FILESIZE pos = m_Pos + m_HeaderOffset;
+  if (pos >= m_FileLen)
+    return {};
+
+  if (!IsPositionRead(pos) && !ReadBlockAt(pos))
+    return {};
+
+  return m_FileView.subspan(static_cast<size_t>(pos - m_BufOffset));
+}
+
 FX_FILESIZE CPDF_SyntaxParser::GetDocumentSize() const {
   return m_FileLen - m_HeaderOffset;
 }
@@ -158,7 +199,7 @@ bool CPDF_SyntaxParser::GetCharAtBackward(FX_FILESIZE pos, uint8_t* ch) {
     if (!ReadBlockAt(block_start) || !IsPositionRead(pos))
       return false;
   }
-  *ch = m_pFileBuf[pos - m_BufOffset];
+  *ch = m_FileView[pos - m_BufOffset];
   return true;
 }
 
@@ -184,16 +225,19 @@ CPDF_SyntaxParser::WordType CPDF_SyntaxParser::GetNextWordInternal() {
     m_WordBuffer[m_WordSize++] = ch;
     if (ch == '/') {
       while (true) {
-        if (!GetNextChar(ch))
+        pdfium::span<const uint8_t> bytes = GetBufferedBytes();
+        if (bytes.empty())
           return word_type;
 
-        if (!PDFCharIsOther(ch) && !PDFCharIsNumeric(ch)) {
-          m_Pos--;
-          return word_type;
+        for (size_t i = 0; i < bytes.size(); ++i) {
+          if (!PDFCharIsOther(bytes[i]) && !PDFCharIsNumeric(bytes[i])) {
+            m_Pos += i;
+            return word_type;
+          }
+          if (m_WordSize < sizeof(m_WordBuffer) - 1)
+            m_WordBuffer[m_WordSize++] = bytes[i];
         }
-
-        if (m_WordSize < sizeof(m_WordBuffer) - 1)
-          m_WordBuffer[m_WordSize++] = ch;
+        m_Pos += bytes.size();
       }
     } else if (ch == '<') {
       if (!GetNextChar(ch))
@@ -215,22 +259,28 @@ CPDF_SyntaxParser::WordType CPDF_SyntaxParser::GetNextWordInternal() {
     return word_type;
   }
 
-  while (true) {
-    if (m_WordSize < sizeof(m_WordBuffer) - 1)
-      m_WordBuffer[m_WordSize++] = ch;
-
-    if (!PDFCharIsNumeric(ch))
-      word_type = WordType::kWord;
+  m_WordBuffer[m_WordSize++] = ch;
+  if (!PDFCharIsNumeric(ch))
+    word_type = WordType::kWord;
 
-    if (!GetNextChar(ch))
+  while (true) {
+    pdfium::span<const uint8_t> bytes = GetBufferedBytes();
+    if (bytes.empty())
       return word_type;
 
-    if (PDFCharIsDelimiter(ch) || PDFCharIsWhitespace(ch)) {
-      m_Pos--;
-      break;
+    for (size_t i = 0; i < bytes.size(); ++i) {
+      const uint8_t byte = bytes[i];
+      if (PDFCharIsDelimiter(byte) || PDFCharIsWhitespace(byte)) {
+        m_Pos += i;
+        return word_type;
+      }
+      if (m_WordSize < sizeof(m_WordBuffer) - 1)
+        m_WordBuffer[m_WordSize++] = byte;
+      if (!PDFCharIsNumeric(byte))
+        word_type = WordType::kWord;
     }
+    m_Pos += bytes.size();
   }
-  return word_type;
 }
 
 ByteString CPDF_SyntaxParser::ReadString() {
@@ -320,49 +370,63 @@ ByteString CPDF_SyntaxParser::ReadString() {
 }
 
 ByteString CPDF_SyntaxParser::ReadHexString() {
-  uint8_t ch;
-  if (!GetNextChar(ch))
-    return ByteString();
-
-  ByteString buf;
+  DataVector<uint8_t> buf;
   bool bFirst = true;
   uint8_t code = 0;
   while (true) {
-    if (ch == '>')
+    pdfium::span<const uint8_t> bytes = GetBufferedBytes();
+    if (bytes.empty())
       break;
 
-    if (isxdigit(ch)) {
+    // Decode up to the closing '>', which gets consumed as well.
+    const auto* end =
+        static_cast<const uint8_t*>(memchr(bytes.data(), '>', bytes.size()));
+    const size_t length = end ? end - bytes.data() : bytes.size();
+    for (const uint8_t ch : bytes.first(length)) {
+      if (!isxdigit(ch))
+        continue;
+
       int val = FXSYS_HexCharToInt(ch);
       if (bFirst) {
         code = val * 16;
       } else {
         code += val;
-        buf += static_cast<char>(code);
+        buf.push_back(code);
       }
       bFirst = !bFirst;
     }
-
-    if (!GetNextChar(ch))
+    m_Pos += length;
+    if (end) {
+      m_Pos++;
       break;
+    }
   }
   if (!bFirst)
-    buf += static_cast<char>(code);
+    buf.push_back(code);
 
-  return buf;
+  return ByteString(buf.data(), buf.size());
 }
 
 void CPDF_SyntaxParser::ToNextLine() {
-  uint8_t ch;
-  while (GetNextChar(ch)) {
-    if (ch == '\n')
-      break;
+  while (true) {
+    pdfium::span<const uint8_t> bytes = GetBufferedBytes();
+    if (bytes.empty())
+      return;
 
-    if (ch == '\r') {
-      GetNextChar(ch);
-      if (ch != '\n')
-        --m_Pos;
-      break;
+    for (size_t i = 0; i < bytes.size(); ++i) {
+      if (bytes[i] == '\n') {
+        m_Pos += i + 1;
+        return;
+      }
+      if (bytes[i] == '\r') {
+        m_Pos += i + 1;
+        uint8_t ch;
+        if (!GetNextChar(ch) || ch != '\n')
+          --m_Pos;
+        return;
+      }
     }
+    m_Pos += bytes.size();
   }
 }
 
@@ -372,27 +436,27 @@ void CPDF_SyntaxParser::ToNextWord() {
     return;
   }
 
-  uint8_t ch;
-  if (!GetNextChar(ch))
-    return;
-
+  bool in_comment = false;
   while (true) {
-    while (PDFCharIsWhitespace(ch)) {
-      if (!GetNextChar(ch))
-        return;
-    }
-
-    if (ch != '%')
-      break;
+    pdfium::span<const uint8_t> bytes = GetBufferedBytes();
+    if (bytes.empty())
+      return;
 
-    while (true) {
-      if (!GetNextChar(ch))
-        return;
-      if (PDFCharIsLineEnding(ch))
+    size_t i = 0;
+    for (; i < bytes.size(); ++i) {
+      if (in_comment) {
+        // Skip the comment, up to and including the line ending.
+        in_comment = !PDFCharIsLineEnding(bytes[i]);
+      } else if (bytes[i] == '%') {
+        in_comment = true;
+      } else if (!PDFCharIsWhitespace(bytes[i])) {
         break;
+      }
     }
+    m_Pos += i;
+    if (i < bytes.size())
+      return;
   }
-  m_Pos--;
 }
 
 // A state machine which goes % -> E -> O -> F -> line ending.
@@ -553,8 +617,7 @@ RetainPtr<CPDF_Object> CPDF_SyntaxParser::GetObjectBodyInternal(
         PDF_NameDecode(ByteStringView(m_WordBuffer + 1, m_WordSize - 1)));
   }
   if (word == "<<") {
-    RetainPtr<CPDF_Dictionary> pDict =
-        pdfium::MakeRetain<CPDF_Dictionary>(m_pPool);
+    CPDF_Dictionary::DictMap entries;
     while (true) {
       WordResult inner_word_result = GetNextWord();
       const ByteString& inner_word = inner_word_result.word;
@@ -588,9 +651,11 @@ RetainPtr<CPDF_Object> CPDF_SyntaxParser::GetObjectBodyInternal(
 
       // `key` has to be "/X" at the minimum.
       if (key.GetLength() > 1) {
-        pDict->SetFor(key.Substr(1), std::move(pObj));
+        entries.emplace_back(key.Substr(1), std::move(pObj));
       }
     }
+    auto pDict = pdfium::MakeRetain<CPDF_Dictionary>(m_pPool);
+    pDict->SetEntries(std::move(entries));
 
     AutoRestorer<FX_FILESIZE> pos_restorer(&m_Pos);
     if (GetNextWord().word != "stream")
@@ -786,18 +851,26 @@ RetainPtr<CPDF_Stream> CPDF_SyntaxParser::ReadStream(
 
   RetainPtr<CPDF_Stream> pStream;
   if (substream) {
-    // It is unclear from CPDF_SyntaxParser's perspective what object
-    // `substream` is ultimately holding references to. To avoid unexpectedly
-    // changing object lifetimes by handing `substream` to `pStream`, make a
-    // copy of the data here.
-    FixedUninitDataVector<uint8_t> data(substream->GetSize());
-    bool did_read = substream->ReadBlockAtOffset(data.writable_span(), 0);
-    CHECK(did_read);
-    auto data_as_stream =
-        pdfium::MakeRetain<CFX_ReadOnlyVectorStream>(std::move(data));
-
+    const size_t substream_size =
+        pdfium::base::checked_cast<size_t>(substream->GetSize());
     pStream = pdfium::MakeRetain<CPDF_Stream>();
-    pStream->InitStreamFromFile(std::move(data_as_stream), std::move(pDict));
+    if (!substream->BorrowBlockAtOffset(0, substream_size).empty()) {
+      // The file lends out its storage, so reference the raw data in place.
+      // This only happens when nothing but the file itself is kept alive by
+      // `substream`, see CPDF_ReadValidator::BorrowBlockAtOffset().
+      pStream->InitStreamFromFile(std::move(substream), std::move(pDict));
+    } else {
+      // It is unclear from CPDF_SyntaxParser's perspective what object
+      // `substream` is ultimately holding references to. To avoid
+      // unexpectedly changing object lifetimes by handing `substream` to
+      // `pStream`, make a copy of the data here.
+      FixedUninitDataVector<uint8_t> data(substream_size);
+      bool did_read = substream->ReadBlockAtOffset(data.writable_span(), 0);
+      CHECK(did_read);
+      auto data_as_stream =
+          pdfium::MakeRetain<CFX_ReadOnlyVectorStream>(std::move(data));
+      pStream->InitStreamFromFile(std::move(data_as_stream), std::move(pDict));
+    }
   } else {
     DCHECK(!len);
     pStream = pdfium::MakeRetain<CPDF_Stream>(std::move(pDict));
@@ -904,6 +977,21 @@ FX_FILESIZE CPDF_SyntaxParser::FindTag(ByteStringView tag) {
 
   int32_t match = 0;
   while (true) {
+    if (match == 0) {
+      // Skip ahead to the next byte that can start `tag` in bulk.
+      pdfium::span<const uint8_t> bytes = GetBufferedBytes();
+      if (bytes.empty())
+        return -1;
+
+      const auto* start = static_cast<const uint8_t*>(
+          memchr(bytes.data(), tag[0], bytes.size()));
+      if (!start) {
+        m_Pos += bytes.size();
+        continue;
+      }
+      m_Pos += start - bytes.data();
+    }
+
     uint8_t ch;
     if (!GetNextChar(ch))
       return -1;
@@ -920,5 +1008,5 @@ FX_FILESIZE CPDF_SyntaxParser::FindTag(ByteStringView tag) {
 
 bool CPDF_SyntaxParser::IsPositionRead(FX_FILESIZE pos) const {
   return m_BufOffset <= pos &&
-         pos < static_cast<FX_FILESIZE>(m_BufOffset + m_pFileBuf.size());
+         pos < static_cast<FX_FILESIZE>(m_BufOffset + m_FileView.size());
 }
@@ -50,6 +50,7 @@ class CPDF_SyntaxParser {
     m_ReadBufferSize = read_buffer_size;
   }
 
+  FX_FILESIZE GetHeaderOffset() const { return m_HeaderOffset; }
   FX_FILESIZE GetPos() const { return m_Pos; }
   void SetPos(FX_FILESIZE pos);
 
@@ -94,9 +95,14 @@ class CPDF_SyntaxParser {
   friend class cpdf_syntax_parser_ReadHexString_Test;
 
   static constexpr int kParserMaxRecursionDepth = 64;
-  static int s_CurrentRecursionDepth;
+  static thread_local int s_CurrentRecursionDepth;
 
   bool ReadBlockAt(FX_FILESIZE read_pos);
+  // Returns the read bytes from the current position on, reading the block at
+  // the current position first if needed. Lets callers scan many bytes at once
+  // instead of calling GetNextChar() for each one. Returns an empty span at
+  // the end of the file, or if the data is not available.
+  pdfium::span<const uint8_t> GetBufferedBytes();
   bool GetCharAtBackward(FX_FILESIZE pos, uint8_t* ch);
   WordType GetNextWordInternal();
   bool IsWholeWord(FX_FILESIZE startpos,
@@ -124,6 +130,9 @@ class CPDF_SyntaxParser {
   FX_FILESIZE m_Pos = 0;
   WeakPtr<ByteStringPool> m_pPool;
   DataVector<uint8_t> m_pFileBuf;
+  // The bytes starting at `m_BufOffset`. Views either `m_pFileBuf`, or the
+  // whole file when `m_pFileAccess` can lend out its storage.
+  pdfium::span<const uint8_t> m_FileView;
   FX_FILESIZE m_BufOffset = 0;
   uint32_t m_WordSize = 0;
   uint8_t m_WordBuffer[257] = {};
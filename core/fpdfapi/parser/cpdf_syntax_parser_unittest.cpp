@@ -6,7 +6,10 @@
 
 #include "core/fpdfapi/parser/cpdf_object.h"
 #include "core/fpdfapi/parser/cpdf_parser.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fpdfapi/parser/cpdf_stream_acc.h"
 #include "core/fpdfapi/parser/cpdf_syntax_parser.h"
+#include "core/fxcrt/cfx_borrowed_span_stream.h"
 #include "core/fxcrt/cfx_read_only_span_stream.h"
 #include "core/fxcrt/fx_extension.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -156,3 +159,60 @@ TEST(SyntaxParserTest, PeekNextWord) {
   EXPECT_EQ("WORD", parser.PeekNextWord());
   EXPECT_EQ("WORD", parser.GetNextWord().word);
 }
+
+TEST(SyntaxParserTest, ReadStreamFromBorrowableFile) {
+  static const char kData[] =
+      "<</Length 5>>stream\r\nhello\r\nendstream\r\nendobj";
+  auto data = pdfium::make_span(reinterpret_cast<const uint8_t*>(kData),
+                                sizeof(kData) - 1);
+  CPDF_SyntaxParser parser(pdfium::MakeRetain<CFX_BorrowedSpanStream>(data));
+  RetainPtr<CPDF_Stream> stream = ToStream(parser.GetObjectBody(nullptr));
+  ASSERT_TRUE(stream);
+  EXPECT_TRUE(stream->IsFileBased());
+
+  // The raw data is referenced in place rather than copied.
+  auto stream_acc = pdfium::MakeRetain<CPDF_StreamAcc>(stream);
+  stream_acc->LoadAllDataRaw();
+  pdfium::span<const uint8_t> span = stream_acc->GetSpan();
+  ASSERT_EQ(5u, span.size());
+  EXPECT_EQ(data.data() + 21, span.data());
+  EXPECT_EQ(0, memcmp(span.data(), "hello", 5));
+}
+
+TEST(SyntaxParserTest, ScanAcrossReadBuffers) {
+  static const char kData[] =
+      "  % comment\r\n /Name123 12345 word<a1 b2\n c>\r\nnext endobj";
+  auto data = pdfium::make_span(reinterpret_cast<const uint8_t*>(kData),
+                                sizeof(kData) - 1);
+  // Scanning must give the same results whether the bytes come in one piece
+  // or in blocks of any size.
+  for (uint32_t buffer_size : {1u, 2u, 3u, 5u, 512u}) {
+    CPDF_SyntaxParser parser(pdfium::MakeRetain<CFX_ReadOnlySpanStream>(data));
+    parser.SetReadBufferSize(buffer_size);
+
+    CPDF_SyntaxParser::WordResult result = parser.GetNextWord();
+    EXPECT_EQ("/Name123", result.word);
+    EXPECT_FALSE(result.is_number);
+    result = parser.GetNextWord();
+    EXPECT_EQ("12345", result.word);
+    EXPECT_TRUE(result.is_number);
+    EXPECT_EQ("word", parser.GetNextWord().word);
+    EXPECT_EQ("<", parser.GetNextWord().word);
+    EXPECT_EQ("\xa1\xb2\xc0", parser.ReadHexString());
+    EXPECT_EQ(43, parser.GetPos());
+
+    parser.ToNextLine();
+    EXPECT_EQ(45, parser.GetPos());
+    EXPECT_EQ("next", parser.GetNextWord().word);
+
+    parser.SetPos(0);
+    EXPECT_EQ(50, parser.FindTag("endobj"));
+    EXPECT_EQ(56, parser.GetPos());
+    EXPECT_EQ(-1, parser.FindTag("endobj"));
+  }
+
+  CPDF_SyntaxParser parser(pdfium::MakeRetain<CFX_BorrowedSpanStream>(data));
+  EXPECT_EQ("/Name123", parser.GetNextWord().word);
+  parser.SetPos(0);
+  EXPECT_EQ(50, parser.FindTag("endobj"));
+}
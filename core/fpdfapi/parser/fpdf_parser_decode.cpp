@@ -21,12 +21,14 @@
 #include "core/fxcodec/fax/faxmodule.h"
 #include "core/fxcodec/flate/flatemodule.h"
 #include "core/fxcodec/scanlinedecoder.h"
+#include "core/fxcodec/streaming_decoder.h"
 #include "core/fxcrt/fx_extension.h"
 #include "core/fxcrt/fx_safe_types.h"
 #include "core/fxcrt/span_util.h"
 #include "core/fxcrt/utf16.h"
 #include "third_party/base/check.h"
 #include "third_party/base/containers/contains.h"
+#include "third_party/base/numerics/safe_conversions.h"
 
 namespace {
 
@@ -49,6 +51,293 @@ uint8_t GetA85Result(uint32_t res, size_t i) {
   return static_cast<uint8_t>(res >> (3 - i) * 8);
 }
 
+// Same as A85Decode(), one group at a time.
+class A85StreamingDecoder final : public ChunkedStreamingDecoder {
+ public:
+  explicit A85StreamingDecoder(std::unique_ptr<StreamingDecoder> pUpstream)
+      : ChunkedStreamingDecoder(4), m_Input(std::move(pUpstream)) {}
+  ~A85StreamingDecoder() override = default;
+
+  // StreamingDecoder:
+  bool HasError() const override { return m_Input.HasError(); }
+
+ private:
+  // ChunkedStreamingDecoder:
+  bool DecodeChunk(pdfium::span<uint8_t> chunk, size_t* size) override {
+    if (m_bDone)
+      return false;
+
+    size_t state = 0;
+    uint32_t res = 0;
+    uint8_t ch;
+    while (m_Input.ReadByte(&ch)) {
+      if (PDFCharIsLineEnding(ch) || ch == ' ' || ch == '\t')
+        continue;
+
+      if (ch == 'z') {
+        // Like A85Decode(), this drops a preceding partial group.
+        fxcrt::spanclr(chunk);
+        *size = 4;
+        return true;
+      }
+
+      // Check for the end or illegal character.
+      if (ch < '!' || ch > 'u')
+        break;
+
+      res = res * 85 + ch - 33;
+      if (state < 4) {
+        ++state;
+        continue;
+      }
+
+      for (size_t i = 0; i < 4; ++i)
+        chunk[i] = GetA85Result(res, i);
+      *size = 4;
+      return true;
+    }
+    m_bDone = true;
+    if (!state)
+      return false;
+
+    // Handle partial group.
+    for (size_t i = state; i < 5; ++i)
+      res = res * 85 + 84;
+    for (size_t i = 0; i < state - 1; ++i)
+      chunk[i] = GetA85Result(res, i);
+    *size = state - 1;
+    return true;
+  }
+
+  StreamingDecoderInput m_Input;
+  bool m_bDone = false;
+};
+
+// Same as HexDecode(), one byte at a time.
+class HexStreamingDecoder final : public ChunkedStreamingDecoder {
+ public:
+  explicit HexStreamingDecoder(std::unique_ptr<StreamingDecoder> pUpstream)
+      : ChunkedStreamingDecoder(1), m_Input(std::move(pUpstream)) {}
+  ~HexStreamingDecoder() override = default;
+
+  // StreamingDecoder:
+  bool HasError() const override { return m_Input.HasError(); }
+
+ private:
+  // ChunkedStreamingDecoder:
+  bool DecodeChunk(pdfium::span<uint8_t> chunk, size_t* size) override {
+    if (m_bDone)
+      return false;
+
+    bool bFirst = true;
+    uint8_t ch;
+    while (m_Input.ReadByte(&ch)) {
+      if (ch == '>')
+        break;
+      if (!isxdigit(ch))
+        continue;
+
+      int digit = FXSYS_HexCharToInt(ch);
+      if (bFirst) {
+        chunk[0] = digit * 16;
+        bFirst = false;
+        continue;
+      }
+      chunk[0] += digit;
+      *size = 1;
+      return true;
+    }
+    m_bDone = true;
+    if (bFirst)
+      return false;
+
+    // Like HexDecode(), keep a trailing odd digit.
+    *size = 1;
+    return true;
+  }
+
+  StreamingDecoderInput m_Input;
+  bool m_bDone = false;
+};
+
+// Same as RunLengthDecode(), one run at a time.
+class RunLengthStreamingDecoder final : public ChunkedStreamingDecoder {
+ public:
+  explicit RunLengthStreamingDecoder(
+      std::unique_ptr<StreamingDecoder> pUpstream)
+      : ChunkedStreamingDecoder(128), m_Input(std::move(pUpstream)) {}
+  ~RunLengthStreamingDecoder() override = default;
+
+  // StreamingDecoder:
+  bool HasError() const override { return m_bError || m_Input.HasError(); }
+
+ private:
+  // ChunkedStreamingDecoder:
+  bool DecodeChunk(pdfium::span<uint8_t> chunk, size_t* size) override {
+    uint8_t length;
+    if (m_bDone || !m_Input.ReadByte(&length) || length == 128) {
+      m_bDone = true;
+      return false;
+    }
+
+    if (length < 128) {
+      *size = length + 1;
+      for (size_t i = 0; i < *size; ++i) {
+        if (!m_Input.ReadByte(&chunk[i])) {
+          // Like RunLengthDecode(), zero-fill a truncated run.
+          fxcrt::spanclr(chunk.subspan(i, *size - i));
+          m_bDone = true;
+          break;
+        }
+      }
+    } else {
+      *size = 257 - length;
+      uint8_t fill;
+      if (!m_Input.ReadByte(&fill)) {
+        fill = 0;
+        m_bDone = true;
+      }
+      fxcrt::spanset(chunk.first(*size), fill);
+    }
+
+    // RunLengthDecode() refuses to decode this much.
+    m_TotalSize += *size;
+    if (m_TotalSize >= kMaxStreamSize) {
+      m_bError = true;
+      m_bDone = true;
+      return false;
+    }
+    return true;
+  }
+
+  StreamingDecoderInput m_Input;
+  uint32_t m_TotalSize = 0;
+  bool m_bDone = false;
+  bool m_bError = false;
+};
+
+// Returns how many of the filters at the start of `decoder_array` can be
+// chained by CreateStreamingDecoderForPrefix(), not counting "Crypt". Sets
+// `prefix_size` to the number of entries they span.
+size_t CountStreamableDecoders(const DecoderArray& decoder_array,
+                               bool bImageAcc,
+                               size_t* prefix_size) {
+  size_t count = 0;
+  size_t i = 0;
+  for (; i < decoder_array.size(); ++i) {
+    const ByteString& decoder = decoder_array[i].first;
+    if (decoder == "Crypt")
+      continue;
+
+    const bool bLastOfImage = bImageAcc && i == decoder_array.size() - 1;
+    if (decoder == "FlateDecode" || decoder == "Fl" ||
+        decoder == "RunLengthDecode" || decoder == "RL") {
+      // PDF_DataDecode() leaves these to the image decoder.
+      if (bLastOfImage)
+        break;
+    } else if (decoder != "LZWDecode" && decoder != "LZW" &&
+               decoder != "ASCII85Decode" && decoder != "A85" &&
+               decoder != "ASCIIHexDecode" && decoder != "AHx") {
+      break;
+    }
+    ++count;
+  }
+  *prefix_size = i;
+  return count;
+}
+
+std::unique_ptr<StreamingDecoder> CreateStreamingDecoderForPrefix(
+    pdfium::span<const uint8_t> src_span,
+    const DecoderArray& decoder_array,
+    size_t prefix_size) {
+  std::unique_ptr<StreamingDecoder> decoder =
+      std::make_unique<SpanStreamingDecoder>(src_span);
+  for (size_t i = 0; i < prefix_size; ++i) {
+    const ByteString& name = decoder_array[i].first;
+    RetainPtr<const CPDF_Dictionary> pParams =
+        ToDictionary(decoder_array[i].second);
+    if (name == "Crypt")
+      continue;
+
+    if (name == "FlateDecode" || name == "Fl" || name == "LZWDecode" ||
+        name == "LZW") {
+      int predictor = 0;
+      int Colors = 0;
+      int BitsPerComponent = 0;
+      int Columns = 0;
+      bool bEarlyChange = true;
+      if (pParams) {
+        predictor = pParams->GetIntegerFor("Predictor");
+        bEarlyChange = !!pParams->GetIntegerFor("EarlyChange", 1);
+        Colors = pParams->GetIntegerFor("Colors", 1);
+        BitsPerComponent = pParams->GetIntegerFor("BitsPerComponent", 8);
+        Columns = pParams->GetIntegerFor("Columns", 1);
+        if (!CheckFlateDecodeParams(Colors, BitsPerComponent, Columns))
+          return nullptr;
+      }
+      decoder = FlateModule::CreateStreamingDecoder(
+          name == "LZWDecode" || name == "LZW", std::move(decoder),
+          bEarlyChange, predictor, Colors, BitsPerComponent, Columns);
+      if (!decoder)
+        return nullptr;
+    } else if (name == "ASCII85Decode" || name == "A85") {
+      decoder = std::make_unique<A85StreamingDecoder>(std::move(decoder));
+    } else if (name == "ASCIIHexDecode" || name == "AHx") {
+      decoder = std::make_unique<HexStreamingDecoder>(std::move(decoder));
+    } else if (name == "RunLengthDecode" || name == "RL") {
+      decoder = std::make_unique<RunLengthStreamingDecoder>(std::move(decoder));
+    } else {
+      return nullptr;
+    }
+  }
+  return decoder;
+}
+
+// Decodes the first `prefix_size` filters of `decoder_array` without holding
+// the output of each of them.
+bool StreamingDataDecode(pdfium::span<const uint8_t> src_span,
+                         const DecoderArray& decoder_array,
+                         size_t prefix_size,
+                         uint32_t estimated_size,
+                         std::unique_ptr<uint8_t, FxFreeDeleter>* dest_buf,
+                         uint32_t* dest_size) {
+  std::unique_ptr<StreamingDecoder> decoder =
+      CreateStreamingDecoderForPrefix(src_span, decoder_array, prefix_size);
+  if (!decoder)
+    return false;
+
+  constexpr uint32_t kMaxInitialAllocSize = 10000000;
+  uint32_t buf_size = estimated_size;
+  if (!buf_size) {
+    buf_size = pdfium::base::saturated_cast<uint32_t>(src_span.size() * 2);
+    buf_size = std::min(buf_size, kMaxInitialAllocSize);
+  }
+  buf_size = std::max<uint32_t>(buf_size, StreamingDecoder::kChunkSize);
+
+  std::unique_ptr<uint8_t, FxFreeDeleter> buf(FX_Alloc(uint8_t, buf_size));
+  uint32_t size = 0;
+  while (true) {
+    size += pdfium::base::checked_cast<uint32_t>(
+        decoder->Read({buf.get() + size, buf_size - size}));
+    if (size < buf_size)
+      break;
+
+    FX_SAFE_UINT32 new_buf_size = buf_size;
+    new_buf_size *= 2;
+    if (!new_buf_size.IsValid())
+      return false;
+
+    buf_size = new_buf_size.ValueOrDie();
+    buf.reset(FX_Realloc(uint8_t, buf.release(), buf_size));
+  }
+  if (decoder->HasError())
+    return false;
+
+  *dest_buf = std::move(buf);
+  *dest_size = size;
+  return true;
+}
+
 }  // namespace
 
 const uint16_t kPDFDocEncoding[256] = {
@@ -392,6 +681,22 @@ absl::optional<DecoderArray> GetDecoderArray(
   return decoder_array;
 }
 
+bool HasOnlyDataFilters(const DecoderArray& decoder_array) {
+  size_t prefix_size = 0;
+  CountStreamableDecoders(decoder_array, /*bImageAcc=*/false, &prefix_size);
+  return prefix_size == decoder_array.size();
+}
+
+std::unique_ptr<StreamingDecoder> CreateStreamingDecoder(
+    pdfium::span<const uint8_t> src_span,
+    const DecoderArray& decoder_array) {
+  if (!HasOnlyDataFilters(decoder_array))
+    return nullptr;
+
+  return CreateStreamingDecoderForPrefix(src_span, decoder_array,
+                                         decoder_array.size());
+}
+
 bool PDF_DataDecode(pdfium::span<const uint8_t> src_span,
                     uint32_t last_estimated_size,
                     bool bImageAcc,
@@ -405,7 +710,24 @@ bool PDF_DataDecode(pdfium::span<const uint8_t> src_span,
   // |result| and let it get destroyed first.
   pdfium::span<const uint8_t> last_span = src_span;
   size_t nSize = decoder_array.size();
-  for (size_t i = 0; i < nSize; ++i) {
+  size_t first_decoder = 0;
+
+  // Chains of filters get decoded without holding the whole output of each
+  // filter. A single filter is faster to decode in one go.
+  size_t prefix_size = 0;
+  if (CountStreamableDecoders(decoder_array, bImageAcc, &prefix_size) > 1) {
+    uint32_t new_size = 0;
+    if (!StreamingDataDecode(
+            src_span, decoder_array, prefix_size,
+            prefix_size == nSize ? last_estimated_size : 0, &result,
+            &new_size)) {
+      return false;
+    }
+    last_span = {result.get(), new_size};
+    first_decoder = prefix_size;
+  }
+
+  for (size_t i = first_decoder; i < nSize; ++i) {
     int estimated_size = i == nSize - 1 ? last_estimated_size : 0;
     ByteString decoder = decoder_array[i].first;
     RetainPtr<const CPDF_Dictionary> pParam =
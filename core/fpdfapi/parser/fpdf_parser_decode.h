@@ -26,6 +26,7 @@ class CPDF_Object;
 
 namespace fxcodec {
 class ScanlineDecoder;
+class StreamingDecoder;
 }
 
 // Indexed by 8-bit char code, contains unicode code points.
@@ -81,6 +82,17 @@ using DecoderArray =
 absl::optional<DecoderArray> GetDecoderArray(
     RetainPtr<const CPDF_Dictionary> pDict);
 
+// Returns whether PDF_DataDecode() decodes all of `decoder_array` itself,
+// i.e. none of the filters are image filters.
+bool HasOnlyDataFilters(const DecoderArray& decoder_array);
+
+// Returns a decoder that decodes `src_span` through all of `decoder_array` as
+// its output is read, or nullptr if one of the filters is an image filter, or
+// has invalid parameters. `src_span` must outlive the decoder.
+std::unique_ptr<fxcodec::StreamingDecoder> CreateStreamingDecoder(
+    pdfium::span<const uint8_t> src_span,
+    const DecoderArray& decoder_array);
+
 bool PDF_DataDecode(pdfium::span<const uint8_t> src_span,
                     uint32_t estimated_size,
                     bool bImageAcc,
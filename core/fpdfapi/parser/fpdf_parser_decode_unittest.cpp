@@ -7,15 +7,21 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <initializer_list>
 #include <iterator>
+#include <memory>
 
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_indirect_object_holder.h"
 #include "core/fpdfapi/parser/cpdf_name.h"
+#include "core/fpdfapi/parser/cpdf_number.h"
 #include "core/fpdfapi/parser/cpdf_reference.h"
 #include "core/fpdfapi/parser/cpdf_string.h"
+#include "core/fxcodec/flate/flatemodule.h"
+#include "core/fxcodec/streaming_decoder.h"
 #include "core/fxcrt/bytestring.h"
+#include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fx_memory_wrappers.h"
 #include "core/fxcrt/string_view_template.h"
 #include "core/fxcrt/widestring.h"
@@ -37,6 +43,26 @@ ByteString ToByteString(const char (&array)[N]) {
   return ByteString(array, N - 1);
 }
 
+// Reads all of `decoder` in small chunks, to cross the chunk boundaries of
+// every stage.
+ByteString ReadAll(fxcodec::StreamingDecoder* decoder) {
+  ByteString result;
+  uint8_t buffer[3];
+  size_t size;
+  do {
+    size = decoder->Read(buffer);
+    result += ByteStringView(buffer, size);
+  } while (size == sizeof(buffer));
+  return result;
+}
+
+DecoderArray MakeDecoderArray(std::initializer_list<const char*> names) {
+  DecoderArray decoder_array;
+  for (const char* name : names)
+    decoder_array.emplace_back(name, nullptr);
+  return decoder_array;
+}
+
 }  // namespace
 
 TEST(ParserDecodeTest, ValidateDecoderPipeline) {
@@ -332,6 +358,95 @@ TEST(ParserDecodeTest, HexDecode) {
   }
 }
 
+TEST(ParserDecodeTest, StreamingDecoder) {
+  {
+    // ASCIIHex, then ASCII85.
+    std::unique_ptr<fxcodec::StreamingDecoder> decoder =
+        CreateStreamingDecoder(ToSpan("46 43 66 4E 38 7E 3E>"),
+                               MakeDecoderArray({"AHx", "A85"}));
+    ASSERT_TRUE(decoder);
+    EXPECT_EQ("test", ReadAll(decoder.get()));
+    EXPECT_FALSE(decoder->HasError());
+  }
+  {
+    // ASCIIHex, then LZW, using the example from the PDF spec.
+    std::unique_ptr<fxcodec::StreamingDecoder> decoder =
+        CreateStreamingDecoder(ToSpan("800B6050220C0C8501>"),
+                               MakeDecoderArray({"AHx", "LZWDecode"}));
+    ASSERT_TRUE(decoder);
+    EXPECT_EQ("-----A---B", ReadAll(decoder.get()));
+    EXPECT_FALSE(decoder->HasError());
+  }
+  {
+    // ASCIIHex, then RunLength, with a crypt filter in between.
+    std::unique_ptr<fxcodec::StreamingDecoder> decoder =
+        CreateStreamingDecoder(ToSpan("02616263FE7880>"),
+                               MakeDecoderArray({"AHx", "Crypt", "RL"}));
+    ASSERT_TRUE(decoder);
+    EXPECT_EQ("abcxxx", ReadAll(decoder.get()));
+    EXPECT_FALSE(decoder->HasError());
+  }
+  {
+    // LZW code 258 before any string is defined.
+    std::unique_ptr<fxcodec::StreamingDecoder> decoder =
+        CreateStreamingDecoder(ToSpan("8100>"),
+                               MakeDecoderArray({"AHx", "LZW"}));
+    ASSERT_TRUE(decoder);
+    EXPECT_EQ("", ReadAll(decoder.get()));
+    EXPECT_TRUE(decoder->HasError());
+  }
+  {
+    // Image filters cannot be streamed.
+    EXPECT_FALSE(CreateStreamingDecoder(ToSpan("FFD8>"),
+                                        MakeDecoderArray({"AHx", "DCT"})));
+  }
+}
+
+TEST(ParserDecodeTest, StreamingDecoderWithPredictor) {
+  // Two rows of 4 bytes, with the PNG Sub and Up predictors.
+  static const uint8_t kPredicted[] = {1, 1, 1, 1, 1, 2, 1, 1, 1, 1};
+  DataVector<uint8_t> compressed = FlateModule::Encode(kPredicted);
+  ByteString hex = PDF_HexEncodeString(
+      ByteStringView(compressed.data(), compressed.size()));
+
+  auto params = pdfium::MakeRetain<CPDF_Dictionary>();
+  params->SetNewFor<CPDF_Number>("Predictor", 12);
+  params->SetNewFor<CPDF_Number>("Columns", 4);
+  DecoderArray decoder_array = MakeDecoderArray({"AHx", "FlateDecode"});
+  decoder_array[1].second = params;
+
+  std::unique_ptr<fxcodec::StreamingDecoder> decoder =
+      CreateStreamingDecoder(hex.raw_span(), decoder_array);
+  ASSERT_TRUE(decoder);
+  EXPECT_EQ(ToByteString("\x01\x02\x03\x04\x02\x03\x04\x05"),
+            ReadAll(decoder.get()));
+  EXPECT_FALSE(decoder->HasError());
+
+  // PDF_DataDecode() decodes the chain the same way.
+  std::unique_ptr<uint8_t, FxFreeDeleter> result;
+  uint32_t result_size = 0;
+  ByteString image_encoding;
+  RetainPtr<const CPDF_Dictionary> image_params;
+  ASSERT_TRUE(PDF_DataDecode(hex.raw_span(), 0, /*bImageAcc=*/false,
+                             decoder_array, &result, &result_size,
+                             &image_encoding, &image_params));
+  EXPECT_EQ(ToByteString("\x01\x02\x03\x04\x02\x03\x04\x05"),
+            ByteStringView(result.get(), result_size));
+  EXPECT_TRUE(image_encoding.IsEmpty());
+}
+
+TEST(ParserDecodeTest, DataDecodeChainBeforeImageFilter) {
+  std::unique_ptr<uint8_t, FxFreeDeleter> result;
+  uint32_t result_size = 0;
+  ByteString image_encoding;
+  RetainPtr<const CPDF_Dictionary> image_params;
+  ASSERT_TRUE(PDF_DataDecode(ToSpan("02616263FE7880>"), 0, /*bImageAcc=*/true,
+                             MakeDecoderArray({"AHx", "RL", "DCT"}), &result,
+                             &result_size, &image_encoding, &image_params));
+  EXPECT_EQ("abcxxx", ByteStringView(result.get(), result_size));
+  EXPECT_EQ("DCTDecode", image_encoding);
+}
+
 TEST(ParserDecodeTest, DecodeText) {
   // Empty src string.
   EXPECT_EQ(L"", PDF_DecodeText(ToSpan("")));
@@ -71,16 +71,23 @@ CPDF_ImageRenderer::CPDF_ImageRenderer(CPDF_RenderStatus* pStatus)
 CPDF_ImageRenderer::~CPDF_ImageRenderer() = default;
 
 bool CPDF_ImageRenderer::StartLoadDIBBase() {
-  if (!GetUnitRect().has_value())
+  absl::optional<FX_RECT> image_rect = GetUnitRect();
+  if (!image_rect.has_value())
     return false;
 
+  // The image gets drawn at the size of its bounding box, which may well be
+  // larger than the device. For images rotated by about 90 degrees, swap the
+  // bounding box dimensions back to match the image's width and height.
+  CFX_Size max_size_required(image_rect->Width(), image_rect->Height());
+  if (fabsf(m_ImageMatrix.a) < fabsf(m_ImageMatrix.b))
+    std::swap(max_size_required.width, max_size_required.height);
+
   if (!m_pLoader->Start(
           m_pImageObject, m_pRenderStatus->GetContext()->GetPageCache(),
           m_pRenderStatus->GetFormResource(),
           m_pRenderStatus->GetPageResource(), m_bStdCS,
           m_pRenderStatus->GetGroupFamily(), m_pRenderStatus->GetLoadMask(),
-          {m_pRenderStatus->GetRenderDevice()->GetWidth(),
-           m_pRenderStatus->GetRenderDevice()->GetHeight()})) {
+          max_size_required)) {
     return false;
   }
   m_Mode = Mode::kDefault;
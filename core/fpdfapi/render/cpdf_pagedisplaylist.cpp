@@ -0,0 +1,138 @@
+// Copyright 2024 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/render/cpdf_pagedisplaylist.h"
+
+#include "core/fpdfapi/font/cpdf_font.h"
+#include "core/fpdfapi/font/cpdf_fontglobals.h"
+#include "core/fpdfapi/page/cpdf_form.h"
+#include "core/fpdfapi/page/cpdf_formobject.h"
+#include "core/fpdfapi/page/cpdf_image.h"
+#include "core/fpdfapi/page/cpdf_imageloader.h"
+#include "core/fpdfapi/page/cpdf_imageobject.h"
+#include "core/fpdfapi/page/cpdf_page.h"
+#include "core/fpdfapi/page/cpdf_pageimagecache.h"
+#include "core/fpdfapi/page/cpdf_textobject.h"
+#include "core/fpdfapi/parser/cpdf_array.h"
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/render/charposlist.h"
+#include "core/fxge/dib/cfx_dibbase.h"
+#include "third_party/base/check.h"
+
+namespace {
+
+// JPX images get decoded at a resolution that depends on the size of the
+// device they are rendered to, so decoding them up front would change how
+// they look.
+bool HasJpxFilter(const CPDF_Image* image) {
+  RetainPtr<const CPDF_Dictionary> dict = image->GetDict();
+  if (!dict)
+    return false;
+
+  RetainPtr<const CPDF_Object> filter = dict->GetDirectObjectFor("Filter");
+  if (!filter)
+    return false;
+
+  if (filter->IsName())
+    return filter->GetString() == "JPXDecode";
+
+  const CPDF_Array* filters = filter->AsArray();
+  if (!filters)
+    return false;
+
+  for (size_t i = 0; i < filters->size(); ++i) {
+    if (filters->GetByteStringAt(i) == "JPXDecode")
+      return true;
+  }
+  return false;
+}
+
+// Images that get rendered with transparency are loaded with different
+// parameters, see CPDF_RenderStatus::ProcessTransparency().
+bool MayRenderWithTransparency(const CPDF_ImageObject* image_obj) {
+  if (image_obj->general_state().GetBlendType() != BlendMode::kNormal)
+    return true;
+
+  if (image_obj->general_state().GetSoftMask()) {
+    RetainPtr<const CPDF_Dictionary> dict = image_obj->GetImage()->GetDict();
+    if (!dict || !dict->KeyExist("SMask"))
+      return true;
+  }
+
+  return image_obj->clip_path().HasRef() &&
+         image_obj->clip_path().GetTextCount() > 0;
+}
+
+}  // namespace
+
+CPDF_PageDisplayList::CPDF_PageDisplayList(CPDF_Page* page) {
+  DCHECK(page->GetParseState() == CPDF_PageObjectHolder::ParseState::kParsed);
+  CPDF_FontGlobals::ScopedSharedAccess font_access(page->GetDocument());
+  AddObjects(page, page, nullptr);
+}
+
+CPDF_PageDisplayList::~CPDF_PageDisplayList() = default;
+
+const std::vector<TextCharPos>* CPDF_PageDisplayList::GetCharPosList(
+    const CPDF_TextObject* text_obj) const {
+  if (text_obj->IsDirty())
+    return nullptr;
+
+  auto it = texts_.find(text_obj);
+  return it != texts_.end() ? &it->second : nullptr;
+}
+
+void CPDF_PageDisplayList::AddObjects(CPDF_Page* page,
+                                      const CPDF_PageObjectHolder* holder,
+                                      const CPDF_Dictionary* form_resources) {
+  for (const auto& obj : *holder) {
+    if (const CPDF_TextObject* text_obj = obj->AsText()) {
+      AddText(text_obj);
+    } else if (const CPDF_ImageObject* image_obj = obj->AsImage()) {
+      AddImage(page, image_obj, form_resources);
+    } else if (const CPDF_FormObject* form_obj = obj->AsForm()) {
+      const CPDF_Form* form = form_obj->form();
+      RetainPtr<const CPDF_Dictionary> resources =
+          form->GetDict()->GetDictFor("Resources");
+      AddObjects(page, form, resources.Get());
+    }
+  }
+}
+
+void CPDF_PageDisplayList::AddText(const CPDF_TextObject* text_obj) {
+  if (text_obj->IsDirty())
+    return;
+
+  RetainPtr<CPDF_Font> font = text_obj->text_state().GetFont();
+  if (!font || font->IsType3Font())
+    return;
+
+  texts_.emplace(
+      text_obj,
+      ::GetCharPosList(text_obj->GetCharCodes(), text_obj->GetCharPositions(),
+                       font.Get(), text_obj->text_state().GetFontSize()));
+}
+
+void CPDF_PageDisplayList::AddImage(CPDF_Page* page,
+                                    const CPDF_ImageObject* image_obj,
+                                    const CPDF_Dictionary* form_resources) {
+  CPDF_PageImageCache* image_cache = page->GetPageImageCache();
+  if (!image_cache || MayRenderWithTransparency(image_obj) ||
+      HasJpxFilter(image_obj->GetImage().Get())) {
+    return;
+  }
+
+  // Use the same parameters as CPDF_ImageRenderer, so that rendering finds
+  // the decoded image in the cache.
+  CPDF_ImageLoader loader;
+  if (loader.Start(image_obj, image_cache, form_resources,
+                   page->GetPageResources().Get(), /*bStdCS=*/false,
+                   CPDF_ColorSpace::Family::kUnknown, /*bLoadMask=*/false,
+                   /*max_size_required=*/CFX_Size())) {
+    while (loader.Continue(nullptr)) {
+    }
+  }
+  if (loader.GetBitmap())
+    ++image_count_;
+}
@@ -0,0 +1,60 @@
+// Copyright 2024 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_RENDER_CPDF_PAGEDISPLAYLIST_H_
+#define CORE_FPDFAPI_RENDER_CPDF_PAGEDISPLAYLIST_H_
+
+#include <stddef.h>
+
+#include <map>
+#include <vector>
+
+#include "core/fpdfapi/page/cpdf_page.h"
+#include "core/fxge/text_char_pos.h"
+
+class CPDF_Dictionary;
+class CPDF_ImageObject;
+class CPDF_PageObjectHolder;
+class CPDF_TextObject;
+
+// Keeps the device-independent work of rendering a parsed page, so that
+// rendering the page again, e.g. at another zoom level or for another tile,
+// does not redo it. For every text object, it keeps the glyphs and their
+// positions in text space. It also decodes the page's images into the page
+// image cache up front.
+//
+// Everything else that rendering needs, like the colors and the paths, is
+// already resolved when parsing the page. The display list does not flatten
+// forms, as their clipping, transparency groups and resources are applied at
+// render time.
+class CPDF_PageDisplayList final : public CPDF_Page::DisplayListIface {
+ public:
+  // `page` must be parsed already.
+  explicit CPDF_PageDisplayList(CPDF_Page* page);
+  ~CPDF_PageDisplayList() override;
+
+  // Returns the glyphs for `text_obj`, or nullptr if the display list does
+  // not have them, e.g. because the text object is dirty, i.e. changed since
+  // its content was generated. Objects that were dirty when building the
+  // display list are left out, as later changes to them cannot be told apart.
+  const std::vector<TextCharPos>* GetCharPosList(
+      const CPDF_TextObject* text_obj) const;
+
+  size_t text_count() const { return texts_.size(); }
+  size_t image_count() const { return image_count_; }
+
+ private:
+  void AddObjects(CPDF_Page* page,
+                  const CPDF_PageObjectHolder* holder,
+                  const CPDF_Dictionary* form_resources);
+  void AddText(const CPDF_TextObject* text_obj);
+  void AddImage(CPDF_Page* page,
+                const CPDF_ImageObject* image_obj,
+                const CPDF_Dictionary* form_resources);
+
+  std::map<const CPDF_TextObject*, std::vector<TextCharPos>> texts_;
+  size_t image_count_ = 0;
+};
+
+#endif  // CORE_FPDFAPI_RENDER_CPDF_PAGEDISPLAYLIST_H_
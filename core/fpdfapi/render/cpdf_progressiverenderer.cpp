@@ -16,6 +16,16 @@
 #include "core/fxcrt/pauseindicator_iface.h"
 #include "core/fxge/cfx_renderdevice.h"
 
+namespace {
+
+// Makes CPDF_PageObjectHolder::ContinueParse() return after every step.
+class ParseStepPause final : public PauseIndicatorIface {
+ public:
+  bool NeedToPauseNow() override { return true; }
+};
+
+}  // namespace
+
 CPDF_ProgressiveRenderer::CPDF_ProgressiveRenderer(
     CPDF_RenderContext* pContext,
     CFX_RenderDevice* pDevice,
@@ -46,7 +56,7 @@ void CPDF_ProgressiveRenderer::Continue(PauseIndicatorIface* pPause) {
         return;
       }
       m_pCurrentLayer = m_pContext->GetLayer(m_LayerIndex);
-      m_LastObjectRendered = m_pCurrentLayer->GetObjectHolder()->end();
+      m_NextObjectIndex = 0;
       m_pRenderStatus =
           std::make_unique<CPDF_RenderStatus>(m_pContext, m_pDevice);
       if (m_pOptions)
@@ -58,19 +68,14 @@ void CPDF_ProgressiveRenderer::Continue(PauseIndicatorIface* pPause) {
       m_ClipRect = m_pCurrentLayer->GetMatrix().GetInverse().TransformRect(
           CFX_FloatRect(m_pDevice->GetClipBox()));
     }
-    CPDF_PageObjectHolder::const_iterator iter;
-    CPDF_PageObjectHolder::const_iterator iterEnd =
-        m_pCurrentLayer->GetObjectHolder()->end();
-    if (m_LastObjectRendered != iterEnd) {
-      iter = m_LastObjectRendered;
-      ++iter;
-    } else {
-      iter = m_pCurrentLayer->GetObjectHolder()->begin();
-    }
+    // Parsing below appends to the object list, so walk it by index and
+    // re-check its size on every iteration.
+    CPDF_PageObjectHolder* pHolder = m_pCurrentLayer->GetObjectHolder();
     int nObjsToGo = kStepLimit;
     bool is_mask = false;
-    while (iter != iterEnd) {
-      CPDF_PageObject* pCurObj = iter->get();
+    while (m_NextObjectIndex < pHolder->GetPageObjectCount()) {
+      CPDF_PageObject* pCurObj =
+          pHolder->GetPageObjectByIndex(m_NextObjectIndex);
       if (pCurObj && pCurObj->GetRect().left <= m_ClipRect.right &&
           pCurObj->GetRect().right >= m_ClipRect.left &&
           pCurObj->GetRect().bottom <= m_ClipRect.top &&
@@ -78,7 +83,7 @@ void CPDF_ProgressiveRenderer::Continue(PauseIndicatorIface* pPause) {
         if (m_pOptions->GetOptions().bBreakForMasks && pCurObj->IsImage() &&
             pCurObj->AsImage()->GetImage()->IsMask()) {
           if (m_pDevice->GetDeviceType() == DeviceType::kPrinter) {
-            m_LastObjectRendered = iter;
+            ++m_NextObjectIndex;
             m_pRenderStatus->ProcessClipPath(pCurObj->clip_path(),
                                              m_pCurrentLayer->GetMatrix());
             return;
@@ -100,17 +105,16 @@ void CPDF_ProgressiveRenderer::Continue(PauseIndicatorIface* pPause) {
         else
           --nObjsToGo;
       }
-      m_LastObjectRendered = iter;
+      ++m_NextObjectIndex;
       if (nObjsToGo == 0) {
         if (pPause && pPause->NeedToPauseNow())
           return;
         nObjsToGo = kStepLimit;
       }
-      ++iter;
-      if (is_mask && iter != iterEnd)
+      if (is_mask && m_NextObjectIndex < pHolder->GetPageObjectCount())
         return;
     }
-    if (m_pCurrentLayer->GetObjectHolder()->GetParseState() ==
+    if (pHolder->GetParseState() ==
         CPDF_PageObjectHolder::ParseState::kParsed) {
       m_pRenderStatus.reset();
       m_pDevice->RestoreState(false);
@@ -121,9 +125,13 @@ void CPDF_ProgressiveRenderer::Continue(PauseIndicatorIface* pPause) {
     } else if (is_mask) {
       return;
     } else {
-      m_pCurrentLayer->GetObjectHolder()->ContinueParse(pPause);
-      if (m_pCurrentLayer->GetObjectHolder()->GetParseState() !=
-          CPDF_PageObjectHolder::ParseState::kParsed) {
+      // Parse a single step, so the objects it creates get drawn before the
+      // rest of the content gets parsed.
+      ParseStepPause step_pause;
+      pHolder->ContinueParse(&step_pause);
+      if (pHolder->GetParseState() !=
+              CPDF_PageObjectHolder::ParseState::kParsed &&
+          pPause && pPause->NeedToPauseNow()) {
         return;
       }
     }
@@ -7,6 +7,7 @@
 #ifndef CORE_FPDFAPI_RENDER_CPDF_PROGRESSIVERENDERER_H_
 #define CORE_FPDFAPI_RENDER_CPDF_PROGRESSIVERENDERER_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <memory>
@@ -54,7 +55,7 @@ class CPDF_ProgressiveRenderer {
   CFX_FloatRect m_ClipRect;
   uint32_t m_LayerIndex = 0;
   UnownedPtr<CPDF_RenderContext::Layer> m_pCurrentLayer;
-  CPDF_PageObjectHolder::const_iterator m_LastObjectRendered;
+  size_t m_NextObjectIndex = 0;
 };
 
 #endif  // CORE_FPDFAPI_RENDER_CPDF_PROGRESSIVERENDERER_H_
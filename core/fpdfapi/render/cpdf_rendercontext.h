@@ -18,6 +18,7 @@ class CFX_Matrix;
 class CFX_RenderDevice;
 class CPDF_Dictionary;
 class CPDF_Document;
+class CPDF_PageDisplayList;
 class CPDF_PageImageCache;
 class CPDF_PageObject;
 class CPDF_PageObjectHolder;
@@ -69,10 +70,16 @@ class CPDF_RenderContext {
   }
   CPDF_PageImageCache* GetPageCache() const { return m_pPageCache; }
 
+  void SetDisplayList(const CPDF_PageDisplayList* pDisplayList) {
+    m_pDisplayList = pDisplayList;
+  }
+  const CPDF_PageDisplayList* GetDisplayList() const { return m_pDisplayList; }
+
  private:
   UnownedPtr<CPDF_Document> const m_pDocument;
   RetainPtr<CPDF_Dictionary> const m_pPageResources;
   UnownedPtr<CPDF_PageImageCache> const m_pPageCache;
+  UnownedPtr<const CPDF_PageDisplayList> m_pDisplayList;
   std::vector<Layer> m_Layers;
 };
 
@@ -18,6 +18,7 @@
 #include "build/build_config.h"
 #include "constants/transparency.h"
 #include "core/fpdfapi/font/cpdf_font.h"
+#include "core/fpdfapi/font/cpdf_fontglobals.h"
 #include "core/fpdfapi/font/cpdf_type3char.h"
 #include "core/fpdfapi/font/cpdf_type3font.h"
 #include "core/fpdfapi/page/cpdf_docpagedata.h"
@@ -44,6 +45,7 @@
 #include "core/fpdfapi/render/charposlist.h"
 #include "core/fpdfapi/render/cpdf_docrenderdata.h"
 #include "core/fpdfapi/render/cpdf_imagerenderer.h"
+#include "core/fpdfapi/render/cpdf_pagedisplaylist.h"
 #include "core/fpdfapi/render/cpdf_rendercontext.h"
 #include "core/fpdfapi/render/cpdf_renderoptions.h"
 #include "core/fpdfapi/render/cpdf_rendershading.h"
@@ -75,7 +77,7 @@
 namespace {
 
 constexpr int kRenderMaxRecursionDepth = 64;
-int g_CurrentRecursionDepth = 0;
+thread_local int g_CurrentRecursionDepth = 0;
 
 CFX_FillRenderOptions GetFillOptionsForDrawPathWithBlend(
     const CPDF_RenderOptions::Options& options,
@@ -645,18 +647,23 @@ bool CPDF_RenderStatus::ProcessTransparency(CPDF_PageObject* pPageObj,
 
     CFX_DefaultRenderDevice text_device;
     text_device.Attach(pTextMask);
+    CPDF_FontGlobals::ScopedSharedAccess font_access(
+        m_pContext->GetDocument());
     for (size_t i = 0; i < pPageObj->clip_path().GetTextCount(); ++i) {
       CPDF_TextObject* textobj = pPageObj->clip_path().GetText(i);
       if (!textobj)
         break;
 
+      CPDF_Font* pFont = textobj->text_state().GetFont().Get();
+      float font_size = textobj->text_state().GetFontSize();
       // TODO(thestig): Should we check the return value here?
       CPDF_TextRenderer::DrawTextPath(
-          &text_device, textobj->GetCharCodes(), textobj->GetCharPositions(),
-          textobj->text_state().GetFont().Get(),
-          textobj->text_state().GetFontSize(), textobj->GetTextMatrix(),
-          &new_matrix, textobj->graph_state().GetObject(), 0xffffffff, 0,
-          nullptr, CFX_FillRenderOptions());
+          &text_device,
+          GetCharPosList(textobj->GetCharCodes(), textobj->GetCharPositions(),
+                         pFont, font_size),
+          pFont, font_size, textobj->GetTextMatrix(), &new_matrix,
+          textobj->graph_state().GetObject(), 0xffffffff, 0, nullptr,
+          CFX_FillRenderOptions());
     }
   }
   CPDF_RenderStatus bitmap_render(m_pContext, &bitmap_device);
@@ -776,6 +783,7 @@ bool CPDF_RenderStatus::ProcessText(CPDF_TextObject* textobj,
   if (text_render_mode == TextRenderingMode::MODE_INVISIBLE)
     return true;
 
+  CPDF_FontGlobals::ScopedSharedAccess font_access(m_pContext->GetDocument());
   RetainPtr<CPDF_Font> pFont = textobj->text_state().GetFont();
   if (pFont->IsType3Font())
     return ProcessType3Text(textobj, mtObj2Device);
@@ -841,6 +849,9 @@ bool CPDF_RenderStatus::ProcessText(CPDF_TextObject* textobj,
                             text_matrix, is_fill, is_stroke);
     return true;
   }
+  std::vector<TextCharPos> char_pos_storage;
+  pdfium::span<const TextCharPos> char_pos_list =
+      GetTextCharPosList(textobj, pFont.Get(), font_size, &char_pos_storage);
   if (is_clip || is_stroke) {
     const CFX_Matrix* pDeviceMatrix = &mtObj2Device;
     CFX_Matrix device_matrix;
@@ -854,17 +865,33 @@ bool CPDF_RenderStatus::ProcessText(CPDF_TextObject* textobj,
       }
     }
     return CPDF_TextRenderer::DrawTextPath(
-        m_pDevice, textobj->GetCharCodes(), textobj->GetCharPositions(),
-        pFont.Get(), font_size, text_matrix, pDeviceMatrix,
-        textobj->graph_state().GetObject(), fill_argb, stroke_argb,
-        clipping_path,
+        m_pDevice, char_pos_list, pFont.Get(), font_size, text_matrix,
+        pDeviceMatrix, textobj->graph_state().GetObject(), fill_argb,
+        stroke_argb, clipping_path,
         GetFillOptionsForDrawTextPath(m_Options.GetOptions(), textobj,
                                       is_stroke, is_fill));
   }
   text_matrix.Concat(mtObj2Device);
-  return CPDF_TextRenderer::DrawNormalText(
-      m_pDevice, textobj->GetCharCodes(), textobj->GetCharPositions(),
-      pFont.Get(), font_size, text_matrix, fill_argb, m_Options);
+  return CPDF_TextRenderer::DrawNormalText(m_pDevice, char_pos_list,
+                                           pFont.Get(), font_size, text_matrix,
+                                           fill_argb, m_Options);
+}
+
+pdfium::span<const TextCharPos> CPDF_RenderStatus::GetTextCharPosList(
+    const CPDF_TextObject* textobj,
+    CPDF_Font* pFont,
+    float font_size,
+    std::vector<TextCharPos>* storage) const {
+  const CPDF_PageDisplayList* pDisplayList = m_pContext->GetDisplayList();
+  if (pDisplayList) {
+    const std::vector<TextCharPos>* pCharPosList =
+        pDisplayList->GetCharPosList(textobj);
+    if (pCharPosList)
+      return *pCharPosList;
+  }
+  *storage = GetCharPosList(textobj->GetCharCodes(),
+                            textobj->GetCharPositions(), pFont, font_size);
+  return *storage;
 }
 
 // TODO(npm): Font fallback for type 3 fonts? (Completely separate code!!)
@@ -984,7 +1011,8 @@ bool CPDF_RenderStatus::ProcessType3Text(CPDF_TextObject* textobj,
         RetainPtr<CPDF_Type3Cache> pCache =
             CPDF_DocRenderData::FromDocument(pDoc)->GetCachedType3(pType3Font);
 
-        const CFX_GlyphBitmap* pBitmap = pCache->LoadGlyph(charcode, matrix);
+        RetainPtr<const CFX_GlyphBitmap> pBitmap =
+            pCache->LoadGlyph(charcode, matrix);
         if (!pBitmap)
           continue;
 
@@ -1005,7 +1033,7 @@ bool CPDF_RenderStatus::ProcessType3Text(CPDF_TextObject* textobj,
           m_pDevice->SetBitMask(pBitmap->GetBitmap(), left.ValueOrDie(),
                                 top.ValueOrDie(), fill_argb);
         } else {
-          glyphs[iChar].m_pGlyph = pBitmap;
+          glyphs[iChar].m_pGlyph = std::move(pBitmap);
           glyphs[iChar].m_Origin = origin;
         }
       }
@@ -1062,8 +1090,9 @@ void CPDF_RenderStatus::DrawTextPathWithPattern(const CPDF_TextObject* textobj,
     return;
   }
 
-  std::vector<TextCharPos> char_pos_list = GetCharPosList(
-      textobj->GetCharCodes(), textobj->GetCharPositions(), pFont, font_size);
+  std::vector<TextCharPos> char_pos_storage;
+  pdfium::span<const TextCharPos> char_pos_list =
+      GetTextCharPosList(textobj, pFont, font_size, &char_pos_storage);
   for (const TextCharPos& charpos : char_pos_list) {
     auto* font = charpos.m_FallbackFontPosition == -1
                      ? pFont->GetFont()
@@ -20,6 +20,7 @@
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/unowned_ptr.h"
 #include "core/fxge/dib/fx_dib.h"
+#include "third_party/base/containers/span.h"
 
 class CFX_DIBitmap;
 class CFX_Path;
@@ -41,6 +42,7 @@ class CPDF_TransferFunc;
 class CPDF_Type3Char;
 class CPDF_Type3Font;
 class PauseIndicatorIface;
+class TextCharPos;
 
 class CPDF_RenderStatus {
  public:
@@ -157,6 +159,14 @@ class CPDF_RenderStatus {
   bool ProcessText(CPDF_TextObject* textobj,
                    const CFX_Matrix& mtObj2Device,
                    CFX_Path* clipping_path);
+
+  // Returns the glyphs of `textobj` from the page display list if it has
+  // them. Otherwise computes them into `storage` and returns those.
+  pdfium::span<const TextCharPos> GetTextCharPosList(
+      const CPDF_TextObject* textobj,
+      CPDF_Font* pFont,
+      float font_size,
+      std::vector<TextCharPos>* storage) const;
   void DrawTextPathWithPattern(const CPDF_TextObject* textobj,
                                const CFX_Matrix& mtObj2Device,
                                CPDF_Font* pFont,
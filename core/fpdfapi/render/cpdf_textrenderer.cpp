@@ -49,8 +49,7 @@ CFX_TextRenderOptions GetTextRenderOptionsHelper(
 // static
 bool CPDF_TextRenderer::DrawTextPath(
     CFX_RenderDevice* pDevice,
-    pdfium::span<const uint32_t> char_codes,
-    pdfium::span<const float> char_pos,
+    pdfium::span<const TextCharPos> pos,
     CPDF_Font* pFont,
     float font_size,
     const CFX_Matrix& mtText2User,
@@ -60,8 +59,6 @@ bool CPDF_TextRenderer::DrawTextPath(
     FX_ARGB stroke_argb,
     CFX_Path* pClippingPath,
     const CFX_FillRenderOptions& fill_options) {
-  std::vector<TextCharPos> pos =
-      GetCharPosList(char_codes, char_pos, pFont, font_size);
   if (pos.empty())
     return true;
 
@@ -75,8 +72,8 @@ bool CPDF_TextRenderer::DrawTextPath(
 
     CFX_Font* font = GetFont(pFont, fontPosition);
     if (!pDevice->DrawTextPath(
-            pdfium::make_span(pos).subspan(startIndex, i - startIndex), font,
-            font_size, mtText2User, pUser2Device, pGraphState, fill_argb,
+            pos.subspan(startIndex, i - startIndex), font, font_size,
+            mtText2User, pUser2Device, pGraphState, fill_argb,
             stroke_argb, pClippingPath, fill_options)) {
       bDraw = false;
     }
@@ -84,10 +81,9 @@ bool CPDF_TextRenderer::DrawTextPath(
     startIndex = i;
   }
   CFX_Font* font = GetFont(pFont, fontPosition);
-  if (!pDevice->DrawTextPath(pdfium::make_span(pos).subspan(startIndex), font,
-                             font_size, mtText2User, pUser2Device, pGraphState,
-                             fill_argb, stroke_argb, pClippingPath,
-                             fill_options)) {
+  if (!pDevice->DrawTextPath(pos.subspan(startIndex), font, font_size,
+                             mtText2User, pUser2Device, pGraphState, fill_argb,
+                             stroke_argb, pClippingPath, fill_options)) {
     bDraw = false;
   }
   return bDraw;
@@ -125,21 +121,18 @@ void CPDF_TextRenderer::DrawTextString(CFX_RenderDevice* pDevice,
   CFX_Matrix new_matrix = matrix;
   new_matrix.e = origin_x;
   new_matrix.f = origin_y;
-  DrawNormalText(pDevice, codes, positions, pFont, font_size, new_matrix,
-                 fill_argb, options);
+  DrawNormalText(pDevice, GetCharPosList(codes, positions, pFont, font_size),
+                 pFont, font_size, new_matrix, fill_argb, options);
 }
 
 // static
 bool CPDF_TextRenderer::DrawNormalText(CFX_RenderDevice* pDevice,
-                                       pdfium::span<const uint32_t> char_codes,
-                                       pdfium::span<const float> char_pos,
+                                       pdfium::span<const TextCharPos> pos,
                                        CPDF_Font* pFont,
                                        float font_size,
                                        const CFX_Matrix& mtText2Device,
                                        FX_ARGB fill_argb,
                                        const CPDF_RenderOptions& options) {
-  std::vector<TextCharPos> pos =
-      GetCharPosList(char_codes, char_pos, pFont, font_size);
   if (pos.empty())
     return true;
 
@@ -155,17 +148,16 @@ bool CPDF_TextRenderer::DrawNormalText(CFX_RenderDevice* pDevice,
 
     CFX_Font* font = GetFont(pFont, fontPosition);
     if (!pDevice->DrawNormalText(
-            pdfium::make_span(pos).subspan(startIndex, i - startIndex), font,
-            font_size, mtText2Device, fill_argb, text_options)) {
+            pos.subspan(startIndex, i - startIndex), font, font_size,
+            mtText2Device, fill_argb, text_options)) {
       bDraw = false;
     }
     fontPosition = curFontPosition;
     startIndex = i;
   }
   CFX_Font* font = GetFont(pFont, fontPosition);
-  if (!pDevice->DrawNormalText(pdfium::make_span(pos).subspan(startIndex), font,
-                               font_size, mtText2Device, fill_argb,
-                               text_options)) {
+  if (!pDevice->DrawNormalText(pos.subspan(startIndex), font, font_size,
+                               mtText2Device, fill_argb, text_options)) {
     bDraw = false;
   }
   return bDraw;
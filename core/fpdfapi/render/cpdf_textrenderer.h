@@ -19,6 +19,7 @@ class CFX_GraphStateData;
 class CFX_Path;
 class CPDF_RenderOptions;
 class CPDF_Font;
+class TextCharPos;
 struct CFX_FillRenderOptions;
 
 class CPDF_TextRenderer {
@@ -33,9 +34,9 @@ class CPDF_TextRenderer {
                              FX_ARGB fill_argb,
                              const CPDF_RenderOptions& options);
 
+  // `pos` is the result of GetCharPosList() for the text to draw.
   static bool DrawTextPath(CFX_RenderDevice* pDevice,
-                           pdfium::span<const uint32_t> char_codes,
-                           pdfium::span<const float> char_pos,
+                           pdfium::span<const TextCharPos> pos,
                            CPDF_Font* pFont,
                            float font_size,
                            const CFX_Matrix& mtText2User,
@@ -46,9 +47,9 @@ class CPDF_TextRenderer {
                            CFX_Path* pClippingPath,
                            const CFX_FillRenderOptions& fill_options);
 
+  // `pos` is the result of GetCharPosList() for the text to draw.
   static bool DrawNormalText(CFX_RenderDevice* pDevice,
-                             pdfium::span<const uint32_t> char_codes,
-                             pdfium::span<const float> char_pos,
+                             pdfium::span<const TextCharPos> pos,
                              CPDF_Font* pFont,
                              float font_size,
                              const CFX_Matrix& mtText2Device,
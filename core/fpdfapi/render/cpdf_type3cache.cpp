@@ -77,8 +77,9 @@ CPDF_Type3Cache::CPDF_Type3Cache(CPDF_Type3Font* pFont) : m_pFont(pFont) {}
 
 CPDF_Type3Cache::~CPDF_Type3Cache() = default;
 
-const CFX_GlyphBitmap* CPDF_Type3Cache::LoadGlyph(uint32_t charcode,
-                                                  const CFX_Matrix& mtMatrix) {
+RetainPtr<const CFX_GlyphBitmap> CPDF_Type3Cache::LoadGlyph(
+    uint32_t charcode,
+    const CFX_Matrix& mtMatrix) {
   SizeKey keygen = {
       FXSYS_roundf(mtMatrix.a * 10000),
       FXSYS_roundf(mtMatrix.b * 10000),
@@ -94,18 +95,17 @@ const CFX_GlyphBitmap* CPDF_Type3Cache::LoadGlyph(uint32_t charcode,
   } else {
     pSizeCache = it->second.get();
   }
-  const CFX_GlyphBitmap* pExisting = pSizeCache->GetBitmap(charcode);
+  RetainPtr<const CFX_GlyphBitmap> pExisting = pSizeCache->GetBitmap(charcode);
   if (pExisting)
     return pExisting;
 
-  std::unique_ptr<CFX_GlyphBitmap> pNewBitmap =
+  RetainPtr<CFX_GlyphBitmap> pNewBitmap =
       RenderGlyph(pSizeCache, charcode, mtMatrix);
-  CFX_GlyphBitmap* pGlyphBitmap = pNewBitmap.get();
-  pSizeCache->SetBitmap(charcode, std::move(pNewBitmap));
-  return pGlyphBitmap;
+  pSizeCache->SetBitmap(charcode, pNewBitmap);
+  return pNewBitmap;
 }
 
-std::unique_ptr<CFX_GlyphBitmap> CPDF_Type3Cache::RenderGlyph(
+RetainPtr<CFX_GlyphBitmap> CPDF_Type3Cache::RenderGlyph(
     CPDF_Type3GlyphMap* pSize,
     uint32_t charcode,
     const CFX_Matrix& mtMatrix) {
@@ -154,7 +154,7 @@ std::unique_ptr<CFX_GlyphBitmap> CPDF_Type3Cache::RenderGlyph(
   if (!pResBitmap)
     return nullptr;
 
-  auto pGlyph = std::make_unique<CFX_GlyphBitmap>(left, -top);
+  auto pGlyph = pdfium::MakeRetain<CFX_GlyphBitmap>(left, -top);
   pGlyph->GetBitmap()->TakeOver(std::move(pResBitmap));
   return pGlyph;
 }
@@ -26,8 +26,8 @@ class CPDF_Type3Cache final : public Retainable, public Observable {
  public:
   CONSTRUCT_VIA_MAKE_RETAIN;
 
-  const CFX_GlyphBitmap* LoadGlyph(uint32_t charcode,
-                                   const CFX_Matrix& mtMatrix);
+  RetainPtr<const CFX_GlyphBitmap> LoadGlyph(uint32_t charcode,
+                                             const CFX_Matrix& mtMatrix);
 
  private:
   using SizeKey = std::tuple<int, int, int, int>;
@@ -35,9 +35,9 @@ class CPDF_Type3Cache final : public Retainable, public Observable {
   explicit CPDF_Type3Cache(CPDF_Type3Font* pFont);
   ~CPDF_Type3Cache() override;
 
-  std::unique_ptr<CFX_GlyphBitmap> RenderGlyph(CPDF_Type3GlyphMap* pSize,
-                                               uint32_t charcode,
-                                               const CFX_Matrix& mtMatrix);
+  RetainPtr<CFX_GlyphBitmap> RenderGlyph(CPDF_Type3GlyphMap* pSize,
+                                         uint32_t charcode,
+                                         const CFX_Matrix& mtMatrix);
 
   RetainPtr<CPDF_Type3Font> const m_pFont;
   std::map<SizeKey, std::unique_ptr<CPDF_Type3GlyphMap>> m_SizeMap;
@@ -48,12 +48,13 @@ std::pair<int, int> CPDF_Type3GlyphMap::AdjustBlue(float top, float bottom) {
                         AdjustBlueHelper(bottom, &m_BottomBlue));
 }
 
-const CFX_GlyphBitmap* CPDF_Type3GlyphMap::GetBitmap(uint32_t charcode) const {
+RetainPtr<const CFX_GlyphBitmap> CPDF_Type3GlyphMap::GetBitmap(
+    uint32_t charcode) const {
   auto it = m_GlyphMap.find(charcode);
-  return it != m_GlyphMap.end() ? it->second.get() : nullptr;
+  return it != m_GlyphMap.end() ? it->second : nullptr;
 }
 
 void CPDF_Type3GlyphMap::SetBitmap(uint32_t charcode,
-                                   std::unique_ptr<CFX_GlyphBitmap> pMap) {
+                                   RetainPtr<CFX_GlyphBitmap> pMap) {
   m_GlyphMap[charcode] = std::move(pMap);
 }
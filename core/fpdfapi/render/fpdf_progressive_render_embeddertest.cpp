@@ -9,7 +9,10 @@
 #include "build/build_config.h"
 #include "core/fxge/cfx_defaultrenderdevice.h"
 #include "core/fxge/dib/fx_dib.h"
+#include "public/cpp/fpdf_scopers.h"
+#include "public/fpdf_edit.h"
 #include "public/fpdf_progressive.h"
+#include "public/fpdf_text.h"
 #include "testing/embedder_test.h"
 #include "testing/embedder_test_constants.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -298,6 +301,81 @@ TEST_F(FPDFProgressiveRenderEmbedderTest, RenderFormsWithPause) {
   UnloadPage(page);
 }
 
+TEST_F(FPDFProgressiveRenderEmbedderTest, RenderPageParsedWhileRendering) {
+  ASSERT_TRUE(OpenDocument("rectangles.pdf"));
+  ScopedFPDFPage page(FPDF_LoadPageForProgressiveRender(
+      document(), 0, /*visible_rect=*/nullptr));
+  ASSERT_TRUE(page);
+
+  FakePause pause(true);
+  bool render_done = StartRenderPage(page.get(), &pause);
+  EXPECT_FALSE(render_done);
+
+  while (!render_done) {
+    render_done = ContinueRenderPage(page.get(), &pause);
+  }
+  ScopedFPDFBitmap bitmap = FinishRenderPage(page.get());
+  CompareBitmap(bitmap.get(), 200, 300, pdfium::RectanglesChecksum());
+  EXPECT_EQ(8, FPDFPage_CountObjects(page.get()));
+  EXPECT_TRUE(FPDFPage_GenerateContent(page.get()));
+}
+
+TEST_F(FPDFProgressiveRenderEmbedderTest, RenderPageWithVisibleRect) {
+  ASSERT_TRUE(OpenDocument("rectangles.pdf"));
+  // This part of the page has 2 of its 8 rectangles.
+  const FS_RECTF visible_rect = {0, 140, 100, 0};
+  ScopedFPDFPage page(
+      FPDF_LoadPageForProgressiveRender(document(), 0, &visible_rect));
+  ASSERT_TRUE(page);
+
+  FakePause pause(false);
+  EXPECT_TRUE(StartRenderPage(page.get(), &pause));
+  ScopedFPDFBitmap bitmap = FinishRenderPage(page.get());
+  ASSERT_TRUE(bitmap);
+  EXPECT_EQ(2, FPDFPage_CountObjects(page.get()));
+
+  // The page is missing objects, so it cannot be saved, and it has no text
+  // page.
+  EXPECT_FALSE(FPDFPage_GenerateContent(page.get()));
+  EXPECT_FALSE(FPDFText_LoadPage(page.get()));
+  EXPECT_FALSE(FPDF_BuildPageDisplayList(page.get()));
+}
+
+TEST_F(FPDFProgressiveRenderEmbedderTest, UseUnrenderedPage) {
+  ASSERT_TRUE(OpenDocument("hello_world.pdf"));
+  ScopedFPDFPage page(FPDF_LoadPageForProgressiveRender(
+      document(), 0, /*visible_rect=*/nullptr));
+  ASSERT_TRUE(page);
+
+  // The page gets parsed on first use, rather than looking empty.
+  EXPECT_EQ(2, FPDFPage_CountObjects(page.get()));
+  ScopedFPDFTextPage text_page(FPDFText_LoadPage(page.get()));
+  ASSERT_TRUE(text_page);
+  EXPECT_EQ(30, FPDFText_CountChars(text_page.get()));
+
+  ScopedFPDFPage other_page(FPDF_LoadPageForProgressiveRender(
+      document(), 0, /*visible_rect=*/nullptr));
+  ASSERT_TRUE(other_page);
+  ScopedFPDFTextPage other_text_page(FPDFText_LoadPage(other_page.get()));
+  ASSERT_TRUE(other_text_page);
+  EXPECT_EQ(30, FPDFText_CountChars(other_text_page.get()));
+  EXPECT_FALSE(FPDFPage_HasTransparency(other_page.get()));
+  EXPECT_EQ(2, FPDFPage_CountObjects(other_page.get()));
+}
+
+TEST_F(FPDFProgressiveRenderEmbedderTest, BuildDisplayListForUnrenderedPage) {
+  ASSERT_TRUE(OpenDocument("hello_world.pdf"));
+  ScopedFPDFPage page(FPDF_LoadPageForProgressiveRender(
+      document(), 0, /*visible_rect=*/nullptr));
+  ASSERT_TRUE(page);
+
+  // The page gets parsed before building the display list, so that the
+  // display list has all of its text.
+  ASSERT_TRUE(FPDF_BuildPageDisplayList(page.get()));
+  ScopedFPDFBitmap bitmap = RenderLoadedPage(page.get());
+  CompareBitmap(bitmap.get(), 200, 200, pdfium::HelloWorldChecksum());
+}
+
 void FPDFProgressiveRenderEmbedderTest::VerifyRenderingWithColorScheme(
     int page_num,
     int flags,
@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "core/fxcodec/scanlinedecoder.h"
+#include "core/fxcodec/streaming_decoder.h"
 #include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fixed_zeroed_data_vector.h"
 #include "core/fxcrt/fx_extension.h"
@@ -24,16 +25,25 @@
 #include "core/fxcrt/span_util.h"
 #include "core/fxge/calculate_pitch.h"
 #include "third_party/base/check.h"
+#include "third_party/base/check_op.h"
 #include "third_party/base/containers/span.h"
 #include "third_party/base/notreached.h"
 #include "third_party/base/numerics/safe_conversions.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #if defined(USE_SYSTEM_ZLIB)
 #include <zlib.h>
 #else
 #include "third_party/zlib/zlib.h"
 #endif
 
+#if defined(PDF_USE_LIBDEFLATE)
+#include <libdeflate.h>
+#endif
+
 extern "C" {
 
 static void* my_alloc_func(void* opaque,
@@ -115,27 +125,76 @@ struct FlateDeleter {
   inline void operator()(z_stream* context) { FlateEnd(context); }
 };
 
-class CLZWDecoder {
- public:
-  CLZWDecoder(pdfium::span<const uint8_t> src_span, bool early_change);
+#if defined(PDF_USE_LIBDEFLATE)
+// For use with std::unique_ptr<libdeflate_decompressor>.
+struct LibdeflateDeleter {
+  inline void operator()(libdeflate_decompressor* decompressor) {
+    libdeflate_free_decompressor(decompressor);
+  }
+};
+#endif
 
-  bool Decode();
-  uint32_t GetSrcSize() const { return (src_bit_pos_ + 7) / 8; }
-  uint32_t GetDestSize() const { return dest_byte_pos_; }
-  std::unique_ptr<uint8_t, FxFreeDeleter> TakeDestBuf() {
-    return std::move(dest_buf_);
+// Decodes all of `src_buf` in one call, into `dest_buf`, which is expected to
+// hold all of the output. Not having to stop and resume lets the backend skip
+// maintaining its history window. Returns false if the output does not fit or
+// the data is invalid, leaving it to FlateUncompress() to decode incrementally
+// what it can.
+bool FlateUncompressWhole(pdfium::span<const uint8_t> src_buf,
+                          pdfium::span<uint8_t> dest_buf,
+                          uint32_t* dest_size,
+                          uint32_t* offset) {
+#if defined(PDF_USE_LIBDEFLATE)
+  std::unique_ptr<libdeflate_decompressor, LibdeflateDeleter> decompressor(
+      libdeflate_alloc_decompressor());
+  if (!decompressor)
+    return false;
+
+  size_t in_size = 0;
+  size_t out_size = 0;
+  if (libdeflate_zlib_decompress_ex(decompressor.get(), src_buf.data(),
+                                    src_buf.size(), dest_buf.data(),
+                                    dest_buf.size(), &in_size,
+                                    &out_size) != LIBDEFLATE_SUCCESS) {
+    return false;
   }
+  *dest_size = pdfium::base::checked_cast<uint32_t>(out_size);
+  *offset = pdfium::base::checked_cast<uint32_t>(in_size);
+  return true;
+#else
+  std::unique_ptr<z_stream, FlateDeleter> context(FlateInit());
+  FlateInput(context.get(), src_buf);
+  context->next_out = dest_buf.data();
+  context->avail_out = pdfium::base::checked_cast<uint32_t>(dest_buf.size());
+  if (inflate(context.get(), Z_FINISH) != Z_STREAM_END)
+    return false;
 
- private:
+  *dest_size = FlateGetPossiblyTruncatedTotalOut(context.get());
+  *offset = FlateGetPossiblyTruncatedTotalIn(context.get());
+  return true;
+#endif
+}
+
+// The string table of an LZW decoder.
+class LZWCodeTable {
+ public:
+  // Longest string DecodeString() produces.
+  static constexpr size_t kMaxStringSize = 4000;
+
+  explicit LZWCodeTable(bool early_change);
+
+  void Reset();
   void AddCode(uint32_t prefix_code, uint8_t append_char);
+  // Pushes the string for `code` onto the decode stack, last byte first.
   void DecodeString(uint32_t code);
-  void ExpandDestBuf(uint32_t additional_size);
+  void PushStack(uint8_t ch);
+  void ClearStack() { stack_len_ = 0; }
+  pdfium::span<const uint8_t> GetStack() const {
+    return decode_stack_.span().first(stack_len_);
+  }
+  uint8_t code_len() const { return code_len_; }
+  uint32_t current_code() const { return current_code_; }
 
-  pdfium::span<const uint8_t> const src_span_;
-  std::unique_ptr<uint8_t, FxFreeDeleter> dest_buf_;
-  uint32_t src_bit_pos_ = 0;
-  uint32_t dest_buf_size_ = 0;  // Actual allocated size.
-  uint32_t dest_byte_pos_ = 0;  // Size used.
+ private:
   uint32_t stack_len_ = 0;
   FixedZeroedDataVector<uint8_t> decode_stack_;
   const uint8_t early_change_;
@@ -144,14 +203,17 @@ class CLZWDecoder {
   FixedZeroedDataVector<uint32_t> codes_;
 };
 
-CLZWDecoder::CLZWDecoder(pdfium::span<const uint8_t> src_span,
-                         bool early_change)
-    : src_span_(src_span),
-      decode_stack_(4000),
+LZWCodeTable::LZWCodeTable(bool early_change)
+    : decode_stack_(kMaxStringSize),
       early_change_(early_change ? 1 : 0),
       codes_(5021) {}
 
-void CLZWDecoder::AddCode(uint32_t prefix_code, uint8_t append_char) {
+void LZWCodeTable::Reset() {
+  code_len_ = 9;
+  current_code_ = 0;
+}
+
+void LZWCodeTable::AddCode(uint32_t prefix_code, uint8_t append_char) {
   if (current_code_ + early_change_ == 4094)
     return;
 
@@ -165,7 +227,7 @@ void CLZWDecoder::AddCode(uint32_t prefix_code, uint8_t append_char) {
     code_len_ = 12;
 }
 
-void CLZWDecoder::DecodeString(uint32_t code) {
+void LZWCodeTable::DecodeString(uint32_t code) {
   pdfium::span<uint8_t> decode_span = decode_stack_.writable_span();
   pdfium::span<const uint32_t> codes_span = codes_.span();
   while (true) {
@@ -186,6 +248,37 @@ void CLZWDecoder::DecodeString(uint32_t code) {
   decode_span[stack_len_++] = static_cast<uint8_t>(code);
 }
 
+void LZWCodeTable::PushStack(uint8_t ch) {
+  if (stack_len_ < decode_stack_.size())
+    decode_stack_.writable_span()[stack_len_++] = ch;
+}
+
+class CLZWDecoder {
+ public:
+  CLZWDecoder(pdfium::span<const uint8_t> src_span, bool early_change);
+
+  bool Decode();
+  uint32_t GetSrcSize() const { return (src_bit_pos_ + 7) / 8; }
+  uint32_t GetDestSize() const { return dest_byte_pos_; }
+  std::unique_ptr<uint8_t, FxFreeDeleter> TakeDestBuf() {
+    return std::move(dest_buf_);
+  }
+
+ private:
+  void ExpandDestBuf(uint32_t additional_size);
+
+  pdfium::span<const uint8_t> const src_span_;
+  std::unique_ptr<uint8_t, FxFreeDeleter> dest_buf_;
+  uint32_t src_bit_pos_ = 0;
+  uint32_t dest_buf_size_ = 0;  // Actual allocated size.
+  uint32_t dest_byte_pos_ = 0;  // Size used.
+  LZWCodeTable table_;
+};
+
+CLZWDecoder::CLZWDecoder(pdfium::span<const uint8_t> src_span,
+                         bool early_change)
+    : src_span_(src_span), table_(early_change) {}
+
 void CLZWDecoder::ExpandDestBuf(uint32_t additional_size) {
   FX_SAFE_UINT32 new_size = std::max(dest_buf_size_ / 2, additional_size);
   new_size += dest_buf_size_;
@@ -199,7 +292,6 @@ void CLZWDecoder::ExpandDestBuf(uint32_t additional_size) {
 }
 
 bool CLZWDecoder::Decode() {
-  pdfium::span<uint8_t> decode_span = decode_stack_.writable_span();
   uint32_t old_code = 0xFFFFFFFF;
   uint8_t last_char = 0;
 
@@ -208,12 +300,13 @@ bool CLZWDecoder::Decode() {
   dest_buf_size_ = 512;
   dest_buf_.reset(FX_Alloc(uint8_t, dest_buf_size_));
   while (true) {
-    if (src_bit_pos_ + code_len_ > src_span_.size() * 8)
+    const uint8_t code_len = table_.code_len();
+    if (src_bit_pos_ + code_len > src_span_.size() * 8)
       break;
 
     int byte_pos = src_bit_pos_ / 8;
     int bit_pos = src_bit_pos_ % 8;
-    uint8_t bit_left = code_len_;
+    uint8_t bit_left = code_len;
     uint32_t code = 0;
     if (bit_pos) {
       bit_left -= 8 - bit_pos;
@@ -227,7 +320,7 @@ bool CLZWDecoder::Decode() {
       if (bit_left)
         code |= src_span_[byte_pos] >> (8 - bit_left);
     }
-    src_bit_pos_ += code_len_;
+    src_bit_pos_ += code_len;
 
     if (code < 256) {
       if (dest_byte_pos_ >= dest_buf_size_) {
@@ -240,13 +333,12 @@ bool CLZWDecoder::Decode() {
       dest_byte_pos_++;
       last_char = (uint8_t)code;
       if (old_code != 0xFFFFFFFF)
-        AddCode(old_code, last_char);
+        table_.AddCode(old_code, last_char);
       old_code = code;
       continue;
     }
     if (code == 256) {
-      code_len_ = 9;
-      current_code_ = 0;
+      table_.Reset();
       old_code = 0xFFFFFFFF;
       continue;
     }
@@ -258,17 +350,17 @@ bool CLZWDecoder::Decode() {
       return false;
 
     DCHECK(old_code < 256 || old_code >= 258);
-    stack_len_ = 0;
-    if (code - 258 >= current_code_) {
-      if (stack_len_ < decode_stack_.size())
-        decode_span[stack_len_++] = last_char;
-      DecodeString(old_code);
+    table_.ClearStack();
+    if (code - 258 >= table_.current_code()) {
+      table_.PushStack(last_char);
+      table_.DecodeString(old_code);
     } else {
-      DecodeString(code);
+      table_.DecodeString(code);
     }
+    pdfium::span<const uint8_t> stack = table_.GetStack();
 
     FX_SAFE_UINT32 safe_required_size = dest_byte_pos_;
-    safe_required_size += stack_len_;
+    safe_required_size += stack.size();
     if (!safe_required_size.IsValid())
       return false;
 
@@ -279,14 +371,14 @@ bool CLZWDecoder::Decode() {
         return false;
     }
 
-    for (uint32_t i = 0; i < stack_len_; i++)
-      dest_buf_.get()[dest_byte_pos_ + i] = decode_span[stack_len_ - i - 1];
-    dest_byte_pos_ += stack_len_;
-    last_char = decode_span[stack_len_ - 1];
-    if (old_code >= 258 && old_code - 258 >= current_code_)
+    for (size_t i = 0; i < stack.size(); i++)
+      dest_buf_.get()[dest_byte_pos_ + i] = stack[stack.size() - i - 1];
+    dest_byte_pos_ += stack.size();
+    last_char = stack.back();
+    if (old_code >= 258 && old_code - 258 >= table_.current_code())
       break;
 
-    AddCode(old_code, last_char);
+    table_.AddCode(old_code, last_char);
     old_code = code;
   }
   return dest_byte_pos_ != 0;
@@ -304,74 +396,303 @@ uint8_t PathPredictor(int a, int b, int c) {
   return (uint8_t)c;
 }
 
+#if defined(__SSE2__)
+// The SSE2 functions below undo a PNG filter for as many bytes at the start of
+// a row as they can, and return how many. The scalar loops finish the row.
+
+template <uint32_t kBpp>
+__m128i LoadPixel(const uint8_t* src) {
+  uint32_t value = 0;
+  memcpy(&value, src, kBpp);
+  return _mm_cvtsi32_si128(value);
+}
+
+template <uint32_t kBpp>
+void StorePixel(uint8_t* dest, __m128i pixel) {
+  uint32_t value = _mm_cvtsi128_si32(pixel);
+  memcpy(dest, &value, kBpp);
+}
+
+// Adds to each pixel of `x` all the pixels before it, and `carry`, which holds
+// the pixel to the left of `x` in every pixel position.
+__m128i PrefixSumPixels1(__m128i x, __m128i carry) {
+  x = _mm_add_epi8(x, _mm_slli_si128(x, 1));
+  x = _mm_add_epi8(x, _mm_slli_si128(x, 2));
+  x = _mm_add_epi8(x, _mm_slli_si128(x, 4));
+  x = _mm_add_epi8(x, _mm_slli_si128(x, 8));
+  return _mm_add_epi8(x, carry);
+}
+
+__m128i PrefixSumPixels3(__m128i x, __m128i carry) {
+  // Only the first 4 pixels, in the first 12 bytes, are used.
+  x = _mm_add_epi8(x, _mm_slli_si128(x, 3));
+  x = _mm_add_epi8(x, _mm_slli_si128(x, 6));
+  return _mm_add_epi8(x, carry);
+}
+
+__m128i PrefixSumPixels4(__m128i x, __m128i carry) {
+  x = _mm_add_epi8(x, _mm_slli_si128(x, 4));
+  x = _mm_add_epi8(x, _mm_slli_si128(x, 8));
+  return _mm_add_epi8(x, carry);
+}
+
+// Returns the last pixel of `x` in every pixel position.
+__m128i BroadcastLastPixel1(__m128i x) {
+  x = _mm_srli_si128(x, 15);
+  x = _mm_unpacklo_epi8(x, x);
+  x = _mm_unpacklo_epi16(x, x);
+  return _mm_shuffle_epi32(x, 0);
+}
+
+__m128i BroadcastLastPixel3(__m128i x) {
+  x = _mm_and_si128(_mm_srli_si128(x, 9), _mm_cvtsi32_si128(0xffffff));
+  x = _mm_or_si128(x, _mm_slli_si128(x, 3));
+  return _mm_or_si128(x, _mm_slli_si128(x, 6));
+}
+
+__m128i BroadcastLastPixel4(__m128i x) {
+  return _mm_shuffle_epi32(x, 0xff);
+}
+
+// `dest` may be `src`.
+uint32_t UnfilterSubSSE2(uint8_t* dest,
+                         const uint8_t* src,
+                         uint32_t size,
+                         uint32_t bpp) {
+  __m128i carry = _mm_setzero_si128();
+  uint32_t i = 0;
+  switch (bpp) {
+    case 1:
+      for (; i + 16 <= size; i += 16) {
+        __m128i x = PrefixSumPixels1(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)), carry);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), x);
+        carry = BroadcastLastPixel1(x);
+      }
+      break;
+    case 3:
+      // Loads 16 bytes, but only stores the first 12.
+      for (; i + 16 <= size; i += 12) {
+        __m128i x = PrefixSumPixels3(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)), carry);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dest + i), x);
+        StorePixel<4>(dest + i + 8, _mm_srli_si128(x, 8));
+        carry = BroadcastLastPixel3(x);
+      }
+      break;
+    case 4:
+      for (; i + 16 <= size; i += 16) {
+        __m128i x = PrefixSumPixels4(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)), carry);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), x);
+        carry = BroadcastLastPixel4(x);
+      }
+      break;
+  }
+  return i;
+}
+
+uint32_t UnfilterUpSSE2(uint8_t* dest,
+                        const uint8_t* src,
+                        const uint8_t* last,
+                        uint32_t size) {
+  uint32_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    __m128i up = _mm_loadu_si128(reinterpret_cast<const __m128i*>(last + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i),
+                     _mm_add_epi8(x, up));
+  }
+  return i;
+}
+
+// Average and Paeth depend on the pixel to the left, so these work a pixel
+// at a time, on all of its bytes at once.
+template <uint32_t kBpp>
+uint32_t UnfilterAverageSSE2(uint8_t* dest,
+                             const uint8_t* src,
+                             const uint8_t* last,
+                             uint32_t size) {
+  const __m128i one = _mm_set1_epi8(1);
+  __m128i left = _mm_setzero_si128();
+  uint32_t i = 0;
+  for (; i + kBpp <= size; i += kBpp) {
+    __m128i up = LoadPixel<kBpp>(last + i);
+    // _mm_avg_epu8() rounds up, and the filter rounds down.
+    __m128i average = _mm_sub_epi8(
+        _mm_avg_epu8(left, up), _mm_and_si128(_mm_xor_si128(left, up), one));
+    left = _mm_add_epi8(LoadPixel<kBpp>(src + i), average);
+    StorePixel<kBpp>(dest + i, left);
+  }
+  return i;
+}
+
+__m128i Abs16(__m128i x) {
+  return _mm_max_epi16(x, _mm_sub_epi16(_mm_setzero_si128(), x));
+}
+
+__m128i Select16(__m128i mask, __m128i if_true, __m128i if_false) {
+  return _mm_or_si128(_mm_and_si128(mask, if_true),
+                      _mm_andnot_si128(mask, if_false));
+}
+
+// Same as PathPredictor(), on 16-bit lanes.
+template <uint32_t kBpp>
+uint32_t UnfilterPaethSSE2(uint8_t* dest,
+                           const uint8_t* src,
+                           const uint8_t* last,
+                           uint32_t size) {
+  const __m128i zero = _mm_setzero_si128();
+  __m128i left = zero;
+  __m128i upper_left = zero;
+  uint32_t i = 0;
+  for (; i + kBpp <= size; i += kBpp) {
+    __m128i up = _mm_unpacklo_epi8(LoadPixel<kBpp>(last + i), zero);
+    __m128i pa = Abs16(_mm_sub_epi16(up, upper_left));
+    __m128i pb = Abs16(_mm_sub_epi16(left, upper_left));
+    __m128i pc = Abs16(_mm_sub_epi16(_mm_add_epi16(left, up),
+                                     _mm_add_epi16(upper_left, upper_left)));
+    __m128i smallest = _mm_min_epi16(pa, _mm_min_epi16(pb, pc));
+    __m128i nearest =
+        Select16(_mm_cmpeq_epi16(smallest, pb), up, upper_left);
+    nearest = Select16(_mm_cmpeq_epi16(smallest, pa), left, nearest);
+    __m128i pixel = _mm_add_epi8(LoadPixel<kBpp>(src + i),
+                                 _mm_packus_epi16(nearest, nearest));
+    StorePixel<kBpp>(dest + i, pixel);
+    left = _mm_unpacklo_epi8(pixel, zero);
+    upper_left = up;
+  }
+  return i;
+}
+#endif  // defined(__SSE2__)
+
+// The functions below undo a PNG filter on the first `size` bytes of a row.
+// `last` is the previous row, or nullptr for the first row. `dest` may be
+// `src`.
+
+void UnfilterSub(uint8_t* dest,
+                 const uint8_t* src,
+                 uint32_t size,
+                 uint32_t bpp) {
+  uint32_t i = 0;
+#if defined(__SSE2__)
+  i = UnfilterSubSSE2(dest, src, size, bpp);
+#endif
+  for (; i < size && i < bpp; ++i)
+    dest[i] = src[i];
+  for (; i < size; ++i)
+    dest[i] = src[i] + dest[i - bpp];
+}
+
+void UnfilterUp(uint8_t* dest,
+                const uint8_t* src,
+                const uint8_t* last,
+                uint32_t size) {
+  if (!last) {
+    memmove(dest, src, size);
+    return;
+  }
+
+  uint32_t i = 0;
+#if defined(__SSE2__)
+  i = UnfilterUpSSE2(dest, src, last, size);
+#endif
+  for (; i < size; ++i)
+    dest[i] = src[i] + last[i];
+}
+
+void UnfilterAverage(uint8_t* dest,
+                     const uint8_t* src,
+                     const uint8_t* last,
+                     uint32_t size,
+                     uint32_t bpp) {
+  uint32_t i = 0;
+  if (!last) {
+    for (; i < size && i < bpp; ++i)
+      dest[i] = src[i];
+    for (; i < size; ++i)
+      dest[i] = src[i] + dest[i - bpp] / 2;
+    return;
+  }
+
+#if defined(__SSE2__)
+  if (bpp == 4)
+    i = UnfilterAverageSSE2<4>(dest, src, last, size);
+#endif
+  for (; i < size && i < bpp; ++i)
+    dest[i] = src[i] + last[i] / 2;
+  for (; i < size; ++i)
+    dest[i] = src[i] + (dest[i - bpp] + last[i]) / 2;
+}
+
+void UnfilterPaeth(uint8_t* dest,
+                   const uint8_t* src,
+                   const uint8_t* last,
+                   uint32_t size,
+                   uint32_t bpp) {
+  // With no row above, Paeth always picks the left byte.
+  if (!last) {
+    UnfilterSub(dest, src, size, bpp);
+    return;
+  }
+
+  uint32_t i = 0;
+#if defined(__SSE2__)
+  if (bpp == 3)
+    i = UnfilterPaethSSE2<3>(dest, src, last, size);
+  else if (bpp == 4)
+    i = UnfilterPaethSSE2<4>(dest, src, last, size);
+#endif
+  for (; i < size && i < bpp; ++i)
+    dest[i] = src[i] + last[i];
+  for (; i < size; ++i)
+    dest[i] = src[i] + PathPredictor(dest[i - bpp], last[i], last[i - bpp]);
+}
+
+// Undoes the PNG filter `tag` on a row, which may be cut short at the end of
+// the data.
+void UnfilterRow(uint8_t tag,
+                 pdfium::span<uint8_t> dest_span,
+                 pdfium::span<const uint8_t> src_span,
+                 pdfium::span<const uint8_t> last_span,
+                 uint32_t bpp) {
+  CHECK_EQ(dest_span.size(), src_span.size());
+  CHECK(last_span.empty() || last_span.size() >= src_span.size());
+  uint8_t* dest = dest_span.data();
+  const uint8_t* src = src_span.data();
+  const uint8_t* last = last_span.empty() ? nullptr : last_span.data();
+  const uint32_t size = pdfium::base::checked_cast<uint32_t>(src_span.size());
+  switch (tag) {
+    case 1:
+      UnfilterSub(dest, src, size, bpp);
+      return;
+    case 2:
+      UnfilterUp(dest, src, last, size);
+      return;
+    case 3:
+      UnfilterAverage(dest, src, last, size, bpp);
+      return;
+    case 4:
+      UnfilterPaeth(dest, src, last, size, bpp);
+      return;
+    default:
+      memmove(dest, src, size);
+      return;
+  }
+}
+
 void PNG_PredictLine(pdfium::span<uint8_t> dest_span,
                      pdfium::span<const uint8_t> src_span,
                      pdfium::span<const uint8_t> last_span,
                      int bpc,
                      int nColors,
                      int nPixels) {
-  uint8_t* pDestData = dest_span.data();
-  const uint8_t* pSrcData = src_span.data();
-  const uint8_t* pLastLine = last_span.data();
   const uint32_t row_size = fxge::CalculatePitch8OrDie(bpc, nColors, nPixels);
   const uint32_t BytesPerPixel = (bpc * nColors + 7) / 8;
-  uint8_t tag = pSrcData[0];
-  if (tag == 0) {
-    memmove(pDestData, pSrcData + 1, row_size);
-    return;
-  }
-  for (uint32_t byte = 0; byte < row_size; ++byte) {
-    uint8_t raw_byte = pSrcData[byte + 1];
-    switch (tag) {
-      case 1: {
-        uint8_t left = 0;
-        if (byte >= BytesPerPixel) {
-          left = pDestData[byte - BytesPerPixel];
-        }
-        pDestData[byte] = raw_byte + left;
-        break;
-      }
-      case 2: {
-        uint8_t up = 0;
-        if (pLastLine) {
-          up = pLastLine[byte];
-        }
-        pDestData[byte] = raw_byte + up;
-        break;
-      }
-      case 3: {
-        uint8_t left = 0;
-        if (byte >= BytesPerPixel) {
-          left = pDestData[byte - BytesPerPixel];
-        }
-        uint8_t up = 0;
-        if (pLastLine) {
-          up = pLastLine[byte];
-        }
-        pDestData[byte] = raw_byte + (up + left) / 2;
-        break;
-      }
-      case 4: {
-        uint8_t left = 0;
-        if (byte >= BytesPerPixel) {
-          left = pDestData[byte - BytesPerPixel];
-        }
-        uint8_t up = 0;
-        if (pLastLine) {
-          up = pLastLine[byte];
-        }
-        uint8_t upper_left = 0;
-        if (byte >= BytesPerPixel && pLastLine) {
-          upper_left = pLastLine[byte - BytesPerPixel];
-        }
-        pDestData[byte] = raw_byte + PathPredictor(left, up, upper_left);
-        break;
-      }
-      default:
-        pDestData[byte] = raw_byte;
-        break;
-    }
-  }
+  UnfilterRow(src_span[0], dest_span.first(row_size),
+              src_span.subspan(1, row_size),
+              last_span.empty() ? last_span : last_span.first(row_size),
+              BytesPerPixel);
 }
 
 bool PNG_Predictor(int Colors,
@@ -398,81 +719,20 @@ bool PNG_Predictor(int Colors,
   const uint32_t last_row_size = *data_size % src_row_size;
   std::unique_ptr<uint8_t, FxFreeDeleter> dest_buf(
       FX_Alloc2D(uint8_t, row_size, row_count));
-  uint32_t byte_cnt = 0;
+  const uint32_t BytesPerPixel = (Colors * BitsPerComponent + 7) / 8;
   const uint8_t* pSrcData = data_buf->get();
   uint8_t* pDestData = dest_buf.get();
   const uint8_t* pPrevDestData = nullptr;
+  uint32_t remaining = *data_size;
   for (uint32_t row = 0; row < row_count; row++) {
-    uint8_t tag = pSrcData[0];
-    byte_cnt++;
-    if (tag == 0) {
-      uint32_t move_size = row_size;
-      if ((row + 1) * (move_size + 1) > *data_size) {
-        move_size = last_row_size - 1;
-      }
-      memcpy(pDestData, pSrcData + 1, move_size);
-      pSrcData += move_size + 1;
-      pPrevDestData = pDestData;
-      pDestData += move_size;
-      byte_cnt += move_size;
-      continue;
-    }
-
-    const uint32_t BytesPerPixel = (Colors * BitsPerComponent + 7) / 8;
-    for (uint32_t byte = 0; byte < row_size && byte_cnt < *data_size;
-         ++byte, ++byte_cnt) {
-      uint8_t raw_byte = pSrcData[byte + 1];
-      switch (tag) {
-        case 1: {
-          uint8_t left = 0;
-          if (byte >= BytesPerPixel) {
-            left = pDestData[byte - BytesPerPixel];
-          }
-          pDestData[byte] = raw_byte + left;
-          break;
-        }
-        case 2: {
-          uint8_t up = 0;
-          if (pPrevDestData) {
-            up = pPrevDestData[byte];
-          }
-          pDestData[byte] = raw_byte + up;
-          break;
-        }
-        case 3: {
-          uint8_t left = 0;
-          if (byte >= BytesPerPixel) {
-            left = pDestData[byte - BytesPerPixel];
-          }
-          uint8_t up = 0;
-          if (pPrevDestData) {
-            up = pPrevDestData[byte];
-          }
-          pDestData[byte] = raw_byte + (up + left) / 2;
-          break;
-        }
-        case 4: {
-          uint8_t left = 0;
-          if (byte >= BytesPerPixel) {
-            left = pDestData[byte - BytesPerPixel];
-          }
-          uint8_t up = 0;
-          if (pPrevDestData) {
-            up = pPrevDestData[byte];
-          }
-          uint8_t upper_left = 0;
-          if (pPrevDestData && byte >= BytesPerPixel) {
-            upper_left = pPrevDestData[byte - BytesPerPixel];
-          }
-          pDestData[byte] = raw_byte + PathPredictor(left, up, upper_left);
-          break;
-        }
-        default:
-          pDestData[byte] = raw_byte;
-          break;
-      }
-    }
-    pSrcData += src_row_size;
+    // Every row has its tag byte, but the last one may be cut short.
+    const uint32_t size = std::min(row_size, remaining - 1);
+    UnfilterRow(pSrcData[0], {pDestData, size}, {pSrcData + 1, size},
+                pPrevDestData ? pdfium::make_span(pPrevDestData, size)
+                              : pdfium::span<const uint8_t>(),
+                BytesPerPixel);
+    remaining -= size + 1;
+    pSrcData += size + 1;
     pPrevDestData = pDestData;
     pDestData += row_size;
   }
@@ -515,6 +775,9 @@ void TIFF_PredictLine(uint8_t* dest_buf,
       dest_buf[i] = pixel >> 8;
       dest_buf[i + 1] = (uint8_t)pixel;
     }
+  } else if (BitsPerComponent == 8) {
+    // Same as the PNG Sub filter, in place.
+    UnfilterSub(dest_buf, dest_buf, row_size, BytesPerPixel);
   } else {
     for (uint32_t i = BytesPerPixel; i < row_size; i++) {
       dest_buf[i] += dest_buf[i - BytesPerPixel];
@@ -552,13 +815,38 @@ void FlateUncompress(pdfium::span<const uint8_t> src_buf,
   dest_buf->reset();
   *dest_size = 0;
 
+  // `orig_size` may come from the document, so it does not get to allocate
+  // more than this up front.
+  const uint32_t kMaxInitialAllocSize = 10000000;
+
+  // Inflating expands data by at most this much, which bounds believable
+  // `orig_size` values.
+  constexpr uint32_t kMaxCompressionRatio = 1032;
+  if (orig_size && orig_size <= kMaxInitialAllocSize &&
+      orig_size / kMaxCompressionRatio <= src_buf.size()) {
+    std::unique_ptr<uint8_t, FxFreeDeleter> whole_buf(
+        FX_TryAlloc(uint8_t, orig_size));
+    if (whole_buf && FlateUncompressWhole(src_buf, {whole_buf.get(), orig_size},
+                                          dest_size, offset)) {
+      // Do not hold on to a buffer much larger than the data.
+      if (*dest_size < orig_size / 2) {
+        std::unique_ptr<uint8_t, FxFreeDeleter> result_buf(
+            FX_Alloc(uint8_t, *dest_size));
+        memcpy(result_buf.get(), whole_buf.get(), *dest_size);
+        whole_buf = std::move(result_buf);
+      }
+      *dest_buf = std::move(whole_buf);
+      return;
+    }
+    *dest_size = 0;
+  }
+
   std::unique_ptr<z_stream, FlateDeleter> context(FlateInit());
   if (!context)
     return;
 
   FlateInput(context.get(), src_buf);
 
-  const uint32_t kMaxInitialAllocSize = 10000000;
   uint32_t guess_size =
       orig_size ? orig_size
                 : pdfium::base::checked_cast<uint32_t>(src_buf.size() * 2);
@@ -816,6 +1104,321 @@ void FlatePredictorScanlineDecoder::GetNextLineWithoutPredictedPitch() {
   }
 }
 
+class FlateStreamingDecoder final : public StreamingDecoder {
+ public:
+  explicit FlateStreamingDecoder(std::unique_ptr<StreamingDecoder> pUpstream);
+  ~FlateStreamingDecoder() override;
+
+  // StreamingDecoder:
+  size_t Read(pdfium::span<uint8_t> buffer) override;
+  bool HasError() const override;
+
+ private:
+  std::unique_ptr<StreamingDecoder> const m_pUpstream;
+  std::unique_ptr<z_stream, FlateDeleter> const m_pContext;
+  DataVector<uint8_t> m_InputBuffer;
+  bool m_bInputEOF = false;
+  bool m_bDone = false;
+};
+
+FlateStreamingDecoder::FlateStreamingDecoder(
+    std::unique_ptr<StreamingDecoder> pUpstream)
+    : m_pUpstream(std::move(pUpstream)),
+      m_pContext(FlateInit()),
+      m_InputBuffer(kChunkSize) {}
+
+FlateStreamingDecoder::~FlateStreamingDecoder() = default;
+
+size_t FlateStreamingDecoder::Read(pdfium::span<uint8_t> buffer) {
+  size_t written = 0;
+  while (!m_bDone && written < buffer.size()) {
+    if (m_pContext->avail_in == 0 && !m_bInputEOF) {
+      const size_t size = m_pUpstream->Read(m_InputBuffer);
+      m_bInputEOF = size < m_InputBuffer.size();
+      FlateInput(m_pContext.get(),
+                 pdfium::make_span(m_InputBuffer).first(size));
+    }
+
+    // Like FlateUncompress(), stop at `kMaxTotalOutSize`.
+    const uint32_t total_out =
+        FlateGetPossiblyTruncatedTotalOut(m_pContext.get());
+    const uint32_t avail_out = static_cast<uint32_t>(std::min<size_t>(
+        buffer.size() - written, kMaxTotalOutSize - total_out));
+    if (avail_out == 0) {
+      m_bDone = true;
+      break;
+    }
+
+    m_pContext->next_out = buffer.subspan(written).data();
+    m_pContext->avail_out = avail_out;
+    const int ret = inflate(m_pContext.get(), Z_SYNC_FLUSH);
+    written += avail_out - m_pContext->avail_out;
+
+    // Z_BUF_ERROR only means inflate() needs more input. Like
+    // FlateUncompress(), treat any other failure as the end of the data.
+    if (ret == Z_OK ||
+        (ret == Z_BUF_ERROR && m_pContext->avail_in == 0 && !m_bInputEOF)) {
+      continue;
+    }
+    m_bDone = true;
+  }
+  return written;
+}
+
+bool FlateStreamingDecoder::HasError() const {
+  return m_pUpstream->HasError();
+}
+
+class LZWStreamingDecoder final : public ChunkedStreamingDecoder {
+ public:
+  LZWStreamingDecoder(std::unique_ptr<StreamingDecoder> pUpstream,
+                      bool early_change);
+  ~LZWStreamingDecoder() override;
+
+  // StreamingDecoder:
+  bool HasError() const override;
+
+ private:
+  static constexpr uint32_t kInvalidCode = 0xFFFFFFFF;
+
+  // ChunkedStreamingDecoder:
+  // Same as one iteration of the loop in CLZWDecoder::Decode().
+  bool DecodeChunk(pdfium::span<uint8_t> chunk, size_t* size) override;
+
+  bool ReadCode(uint32_t* code);
+
+  StreamingDecoderInput m_Input;
+  LZWCodeTable m_Table;
+  uint32_t m_BitBuf = 0;
+  uint8_t m_BitCount = 0;
+  uint32_t m_OldCode = kInvalidCode;
+  uint8_t m_LastChar = 0;
+  bool m_bDone = false;
+  bool m_bHasOutput = false;
+  bool m_bError = false;
+};
+
+LZWStreamingDecoder::LZWStreamingDecoder(
+    std::unique_ptr<StreamingDecoder> pUpstream,
+    bool early_change)
+    : ChunkedStreamingDecoder(LZWCodeTable::kMaxStringSize),
+      m_Input(std::move(pUpstream)),
+      m_Table(early_change) {}
+
+LZWStreamingDecoder::~LZWStreamingDecoder() = default;
+
+bool LZWStreamingDecoder::HasError() const {
+  // CLZWDecoder::Decode() also fails when it decodes nothing.
+  return m_bError || (m_bDone && !m_bHasOutput) || m_Input.HasError();
+}
+
+bool LZWStreamingDecoder::DecodeChunk(pdfium::span<uint8_t> chunk,
+                                      size_t* size) {
+  uint32_t code;
+  if (m_bDone || !ReadCode(&code)) {
+    m_bDone = true;
+    return false;
+  }
+
+  if (code < 256) {
+    chunk[0] = static_cast<uint8_t>(code);
+    *size = 1;
+    m_bHasOutput = true;
+    m_LastChar = static_cast<uint8_t>(code);
+    if (m_OldCode != kInvalidCode)
+      m_Table.AddCode(m_OldCode, m_LastChar);
+    m_OldCode = code;
+    return true;
+  }
+  if (code == 256) {
+    m_Table.Reset();
+    m_OldCode = kInvalidCode;
+    return true;
+  }
+  if (code == 257) {
+    m_bDone = true;
+    return false;
+  }
+
+  // Case where |code| is 258 or greater.
+  if (m_OldCode == kInvalidCode) {
+    m_bError = true;
+    m_bDone = true;
+    return false;
+  }
+
+  m_Table.ClearStack();
+  if (code - 258 >= m_Table.current_code()) {
+    m_Table.PushStack(m_LastChar);
+    m_Table.DecodeString(m_OldCode);
+  } else {
+    m_Table.DecodeString(code);
+  }
+  pdfium::span<const uint8_t> stack = m_Table.GetStack();
+  for (size_t i = 0; i < stack.size(); i++)
+    chunk[i] = stack[stack.size() - i - 1];
+  *size = stack.size();
+  m_bHasOutput = true;
+  m_LastChar = stack.back();
+  if (m_OldCode >= 258 && m_OldCode - 258 >= m_Table.current_code()) {
+    // Hand out this chunk, then stop.
+    m_bDone = true;
+    return true;
+  }
+
+  m_Table.AddCode(m_OldCode, m_LastChar);
+  m_OldCode = code;
+  return true;
+}
+
+bool LZWStreamingDecoder::ReadCode(uint32_t* code) {
+  const uint8_t code_len = m_Table.code_len();
+  while (m_BitCount < code_len) {
+    uint8_t byte;
+    if (!m_Input.ReadByte(&byte))
+      return false;
+
+    // Bits above the pending ones get shifted out, and are never read again.
+    m_BitBuf = (m_BitBuf << 8) | byte;
+    m_BitCount += 8;
+  }
+  m_BitCount -= code_len;
+  *code = (m_BitBuf >> m_BitCount) & ((1u << code_len) - 1);
+  return true;
+}
+
+class PNGPredictorStreamingDecoder final : public ChunkedStreamingDecoder {
+ public:
+  PNGPredictorStreamingDecoder(std::unique_ptr<StreamingDecoder> pUpstream,
+                               int Colors,
+                               int BitsPerComponent,
+                               int Columns,
+                               uint32_t row_size);
+  ~PNGPredictorStreamingDecoder() override;
+
+  // StreamingDecoder:
+  bool HasError() const override;
+
+ private:
+  // ChunkedStreamingDecoder:
+  // Same as one row of PNG_Predictor().
+  bool DecodeChunk(pdfium::span<uint8_t> chunk, size_t* size) override;
+
+  std::unique_ptr<StreamingDecoder> const m_pUpstream;
+  const int m_Colors;
+  const int m_BitsPerComponent;
+  const int m_Columns;
+  DataVector<uint8_t> m_SrcRow;
+  // Starts out as zeros, as PNG_PredictLine() expects for the first row.
+  DataVector<uint8_t> m_LastRow;
+  bool m_bEOF = false;
+  bool m_bHasRows = false;
+};
+
+PNGPredictorStreamingDecoder::PNGPredictorStreamingDecoder(
+    std::unique_ptr<StreamingDecoder> pUpstream,
+    int Colors,
+    int BitsPerComponent,
+    int Columns,
+    uint32_t row_size)
+    : ChunkedStreamingDecoder(row_size),
+      m_pUpstream(std::move(pUpstream)),
+      m_Colors(Colors),
+      m_BitsPerComponent(BitsPerComponent),
+      m_Columns(Columns),
+      m_SrcRow(row_size + 1),
+      m_LastRow(row_size) {}
+
+PNGPredictorStreamingDecoder::~PNGPredictorStreamingDecoder() = default;
+
+bool PNGPredictorStreamingDecoder::HasError() const {
+  // PNG_Predictor() also fails on empty input.
+  return (m_bEOF && !m_bHasRows) || m_pUpstream->HasError();
+}
+
+bool PNGPredictorStreamingDecoder::DecodeChunk(pdfium::span<uint8_t> chunk,
+                                               size_t* size) {
+  if (m_bEOF)
+    return false;
+
+  const size_t src_size = m_pUpstream->Read(m_SrcRow);
+  if (src_size < m_SrcRow.size()) {
+    m_bEOF = true;
+    if (src_size == 0)
+      return false;
+
+    // Like PNG_Predictor(), only hand out the bytes of the last row that are
+    // there. The padding does not affect them.
+    fxcrt::spanclr(pdfium::make_span(m_SrcRow).subspan(src_size));
+  }
+
+  PNG_PredictLine(chunk, m_SrcRow, m_LastRow, m_BitsPerComponent, m_Colors,
+                  m_Columns);
+  fxcrt::spancpy(pdfium::make_span(m_LastRow), chunk);
+  *size = src_size - 1;
+  m_bHasRows = true;
+  return true;
+}
+
+class TIFFPredictorStreamingDecoder final : public ChunkedStreamingDecoder {
+ public:
+  TIFFPredictorStreamingDecoder(std::unique_ptr<StreamingDecoder> pUpstream,
+                                int Colors,
+                                int BitsPerComponent,
+                                int Columns,
+                                uint32_t row_size);
+  ~TIFFPredictorStreamingDecoder() override;
+
+  // StreamingDecoder:
+  bool HasError() const override;
+
+ private:
+  // ChunkedStreamingDecoder:
+  // Same as one row of TIFF_Predictor().
+  bool DecodeChunk(pdfium::span<uint8_t> chunk, size_t* size) override;
+
+  std::unique_ptr<StreamingDecoder> const m_pUpstream;
+  const int m_Colors;
+  const int m_BitsPerComponent;
+  const int m_Columns;
+  bool m_bEOF = false;
+};
+
+TIFFPredictorStreamingDecoder::TIFFPredictorStreamingDecoder(
+    std::unique_ptr<StreamingDecoder> pUpstream,
+    int Colors,
+    int BitsPerComponent,
+    int Columns,
+    uint32_t row_size)
+    : ChunkedStreamingDecoder(row_size),
+      m_pUpstream(std::move(pUpstream)),
+      m_Colors(Colors),
+      m_BitsPerComponent(BitsPerComponent),
+      m_Columns(Columns) {}
+
+TIFFPredictorStreamingDecoder::~TIFFPredictorStreamingDecoder() = default;
+
+bool TIFFPredictorStreamingDecoder::HasError() const {
+  return m_pUpstream->HasError();
+}
+
+bool TIFFPredictorStreamingDecoder::DecodeChunk(pdfium::span<uint8_t> chunk,
+                                                size_t* size) {
+  if (m_bEOF)
+    return false;
+
+  *size = m_pUpstream->Read(chunk);
+  if (*size < chunk.size()) {
+    m_bEOF = true;
+    if (*size == 0)
+      return false;
+  }
+
+  TIFF_PredictLine(chunk.data(), static_cast<uint32_t>(*size),
+                   m_BitsPerComponent, m_Colors, m_Columns);
+  return true;
+}
+
 }  // namespace
 
 // static
@@ -864,6 +1467,16 @@ uint32_t FlateModule::FlateOrLZWDecode(
     *dest_size = decoder->GetDestSize();
     *dest_buf = decoder->TakeDestBuf();
   } else {
+    if (predictor_type == PredictorType::kPng && estimated_size) {
+      // `estimated_size` is the size after the predictor, which drops the tag
+      // byte at the start of each row.
+      const uint32_t row_size =
+          fxge::CalculatePitch8(BitsPerComponent, Colors, Columns).value_or(0);
+      FX_SAFE_UINT32 safe_size = estimated_size;
+      if (row_size)
+        safe_size += estimated_size / row_size + 1;
+      estimated_size = safe_size.ValueOrDefault(0);
+    }
     FlateUncompress(src_span, estimated_size, dest_buf, dest_size, &offset);
   }
 
@@ -883,6 +1496,40 @@ uint32_t FlateModule::FlateOrLZWDecode(
   return ret ? offset : FX_INVALID_OFFSET;
 }
 
+// static
+std::unique_ptr<StreamingDecoder> FlateModule::CreateStreamingDecoder(
+    bool bLZW,
+    std::unique_ptr<StreamingDecoder> pUpstream,
+    bool bEarlyChange,
+    int predictor,
+    int Colors,
+    int BitsPerComponent,
+    int Columns) {
+  std::unique_ptr<StreamingDecoder> decoder;
+  if (bLZW) {
+    decoder = std::make_unique<LZWStreamingDecoder>(std::move(pUpstream),
+                                                    bEarlyChange);
+  } else {
+    decoder = std::make_unique<FlateStreamingDecoder>(std::move(pUpstream));
+  }
+
+  PredictorType predictor_type = GetPredictor(predictor);
+  if (predictor_type == PredictorType::kNone)
+    return decoder;
+
+  const uint32_t row_size =
+      fxge::CalculatePitch8(BitsPerComponent, Colors, Columns).value_or(0);
+  if (row_size == 0)
+    return nullptr;
+
+  if (predictor_type == PredictorType::kPng) {
+    return std::make_unique<PNGPredictorStreamingDecoder>(
+        std::move(decoder), Colors, BitsPerComponent, Columns, row_size);
+  }
+  return std::make_unique<TIFFPredictorStreamingDecoder>(
+      std::move(decoder), Colors, BitsPerComponent, Columns, row_size);
+}
+
 // static
 DataVector<uint8_t> FlateModule::Encode(pdfium::span<const uint8_t> src_span) {
   const unsigned long src_size =
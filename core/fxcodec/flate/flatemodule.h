@@ -18,6 +18,7 @@
 namespace fxcodec {
 
 class ScanlineDecoder;
+class StreamingDecoder;
 
 class FlateModule {
  public:
@@ -44,6 +45,17 @@ class FlateModule {
       std::unique_ptr<uint8_t, FxFreeDeleter>* dest_buf,
       uint32_t* dest_size);
 
+  // Same as FlateOrLZWDecode(), but decodes the output of `pUpstream` as it
+  // is read. Returns nullptr if the predictor parameters are invalid.
+  static std::unique_ptr<StreamingDecoder> CreateStreamingDecoder(
+      bool bLZW,
+      std::unique_ptr<StreamingDecoder> pUpstream,
+      bool bEarlyChange,
+      int predictor,
+      int Colors,
+      int BitsPerComponent,
+      int Columns);
+
   static DataVector<uint8_t> Encode(pdfium::span<const uint8_t> src_span);
 
   FlateModule() = delete;
@@ -4,9 +4,114 @@
 
 #include "core/fxcodec/flate/flatemodule.h"
 
+#include <stdlib.h>
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "core/fxcodec/scanlinedecoder.h"
+#include "core/fxcodec/streaming_decoder.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/test_support.h"
 
+namespace {
+
+uint8_t PaethPredictor(int a, int b, int c) {
+  int p = a + b - c;
+  int pa = abs(p - a);
+  int pb = abs(p - b);
+  int pc = abs(p - c);
+  if (pa <= pb && pa <= pc)
+    return a;
+  return pb <= pc ? b : c;
+}
+
+// Undoes PNG predictors a byte at a time, straight from the PNG spec. The
+// last row may be cut short.
+std::vector<uint8_t> UnfilterPNG(const std::vector<uint8_t>& src,
+                                 size_t row_size,
+                                 size_t bpp) {
+  std::vector<uint8_t> dest;
+  size_t row_start = 0;
+  for (size_t pos = 0; pos < src.size(); pos += row_size + 1) {
+    const uint8_t tag = src[pos];
+    const size_t size = std::min(row_size, src.size() - pos - 1);
+    for (size_t i = 0; i < size; ++i) {
+      int left = i >= bpp ? dest[row_start + i - bpp] : 0;
+      int up = row_start > 0 ? dest[row_start - row_size + i] : 0;
+      int upper_left =
+          row_start > 0 && i >= bpp ? dest[row_start - row_size + i - bpp] : 0;
+      int predicted = 0;
+      switch (tag) {
+        case 1:
+          predicted = left;
+          break;
+        case 2:
+          predicted = up;
+          break;
+        case 3:
+          predicted = (left + up) / 2;
+          break;
+        case 4:
+          predicted = PaethPredictor(left, up, upper_left);
+          break;
+      }
+      dest.push_back(src[pos + 1 + i] + predicted);
+    }
+    row_start += row_size;
+  }
+  return dest;
+}
+
+// Undoes the TIFF predictor for 8-bit components.
+std::vector<uint8_t> UnfilterTIFF(std::vector<uint8_t> data,
+                                  size_t row_size,
+                                  size_t bpp) {
+  for (size_t i = 0; i < data.size(); ++i) {
+    if (i % row_size >= bpp)
+      data[i] += data[i - bpp];
+  }
+  return data;
+}
+
+std::vector<uint8_t> ReadAll(StreamingDecoder* decoder) {
+  std::vector<uint8_t> result;
+  uint8_t buffer[1000];
+  size_t size;
+  while ((size = decoder->Read(buffer)) > 0)
+    result.insert(result.end(), buffer, buffer + size);
+  return result;
+}
+
+// Checks that all the ways to decode a Flate stream with a predictor agree
+// with `expected`.
+void CheckPredictor(const std::vector<uint8_t>& filtered,
+                    const std::vector<uint8_t>& expected,
+                    int predictor,
+                    int colors,
+                    int bpc,
+                    int columns) {
+  DataVector<uint8_t> encoded = FlateModule::Encode(filtered);
+
+  std::unique_ptr<uint8_t, FxFreeDeleter> buf;
+  uint32_t buf_size;
+  EXPECT_EQ(encoded.size(), FlateModule::FlateOrLZWDecode(
+                                false, encoded, false, predictor, colors, bpc,
+                                columns, 0, &buf, &buf_size));
+  ASSERT_EQ(expected.size(), buf_size);
+  EXPECT_EQ(0, memcmp(expected.data(), buf.get(), buf_size));
+
+  std::unique_ptr<StreamingDecoder> streaming =
+      FlateModule::CreateStreamingDecoder(
+          false, std::make_unique<SpanStreamingDecoder>(encoded), false,
+          predictor, colors, bpc, columns);
+  ASSERT_TRUE(streaming);
+  EXPECT_EQ(expected, ReadAll(streaming.get()));
+}
+
+}  // namespace
+
 // NOTE: python's zlib.compress() and zlib.decompress() may be useful for
 // external validation of the FlateDncode/FlateEecode test cases.
 TEST(FlateModule, Decode) {
@@ -80,3 +185,124 @@ TEST(FlateModule, Encode) {
         << " for case " << i;
   }
 }
+
+// Compares the predictors against a byte-at-a-time reference, for pixel sizes
+// with and without vectorized paths, and rows that do not fill whole vectors.
+TEST(FlateModule, PNGPredictor) {
+  uint32_t seed = 1;
+  auto next_byte = [&seed] {
+    seed = seed * 1103515245 + 12345;
+    return static_cast<uint8_t>(seed >> 16);
+  };
+  for (int bpc : {1, 8, 16}) {
+    for (int colors = 1; colors <= 4; ++colors) {
+      for (int columns : {1, 5, 16, 37}) {
+        SCOPED_TRACE(testing::Message() << "bpc " << bpc << ", colors "
+                                        << colors << ", columns " << columns);
+        const size_t row_size = (bpc * colors * columns + 7) / 8;
+        const size_t bpp = (bpc * colors + 7) / 8;
+        const int kRows = 6;
+        std::vector<uint8_t> filtered;
+        for (int row = 0; row < kRows; ++row) {
+          // Each tag, including an invalid one, follows every other.
+          filtered.push_back(row < 5 ? row : 7);
+          for (size_t i = 0; i < row_size; ++i)
+            filtered.push_back(next_byte());
+        }
+        std::vector<uint8_t> expected = UnfilterPNG(filtered, row_size, bpp);
+        CheckPredictor(filtered, expected, 12, colors, bpc, columns);
+
+        // Full rows also decode a row at a time.
+        DataVector<uint8_t> encoded = FlateModule::Encode(filtered);
+        std::unique_ptr<ScanlineDecoder> decoder =
+            FlateModule::CreateDecoder(encoded, columns, kRows, colors, bpc,
+                                       12, colors, bpc, columns);
+        ASSERT_TRUE(decoder);
+        for (int row = 0; row < kRows; ++row) {
+          pdfium::span<const uint8_t> scanline = decoder->GetScanline(row);
+          ASSERT_GE(scanline.size(), row_size);
+          EXPECT_EQ(0, memcmp(&expected[row * row_size], scanline.data(),
+                              row_size));
+        }
+
+        // Cut the last row short.
+        filtered.resize(filtered.size() - row_size / 2 - 1);
+        CheckPredictor(filtered, UnfilterPNG(filtered, row_size, bpp), 12,
+                       colors, bpc, columns);
+      }
+    }
+  }
+}
+
+TEST(FlateModule, TIFFPredictor) {
+  uint32_t seed = 1;
+  auto next_byte = [&seed] {
+    seed = seed * 1103515245 + 12345;
+    return static_cast<uint8_t>(seed >> 16);
+  };
+  for (int colors = 1; colors <= 4; ++colors) {
+    for (int columns : {1, 5, 16, 37}) {
+      SCOPED_TRACE(testing::Message()
+                   << "colors " << colors << ", columns " << columns);
+      const size_t row_size = colors * columns;
+      std::vector<uint8_t> filtered;
+      for (size_t i = 0; i < row_size * 3 + row_size / 2; ++i)
+        filtered.push_back(next_byte());
+      CheckPredictor(filtered, UnfilterTIFF(filtered, row_size, colors), 2,
+                     colors, 8, columns);
+    }
+  }
+}
+
+// Decoding with the decoded size known up front takes a different path, which
+// must give the same results whether or not the size is right.
+TEST(FlateModule, DecodeWithEstimatedSize) {
+  std::vector<uint8_t> data;
+  for (int i = 0; i < 100000; ++i)
+    data.push_back(static_cast<uint8_t>(i * i / 7));
+  const DataVector<uint8_t> encoded = FlateModule::Encode(data);
+  const uint32_t size = static_cast<uint32_t>(data.size());
+
+  // Whole, cut short inside the data, and missing its checksum.
+  const pdfium::span<const uint8_t> inputs[] = {
+      encoded,
+      pdfium::make_span(encoded).first(encoded.size() / 2),
+      pdfium::make_span(encoded).first(encoded.size() - 4),
+  };
+  for (size_t i = 0; i < std::size(inputs); ++i) {
+    std::unique_ptr<uint8_t, FxFreeDeleter> expected_buf;
+    uint32_t expected_size;
+    const uint32_t expected_offset = FlateModule::FlateOrLZWDecode(
+        false, inputs[i], false, 0, 0, 0, 0, 0, &expected_buf, &expected_size);
+    // Includes sizes much larger than the data, and larger than what
+    // FlateUncompress() allocates up front.
+    for (uint32_t estimated_size :
+         {size, size - 1, size + 1, size * 2, size * 20, 20000000u,
+          std::numeric_limits<uint32_t>::max()}) {
+      SCOPED_TRACE(testing::Message() << "input " << i << ", estimated size "
+                                      << estimated_size);
+      std::unique_ptr<uint8_t, FxFreeDeleter> buf;
+      uint32_t buf_size;
+      EXPECT_EQ(expected_offset, FlateModule::FlateOrLZWDecode(
+                                     false, inputs[i], false, 0, 0, 0, 0,
+                                     estimated_size, &buf, &buf_size));
+      ASSERT_EQ(expected_size, buf_size);
+      EXPECT_EQ(0, memcmp(expected_buf.get(), buf.get(), buf_size));
+    }
+  }
+
+  // With a PNG predictor, the estimated size leaves out the tag bytes.
+  std::vector<uint8_t> filtered;
+  for (size_t i = 0; i < data.size(); ++i) {
+    if (i % 100 == 0)
+      filtered.push_back(2);
+    filtered.push_back(data[i]);
+  }
+  const DataVector<uint8_t> encoded_filtered = FlateModule::Encode(filtered);
+  std::unique_ptr<uint8_t, FxFreeDeleter> buf;
+  uint32_t buf_size;
+  EXPECT_EQ(encoded_filtered.size(),
+            FlateModule::FlateOrLZWDecode(false, encoded_filtered, false, 12,
+                                          1, 8, 100, size, &buf, &buf_size));
+  EXPECT_EQ(size, buf_size);
+}
@@ -6,6 +6,7 @@
 
 #include "core/fxcodec/jbig2/JBig2_GrdProc.h"
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <utility>
@@ -27,10 +28,40 @@ constexpr uint16_t kOptConstant5[] = {0x07f0, 0x01f8, 0x007c};
 constexpr uint16_t kOptConstant6[] = {0x7bf7, 0x0efb, 0x01bd};
 constexpr uint16_t kOptConstant7[] = {0x0800, 0x0200, 0x0080};
 constexpr uint16_t kOptConstant8[] = {0x0010, 0x0008, 0x0004};
-constexpr uint16_t kOptConstant9[] = {0x000c, 0x0009, 0x0007};
-constexpr uint16_t kOptConstant10[] = {0x0007, 0x000f, 0x0007};
-constexpr uint16_t kOptConstant11[] = {0x001f, 0x001f, 0x000f};
-constexpr uint16_t kOptConstant12[] = {0x000f, 0x0007, 0x0003};
+
+// Where a generic region template puts the pixels of a row above the current
+// one in its context: `count` pixels, the rightmost at `right` from the
+// current pixel, going into the context from bit `shift` up.
+struct GenericTemplateRow {
+  int8_t dy;
+  int8_t right;
+  uint8_t count;
+  uint8_t shift;
+};
+
+// The context layout of a generic region template, per 6.2.5.3 of the JBIG2
+// specification. The `current_count` pixels left of the current one go into
+// the lowest bits.
+struct GenericTemplate {
+  GenericTemplateRow rows[2];
+  uint8_t row_count;
+  uint8_t current_count;
+  uint8_t at_count;
+  uint8_t at_shift[4];
+  uint16_t tpgdon_context;
+};
+
+constexpr GenericTemplate kGenericTemplates[] = {
+    {{{-1, 2, 5, 5}, {-2, 1, 3, 12}}, 2, 4, 4, {4, 10, 11, 15}, 0x9b25},
+    {{{-1, 2, 5, 4}, {-2, 2, 4, 9}}, 2, 3, 1, {3}, 0x0795},
+    {{{-1, 1, 4, 3}, {-2, 1, 3, 7}}, 2, 2, 1, {2}, 0x00e5},
+    {{{-1, 1, 5, 5}, {}}, 1, 4, 1, {4}, 0x0195},
+};
+
+// Index of the byte holding pixel `x`, rounding down for negative `x`.
+int32_t ByteIndex(int32_t x) {
+  return x >= 0 ? x / 8 : -((7 - x) / 8);
+}
 
 }  // namespace
 
@@ -66,21 +97,19 @@ std::unique_ptr<CJBig2_Image> CJBig2_GRDProc::DecodeArith(
 
   switch (GBTEMPLATE) {
     case 0:
-      return UseTemplate0Opt3()
-                 ? DecodeArithOpt3(pArithDecoder, gbContext, 0)
-                 : DecodeArithTemplateUnopt(pArithDecoder, gbContext, 0);
+      return UseTemplate0Opt3() ? DecodeArithOpt3(pArithDecoder, gbContext, 0)
+                                : DecodeArithGeneric(pArithDecoder, gbContext);
     case 1:
-      return UseTemplate1Opt3()
-                 ? DecodeArithOpt3(pArithDecoder, gbContext, 1)
-                 : DecodeArithTemplateUnopt(pArithDecoder, gbContext, 1);
+      return UseTemplate1Opt3() ? DecodeArithOpt3(pArithDecoder, gbContext, 1)
+                                : DecodeArithGeneric(pArithDecoder, gbContext);
     case 2:
       return UseTemplate23Opt3()
                  ? DecodeArithOpt3(pArithDecoder, gbContext, 2)
-                 : DecodeArithTemplateUnopt(pArithDecoder, gbContext, 2);
+                 : DecodeArithGeneric(pArithDecoder, gbContext);
     default:
       return UseTemplate23Opt3()
                  ? DecodeArithTemplate3Opt3(pArithDecoder, gbContext)
-                 : DecodeArithTemplate3Unopt(pArithDecoder, gbContext);
+                 : DecodeArithGeneric(pArithDecoder, gbContext);
   }
 }
 
@@ -190,68 +219,6 @@ std::unique_ptr<CJBig2_Image> CJBig2_GRDProc::DecodeArithOpt3(
   return GBREG;
 }
 
-std::unique_ptr<CJBig2_Image> CJBig2_GRDProc::DecodeArithTemplateUnopt(
-    CJBig2_ArithDecoder* pArithDecoder,
-    JBig2ArithCtx* gbContext,
-    int UNOPT) {
-  auto GBREG = std::make_unique<CJBig2_Image>(GBW, GBH);
-  if (!GBREG->data())
-    return nullptr;
-
-  GBREG->Fill(false);
-  int LTP = 0;
-  uint8_t MOD2 = UNOPT % 2;
-  uint8_t DIV2 = UNOPT / 2;
-  uint8_t SHIFT = 4 - UNOPT;
-  for (uint32_t h = 0; h < GBH; h++) {
-    if (TPGDON) {
-      if (pArithDecoder->IsComplete())
-        return nullptr;
-
-      LTP = LTP ^ pArithDecoder->Decode(&gbContext[kOptConstant1[UNOPT]]);
-    }
-    if (LTP) {
-      GBREG->CopyLine(h, h - 1);
-      continue;
-    }
-    uint32_t line1 = GBREG->GetPixel(1 + MOD2, h - 2);
-    line1 |= GBREG->GetPixel(MOD2, h - 2) << 1;
-    if (UNOPT == 1)
-      line1 |= GBREG->GetPixel(0, h - 2) << 2;
-    uint32_t line2 = GBREG->GetPixel(2 - DIV2, h - 1);
-    line2 |= GBREG->GetPixel(1 - DIV2, h - 1) << 1;
-    if (UNOPT < 2)
-      line2 |= GBREG->GetPixel(0, h - 1) << 2;
-    uint32_t line3 = 0;
-    for (uint32_t w = 0; w < GBW; w++) {
-      int bVal = 0;
-      if (!USESKIP || !SKIP->GetPixel(w, h)) {
-        if (pArithDecoder->IsComplete())
-          return nullptr;
-
-        uint32_t CONTEXT = line3;
-        CONTEXT |= GBREG->GetPixel(w + GBAT[0], h + GBAT[1]) << SHIFT;
-        CONTEXT |= line2 << (SHIFT + 1);
-        CONTEXT |= line1 << kOptConstant9[UNOPT];
-        if (UNOPT == 0) {
-          CONTEXT |= GBREG->GetPixel(w + GBAT[2], h + GBAT[3]) << 10;
-          CONTEXT |= GBREG->GetPixel(w + GBAT[4], h + GBAT[5]) << 11;
-          CONTEXT |= GBREG->GetPixel(w + GBAT[6], h + GBAT[7]) << 15;
-        }
-        bVal = pArithDecoder->Decode(&gbContext[CONTEXT]);
-        if (bVal)
-          GBREG->SetPixel(w, h, bVal);
-      }
-      line1 = ((line1 << 1) | GBREG->GetPixel(w + 2 + MOD2, h - 2)) &
-              kOptConstant10[UNOPT];
-      line2 = ((line2 << 1) | GBREG->GetPixel(w + 3 - DIV2, h - 1)) &
-              kOptConstant11[UNOPT];
-      line3 = ((line3 << 1) | bVal) & kOptConstant12[UNOPT];
-    }
-  }
-  return GBREG;
-}
-
 std::unique_ptr<CJBig2_Image> CJBig2_GRDProc::DecodeArithTemplate3Opt3(
     CJBig2_ArithDecoder* pArithDecoder,
     JBig2ArithCtx* gbContext) {
@@ -337,7 +304,7 @@ std::unique_ptr<CJBig2_Image> CJBig2_GRDProc::DecodeArithTemplate3Opt3(
   return GBREG;
 }
 
-std::unique_ptr<CJBig2_Image> CJBig2_GRDProc::DecodeArithTemplate3Unopt(
+std::unique_ptr<CJBig2_Image> CJBig2_GRDProc::DecodeArithGeneric(
     CJBig2_ArithDecoder* pArithDecoder,
     JBig2ArithCtx* gbContext) {
   auto GBREG = std::make_unique<CJBig2_Image>(GBW, GBH);
@@ -345,42 +312,127 @@ std::unique_ptr<CJBig2_Image> CJBig2_GRDProc::DecodeArithTemplate3Unopt(
     return nullptr;
 
   GBREG->Fill(false);
+  const uint16_t tpgdon_context =
+      kGenericTemplates[std::min<uint8_t>(GBTEMPLATE, 3)].tpgdon_context;
   int LTP = 0;
   for (uint32_t h = 0; h < GBH; h++) {
     if (TPGDON) {
       if (pArithDecoder->IsComplete())
         return nullptr;
 
-      LTP = LTP ^ pArithDecoder->Decode(&gbContext[0x0195]);
+      LTP = LTP ^ pArithDecoder->Decode(&gbContext[tpgdon_context]);
     }
-    if (LTP == 1) {
+    if (LTP) {
       GBREG->CopyLine(h, h - 1);
-    } else {
-      uint32_t line1 = GBREG->GetPixel(1, h - 1);
-      line1 |= GBREG->GetPixel(0, h - 1) << 1;
-      uint32_t line2 = 0;
-      for (uint32_t w = 0; w < GBW; w++) {
-        int bVal;
-        if (USESKIP && SKIP->GetPixel(w, h)) {
-          bVal = 0;
-        } else {
-          uint32_t CONTEXT = line2;
-          CONTEXT |= GBREG->GetPixel(w + GBAT[0], h + GBAT[1]) << 4;
-          CONTEXT |= line1 << 5;
-          if (pArithDecoder->IsComplete())
-            return nullptr;
+      continue;
+    }
+    if (!DecodeRowGeneric(GBREG.get(), h, pArithDecoder, gbContext))
+      return nullptr;
+  }
+  return GBREG;
+}
 
-          bVal = pArithDecoder->Decode(&gbContext[CONTEXT]);
-        }
-        if (bVal) {
-          GBREG->SetPixel(w, h, bVal);
+bool CJBig2_GRDProc::DecodeRowGeneric(CJBig2_Image* pImage,
+                                      uint32_t h,
+                                      CJBig2_ArithDecoder* pArithDecoder,
+                                      JBig2ArithCtx* gbContext) {
+  const GenericTemplate& tmpl =
+      kGenericTemplates[std::min<uint8_t>(GBTEMPLATE, 3)];
+  const int32_t y = static_cast<int32_t>(h);
+  const int32_t nLineBytes = (GBW + 7) >> 3;
+  auto ByteAt = [nLineBytes](const uint8_t* pRow, int32_t index) -> uint32_t {
+    return pRow && index >= 0 && index < nLineBytes ? pRow[index] : 0;
+  };
+
+  const uint8_t* pRows[2] = {};
+  for (uint8_t i = 0; i < tmpl.row_count; ++i)
+    pRows[i] = pImage->GetLine(y + tmpl.rows[i].dy);
+
+  // AT pixels below the current row, or in it at or right of the current
+  // pixel, are not decoded yet, and those outside the image are 0; leave all
+  // of them out. Those in rows above get read a byte at a time like the fixed
+  // pixels. Those left of the current pixel in its row get read per pixel.
+  struct AtPixel {
+    const uint8_t* pRow;
+    int32_t dx;
+    uint8_t shift;
+  };
+  AtPixel at_above[4];
+  AtPixel at_left[4];
+  size_t at_above_count = 0;
+  size_t at_left_count = 0;
+  for (uint8_t i = 0; i < tmpl.at_count; ++i) {
+    const int32_t dx = GBAT[2 * i];
+    const int32_t dy = GBAT[2 * i + 1];
+    if (dy < 0) {
+      const uint8_t* pRow = pImage->GetLine(y + dy);
+      if (pRow)
+        at_above[at_above_count++] = {pRow, dx, tmpl.at_shift[i]};
+    } else if (dy == 0 && dx < 0) {
+      at_left[at_left_count++] = {nullptr, dx, tmpl.at_shift[i]};
+    }
+  }
+
+  uint8_t* pLine = pImage->GetLine(y);
+  const uint32_t current_mask = (1 << tmpl.current_count) - 1;
+  uint32_t current = 0;
+  for (int32_t cc = 0; cc < nLineBytes; ++cc) {
+    const int32_t x0 = cc << 3;
+    const int32_t nBits = std::min<int32_t>(8, GBW - x0);
+
+    // 24 pixels centered on the byte being decoded, for each fixed row.
+    uint32_t windows[2] = {};
+    for (uint8_t i = 0; i < tmpl.row_count; ++i) {
+      windows[i] = (ByteAt(pRows[i], cc - 1) << 16) |
+                   (ByteAt(pRows[i], cc) << 8) | ByteAt(pRows[i], cc + 1);
+    }
+    // The 16 pixels starting with the one at x0 + dx, aligned to bytes, for
+    // each AT pixel above; `offset` is where x0 + dx falls in the first byte.
+    uint32_t at_windows[4];
+    int32_t at_offsets[4];
+    for (size_t j = 0; j < at_above_count; ++j) {
+      const int32_t x = x0 + at_above[j].dx;
+      const int32_t index = ByteIndex(x);
+      at_windows[j] = (ByteAt(at_above[j].pRow, index) << 8) |
+                      ByteAt(at_above[j].pRow, index + 1);
+      at_offsets[j] = x - index * 8;
+    }
+
+    uint8_t cVal = 0;
+    for (int32_t k = 0; k < nBits; ++k) {
+      int bVal = 0;
+      if (!USESKIP || !SKIP->GetPixel(x0 + k, y)) {
+        uint32_t CONTEXT = current;
+        for (uint8_t i = 0; i < tmpl.row_count; ++i) {
+          const GenericTemplateRow& row = tmpl.rows[i];
+          CONTEXT |= ((windows[i] >> (15 - k - row.right)) &
+                      ((1 << row.count) - 1))
+                     << row.shift;
+        }
+        for (size_t j = 0; j < at_above_count; ++j) {
+          CONTEXT |= ((at_windows[j] >> (15 - at_offsets[j] - k)) & 1)
+                     << at_above[j].shift;
+        }
+        for (size_t j = 0; j < at_left_count; ++j) {
+          const int32_t x = x0 + k + at_left[j].dx;
+          uint32_t bit = 0;
+          if (x >= x0)
+            bit = (cVal >> (7 - (x - x0))) & 1;
+          else if (x >= 0)
+            bit = (pLine[x >> 3] >> (7 - (x & 7))) & 1;
+          CONTEXT |= bit << at_left[j].shift;
         }
-        line1 = ((line1 << 1) | GBREG->GetPixel(w + 2, h - 1)) & 0x1f;
-        line2 = ((line2 << 1) | bVal) & 0x0f;
+        if (pArithDecoder->IsComplete())
+          return false;
+
+        bVal = pArithDecoder->Decode(&gbContext[CONTEXT]);
+        cVal |= bVal << (7 - k);
       }
+      current = ((current << 1) | bVal) & current_mask;
     }
+    pLine[cc] = cVal;
   }
-  return GBREG;
+  return true;
 }
 
 FXCODEC_STATUS CJBig2_GRDProc::StartDecodeArith(
@@ -417,22 +469,22 @@ FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArith(
     case 0:
       func = UseTemplate0Opt3()
                  ? &CJBig2_GRDProc::ProgressiveDecodeArithTemplate0Opt3
-                 : &CJBig2_GRDProc::ProgressiveDecodeArithTemplate0Unopt;
+                 : &CJBig2_GRDProc::ProgressiveDecodeArithGeneric;
       break;
     case 1:
       func = UseTemplate1Opt3()
                  ? &CJBig2_GRDProc::ProgressiveDecodeArithTemplate1Opt3
-                 : &CJBig2_GRDProc::ProgressiveDecodeArithTemplate1Unopt;
+                 : &CJBig2_GRDProc::ProgressiveDecodeArithGeneric;
       break;
     case 2:
       func = UseTemplate23Opt3()
                  ? &CJBig2_GRDProc::ProgressiveDecodeArithTemplate2Opt3
-                 : &CJBig2_GRDProc::ProgressiveDecodeArithTemplate2Unopt;
+                 : &CJBig2_GRDProc::ProgressiveDecodeArithGeneric;
       break;
     default:
       func = UseTemplate23Opt3()
                  ? &CJBig2_GRDProc::ProgressiveDecodeArithTemplate3Opt3
-                 : &CJBig2_GRDProc::ProgressiveDecodeArithTemplate3Unopt;
+                 : &CJBig2_GRDProc::ProgressiveDecodeArithGeneric;
       break;
   }
   CJBig2_Image* pImage = pState->pImage->get();
@@ -583,64 +635,6 @@ FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArithTemplate0Opt3(
   return FXCODEC_STATUS::kDecodeFinished;
 }
 
-FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArithTemplate0Unopt(
-    ProgressiveArithDecodeState* pState) {
-  CJBig2_Image* pImage = pState->pImage->get();
-  JBig2ArithCtx* gbContext = pState->gbContext;
-  CJBig2_ArithDecoder* pArithDecoder = pState->pArithDecoder;
-  for (; m_loopIndex < GBH; m_loopIndex++) {
-    if (TPGDON) {
-      if (pArithDecoder->IsComplete())
-        return FXCODEC_STATUS::kError;
-
-      m_LTP = m_LTP ^ pArithDecoder->Decode(&gbContext[0x9b25]);
-    }
-    if (m_LTP) {
-      pImage->CopyLine(m_loopIndex, m_loopIndex - 1);
-    } else {
-      uint32_t line1 = pImage->GetPixel(1, m_loopIndex - 2);
-      line1 |= pImage->GetPixel(0, m_loopIndex - 2) << 1;
-      uint32_t line2 = pImage->GetPixel(2, m_loopIndex - 1);
-      line2 |= pImage->GetPixel(1, m_loopIndex - 1) << 1;
-      line2 |= pImage->GetPixel(0, m_loopIndex - 1) << 2;
-      uint32_t line3 = 0;
-      for (uint32_t w = 0; w < GBW; w++) {
-        int bVal;
-        if (USESKIP && SKIP->GetPixel(w, m_loopIndex)) {
-          bVal = 0;
-        } else {
-          uint32_t CONTEXT = line3;
-          CONTEXT |= pImage->GetPixel(w + GBAT[0], m_loopIndex + GBAT[1]) << 4;
-          CONTEXT |= line2 << 5;
-          CONTEXT |= pImage->GetPixel(w + GBAT[2], m_loopIndex + GBAT[3]) << 10;
-          CONTEXT |= pImage->GetPixel(w + GBAT[4], m_loopIndex + GBAT[5]) << 11;
-          CONTEXT |= line1 << 12;
-          CONTEXT |= pImage->GetPixel(w + GBAT[6], m_loopIndex + GBAT[7]) << 15;
-          if (pArithDecoder->IsComplete())
-            return FXCODEC_STATUS::kError;
-
-          bVal = pArithDecoder->Decode(&gbContext[CONTEXT]);
-        }
-        if (bVal) {
-          pImage->SetPixel(w, m_loopIndex, bVal);
-        }
-        line1 =
-            ((line1 << 1) | pImage->GetPixel(w + 2, m_loopIndex - 2)) & 0x07;
-        line2 =
-            ((line2 << 1) | pImage->GetPixel(w + 3, m_loopIndex - 1)) & 0x1f;
-        line3 = ((line3 << 1) | bVal) & 0x0f;
-      }
-    }
-    if (pState->pPause && pState->pPause->NeedToPauseNow()) {
-      m_loopIndex++;
-      m_ProgressiveStatus = FXCODEC_STATUS::kDecodeToBeContinued;
-      return FXCODEC_STATUS::kDecodeToBeContinued;
-    }
-  }
-  m_ProgressiveStatus = FXCODEC_STATUS::kDecodeFinished;
-  return FXCODEC_STATUS::kDecodeFinished;
-}
-
 FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArithTemplate1Opt3(
     ProgressiveArithDecodeState* pState) {
   CJBig2_Image* pImage = pState->pImage->get();
@@ -742,60 +736,6 @@ FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArithTemplate1Opt3(
   return FXCODEC_STATUS::kDecodeFinished;
 }
 
-FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArithTemplate1Unopt(
-    ProgressiveArithDecodeState* pState) {
-  CJBig2_Image* pImage = pState->pImage->get();
-  JBig2ArithCtx* gbContext = pState->gbContext;
-  CJBig2_ArithDecoder* pArithDecoder = pState->pArithDecoder;
-  for (uint32_t h = 0; h < GBH; h++) {
-    if (TPGDON) {
-      if (pArithDecoder->IsComplete())
-        return FXCODEC_STATUS::kError;
-
-      m_LTP = m_LTP ^ pArithDecoder->Decode(&gbContext[0x0795]);
-    }
-    if (m_LTP) {
-      pImage->CopyLine(h, h - 1);
-    } else {
-      uint32_t line1 = pImage->GetPixel(2, h - 2);
-      line1 |= pImage->GetPixel(1, h - 2) << 1;
-      line1 |= pImage->GetPixel(0, h - 2) << 2;
-      uint32_t line2 = pImage->GetPixel(2, h - 1);
-      line2 |= pImage->GetPixel(1, h - 1) << 1;
-      line2 |= pImage->GetPixel(0, h - 1) << 2;
-      uint32_t line3 = 0;
-      for (uint32_t w = 0; w < GBW; w++) {
-        int bVal;
-        if (USESKIP && SKIP->GetPixel(w, h)) {
-          bVal = 0;
-        } else {
-          uint32_t CONTEXT = line3;
-          CONTEXT |= pImage->GetPixel(w + GBAT[0], h + GBAT[1]) << 3;
-          CONTEXT |= line2 << 4;
-          CONTEXT |= line1 << 9;
-          if (pArithDecoder->IsComplete())
-            return FXCODEC_STATUS::kError;
-
-          bVal = pArithDecoder->Decode(&gbContext[CONTEXT]);
-        }
-        if (bVal) {
-          pImage->SetPixel(w, h, bVal);
-        }
-        line1 = ((line1 << 1) | pImage->GetPixel(w + 3, h - 2)) & 0x0f;
-        line2 = ((line2 << 1) | pImage->GetPixel(w + 3, h - 1)) & 0x1f;
-        line3 = ((line3 << 1) | bVal) & 0x07;
-      }
-    }
-    if (pState->pPause && pState->pPause->NeedToPauseNow()) {
-      m_loopIndex++;
-      m_ProgressiveStatus = FXCODEC_STATUS::kDecodeToBeContinued;
-      return FXCODEC_STATUS::kDecodeToBeContinued;
-    }
-  }
-  m_ProgressiveStatus = FXCODEC_STATUS::kDecodeFinished;
-  return FXCODEC_STATUS::kDecodeFinished;
-}
-
 FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArithTemplate2Opt3(
     ProgressiveArithDecodeState* pState) {
   CJBig2_Image* pImage = pState->pImage->get();
@@ -898,60 +838,6 @@ FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArithTemplate2Opt3(
   return FXCODEC_STATUS::kDecodeFinished;
 }
 
-FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArithTemplate2Unopt(
-    ProgressiveArithDecodeState* pState) {
-  CJBig2_Image* pImage = pState->pImage->get();
-  JBig2ArithCtx* gbContext = pState->gbContext;
-  CJBig2_ArithDecoder* pArithDecoder = pState->pArithDecoder;
-  for (; m_loopIndex < GBH; m_loopIndex++) {
-    if (TPGDON) {
-      if (pArithDecoder->IsComplete())
-        return FXCODEC_STATUS::kError;
-
-      m_LTP = m_LTP ^ pArithDecoder->Decode(&gbContext[0x00e5]);
-    }
-    if (m_LTP) {
-      pImage->CopyLine(m_loopIndex, m_loopIndex - 1);
-    } else {
-      uint32_t line1 = pImage->GetPixel(1, m_loopIndex - 2);
-      line1 |= pImage->GetPixel(0, m_loopIndex - 2) << 1;
-      uint32_t line2 = pImage->GetPixel(1, m_loopIndex - 1);
-      line2 |= pImage->GetPixel(0, m_loopIndex - 1) << 1;
-      uint32_t line3 = 0;
-      for (uint32_t w = 0; w < GBW; w++) {
-        int bVal;
-        if (USESKIP && SKIP->GetPixel(w, m_loopIndex)) {
-          bVal = 0;
-        } else {
-          uint32_t CONTEXT = line3;
-          CONTEXT |= pImage->GetPixel(w + GBAT[0], m_loopIndex + GBAT[1]) << 2;
-          CONTEXT |= line2 << 3;
-          CONTEXT |= line1 << 7;
-          if (pArithDecoder->IsComplete())
-            return FXCODEC_STATUS::kError;
-
-          bVal = pArithDecoder->Decode(&gbContext[CONTEXT]);
-        }
-        if (bVal) {
-          pImage->SetPixel(w, m_loopIndex, bVal);
-        }
-        line1 =
-            ((line1 << 1) | pImage->GetPixel(w + 2, m_loopIndex - 2)) & 0x07;
-        line2 =
-            ((line2 << 1) | pImage->GetPixel(w + 2, m_loopIndex - 1)) & 0x0f;
-        line3 = ((line3 << 1) | bVal) & 0x03;
-      }
-    }
-    if (pState->pPause && pState->pPause->NeedToPauseNow()) {
-      m_loopIndex++;
-      m_ProgressiveStatus = FXCODEC_STATUS::kDecodeToBeContinued;
-      return FXCODEC_STATUS::kDecodeToBeContinued;
-    }
-  }
-  m_ProgressiveStatus = FXCODEC_STATUS::kDecodeFinished;
-  return FXCODEC_STATUS::kDecodeFinished;
-}
-
 FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArithTemplate3Opt3(
     ProgressiveArithDecodeState* pState) {
   CJBig2_Image* pImage = pState->pImage->get();
@@ -1039,44 +925,25 @@ FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArithTemplate3Opt3(
   return FXCODEC_STATUS::kDecodeFinished;
 }
 
-FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArithTemplate3Unopt(
+FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArithGeneric(
     ProgressiveArithDecodeState* pState) {
   CJBig2_Image* pImage = pState->pImage->get();
   JBig2ArithCtx* gbContext = pState->gbContext;
   CJBig2_ArithDecoder* pArithDecoder = pState->pArithDecoder;
+  const uint16_t tpgdon_context =
+      kGenericTemplates[std::min<uint8_t>(GBTEMPLATE, 3)].tpgdon_context;
   for (; m_loopIndex < GBH; m_loopIndex++) {
     if (TPGDON) {
       if (pArithDecoder->IsComplete())
         return FXCODEC_STATUS::kError;
 
-      m_LTP = m_LTP ^ pArithDecoder->Decode(&gbContext[0x0195]);
+      m_LTP = m_LTP ^ pArithDecoder->Decode(&gbContext[tpgdon_context]);
     }
     if (m_LTP) {
       pImage->CopyLine(m_loopIndex, m_loopIndex - 1);
-    } else {
-      uint32_t line1 = pImage->GetPixel(1, m_loopIndex - 1);
-      line1 |= pImage->GetPixel(0, m_loopIndex - 1) << 1;
-      uint32_t line2 = 0;
-      for (uint32_t w = 0; w < GBW; w++) {
-        int bVal;
-        if (USESKIP && SKIP->GetPixel(w, m_loopIndex)) {
-          bVal = 0;
-        } else {
-          uint32_t CONTEXT = line2;
-          CONTEXT |= pImage->GetPixel(w + GBAT[0], m_loopIndex + GBAT[1]) << 4;
-          CONTEXT |= line1 << 5;
-          if (pArithDecoder->IsComplete())
-            return FXCODEC_STATUS::kError;
-
-          bVal = pArithDecoder->Decode(&gbContext[CONTEXT]);
-        }
-        if (bVal) {
-          pImage->SetPixel(w, m_loopIndex, bVal);
-        }
-        line1 =
-            ((line1 << 1) | pImage->GetPixel(w + 2, m_loopIndex - 1)) & 0x1f;
-        line2 = ((line2 << 1) | bVal) & 0x0f;
-      }
+    } else if (!DecodeRowGeneric(pImage, m_loopIndex, pArithDecoder,
+                                 gbContext)) {
+      return FXCODEC_STATUS::kError;
     }
     if (pState->pPause && pState->pPause->NeedToPauseNow()) {
       m_loopIndex++;
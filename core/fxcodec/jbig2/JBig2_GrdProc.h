@@ -64,36 +64,34 @@ class CJBig2_GRDProc {
   FXCODEC_STATUS ProgressiveDecodeArith(ProgressiveArithDecodeState* pState);
   FXCODEC_STATUS ProgressiveDecodeArithTemplate0Opt3(
       ProgressiveArithDecodeState* pState);
-  FXCODEC_STATUS ProgressiveDecodeArithTemplate0Unopt(
-      ProgressiveArithDecodeState* pState);
   FXCODEC_STATUS ProgressiveDecodeArithTemplate1Opt3(
       ProgressiveArithDecodeState* pState);
-  FXCODEC_STATUS ProgressiveDecodeArithTemplate1Unopt(
-      ProgressiveArithDecodeState* pState);
   FXCODEC_STATUS ProgressiveDecodeArithTemplate2Opt3(
       ProgressiveArithDecodeState* pState);
-  FXCODEC_STATUS ProgressiveDecodeArithTemplate2Unopt(
-      ProgressiveArithDecodeState* pState);
   FXCODEC_STATUS ProgressiveDecodeArithTemplate3Opt3(
       ProgressiveArithDecodeState* pState);
-  FXCODEC_STATUS ProgressiveDecodeArithTemplate3Unopt(
+  FXCODEC_STATUS ProgressiveDecodeArithGeneric(
       ProgressiveArithDecodeState* pState);
 
   std::unique_ptr<CJBig2_Image> DecodeArithOpt3(
       CJBig2_ArithDecoder* pArithDecoder,
       JBig2ArithCtx* gbContext,
       int OPT);
-  std::unique_ptr<CJBig2_Image> DecodeArithTemplateUnopt(
-      CJBig2_ArithDecoder* pArithDecoder,
-      JBig2ArithCtx* gbContext,
-      int UNOPT);
   std::unique_ptr<CJBig2_Image> DecodeArithTemplate3Opt3(
       CJBig2_ArithDecoder* pArithDecoder,
       JBig2ArithCtx* gbContext);
-  std::unique_ptr<CJBig2_Image> DecodeArithTemplate3Unopt(
+  std::unique_ptr<CJBig2_Image> DecodeArithGeneric(
       CJBig2_ArithDecoder* pArithDecoder,
       JBig2ArithCtx* gbContext);
 
+  // Decodes row `h` of `pImage` with any template and AT pixels, taking the
+  // pixels of the rows above a byte at a time. Returns false if the decoder
+  // runs out of data.
+  bool DecodeRowGeneric(CJBig2_Image* pImage,
+                        uint32_t h,
+                        CJBig2_ArithDecoder* pArithDecoder,
+                        JBig2ArithCtx* gbContext);
+
   uint32_t m_loopIndex = 0;
   UNOWNED_PTR_EXCLUSION uint8_t* m_pLine = nullptr;
   FXCODEC_STATUS m_ProgressiveStatus;
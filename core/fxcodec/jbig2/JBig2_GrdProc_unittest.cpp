@@ -0,0 +1,285 @@
+// Copyright 2024 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcodec/jbig2/JBig2_GrdProc.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "core/fxcodec/jbig2/JBig2_ArithDecoder.h"
+#include "core/fxcodec/jbig2/JBig2_BitStream.h"
+#include "core/fxcodec/jbig2/JBig2_Image.h"
+#include "core/fxcrt/pauseindicator_iface.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+constexpr size_t kContextCount = 65536;
+
+class PauseEveryRow final : public PauseIndicatorIface {
+ public:
+  bool NeedToPauseNow() override { return true; }
+};
+
+// Decodes a generic region a pixel at a time, building each context straight
+// from 6.2.5.3 of the JBIG2 specification.
+std::unique_ptr<CJBig2_Image> DecodeReference(
+    const CJBig2_GRDProc& proc,
+    CJBig2_ArithDecoder* pArithDecoder,
+    JBig2ArithCtx* gbContext) {
+  static constexpr uint16_t kTpgdonContexts[] = {0x9b25, 0x0795, 0x00e5,
+                                                 0x0195};
+  auto image = std::make_unique<CJBig2_Image>(proc.GBW, proc.GBH);
+  image->Fill(false);
+  const int32_t w = proc.GBW;
+  const int32_t h = proc.GBH;
+  const int8_t* at = proc.GBAT;
+  int LTP = 0;
+  for (int32_t y = 0; y < h; ++y) {
+    if (proc.TPGDON) {
+      if (pArithDecoder->IsComplete())
+        return nullptr;
+
+      LTP ^=
+          pArithDecoder->Decode(&gbContext[kTpgdonContexts[proc.GBTEMPLATE]]);
+    }
+    if (LTP) {
+      image->CopyLine(y, y - 1);
+      continue;
+    }
+    for (int32_t x = 0; x < w; ++x) {
+      if (proc.USESKIP && proc.SKIP->GetPixel(x, y))
+        continue;
+
+      auto P = [&image, x, y](int32_t dx, int32_t dy) -> uint32_t {
+        return image->GetPixel(x + dx, y + dy);
+      };
+      uint32_t context = 0;
+      int bit = 0;
+      auto Add = [&context, &bit](uint32_t pixel) {
+        context |= pixel << bit++;
+      };
+      switch (proc.GBTEMPLATE) {
+        case 0:
+          for (int32_t dx = -1; dx >= -4; --dx)
+            Add(P(dx, 0));
+          Add(P(at[0], at[1]));
+          for (int32_t dx = 2; dx >= -2; --dx)
+            Add(P(dx, -1));
+          Add(P(at[2], at[3]));
+          Add(P(at[4], at[5]));
+          for (int32_t dx = 1; dx >= -1; --dx)
+            Add(P(dx, -2));
+          Add(P(at[6], at[7]));
+          break;
+        case 1:
+          for (int32_t dx = -1; dx >= -3; --dx)
+            Add(P(dx, 0));
+          Add(P(at[0], at[1]));
+          for (int32_t dx = 2; dx >= -2; --dx)
+            Add(P(dx, -1));
+          for (int32_t dx = 2; dx >= -1; --dx)
+            Add(P(dx, -2));
+          break;
+        case 2:
+          for (int32_t dx = -1; dx >= -2; --dx)
+            Add(P(dx, 0));
+          Add(P(at[0], at[1]));
+          for (int32_t dx = 1; dx >= -2; --dx)
+            Add(P(dx, -1));
+          for (int32_t dx = 1; dx >= -1; --dx)
+            Add(P(dx, -2));
+          break;
+        default:
+          for (int32_t dx = -1; dx >= -4; --dx)
+            Add(P(dx, 0));
+          Add(P(at[0], at[1]));
+          for (int32_t dx = 1; dx >= -3; --dx)
+            Add(P(dx, -1));
+          break;
+      }
+      if (pArithDecoder->IsComplete())
+        return nullptr;
+
+      image->SetPixel(x, y, pArithDecoder->Decode(&gbContext[context]));
+    }
+  }
+  return image;
+}
+
+void CheckImageEq(const CJBig2_Image* expected, const CJBig2_Image* actual) {
+  ASSERT_TRUE(expected);
+  ASSERT_TRUE(actual);
+  ASSERT_EQ(expected->width(), actual->width());
+  ASSERT_EQ(expected->height(), actual->height());
+  for (int32_t y = 0; y < expected->height(); ++y) {
+    for (int32_t x = 0; x < expected->width(); ++x) {
+      ASSERT_EQ(expected->GetPixel(x, y), actual->GetPixel(x, y))
+          << " at " << x << " " << y;
+    }
+  }
+}
+
+class JBig2GrdProcTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    m_Data.resize(64 * 1024);
+    for (uint8_t& byte : m_Data)
+      byte = static_cast<uint8_t>(m_Random());
+  }
+
+  void SetRandomAt(CJBig2_GRDProc* proc) {
+    std::uniform_int_distribution<int> dx(-20, 20);
+    std::uniform_int_distribution<int> dy(-4, 1);
+    for (int i = 0; i < 4; ++i) {
+      proc->GBAT[2 * i] = dx(m_Random);
+      proc->GBAT[2 * i + 1] = dy(m_Random);
+    }
+  }
+
+  // Checks that DecodeArith() and the progressive decoder both produce what
+  // DecodeReference() does, from the same data.
+  void CheckDecode(CJBig2_GRDProc* proc, size_t data_size) {
+    pdfium::span<const uint8_t> data =
+        pdfium::make_span(m_Data).first(data_size);
+
+    std::vector<JBig2ArithCtx> expected_contexts(kContextCount);
+    CJBig2_BitStream expected_stream(data, 0);
+    CJBig2_ArithDecoder expected_decoder(&expected_stream);
+    std::unique_ptr<CJBig2_Image> expected =
+        DecodeReference(*proc, &expected_decoder, expected_contexts.data());
+
+    std::vector<JBig2ArithCtx> contexts(kContextCount);
+    CJBig2_BitStream stream(data, 0);
+    CJBig2_ArithDecoder decoder(&stream);
+    std::unique_ptr<CJBig2_Image> actual =
+        proc->DecodeArith(&decoder, contexts.data());
+    if (!expected) {
+      EXPECT_FALSE(actual);
+    } else {
+      CheckImageEq(expected.get(), actual.get());
+    }
+
+    std::vector<JBig2ArithCtx> progressive_contexts(kContextCount);
+    CJBig2_BitStream progressive_stream(data, 0);
+    CJBig2_ArithDecoder progressive_decoder(&progressive_stream);
+    std::unique_ptr<CJBig2_Image> progressive;
+    PauseEveryRow pause;
+    CJBig2_GRDProc::ProgressiveArithDecodeState state;
+    state.pImage = &progressive;
+    state.pArithDecoder = &progressive_decoder;
+    state.gbContext = progressive_contexts.data();
+    state.pPause = &pause;
+    FXCODEC_STATUS status = proc->StartDecodeArith(&state);
+    while (status == FXCODEC_STATUS::kDecodeToBeContinued)
+      status = proc->ContinueDecode(&state);
+    if (!expected) {
+      EXPECT_EQ(FXCODEC_STATUS::kError, status);
+    } else {
+      EXPECT_EQ(FXCODEC_STATUS::kDecodeFinished, status);
+      CheckImageEq(expected.get(), progressive.get());
+    }
+  }
+
+  std::mt19937 m_Random{20240101};
+  std::vector<uint8_t> m_Data;
+};
+
+constexpr uint32_t kWidths[] = {1, 7, 8, 9, 31, 64, 67};
+
+}  // namespace
+
+TEST_F(JBig2GrdProcTest, NominalAt) {
+  static constexpr int8_t kNominalAt[4][8] = {
+      {3, -1, -3, -1, 2, -2, -2, -2},
+      {3, -1},
+      {2, -1},
+      {2, -1},
+  };
+  for (uint8_t tmpl = 0; tmpl < 4; ++tmpl) {
+    for (bool tpgdon : {false, true}) {
+      for (uint32_t width : kWidths) {
+        SCOPED_TRACE(testing::Message() << "template " << int{tmpl}
+                                        << " tpgdon " << tpgdon << " width "
+                                        << width);
+        CJBig2_GRDProc proc;
+        proc.MMR = false;
+        proc.TPGDON = tpgdon;
+        proc.USESKIP = false;
+        proc.GBTEMPLATE = tmpl;
+        proc.GBW = width;
+        proc.GBH = 23;
+        for (int i = 0; i < 8; ++i)
+          proc.GBAT[i] = kNominalAt[tmpl][i];
+        CheckDecode(&proc, m_Data.size());
+      }
+    }
+  }
+}
+
+TEST_F(JBig2GrdProcTest, RandomAt) {
+  for (uint8_t tmpl = 0; tmpl < 4; ++tmpl) {
+    for (bool tpgdon : {false, true}) {
+      for (uint32_t width : kWidths) {
+        for (int i = 0; i < 8; ++i) {
+          CJBig2_GRDProc proc;
+          proc.MMR = false;
+          proc.TPGDON = tpgdon;
+          proc.USESKIP = false;
+          proc.GBTEMPLATE = tmpl;
+          proc.GBW = width;
+          proc.GBH = 23;
+          SetRandomAt(&proc);
+          SCOPED_TRACE(testing::Message()
+                       << "template " << int{tmpl} << " tpgdon " << tpgdon
+                       << " width " << width << " at " << int{proc.GBAT[0]}
+                       << "," << int{proc.GBAT[1]});
+          CheckDecode(&proc, m_Data.size());
+        }
+      }
+    }
+  }
+}
+
+TEST_F(JBig2GrdProcTest, Skip) {
+  for (uint8_t tmpl = 0; tmpl < 4; ++tmpl) {
+    for (uint32_t width : kWidths) {
+      SCOPED_TRACE(testing::Message() << "template " << int{tmpl} << " width "
+                                      << width);
+      CJBig2_Image skip(width, 23);
+      for (int32_t y = 0; y < skip.height(); ++y) {
+        for (int32_t x = 0; x < skip.width(); ++x)
+          skip.SetPixel(x, y, m_Random() % 3 == 0);
+      }
+      CJBig2_GRDProc proc;
+      proc.MMR = false;
+      proc.TPGDON = true;
+      proc.USESKIP = true;
+      proc.SKIP = &skip;
+      proc.GBTEMPLATE = tmpl;
+      proc.GBW = width;
+      proc.GBH = 23;
+      SetRandomAt(&proc);
+      CheckDecode(&proc, m_Data.size());
+    }
+  }
+}
+
+TEST_F(JBig2GrdProcTest, OutOfData) {
+  for (uint8_t tmpl = 0; tmpl < 4; ++tmpl) {
+    SCOPED_TRACE(testing::Message() << "template " << int{tmpl});
+    CJBig2_GRDProc proc;
+    proc.MMR = false;
+    proc.TPGDON = false;
+    proc.USESKIP = false;
+    proc.GBTEMPLATE = tmpl;
+    proc.GBW = 200;
+    proc.GBH = 200;
+    SetRandomAt(&proc);
+    CheckDecode(&proc, 16);
+  }
+}
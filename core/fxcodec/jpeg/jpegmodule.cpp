@@ -121,7 +121,8 @@ class JpegDecoder final : public ScanlineDecoder {
               uint32_t width,
               uint32_t height,
               int nComps,
-              bool ColorTransform);
+              bool ColorTransform,
+              uint8_t resolution_levels_to_skip);
 
   // ScanlineDecoder:
   bool Rewind() override;
@@ -133,6 +134,9 @@ class JpegDecoder final : public ScanlineDecoder {
  private:
   void CalcPitch();
   void InitDecompressSrc();
+  // Sets up `m_Cinfo` to decode at the reduced size, and sets the output size
+  // accordingly.
+  void SetOutputScale();
 
   // Can only be called inside a jpeg_read_header() setjmp handler.
   bool HasKnownBadHeaderWithInvalidHeight(size_t dimension_offset) const;
@@ -163,6 +167,7 @@ class JpegDecoder final : public ScanlineDecoder {
   bool m_bStarted = false;
   bool m_bJpegTransform = false;
   uint32_t m_nDefaultScaleDenom = 1;
+  uint8_t m_ResolutionLevelsToSkip = 0;
 };
 
 JpegDecoder::JpegDecoder() {
@@ -234,7 +239,8 @@ bool JpegDecoder::Create(pdfium::span<const uint8_t> src_span,
                          uint32_t width,
                          uint32_t height,
                          int nComps,
-                         bool ColorTransform) {
+                         bool ColorTransform,
+                         uint8_t resolution_levels_to_skip) {
   m_SrcSpan = JpegScanSOI(src_span);
   if (m_SrcSpan.size() < 2)
     return false;
@@ -263,6 +269,9 @@ bool JpegDecoder::Create(pdfium::span<const uint8_t> src_span,
   if (m_Cinfo.image_width < width)
     return false;
 
+  m_ResolutionLevelsToSkip = resolution_levels_to_skip;
+  SetOutputScale();
+
   CalcPitch();
   m_ScanlineBuf = DataVector<uint8_t>(m_Pitch);
   m_nComps = m_Cinfo.num_components;
@@ -281,9 +290,7 @@ bool JpegDecoder::Rewind() {
   if (setjmp(m_JmpBuf) == -1) {
     return false;
   }
-  m_Cinfo.scale_denom = m_nDefaultScaleDenom;
-  m_OutputWidth = m_OrigWidth;
-  m_OutputHeight = m_OrigHeight;
+  SetOutputScale();
   if (!jpeg_start_decompress(&m_Cinfo)) {
     jpeg_destroy_decompress(&m_Cinfo);
     return false;
@@ -316,6 +323,14 @@ void JpegDecoder::CalcPitch() {
   m_Pitch *= 4;
 }
 
+void JpegDecoder::SetOutputScale() {
+  // Rounds up, like jpeg_calc_output_dimensions() does.
+  const int rounding = (1 << m_ResolutionLevelsToSkip) - 1;
+  m_Cinfo.scale_denom = m_nDefaultScaleDenom << m_ResolutionLevelsToSkip;
+  m_OutputWidth = (m_OrigWidth + rounding) >> m_ResolutionLevelsToSkip;
+  m_OutputHeight = (m_OrigHeight + rounding) >> m_ResolutionLevelsToSkip;
+}
+
 void JpegDecoder::InitDecompressSrc() {
   m_Cinfo.src = &m_Src;
   m_Src.bytes_in_buffer = m_SrcSpan.size();
@@ -382,12 +397,16 @@ std::unique_ptr<ScanlineDecoder> JpegModule::CreateDecoder(
     uint32_t width,
     uint32_t height,
     int nComps,
-    bool ColorTransform) {
+    bool ColorTransform,
+    uint8_t resolution_levels_to_skip) {
   DCHECK(!src_span.empty());
+  DCHECK_LE(resolution_levels_to_skip, kMaxResolutionLevelsToSkip);
 
   auto pDecoder = std::make_unique<JpegDecoder>();
-  if (!pDecoder->Create(src_span, width, height, nComps, ColorTransform))
+  if (!pDecoder->Create(src_span, width, height, nComps, ColorTransform,
+                        resolution_levels_to_skip)) {
     return nullptr;
+  }
 
   return std::move(pDecoder);
 }
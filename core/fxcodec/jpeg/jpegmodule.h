@@ -27,6 +27,9 @@ class ScanlineDecoder;
 
 class JpegModule {
  public:
+  // libjpeg scales down by up to 1/8.
+  static constexpr uint8_t kMaxResolutionLevelsToSkip = 3;
+
   struct ImageInfo {
     uint32_t width;
     uint32_t height;
@@ -35,12 +38,16 @@ class JpegModule {
     bool color_transform;
   };
 
+  // The decoder decodes at 1 / 2^`resolution_levels_to_skip` of the image
+  // size, which must be at most kMaxResolutionLevelsToSkip. Its GetWidth() and
+  // GetHeight() give the decoded size.
   static std::unique_ptr<ScanlineDecoder> CreateDecoder(
       pdfium::span<const uint8_t> src_span,
       uint32_t width,
       uint32_t height,
       int nComps,
-      bool ColorTransform);
+      bool ColorTransform,
+      uint8_t resolution_levels_to_skip);
 
   static absl::optional<ImageInfo> LoadInfo(
       pdfium::span<const uint8_t> src_span);
@@ -0,0 +1,99 @@
+// Copyright 2024 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcodec/jpeg/jpegmodule.h"
+
+#include <stdint.h>
+
+#include <iterator>
+#include <memory>
+
+#include "core/fxcodec/scanlinedecoder.h"
+#include "core/fxcrt/data_vector.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using fxcodec::JpegModule;
+using fxcodec::ScanlineDecoder;
+
+namespace {
+
+// A 20x16 grayscale JPEG, made of 8x8 blocks of a single value each, see
+// kBlockValues. The blocks in the last column are cut to 4 pixels.
+const uint8_t kBlocksJpeg[] = {
+    0xff, 0xd8, 0xff, 0xe0, 0x00, 0x10, 0x4a, 0x46, 0x49, 0x46, 0x00, 0x01,
+    0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0xff, 0xdb, 0x00, 0x43,
+    0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0xff, 0xc0, 0x00, 0x0b, 0x08, 0x00, 0x10,
+    0x00, 0x14, 0x01, 0x01, 0x11, 0x00, 0xff, 0xc4, 0x00, 0x16, 0x00, 0x01,
+    0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x0a, 0x0b, 0x09, 0xff, 0xc4, 0x00, 0x14, 0x10, 0x01,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xff, 0xda, 0x00, 0x08, 0x01, 0x01, 0x00, 0x00,
+    0x3f, 0x00, 0x1f, 0xeb, 0x00, 0x07, 0xfb, 0x1f, 0xcc, 0x01, 0x2f, 0xf7,
+    0xff, 0xd9,
+};
+
+constexpr uint8_t kBlockValues[2][3] = {{0x20, 0xe0, 0x80},
+                                        {0x50, 0xb0, 0x10}};
+
+// The decoder patches up the data it decodes, so it gets a copy.
+DataVector<uint8_t> GetBlocksJpeg() {
+  return DataVector<uint8_t>(std::begin(kBlocksJpeg), std::end(kBlocksJpeg));
+}
+
+}  // namespace
+
+TEST(JpegModule, ScaledDecode) {
+  // Output sizes round up, like libjpeg does.
+  static constexpr struct {
+    uint8_t resolution_levels_to_skip;
+    int width;
+    int height;
+  } kTestCases[] = {{0, 20, 16}, {1, 10, 8}, {2, 5, 4}, {3, 3, 2}};
+
+  for (const auto& test_case : kTestCases) {
+    const uint8_t levels = test_case.resolution_levels_to_skip;
+    DataVector<uint8_t> data = GetBlocksJpeg();
+    std::unique_ptr<ScanlineDecoder> decoder = JpegModule::CreateDecoder(
+        data, 20, 16, 1, /*ColorTransform=*/true, levels);
+    ASSERT_TRUE(decoder) << "levels " << levels;
+    EXPECT_EQ(test_case.width, decoder->GetWidth()) << "levels " << levels;
+    EXPECT_EQ(test_case.height, decoder->GetHeight()) << "levels " << levels;
+    EXPECT_EQ(1, decoder->CountComps());
+    EXPECT_EQ(8, decoder->GetBPC());
+
+    // Every block is a single value, so it decodes to that value at any
+    // scale, give or take rounding.
+    const int block_size = 8 >> levels;
+    for (int row = 0; row < test_case.height; ++row) {
+      pdfium::span<const uint8_t> scanline = decoder->GetScanline(row);
+      ASSERT_GE(scanline.size(), static_cast<size_t>(test_case.width));
+      for (int col = 0; col < test_case.width; ++col) {
+        EXPECT_NEAR(kBlockValues[row / block_size][col / block_size],
+                    scanline[col], 2)
+            << "levels " << levels << " at " << col << "," << row;
+      }
+    }
+  }
+}
+
+TEST(JpegModule, ScaledDecodeRewind) {
+  DataVector<uint8_t> data = GetBlocksJpeg();
+  std::unique_ptr<ScanlineDecoder> decoder = JpegModule::CreateDecoder(
+      data, 20, 16, 1, /*ColorTransform=*/true,
+      /*resolution_levels_to_skip=*/2);
+  ASSERT_TRUE(decoder);
+  ASSERT_FALSE(decoder->GetScanline(3).empty());
+
+  // Going back to an earlier line rewinds, which keeps the reduced size.
+  pdfium::span<const uint8_t> scanline = decoder->GetScanline(0);
+  ASSERT_FALSE(scanline.empty());
+  EXPECT_EQ(5, decoder->GetWidth());
+  EXPECT_EQ(4, decoder->GetHeight());
+  EXPECT_NEAR(kBlockValues[0][2], scanline[4], 2);
+}
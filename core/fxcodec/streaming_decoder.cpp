@@ -0,0 +1,74 @@
+// Copyright 2024 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcodec/streaming_decoder.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "core/fxcrt/span_util.h"
+
+namespace fxcodec {
+
+SpanStreamingDecoder::SpanStreamingDecoder(
+    pdfium::span<const uint8_t> src_span)
+    : m_SrcSpan(src_span) {}
+
+SpanStreamingDecoder::~SpanStreamingDecoder() = default;
+
+size_t SpanStreamingDecoder::Read(pdfium::span<uint8_t> buffer) {
+  const size_t size = std::min(buffer.size(), m_SrcSpan.size());
+  fxcrt::spancpy(buffer, m_SrcSpan.first(size));
+  m_SrcSpan = m_SrcSpan.subspan(size);
+  return size;
+}
+
+bool SpanStreamingDecoder::HasError() const {
+  return false;
+}
+
+ChunkedStreamingDecoder::ChunkedStreamingDecoder(size_t max_chunk_size)
+    : m_Chunk(max_chunk_size) {}
+
+ChunkedStreamingDecoder::~ChunkedStreamingDecoder() = default;
+
+size_t ChunkedStreamingDecoder::Read(pdfium::span<uint8_t> buffer) {
+  size_t written = 0;
+  while (written < buffer.size()) {
+    if (m_ChunkPos == m_ChunkSize) {
+      if (m_bEOF)
+        break;
+
+      m_ChunkPos = 0;
+      m_ChunkSize = 0;
+      if (!DecodeChunk(m_Chunk, &m_ChunkSize)) {
+        m_bEOF = true;
+        m_ChunkSize = 0;
+      }
+      continue;
+    }
+    const size_t size =
+        std::min(buffer.size() - written, m_ChunkSize - m_ChunkPos);
+    fxcrt::spancpy(buffer.subspan(written),
+                   pdfium::make_span(m_Chunk).subspan(m_ChunkPos, size));
+    m_ChunkPos += size;
+    written += size;
+  }
+  return written;
+}
+
+StreamingDecoderInput::StreamingDecoderInput(
+    std::unique_ptr<StreamingDecoder> pUpstream)
+    : m_pUpstream(std::move(pUpstream)),
+      m_Buffer(StreamingDecoder::kChunkSize) {}
+
+StreamingDecoderInput::~StreamingDecoderInput() = default;
+
+bool StreamingDecoderInput::Refill() {
+  m_Pos = 0;
+  m_Size = m_pUpstream->Read(m_Buffer);
+  return m_Size > 0;
+}
+
+}  // namespace fxcodec
@@ -0,0 +1,109 @@
+// Copyright 2024 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXCODEC_STREAMING_DECODER_H_
+#define CORE_FXCODEC_STREAMING_DECODER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+
+#include "core/fxcrt/data_vector.h"
+#include "third_party/base/containers/span.h"
+
+namespace fxcodec {
+
+// A stage of a pull-based decoding pipeline. Each stage reads its input from
+// the stage before it in chunks of bounded size, so a chain of filters never
+// holds more than one full copy of the data.
+class StreamingDecoder {
+ public:
+  // The size of the chunks stages read from the stage before them.
+  static constexpr size_t kChunkSize = 16 * 1024;
+
+  virtual ~StreamingDecoder() = default;
+
+  // Fills `buffer` with decoded data. Returns the number of bytes written,
+  // which is less than `buffer.size()` only at the end of the data.
+  virtual size_t Read(pdfium::span<uint8_t> buffer) = 0;
+
+  // Whether this stage, or one before it, found its input to be invalid.
+  // Only final once Read() has reached the end of the data.
+  virtual bool HasError() const = 0;
+};
+
+// The first stage of a pipeline. Does not copy `src_span`, which must outlive
+// it.
+class SpanStreamingDecoder final : public StreamingDecoder {
+ public:
+  explicit SpanStreamingDecoder(pdfium::span<const uint8_t> src_span);
+  ~SpanStreamingDecoder() override;
+
+  // StreamingDecoder:
+  size_t Read(pdfium::span<uint8_t> buffer) override;
+  bool HasError() const override;
+
+ private:
+  pdfium::span<const uint8_t> m_SrcSpan;
+};
+
+// Base for stages that decode their input into chunks of bounded size, such as
+// a row or a run, and hand them out across Read() calls.
+class ChunkedStreamingDecoder : public StreamingDecoder {
+ public:
+  ~ChunkedStreamingDecoder() override;
+
+  // StreamingDecoder:
+  size_t Read(pdfium::span<uint8_t> buffer) final;
+
+ protected:
+  explicit ChunkedStreamingDecoder(size_t max_chunk_size);
+
+  // Decodes the next chunk into `chunk`, which is `max_chunk_size` bytes long,
+  // and sets `size` to its actual length, which may be 0. Returns false at the
+  // end of the data.
+  virtual bool DecodeChunk(pdfium::span<uint8_t> chunk, size_t* size) = 0;
+
+ private:
+  DataVector<uint8_t> m_Chunk;
+  size_t m_ChunkPos = 0;
+  size_t m_ChunkSize = 0;
+  bool m_bEOF = false;
+};
+
+// Buffers the output of the stage before a stage that consumes its input a
+// byte at a time.
+class StreamingDecoderInput {
+ public:
+  explicit StreamingDecoderInput(std::unique_ptr<StreamingDecoder> pUpstream);
+  ~StreamingDecoderInput();
+
+  // Returns false at the end of the input.
+  bool ReadByte(uint8_t* byte) {
+    if (m_Pos == m_Size && !Refill())
+      return false;
+    *byte = m_Buffer[m_Pos++];
+    return true;
+  }
+
+  bool HasError() const { return m_pUpstream->HasError(); }
+
+ private:
+  bool Refill();
+
+  std::unique_ptr<StreamingDecoder> const m_pUpstream;
+  DataVector<uint8_t> m_Buffer;
+  size_t m_Pos = 0;
+  size_t m_Size = 0;
+};
+
+}  // namespace fxcodec
+
+using fxcodec::ChunkedStreamingDecoder;
+using fxcodec::SpanStreamingDecoder;
+using fxcodec::StreamingDecoder;
+using fxcodec::StreamingDecoderInput;
+
+#endif  // CORE_FXCODEC_STREAMING_DECODER_H_
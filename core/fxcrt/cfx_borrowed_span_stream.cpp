@@ -0,0 +1,43 @@
+// Copyright 2024 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcrt/cfx_borrowed_span_stream.h"
+
+#include "core/fxcrt/fx_safe_types.h"
+#include "core/fxcrt/span_util.h"
+#include "third_party/base/numerics/safe_conversions.h"
+
+CFX_BorrowedSpanStream::CFX_BorrowedSpanStream(pdfium::span<const uint8_t> span)
+    : span_(span) {}
+
+CFX_BorrowedSpanStream::~CFX_BorrowedSpanStream() = default;
+
+FX_FILESIZE CFX_BorrowedSpanStream::GetSize() {
+  return pdfium::base::checked_cast<FX_FILESIZE>(span_.size());
+}
+
+bool CFX_BorrowedSpanStream::ReadBlockAtOffset(pdfium::span<uint8_t> buffer,
+                                               FX_FILESIZE offset) {
+  pdfium::span<const uint8_t> block =
+      BorrowBlockAtOffset(offset, buffer.size());
+  if (block.empty())
+    return false;
+
+  fxcrt::spancpy(buffer, block);
+  return true;
+}
+
+pdfium::span<const uint8_t> CFX_BorrowedSpanStream::BorrowBlockAtOffset(
+    FX_FILESIZE offset,
+    size_t size) {
+  if (size == 0 || offset < 0)
+    return {};
+
+  FX_SAFE_SIZE_T pos = size;
+  pos += offset;
+  if (!pos.IsValid() || pos.ValueOrDie() > span_.size())
+    return {};
+
+  return span_.subspan(pdfium::base::checked_cast<size_t>(offset), size);
+}
@@ -0,0 +1,34 @@
+// Copyright 2024 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXCRT_CFX_BORROWED_SPAN_STREAM_H_
+#define CORE_FXCRT_CFX_BORROWED_SPAN_STREAM_H_
+
+#include "core/fxcrt/fx_stream.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "third_party/base/containers/span.h"
+
+// Like CFX_ReadOnlySpanStream, but also lends out the span's memory through
+// BorrowBlockAtOffset(), the way a memory-mapped file does. Only use it when
+// the memory outlives everything created from the stream, as borrowers may
+// retain the stream itself but cannot keep the memory alive.
+class CFX_BorrowedSpanStream final : public IFX_SeekableReadStream {
+ public:
+  CONSTRUCT_VIA_MAKE_RETAIN;
+
+  // IFX_SeekableReadStream:
+  FX_FILESIZE GetSize() override;
+  bool ReadBlockAtOffset(pdfium::span<uint8_t> buffer,
+                         FX_FILESIZE offset) override;
+  pdfium::span<const uint8_t> BorrowBlockAtOffset(FX_FILESIZE offset,
+                                                  size_t size) override;
+
+ private:
+  explicit CFX_BorrowedSpanStream(pdfium::span<const uint8_t> span);
+  ~CFX_BorrowedSpanStream() override;
+
+  const pdfium::span<const uint8_t> span_;
+};
+
+#endif  // CORE_FXCRT_CFX_BORROWED_SPAN_STREAM_H_
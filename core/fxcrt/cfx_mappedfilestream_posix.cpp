@@ -0,0 +1,90 @@
+// Copyright 2024 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcrt/cfx_mappedfilestream_posix.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "core/fxcrt/fx_safe_types.h"
+#include "core/fxcrt/span_util.h"
+#include "third_party/base/numerics/safe_conversions.h"
+
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif  // O_BINARY
+
+#ifndef O_LARGEFILE
+#define O_LARGEFILE 0
+#endif  // O_LARGEFILE
+
+// static
+RetainPtr<CFX_MappedFileStream_Posix> CFX_MappedFileStream_Posix::Create(
+    const char* filename) {
+  int fd = open(filename, O_BINARY | O_LARGEFILE | O_RDONLY);
+  if (fd < 0)
+    return nullptr;
+
+  struct stat s;
+  memset(&s, 0, sizeof(s));
+  if (fstat(fd, &s) != 0 || s.st_size <= 0 ||
+      !pdfium::base::IsValueInRangeForNumericType<size_t>(s.st_size)) {
+    close(fd);
+    return nullptr;
+  }
+
+  const size_t size = static_cast<size_t>(s.st_size);
+  void* addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+  // The mapping stays valid after the descriptor is closed.
+  close(fd);
+  if (addr == MAP_FAILED)
+    return nullptr;
+
+  return pdfium::MakeRetain<CFX_MappedFileStream_Posix>(
+      pdfium::make_span(static_cast<const uint8_t*>(addr), size));
+}
+
+CFX_MappedFileStream_Posix::CFX_MappedFileStream_Posix(
+    pdfium::span<const uint8_t> mapping)
+    : mapping_(mapping) {}
+
+CFX_MappedFileStream_Posix::~CFX_MappedFileStream_Posix() {
+  munmap(const_cast<uint8_t*>(mapping_.data()), mapping_.size());
+}
+
+FX_FILESIZE CFX_MappedFileStream_Posix::GetSize() {
+  return pdfium::base::checked_cast<FX_FILESIZE>(mapping_.size());
+}
+
+bool CFX_MappedFileStream_Posix::ReadBlockAtOffset(
+    pdfium::span<uint8_t> buffer,
+    FX_FILESIZE offset) {
+  if (buffer.empty())
+    return false;
+
+  pdfium::span<const uint8_t> block =
+      BorrowBlockAtOffset(offset, buffer.size());
+  if (block.empty())
+    return false;
+
+  fxcrt::spancpy(buffer, block);
+  return true;
+}
+
+pdfium::span<const uint8_t> CFX_MappedFileStream_Posix::BorrowBlockAtOffset(
+    FX_FILESIZE offset,
+    size_t size) {
+  if (offset < 0)
+    return {};
+
+  FX_SAFE_SIZE_T end = size;
+  end += offset;
+  if (!end.IsValid() || end.ValueOrDie() > mapping_.size())
+    return {};
+
+  return mapping_.subspan(static_cast<size_t>(offset), size);
+}
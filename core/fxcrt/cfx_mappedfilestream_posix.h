@@ -0,0 +1,45 @@
+// Copyright 2024 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXCRT_CFX_MAPPEDFILESTREAM_POSIX_H_
+#define CORE_FXCRT_CFX_MAPPEDFILESTREAM_POSIX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "build/build_config.h"
+#include "core/fxcrt/fx_stream.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "third_party/base/containers/span.h"
+
+#if !BUILDFLAG(IS_POSIX) && !BUILDFLAG(IS_FUCHSIA)
+#error "Included on the wrong platform"
+#endif
+
+// Read-only stream over a file mapped into memory with mmap(). Unlike the
+// stream returned by IFX_SeekableReadStream::CreateFromFilename(), it can lend
+// out views of the file contents via BorrowBlockAtOffset(), which lets the
+// parser reference raw stream data without copying it.
+class CFX_MappedFileStream_Posix final : public IFX_SeekableReadStream {
+ public:
+  CONSTRUCT_VIA_MAKE_RETAIN;
+
+  // Returns nullptr if `filename` cannot be opened or mapped, or is empty.
+  static RetainPtr<CFX_MappedFileStream_Posix> Create(const char* filename);
+
+  // IFX_SeekableReadStream:
+  FX_FILESIZE GetSize() override;
+  bool ReadBlockAtOffset(pdfium::span<uint8_t> buffer,
+                         FX_FILESIZE offset) override;
+  pdfium::span<const uint8_t> BorrowBlockAtOffset(FX_FILESIZE offset,
+                                                  size_t size) override;
+
+ private:
+  explicit CFX_MappedFileStream_Posix(pdfium::span<const uint8_t> mapping);
+  ~CFX_MappedFileStream_Posix() override;
+
+  const pdfium::span<const uint8_t> mapping_;
+};
+
+#endif  // CORE_FXCRT_CFX_MAPPEDFILESTREAM_POSIX_H_
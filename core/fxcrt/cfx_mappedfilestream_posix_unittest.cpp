@@ -0,0 +1,72 @@
+// Copyright 2024 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcrt/cfx_mappedfilestream_posix.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+class MappedFileStreamTest : public testing::Test {
+ public:
+  void SetUp() override {
+    char path[] = "/tmp/pdfium_mapped_file_XXXXXX";
+    int fd = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(10, write(fd, "0123456789", 10));
+    close(fd);
+    path_ = path;
+  }
+
+  void TearDown() override { unlink(path_.c_str()); }
+
+  const std::string& path() const { return path_; }
+
+ private:
+  std::string path_;
+};
+
+}  // namespace
+
+TEST_F(MappedFileStreamTest, Nonexistent) {
+  EXPECT_FALSE(
+      CFX_MappedFileStream_Posix::Create("/tmp/no_such_pdfium_file.pdf"));
+}
+
+TEST_F(MappedFileStreamTest, ReadBlockAtOffset) {
+  auto stream = CFX_MappedFileStream_Posix::Create(path().c_str());
+  ASSERT_TRUE(stream);
+  EXPECT_EQ(10, stream->GetSize());
+
+  uint8_t buffer[4] = {};
+  ASSERT_TRUE(stream->ReadBlockAtOffset(buffer, 3));
+  EXPECT_EQ(0, memcmp(buffer, "3456", 4));
+  EXPECT_TRUE(stream->ReadBlockAtOffset(buffer, 6));
+  EXPECT_FALSE(stream->ReadBlockAtOffset(buffer, 7));
+  EXPECT_FALSE(stream->ReadBlockAtOffset(buffer, -1));
+}
+
+TEST_F(MappedFileStreamTest, BorrowBlockAtOffset) {
+  auto stream = CFX_MappedFileStream_Posix::Create(path().c_str());
+  ASSERT_TRUE(stream);
+
+  pdfium::span<const uint8_t> whole = stream->BorrowBlockAtOffset(0, 10);
+  ASSERT_EQ(10u, whole.size());
+  EXPECT_EQ(0, memcmp(whole.data(), "0123456789", 10));
+
+  // Borrowing returns views into the same mapping, not copies.
+  pdfium::span<const uint8_t> part = stream->BorrowBlockAtOffset(4, 2);
+  ASSERT_EQ(2u, part.size());
+  EXPECT_EQ(whole.data() + 4, part.data());
+
+  EXPECT_TRUE(stream->BorrowBlockAtOffset(9, 2).empty());
+  EXPECT_TRUE(stream->BorrowBlockAtOffset(-1, 2).empty());
+}
@@ -9,8 +9,13 @@
 #include <memory>
 #include <utility>
 
+#include "build/build_config.h"
 #include "core/fxcrt/fileaccess_iface.h"
 
+#if BUILDFLAG(IS_POSIX) || BUILDFLAG(IS_FUCHSIA)
+#include "core/fxcrt/cfx_mappedfilestream_posix.h"
+#endif
+
 namespace {
 
 class CFX_CRTFileStream final : public IFX_SeekableStream {
@@ -73,6 +78,16 @@ RetainPtr<IFX_SeekableReadStream> IFX_SeekableReadStream::CreateFromFilename(
   return pdfium::MakeRetain<CFX_CRTFileStream>(std::move(pFA));
 }
 
+// static
+RetainPtr<IFX_SeekableReadStream>
+IFX_SeekableReadStream::CreateMappedFromFilename(const char* filename) {
+#if BUILDFLAG(IS_POSIX) || BUILDFLAG(IS_FUCHSIA)
+  return CFX_MappedFileStream_Posix::Create(filename);
+#else
+  return nullptr;
+#endif
+}
+
 bool IFX_SeekableWriteStream::WriteBlock(pdfium::span<const uint8_t> buffer) {
   return WriteBlockAtOffset(buffer, GetSize());
 }
@@ -89,6 +104,12 @@ size_t IFX_SeekableReadStream::ReadBlock(pdfium::span<uint8_t> buffer) {
   return 0;
 }
 
+pdfium::span<const uint8_t> IFX_SeekableReadStream::BorrowBlockAtOffset(
+    FX_FILESIZE offset,
+    size_t size) {
+  return {};
+}
+
 bool IFX_SeekableStream::WriteBlock(pdfium::span<const uint8_t> buffer) {
   return WriteBlockAtOffset(buffer, GetSize());
 }
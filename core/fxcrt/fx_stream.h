@@ -59,11 +59,25 @@ class IFX_SeekableReadStream : virtual public Retainable,
   static RetainPtr<IFX_SeekableReadStream> CreateFromFilename(
       const char* filename);
 
+  // Like CreateFromFilename(), but maps the file into memory so that
+  // BorrowBlockAtOffset() succeeds. Returns nullptr if the file cannot be
+  // mapped, including on platforms without memory mapping support.
+  static RetainPtr<IFX_SeekableReadStream> CreateMappedFromFilename(
+      const char* filename);
+
   virtual bool IsEOF();
   virtual FX_FILESIZE GetPosition();
   [[nodiscard]] virtual size_t ReadBlock(pdfium::span<uint8_t> buffer);
   [[nodiscard]] virtual bool ReadBlockAtOffset(pdfium::span<uint8_t> buffer,
                                                FX_FILESIZE offset) = 0;
+
+  // Returns a view of `size` bytes starting at `offset` if the stream can lend
+  // its underlying storage without copying, e.g. when the file is
+  // memory-mapped. The view remains valid for as long as the stream is alive.
+  // Returns an empty span if the stream does not support borrowing, or if the
+  // range is out of bounds.
+  virtual pdfium::span<const uint8_t> BorrowBlockAtOffset(FX_FILESIZE offset,
+                                                          size_t size);
 };
 
 class IFX_SeekableStream : public IFX_SeekableReadStream,
@@ -0,0 +1,39 @@
+// Copyright 2024 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcrt/parallel_for.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace fxcrt {
+
+void ParallelFor(size_t count,
+                 size_t max_threads,
+                 const std::function<void(size_t)>& task) {
+  const size_t thread_count = std::min(count, max_threads);
+  if (thread_count <= 1) {
+    for (size_t i = 0; i < count; ++i)
+      task(i);
+    return;
+  }
+
+  std::atomic<size_t> next_index{0};
+  auto run_tasks = [&next_index, count, &task]() {
+    for (size_t i = next_index++; i < count; i = next_index++)
+      task(i);
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(thread_count - 1);
+  for (size_t i = 1; i < thread_count; ++i)
+    threads.emplace_back(run_tasks);
+  run_tasks();
+  for (auto& thread : threads)
+    thread.join();
+}
+
+}  // namespace fxcrt
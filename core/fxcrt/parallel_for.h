@@ -0,0 +1,27 @@
+// Copyright 2024 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXCRT_PARALLEL_FOR_H_
+#define CORE_FXCRT_PARALLEL_FOR_H_
+
+#include <stddef.h>
+
+#include <functional>
+
+namespace fxcrt {
+
+// Calls `task` once for every index in [0, count), spreading the calls over
+// at most `max_threads` threads, one of which is the calling thread. Returns
+// after every call has finished. Indices are handed out in increasing order,
+// but may complete in any order, so `task` must only touch state that is
+// private to its index or otherwise safe to share between threads.
+void ParallelFor(size_t count,
+                 size_t max_threads,
+                 const std::function<void(size_t)>& task);
+
+}  // namespace fxcrt
+
+using fxcrt::ParallelFor;
+
+#endif  // CORE_FXCRT_PARALLEL_FOR_H_
@@ -0,0 +1,42 @@
+// Copyright 2024 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcrt/parallel_for.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+TEST(ParallelFor, NoTasks) {
+  bool called = false;
+  ParallelFor(0, 4, [&called](size_t) { called = true; });
+  EXPECT_FALSE(called);
+}
+
+TEST(ParallelFor, SingleThreadRunsInOrderOnCaller) {
+  const std::thread::id caller = std::this_thread::get_id();
+  std::vector<size_t> order;
+  ParallelFor(5, 1, [&order, caller](size_t i) {
+    EXPECT_EQ(caller, std::this_thread::get_id());
+    order.push_back(i);
+  });
+  EXPECT_EQ((std::vector<size_t>{0, 1, 2, 3, 4}), order);
+}
+
+TEST(ParallelFor, EachIndexRunsOnce) {
+  constexpr size_t kCount = 1000;
+  std::vector<std::atomic<int>> calls(kCount);
+  ParallelFor(kCount, 8, [&calls](size_t i) { ++calls[i]; });
+  for (size_t i = 0; i < kCount; ++i)
+    EXPECT_EQ(1, calls[i].load()) << i;
+}
+
+TEST(ParallelFor, MoreThreadsThanTasks) {
+  std::vector<int> results(3);
+  ParallelFor(results.size(), 16,
+              [&results](size_t i) { results[i] = static_cast<int>(i * i); });
+  EXPECT_EQ((std::vector<int>{0, 1, 4}), results);
+}
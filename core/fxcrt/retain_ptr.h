@@ -7,6 +7,7 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <type_traits>
@@ -193,10 +194,51 @@ class Retainable {
                 "to work properly in Retain()");
 };
 
+// Like Retainable, but with an atomic ref count, for objects that several
+// threads may retain and release at the same time, such as process-wide
+// singletons. Only the ref count is thread-safe.
+class RetainableThreadSafe {
+ public:
+  RetainableThreadSafe() = default;
+
+  bool HasOneRef() const {
+    return m_nRefCount.load(std::memory_order_acquire) == 1;
+  }
+
+ protected:
+  virtual ~RetainableThreadSafe() = default;
+
+ private:
+  template <typename U>
+  friend struct ReleaseDeleter;
+
+  template <typename U>
+  friend class RetainPtr;
+
+  RetainableThreadSafe(const RetainableThreadSafe& that) = delete;
+  RetainableThreadSafe& operator=(const RetainableThreadSafe& that) = delete;
+
+  void Retain() const {
+    const uintptr_t old_count =
+        m_nRefCount.fetch_add(1, std::memory_order_relaxed);
+    CHECK(old_count + 1 > 0);
+  }
+  void Release() const {
+    const uintptr_t old_count =
+        m_nRefCount.fetch_sub(1, std::memory_order_acq_rel);
+    CHECK(old_count > 0);
+    if (old_count == 1)
+      delete this;
+  }
+
+  mutable std::atomic<uintptr_t> m_nRefCount{0};
+};
+
 }  // namespace fxcrt
 
 using fxcrt::ReleaseDeleter;
 using fxcrt::Retainable;
+using fxcrt::RetainableThreadSafe;
 using fxcrt::RetainPtr;
 
 namespace pdfium {
@@ -6,6 +6,7 @@
 
 #include <functional>
 #include <set>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -34,6 +35,19 @@ class NoLinearSearchSet : public std::set<T, C> {
   typename std::set<T, C>::const_iterator cbegin() const noexcept = delete;
 };
 
+class ThreadSafeObject final : public RetainableThreadSafe {
+ public:
+  CONSTRUCT_VIA_MAKE_RETAIN;
+
+  static int s_destroyed;
+
+ private:
+  ThreadSafeObject() = default;
+  ~ThreadSafeObject() override { ++s_destroyed; }
+};
+
+int ThreadSafeObject::s_destroyed = 0;
+
 }  // namespace
 
 TEST(RetainPtr, DefaultCtor) {
@@ -520,4 +534,27 @@ TEST(RetainPtr, VectorContains) {
   EXPECT_FALSE(pdfium::Contains(vec, const_ptr2));
 }
 
+TEST(RetainPtr, ThreadSafeRetainable) {
+  ThreadSafeObject::s_destroyed = 0;
+  RetainPtr<ThreadSafeObject> ptr = pdfium::MakeRetain<ThreadSafeObject>();
+  EXPECT_TRUE(ptr->HasOneRef());
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&ptr] {
+      for (int j = 0; j < 10000; ++j) {
+        RetainPtr<ThreadSafeObject> copy = ptr;
+        RetainPtr<const ThreadSafeObject> const_copy = copy;
+      }
+    });
+  }
+  for (std::thread& thread : threads)
+    thread.join();
+
+  EXPECT_TRUE(ptr->HasOneRef());
+  EXPECT_EQ(0, ThreadSafeObject::s_destroyed);
+  ptr.Reset();
+  EXPECT_EQ(1, ThreadSafeObject::s_destroyed);
+}
+
 }  // namespace fxcrt
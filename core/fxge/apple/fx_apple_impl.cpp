@@ -160,7 +160,7 @@ bool CFX_AggDeviceDriver::DrawDeviceText(
 
 }  // namespace pdfium
 
-std::unique_ptr<CFX_GlyphBitmap> CFX_GlyphCache::RenderGlyph_Nativetext(
+RetainPtr<CFX_GlyphBitmap> CFX_GlyphCache::RenderGlyph_Nativetext(
     const CFX_Font* pFont,
     uint32_t glyph_index,
     const CFX_Matrix& matrix,
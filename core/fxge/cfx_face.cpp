@@ -425,12 +425,12 @@ absl::optional<std::array<uint8_t, 2>> CFX_Face::GetOs2Panose() {
   return std::array<uint8_t, 2>{os2->panose[0], os2->panose[1]};
 }
 
-std::unique_ptr<CFX_GlyphBitmap> CFX_Face::RenderGlyph(const CFX_Font* pFont,
-                                                       uint32_t glyph_index,
-                                                       bool bFontStyle,
-                                                       const CFX_Matrix& matrix,
-                                                       int dest_width,
-                                                       int anti_alias) {
+RetainPtr<CFX_GlyphBitmap> CFX_Face::RenderGlyph(const CFX_Font* pFont,
+                                                 uint32_t glyph_index,
+                                                 bool bFontStyle,
+                                                 const CFX_Matrix& matrix,
+                                                 int dest_width,
+                                                 int anti_alias) {
   FT_Matrix ft_matrix;
   ft_matrix.xx = matrix.a / 64 * 65536;
   ft_matrix.xy = matrix.c / 64 * 65536;
@@ -514,8 +514,8 @@ std::unique_ptr<CFX_GlyphBitmap> CFX_Face::RenderGlyph(const CFX_Font* pFont,
     return nullptr;
   }
   int dib_width = bitmap.width;
-  auto pGlyphBitmap =
-      std::make_unique<CFX_GlyphBitmap>(glyph->bitmap_left, glyph->bitmap_top);
+  auto pGlyphBitmap = pdfium::MakeRetain<CFX_GlyphBitmap>(glyph->bitmap_left,
+                                                          glyph->bitmap_top);
   pGlyphBitmap->GetBitmap()->Create(dib_width, bitmap.rows,
                                     anti_alias == FT_RENDER_MODE_MONO
                                         ? FXDIB_Format::k1bppMask
@@ -710,8 +710,13 @@ bool CFX_Face::SelectCharMap(fxge::FontEncoding encoding) {
   return !error;
 }
 
+void CFX_Face::SelectInitialCharMap() {
+  // FT_Set_Charmap() cannot select no charmap.
+  GetRec()->charmap = static_cast<FT_CharMap>(m_InitialCharMap);
+}
+
 CFX_Face::CFX_Face(FXFT_FaceRec* rec, RetainPtr<Retainable> pDesc)
-    : m_pRec(rec), m_pDesc(std::move(pDesc)) {
+    : m_pRec(rec), m_pDesc(std::move(pDesc)), m_InitialCharMap(rec->charmap) {
   DCHECK(m_pRec);
 }
 
@@ -83,12 +83,12 @@ class CFX_Face final : public Retainable, public Observable {
   absl::optional<std::array<uint32_t, 2>> GetOs2CodePageRange();
   absl::optional<std::array<uint8_t, 2>> GetOs2Panose();
 
-  std::unique_ptr<CFX_GlyphBitmap> RenderGlyph(const CFX_Font* pFont,
-                                               uint32_t glyph_index,
-                                               bool bFontStyle,
-                                               const CFX_Matrix& matrix,
-                                               int dest_width,
-                                               int anti_alias);
+  RetainPtr<CFX_GlyphBitmap> RenderGlyph(const CFX_Font* pFont,
+                                         uint32_t glyph_index,
+                                         bool bFontStyle,
+                                         const CFX_Matrix& matrix,
+                                         int dest_width,
+                                         int anti_alias);
   std::unique_ptr<CFX_Path> LoadGlyphPath(uint32_t glyph_index,
                                           int dest_width,
                                           bool is_vertical,
@@ -113,6 +113,10 @@ class CFX_Face final : public Retainable, public Observable {
   void SetCharMapByIndex(size_t index);
   bool SelectCharMap(fxge::FontEncoding encoding);
 
+  // Selects the charmap that FreeType selected when opening the face, which
+  // may be none.
+  void SelectInitialCharMap();
+
   FXFT_FaceRec* GetRec() { return m_pRec.get(); }
   const FXFT_FaceRec* GetRec() const { return m_pRec.get(); }
 
@@ -124,6 +128,7 @@ class CFX_Face final : public Retainable, public Observable {
 
   ScopedFXFTFaceRec const m_pRec;
   RetainPtr<Retainable> const m_pDesc;
+  CharMap const m_InitialCharMap;
 };
 
 #endif  // CORE_FXGE_CFX_FACE_H_
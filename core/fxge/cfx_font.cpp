@@ -11,10 +11,10 @@
 #include <algorithm>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <utility>
 
 #include "build/build_config.h"
-#include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fx_codepage.h"
 #include "core/fxcrt/fx_stream.h"
 #include "core/fxcrt/unowned_ptr.h"
@@ -209,6 +209,9 @@ void CFX_Font::SetSubstFont(std::unique_ptr<CFX_SubstFont> subst) {
 #endif  // PDF_ENABLE_XFA
 
 CFX_Font::~CFX_Font() {
+  // The face and glyph cache may be shared with fonts on other threads.
+  std::lock_guard<std::recursive_mutex> lock(CFX_GEModule::GetFontLock());
+  m_GlyphCache.Reset();
   m_FontData = {};  // m_FontData can't outive m_Face.
   m_Face.Reset();
 
@@ -262,11 +265,11 @@ bool CFX_Font::LoadEmbedded(pdfium::span<const uint8_t> src_span,
                             uint64_t object_tag) {
   m_bVertical = force_vertical;
   m_ObjectTag = object_tag;
-  m_FontDataAllocation = DataVector<uint8_t>(src_span.begin(), src_span.end());
-  m_Face = CFX_GEModule::Get()->GetFontMgr()->NewFixedFace(
-      nullptr, m_FontDataAllocation, 0);
   m_bEmbedded = true;
-  m_FontData = m_FontDataAllocation;
+  m_Face = CFX_GEModule::Get()->GetFontMgr()->GetSharedEmbeddedFace(
+      src_span, /*face_index=*/0);
+  if (m_Face)
+    m_FontData = m_Face->GetData();
   return !!m_Face;
 }
 
@@ -450,7 +453,7 @@ std::unique_ptr<CFX_Path> CFX_Font::LoadGlyphPathImpl(uint32_t glyph_index,
                                m_pSubstFont.get());
 }
 
-const CFX_GlyphBitmap* CFX_Font::LoadGlyphBitmap(
+RetainPtr<const CFX_GlyphBitmap> CFX_Font::LoadGlyphBitmap(
     uint32_t glyph_index,
     bool bFontStyle,
     const CFX_Matrix& matrix,
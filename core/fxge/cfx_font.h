@@ -72,6 +72,8 @@ class CFX_Font {
                  FX_CodePage code_page,
                  bool bVertical);
 
+  // Shares the face with all other fonts loaded from the same data, see
+  // CFX_FontMgr::GetSharedEmbeddedFace() for selecting charmaps on it.
   bool LoadEmbedded(pdfium::span<const uint8_t> src_span,
                     bool force_vertical,
                     uint64_t object_tag);
@@ -92,7 +94,7 @@ class CFX_Font {
 #endif  // !BUILDFLAG(IS_WIN)
 #endif  // defined(PDF_ENABLE_XFA)
 
-  const CFX_GlyphBitmap* LoadGlyphBitmap(
+  RetainPtr<const CFX_GlyphBitmap> LoadGlyphBitmap(
       uint32_t glyph_index,
       bool bFontStyle,
       const CFX_Matrix& matrix,
@@ -157,7 +159,6 @@ class CFX_Font {
   mutable RetainPtr<CFX_Face> m_Face;
   mutable RetainPtr<CFX_GlyphCache> m_GlyphCache;
   std::unique_ptr<CFX_SubstFont> m_pSubstFont;
-  DataVector<uint8_t> m_FontDataAllocation;
   pdfium::span<uint8_t> m_FontData;
   FontType m_FontType = FontType::kUnknown;
   uint64_t m_ObjectTag = 0;
@@ -11,6 +11,7 @@
 
 #include "core/fxcrt/fx_system.h"
 #include "core/fxcrt/retain_ptr.h"
+#include "core/fxge/cfx_glyphbitmapcache.h"
 #include "core/fxge/cfx_glyphcache.h"
 
 class CFX_Font;
@@ -25,9 +26,12 @@ class CFX_FontCache {
   CFX_TypeFace* GetDeviceCache(const CFX_Font* pFont);
 #endif
 
+  CFX_GlyphBitmapCache* GetGlyphBitmapCache() { return &m_GlyphBitmapCache; }
+
  private:
   std::map<CFX_Face*, ObservedPtr<CFX_GlyphCache>> m_GlyphCacheMap;
   std::map<CFX_Face*, ObservedPtr<CFX_GlyphCache>> m_ExtGlyphCacheMap;
+  CFX_GlyphBitmapCache m_GlyphBitmapCache{CFX_GlyphBitmapCache::kDefaultBudget};
 };
 
 #endif  // CORE_FXGE_CFX_FONTCACHE_H_
@@ -8,15 +8,20 @@
 
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <utility>
 
+#include "core/fdrm/fx_crypt.h"
 #include "core/fxcrt/fixed_uninit_data_vector.h"
+#include "core/fxcrt/span_util.h"
 #include "core/fxge/cfx_fontmapper.h"
+#include "core/fxge/cfx_gemodule.h"
 #include "core/fxge/cfx_substfont.h"
 #include "core/fxge/fontdata/chromefontdata/chromefontdata.h"
 #include "core/fxge/fx_font.h"
 #include "core/fxge/systemfontinfo_iface.h"
 #include "third_party/base/check_op.h"
+#include "third_party/base/numerics/safe_conversions.h"
 
 namespace {
 
@@ -58,7 +63,17 @@ FXFT_LibraryRec* FTLibraryInitHelper() {
 CFX_FontMgr::FontDesc::FontDesc(FixedUninitDataVector<uint8_t> data)
     : m_pFontData(std::move(data)) {}
 
-CFX_FontMgr::FontDesc::~FontDesc() = default;
+CFX_FontMgr::FontDesc::FontDesc(FixedUninitDataVector<uint8_t> data,
+                                CFX_FontMgr* pEmbeddedFontMgr,
+                                const ByteString& embedded_key)
+    : m_pFontData(std::move(data)),
+      m_pEmbeddedFontMgr(pEmbeddedFontMgr),
+      m_EmbeddedKey(embedded_key) {}
+
+CFX_FontMgr::FontDesc::~FontDesc() {
+  if (m_pEmbeddedFontMgr)
+    m_pEmbeddedFontMgr->RemoveEmbeddedFontDesc(m_EmbeddedKey);
+}
 
 void CFX_FontMgr::FontDesc::SetFace(size_t index, CFX_Face* face) {
   CHECK_LT(index, std::size(m_TTCFaces));
@@ -128,6 +143,45 @@ RetainPtr<CFX_Face> CFX_FontMgr::NewFixedFace(RetainPtr<FontDesc> pDesc,
   return face;
 }
 
+RetainPtr<CFX_Face> CFX_FontMgr::GetSharedEmbeddedFace(
+    pdfium::span<const uint8_t> data,
+    size_t face_index) {
+  uint8_t digest[32];
+  CRYPT_SHA256Generate(data.data(),
+                       pdfium::base::checked_cast<uint32_t>(data.size()),
+                       digest);
+  ByteString key(digest, sizeof(digest));
+
+  std::lock_guard<std::recursive_mutex> lock(CFX_GEModule::GetFontLock());
+  RetainPtr<FontDesc> pFontDesc;
+  auto it = m_EmbeddedFontDescMap.find(key);
+  if (it != m_EmbeddedFontDescMap.end()) {
+    pFontDesc = pdfium::WrapRetain(it->second.Get());
+    RetainPtr<CFX_Face> face(pFontDesc->GetFace(face_index));
+    if (face) {
+      // The previous user may have left another charmap selected.
+      face->SelectInitialCharMap();
+      return face;
+    }
+  } else {
+    FixedUninitDataVector<uint8_t> data_copy(data.size());
+    fxcrt::spancpy(data_copy.writable_span(), data);
+    pFontDesc = pdfium::MakeRetain<FontDesc>(std::move(data_copy), this, key);
+    m_EmbeddedFontDescMap[key].Reset(pFontDesc.Get());
+  }
+
+  RetainPtr<CFX_Face> face =
+      NewFixedFace(pFontDesc, pFontDesc->FontData(), face_index);
+  if (face)
+    pFontDesc->SetFace(face_index, face.Get());
+  return face;
+}
+
+void CFX_FontMgr::RemoveEmbeddedFontDesc(const ByteString& key) {
+  std::lock_guard<std::recursive_mutex> lock(CFX_GEModule::GetFontLock());
+  m_EmbeddedFontDescMap.erase(key);
+}
+
 // static
 pdfium::span<const uint8_t> CFX_FontMgr::GetStandardFont(size_t index) {
   CHECK_LT(index, std::size(kFoxitFonts));
@@ -18,6 +18,7 @@
 #include "core/fxcrt/fixed_uninit_data_vector.h"
 #include "core/fxcrt/observed_ptr.h"
 #include "core/fxcrt/retain_ptr.h"
+#include "core/fxcrt/unowned_ptr.h"
 #include "core/fxge/cfx_face.h"
 #include "core/fxge/freetype/fx_freetype.h"
 #include "third_party/base/containers/span.h"
@@ -36,10 +37,17 @@ class CFX_FontMgr {
 
    private:
     explicit FontDesc(FixedUninitDataVector<uint8_t> data);
+    // For the embedded font registry, which the FontDesc removes itself from
+    // when destroyed.
+    FontDesc(FixedUninitDataVector<uint8_t> data,
+             CFX_FontMgr* pEmbeddedFontMgr,
+             const ByteString& embedded_key);
     ~FontDesc() override;
 
     const FixedUninitDataVector<uint8_t> m_pFontData;
     ObservedPtr<CFX_Face> m_TTCFaces[16];
+    UnownedPtr<CFX_FontMgr> const m_pEmbeddedFontMgr;
+    const ByteString m_EmbeddedKey;
   };
 
   // `index` must be less than `CFX_FontMapper::kNumStandardFonts`.
@@ -67,6 +75,21 @@ class CFX_FontMgr {
                                    pdfium::span<const uint8_t> span,
                                    size_t face_index);
 
+  // Returns face `face_index` of the embedded font program in `data`, shared
+  // with all other callers passing byte-identical data and the same
+  // `face_index`, also from other documents. The face holds its own copy of
+  // `data`, and goes away with its last user. Faces get handed out with their
+  // initial charmap selected. Callers that select other charmaps must hold the
+  // font lock until they are done looking up glyphs with them, and select
+  // their charmap again for later lookups. Takes the font lock, see
+  // CFX_GEModule::GetFontLock().
+  RetainPtr<CFX_Face> GetSharedEmbeddedFace(pdfium::span<const uint8_t> data,
+                                            size_t face_index);
+
+  size_t GetEmbeddedFontDescCountForTesting() const {
+    return m_EmbeddedFontDescMap.size();
+  }
+
   // Always present.
   CFX_FontMapper* GetBuiltinMapper() const { return m_pBuiltinMapper.get(); }
 
@@ -76,12 +99,15 @@ class CFX_FontMgr {
  private:
   bool FreeTypeVersionSupportsHinting() const;
   bool SetLcdFilterMode() const;
+  void RemoveEmbeddedFontDesc(const ByteString& key);
 
   // Must come before |m_pBuiltinMapper| and |m_FaceMap|.
   ScopedFXFTLibraryRec const m_FTLibrary;
   std::unique_ptr<CFX_FontMapper> m_pBuiltinMapper;
   std::map<std::tuple<ByteString, int, bool>, ObservedPtr<FontDesc>> m_FaceMap;
   std::map<std::tuple<size_t, uint32_t>, ObservedPtr<FontDesc>> m_TTCFaceMap;
+  // Keyed by the SHA-256 digest of the font data. Guarded by the font lock.
+  std::map<ByteString, ObservedPtr<FontDesc>> m_EmbeddedFontDescMap;
   const bool m_FTLibrarySupportsHinting;
 };
 
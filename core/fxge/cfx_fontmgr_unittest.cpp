@@ -0,0 +1,99 @@
+// Copyright 2024 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/cfx_fontmgr.h"
+
+#include <vector>
+
+#include "core/fxcrt/observed_ptr.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "core/fxge/cfx_face.h"
+#include "core/fxge/cfx_font.h"
+#include "core/fxge/cfx_gemodule.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+TEST(CFXFontMgr, GetSharedEmbeddedFace) {
+  CFX_FontMgr* font_mgr = CFX_GEModule::Get()->GetFontMgr();
+  const size_t desc_count = font_mgr->GetEmbeddedFontDescCountForTesting();
+  pdfium::span<const uint8_t> font_data = CFX_FontMgr::GetStandardFont(0);
+  // A separate copy, like another document embedding the same font program.
+  std::vector<uint8_t> font_data_copy(font_data.begin(), font_data.end());
+
+  RetainPtr<CFX_Face> face = font_mgr->GetSharedEmbeddedFace(font_data, 0);
+  ASSERT_TRUE(face);
+  EXPECT_EQ(font_data.size(), face->GetData().size());
+  EXPECT_NE(font_data.data(), face->GetData().data());
+
+  RetainPtr<CFX_Face> same_face =
+      font_mgr->GetSharedEmbeddedFace(font_data_copy, 0);
+  EXPECT_EQ(face, same_face);
+
+  // The font program has a single face.
+  EXPECT_FALSE(font_mgr->GetSharedEmbeddedFace(font_data, 1));
+
+  RetainPtr<CFX_Face> other_face =
+      font_mgr->GetSharedEmbeddedFace(CFX_FontMgr::GetStandardFont(1), 0);
+  ASSERT_TRUE(other_face);
+  EXPECT_NE(face, other_face);
+  EXPECT_EQ(desc_count + 2, font_mgr->GetEmbeddedFontDescCountForTesting());
+
+  // The face and its data go away with the last user, and so does the entry
+  // for the data.
+  ObservedPtr<CFX_Face> observed_face(face.Get());
+  face.Reset();
+  EXPECT_TRUE(observed_face);
+  same_face.Reset();
+  EXPECT_FALSE(observed_face);
+  EXPECT_EQ(desc_count + 1, font_mgr->GetEmbeddedFontDescCountForTesting());
+  other_face.Reset();
+  EXPECT_EQ(desc_count, font_mgr->GetEmbeddedFontDescCountForTesting());
+
+  face = font_mgr->GetSharedEmbeddedFace(font_data, 0);
+  EXPECT_TRUE(face);
+}
+
+TEST(CFXFontMgr, SharedEmbeddedFaceHasInitialCharMap) {
+  CFX_FontMgr* font_mgr = CFX_GEModule::Get()->GetFontMgr();
+  pdfium::span<const uint8_t> font_data = CFX_FontMgr::GetGenericSansFont();
+  RetainPtr<CFX_Face> face = font_mgr->GetSharedEmbeddedFace(font_data, 0);
+  ASSERT_TRUE(face);
+  ASSERT_GE(face->GetCharMapCount(), 2u);
+  const CFX_Face::CharMap initial_charmap = face->GetCurrentCharMap();
+  ASSERT_TRUE(initial_charmap);
+
+  // Another user gets the charmap that the previous one changed back.
+  face->SetCharMapByIndex(face->GetCharMapCount() - 1);
+  ASSERT_NE(initial_charmap, face->GetCurrentCharMap());
+  RetainPtr<CFX_Face> same_face = font_mgr->GetSharedEmbeddedFace(font_data, 0);
+  EXPECT_EQ(face, same_face);
+  EXPECT_EQ(initial_charmap, same_face->GetCurrentCharMap());
+}
+
+TEST(CFXFontMgr, EmbeddedFontsShareFaces) {
+  pdfium::span<const uint8_t> font_data = CFX_FontMgr::GetStandardFont(0);
+  std::vector<uint8_t> font_data_copy(font_data.begin(), font_data.end());
+
+  CFX_Font font;
+  ASSERT_TRUE(font.LoadEmbedded(font_data, /*force_vertical=*/false,
+                                /*object_tag=*/0));
+  CFX_Font other_font;
+  ASSERT_TRUE(other_font.LoadEmbedded(font_data_copy,
+                                      /*force_vertical=*/false,
+                                      /*object_tag=*/0));
+  EXPECT_EQ(font.GetFace(), other_font.GetFace());
+  EXPECT_EQ(font.GetFontSpan().data(), other_font.GetFontSpan().data());
+}
+
+TEST(CFXFontMgr, EmbeddedFontInvalidData) {
+  CFX_FontMgr* font_mgr = CFX_GEModule::Get()->GetFontMgr();
+  const size_t desc_count = font_mgr->GetEmbeddedFontDescCountForTesting();
+  const uint8_t kBadData[] = {1, 2, 3, 4};
+  CFX_Font font;
+  EXPECT_FALSE(font.LoadEmbedded(kBadData, /*force_vertical=*/false,
+                                 /*object_tag=*/0));
+  CFX_Font other_font;
+  EXPECT_FALSE(other_font.LoadEmbedded(kBadData, /*force_vertical=*/false,
+                                       /*object_tag=*/0));
+  EXPECT_EQ(desc_count, font_mgr->GetEmbeddedFontDescCountForTesting());
+}
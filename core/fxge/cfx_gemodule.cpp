@@ -46,3 +46,9 @@ CFX_GEModule* CFX_GEModule::Get() {
   DCHECK(g_pGEModule);
   return g_pGEModule;
 }
+
+// static
+std::recursive_mutex& CFX_GEModule::GetFontLock() {
+  static std::recursive_mutex* lock = new std::recursive_mutex();
+  return *lock;
+}
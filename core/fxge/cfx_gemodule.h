@@ -10,6 +10,7 @@
 #include <stdint.h>
 
 #include <memory>
+#include <mutex>
 
 #include "build/build_config.h"
 #include "core/fxcrt/unowned_ptr_exclusion.h"
@@ -41,6 +42,10 @@ class CFX_GEModule {
   static void Destroy();
   static CFX_GEModule* Get();
 
+  // Guards the font manager, the font caches, and the fonts and glyphs in
+  // them, when documents are used from multiple threads. Never destroyed.
+  static std::recursive_mutex& GetFontLock();
+
   CFX_FontCache* GetFontCache() const { return m_pFontCache.get(); }
   CFX_FontMgr* GetFontMgr() const { return m_pFontMgr.get(); }
   PlatformIface* GetPlatform() const { return m_pPlatform.get(); }
@@ -11,19 +11,22 @@
 
 class CFX_DIBitmap;
 
-class CFX_GlyphBitmap {
+// Retainable, so that glyphs stay valid while being drawn even if a cache
+// evicts them meanwhile. The process-wide CFX_GlyphBitmapCache hands the same
+// glyphs to all threads, so the ref count is atomic, and glyphs must not
+// change once cached.
+class CFX_GlyphBitmap final : public RetainableThreadSafe {
  public:
-  CFX_GlyphBitmap(int left, int top);
-  ~CFX_GlyphBitmap();
-
-  CFX_GlyphBitmap(const CFX_GlyphBitmap&) = delete;
-  CFX_GlyphBitmap& operator=(const CFX_GlyphBitmap&) = delete;
+  CONSTRUCT_VIA_MAKE_RETAIN;
 
   const RetainPtr<CFX_DIBitmap>& GetBitmap() const { return m_pBitmap; }
   int left() const { return m_Left; }
   int top() const { return m_Top; }
 
  private:
+  CFX_GlyphBitmap(int left, int top);
+  ~CFX_GlyphBitmap() override;
+
   const int m_Left;
   const int m_Top;
   RetainPtr<CFX_DIBitmap> m_pBitmap;
@@ -0,0 +1,126 @@
+// Copyright 2024 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/cfx_glyphbitmapcache.h"
+
+#include "core/fdrm/fx_crypt.h"
+#include "core/fxge/cfx_glyphbitmap.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
+#include "third_party/base/check.h"
+#include "third_party/base/numerics/safe_conversions.h"
+
+namespace {
+
+// Accounts for the entry itself and its key, besides the bitmap data.
+constexpr size_t kEntryOverhead = 128;
+
+size_t GetEntryBytes(const CFX_GlyphBitmap* bitmap) {
+  if (!bitmap)
+    return kEntryOverhead;
+  return kEntryOverhead + bitmap->GetBitmap()->GetEstimatedImageMemoryBurden();
+}
+
+}  // namespace
+
+// static
+ByteString CFX_GlyphBitmapCache::GetFontKey(
+    pdfium::span<const uint8_t> font_data,
+    int face_index) {
+  // A cryptographic digest, so that a document cannot make its glyphs show up
+  // in another one by embedding a font program that collides with theirs.
+  uint8_t digest[32];
+  CRYPT_SHA256Generate(font_data.data(),
+                       pdfium::base::checked_cast<uint32_t>(font_data.size()),
+                       digest);
+  ByteString key(digest, sizeof(digest));
+  key += ByteString(reinterpret_cast<const uint8_t*>(&face_index),
+                    sizeof(face_index));
+  return key;
+}
+
+CFX_GlyphBitmapCache::CFX_GlyphBitmapCache(size_t budget) : budget_(budget) {}
+
+CFX_GlyphBitmapCache::~CFX_GlyphBitmapCache() = default;
+
+absl::optional<RetainPtr<const CFX_GlyphBitmap>> CFX_GlyphBitmapCache::Get(
+    const ByteString& key) {
+  std::lock_guard<std::mutex> lock(lock_);
+  auto it = entries_by_key_.find(key);
+  if (it == entries_by_key_.end()) {
+    ++stats_.misses;
+    return absl::nullopt;
+  }
+
+  ++stats_.hits;
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return it->second->bitmap;
+}
+
+void CFX_GlyphBitmapCache::Add(const ByteString& key,
+                               RetainPtr<const CFX_GlyphBitmap> bitmap) {
+  std::lock_guard<std::mutex> lock(lock_);
+  auto it = entries_by_key_.find(key);
+  if (it != entries_by_key_.end()) {
+    cached_bytes_ -= it->second->bytes;
+    entries_.erase(it->second);
+    entries_by_key_.erase(it);
+  }
+
+  // ByteString ref counts are not atomic, so keep a copy of `key` that is
+  // only ever touched under the lock, not one that shares the caller's data.
+  ByteString owned_key(key.c_str(), key.GetLength());
+  const size_t bytes = GetEntryBytes(bitmap.Get());
+  cached_bytes_ += bytes;
+  entries_.push_front({owned_key, std::move(bitmap), bytes});
+  entries_by_key_[owned_key] = entries_.begin();
+  EvictOverBudget();
+}
+
+void CFX_GlyphBitmapCache::SetBudget(size_t budget) {
+  std::lock_guard<std::mutex> lock(lock_);
+  budget_ = budget;
+  EvictOverBudget();
+}
+
+void CFX_GlyphBitmapCache::Clear() {
+  std::lock_guard<std::mutex> lock(lock_);
+  entries_by_key_.clear();
+  entries_.clear();
+  cached_bytes_ = 0;
+}
+
+size_t CFX_GlyphBitmapCache::budget() const {
+  std::lock_guard<std::mutex> lock(lock_);
+  return budget_;
+}
+
+size_t CFX_GlyphBitmapCache::cached_bytes() const {
+  std::lock_guard<std::mutex> lock(lock_);
+  return cached_bytes_;
+}
+
+size_t CFX_GlyphBitmapCache::size() const {
+  std::lock_guard<std::mutex> lock(lock_);
+  return entries_.size();
+}
+
+CFX_GlyphBitmapCache::Stats CFX_GlyphBitmapCache::stats() const {
+  std::lock_guard<std::mutex> lock(lock_);
+  return stats_;
+}
+
+void CFX_GlyphBitmapCache::EvictOverBudget() {
+  if (!budget_)
+    return;
+
+  // Always keep the most recently used glyph, even if it alone exceeds the
+  // budget, as it is about to be drawn.
+  while (cached_bytes_ > budget_ && entries_.size() > 1) {
+    const Entry& entry = entries_.back();
+    cached_bytes_ -= entry.bytes;
+    entries_by_key_.erase(entry.key);
+    entries_.pop_back();
+    ++stats_.evictions;
+  }
+}
@@ -0,0 +1,88 @@
+// Copyright 2024 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXGE_CFX_GLYPHBITMAPCACHE_H_
+#define CORE_FXGE_CFX_GLYPHBITMAPCACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <utility>
+
+#include "core/fxcrt/bytestring.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+#include "third_party/base/containers/span.h"
+
+class CFX_GlyphBitmap;
+
+// Keeps rendered glyph bitmaps for the whole process. Glyphs are keyed by a
+// digest of the font program rather than by the font object, so documents
+// that embed the same font programs share them, also after the documents that
+// rendered them are closed. With a budget, only the most recently used glyphs
+// whose bitmaps fit into the budget are kept.
+//
+// The cache may be used from multiple threads. The glyph bitmaps it returns
+// have atomic ref counts and do not change, so they may be used from several
+// threads at once, also after the cache evicted them.
+class CFX_GlyphBitmapCache {
+ public:
+  struct Stats {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t evictions = 0;
+  };
+
+  static constexpr size_t kDefaultBudget = 32 * 1024 * 1024;
+
+  // Returns the part of the glyph keys that identifies face `face_index` of
+  // the font program in `font_data`.
+  static ByteString GetFontKey(pdfium::span<const uint8_t> font_data,
+                               int face_index);
+
+  // A `budget` of 0 means no limit.
+  explicit CFX_GlyphBitmapCache(size_t budget);
+  ~CFX_GlyphBitmapCache();
+
+  // Returns the glyph bitmap for `key` and makes it the most recently used
+  // one, or returns absl::nullopt if it is not cached. The glyph bitmap is
+  // nullptr for glyphs that did not render.
+  absl::optional<RetainPtr<const CFX_GlyphBitmap>> Get(const ByteString& key);
+
+  // Adds `bitmap` as the most recently used glyph bitmap, and evicts the
+  // least recently used others until the cache fits the budget again. Callers
+  // that still hold an evicted glyph bitmap can keep using it.
+  void Add(const ByteString& key, RetainPtr<const CFX_GlyphBitmap> bitmap);
+
+  void SetBudget(size_t budget);
+  void Clear();
+
+  size_t budget() const;
+  size_t cached_bytes() const;
+  size_t size() const;
+  Stats stats() const;
+
+ private:
+  struct Entry {
+    ByteString key;
+    RetainPtr<const CFX_GlyphBitmap> bitmap;
+    size_t bytes;
+  };
+
+  void EvictOverBudget();
+
+  mutable std::mutex lock_;
+  size_t budget_;
+  size_t cached_bytes_ = 0;
+  Stats stats_;
+
+  // Most recently used first.
+  std::list<Entry> entries_;
+  std::map<ByteString, std::list<Entry>::iterator> entries_by_key_;
+};
+
+#endif  // CORE_FXGE_CFX_GLYPHBITMAPCACHE_H_
@@ -0,0 +1,115 @@
+// Copyright 2024 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/cfx_glyphbitmapcache.h"
+
+#include <stdint.h>
+
+#include "core/fxcrt/parallel_for.h"
+#include "core/fxge/cfx_glyphbitmap.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
+#include "core/fxge/dib/fx_dib.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+RetainPtr<CFX_GlyphBitmap> CreateGlyphBitmap(int size) {
+  auto glyph = pdfium::MakeRetain<CFX_GlyphBitmap>(0, 0);
+  EXPECT_TRUE(glyph->GetBitmap()->Create(size, size, FXDIB_Format::k8bppMask));
+  return glyph;
+}
+
+}  // namespace
+
+TEST(CFXGlyphBitmapCache, GetFontKey) {
+  const uint8_t kFontData1[] = {1, 2, 3, 4};
+  const uint8_t kFontData2[] = {1, 2, 3, 5};
+  const ByteString key = CFX_GlyphBitmapCache::GetFontKey(kFontData1, 0);
+  EXPECT_FALSE(key.IsEmpty());
+  EXPECT_EQ(key, CFX_GlyphBitmapCache::GetFontKey(kFontData1, 0));
+  EXPECT_NE(key, CFX_GlyphBitmapCache::GetFontKey(kFontData1, 1));
+  EXPECT_NE(key, CFX_GlyphBitmapCache::GetFontKey(kFontData2, 0));
+}
+
+TEST(CFXGlyphBitmapCache, GetAndAdd) {
+  CFX_GlyphBitmapCache cache(/*budget=*/0);
+  EXPECT_FALSE(cache.Get("a").has_value());
+
+  RetainPtr<CFX_GlyphBitmap> glyph = CreateGlyphBitmap(10);
+  cache.Add("a", glyph);
+  // Glyphs that did not render are cached as well.
+  cache.Add("b", nullptr);
+  EXPECT_EQ(2u, cache.size());
+  EXPECT_GT(cache.cached_bytes(), 100u);
+
+  absl::optional<RetainPtr<const CFX_GlyphBitmap>> cached = cache.Get("a");
+  ASSERT_TRUE(cached.has_value());
+  EXPECT_EQ(glyph, cached.value());
+  cached = cache.Get("b");
+  ASSERT_TRUE(cached.has_value());
+  EXPECT_FALSE(cached.value());
+
+  CFX_GlyphBitmapCache::Stats stats = cache.stats();
+  EXPECT_EQ(2u, stats.hits);
+  EXPECT_EQ(1u, stats.misses);
+  EXPECT_EQ(0u, stats.evictions);
+
+  cache.Clear();
+  EXPECT_EQ(0u, cache.size());
+  EXPECT_EQ(0u, cache.cached_bytes());
+  EXPECT_FALSE(cache.Get("a").has_value());
+}
+
+TEST(CFXGlyphBitmapCache, Budget) {
+  RetainPtr<CFX_GlyphBitmap> glyph_a = CreateGlyphBitmap(20);
+  RetainPtr<CFX_GlyphBitmap> glyph_b = CreateGlyphBitmap(20);
+  RetainPtr<CFX_GlyphBitmap> glyph_c = CreateGlyphBitmap(20);
+
+  CFX_GlyphBitmapCache cache(/*budget=*/0);
+  cache.Add("a", glyph_a);
+  const size_t glyph_bytes = cache.cached_bytes();
+  cache.SetBudget(glyph_bytes * 2);
+  cache.Add("b", glyph_b);
+  EXPECT_EQ(2u, cache.size());
+
+  // Using "a" makes "b" the least recently used glyph, so it gets evicted.
+  EXPECT_TRUE(cache.Get("a").has_value());
+  cache.Add("c", glyph_c);
+  EXPECT_EQ(2u, cache.size());
+  EXPECT_EQ(glyph_bytes * 2, cache.cached_bytes());
+  EXPECT_TRUE(cache.Get("a").has_value());
+  EXPECT_FALSE(cache.Get("b").has_value());
+  EXPECT_TRUE(cache.Get("c").has_value());
+  EXPECT_EQ(1u, cache.stats().evictions);
+
+  // Evicted glyphs stay valid for those who hold them.
+  EXPECT_TRUE(glyph_b->HasOneRef());
+  EXPECT_EQ(20, glyph_b->GetBitmap()->GetWidth());
+
+  // The most recently used glyph is kept even if it alone exceeds the budget.
+  cache.SetBudget(1);
+  EXPECT_EQ(1u, cache.size());
+  EXPECT_TRUE(cache.Get("c").has_value());
+}
+
+TEST(CFXGlyphBitmapCache, ConcurrentUse) {
+  CFX_GlyphBitmapCache cache(/*budget=*/0);
+  cache.Add("0", CreateGlyphBitmap(8));
+  cache.SetBudget(cache.cached_bytes() * 4);
+
+  // Threads keep using the glyphs they got while others evict them.
+  ParallelFor(4, 4, [&cache](size_t thread) {
+    for (int i = 0; i < 1000; ++i) {
+      const ByteString key = ByteString::FormatInteger((i + thread) % 16);
+      absl::optional<RetainPtr<const CFX_GlyphBitmap>> glyph = cache.Get(key);
+      if (!glyph.has_value()) {
+        cache.Add(key, CreateGlyphBitmap(8));
+        continue;
+      }
+      RetainPtr<const CFX_GlyphBitmap> copy = glyph.value();
+      EXPECT_EQ(8, copy->GetBitmap()->GetWidth());
+    }
+  });
+  EXPECT_EQ(4u, cache.size());
+}
@@ -16,7 +16,10 @@
 #include "core/fxcrt/fx_memcpy_wrappers.h"
 #include "core/fxge/cfx_defaultrenderdevice.h"
 #include "core/fxge/cfx_font.h"
+#include "core/fxge/cfx_fontcache.h"
+#include "core/fxge/cfx_gemodule.h"
 #include "core/fxge/cfx_glyphbitmap.h"
+#include "core/fxge/cfx_glyphbitmapcache.h"
 #include "core/fxge/cfx_path.h"
 #include "core/fxge/cfx_substfont.h"
 
@@ -106,7 +109,7 @@ CFX_GlyphCache::CFX_GlyphCache(RetainPtr<CFX_Face> face)
 
 CFX_GlyphCache::~CFX_GlyphCache() = default;
 
-std::unique_ptr<CFX_GlyphBitmap> CFX_GlyphCache::RenderGlyph(
+RetainPtr<CFX_GlyphBitmap> CFX_GlyphCache::RenderGlyph(
     const CFX_Font* pFont,
     uint32_t glyph_index,
     bool bFontStyle,
@@ -141,7 +144,7 @@ const CFX_Path* CFX_GlyphCache::LoadGlyphPath(const CFX_Font* pFont,
   return m_PathMap[key].get();
 }
 
-const CFX_GlyphBitmap* CFX_GlyphCache::LoadGlyphBitmap(
+RetainPtr<const CFX_GlyphBitmap> CFX_GlyphCache::LoadGlyphBitmap(
     const CFX_Font* pFont,
     uint32_t glyph_index,
     bool bFontStyle,
@@ -175,32 +178,29 @@ const CFX_GlyphBitmap* CFX_GlyphCache::LoadGlyphBitmap(
 #if BUILDFLAG(IS_APPLE)
   DCHECK(!CFX_DefaultRenderDevice::UseSkiaRenderer());
 
-  std::unique_ptr<CFX_GlyphBitmap> pGlyphBitmap;
+  RetainPtr<CFX_GlyphBitmap> pGlyphBitmap;
   auto it = m_SizeMap.find(FaceGlyphsKey);
   if (it != m_SizeMap.end()) {
     SizeGlyphCache* pSizeCache = &(it->second);
     auto it2 = pSizeCache->find(glyph_index);
     if (it2 != pSizeCache->end())
-      return it2->second.get();
+      return it2->second;
 
     pGlyphBitmap = RenderGlyph_Nativetext(pFont, glyph_index, matrix,
                                           dest_width, anti_alias);
     if (pGlyphBitmap) {
-      CFX_GlyphBitmap* pResult = pGlyphBitmap.get();
-      (*pSizeCache)[glyph_index] = std::move(pGlyphBitmap);
-      return pResult;
+      (*pSizeCache)[glyph_index] = pGlyphBitmap;
+      return pGlyphBitmap;
     }
   } else {
     pGlyphBitmap = RenderGlyph_Nativetext(pFont, glyph_index, matrix,
                                           dest_width, anti_alias);
     if (pGlyphBitmap) {
-      CFX_GlyphBitmap* pResult = pGlyphBitmap.get();
-
       SizeGlyphCache cache;
-      cache[glyph_index] = std::move(pGlyphBitmap);
+      cache[glyph_index] = pGlyphBitmap;
 
       m_SizeMap[FaceGlyphsKey] = std::move(cache);
-      return pResult;
+      return pGlyphBitmap;
     }
   }
   GenKey(&keygen, pFont, matrix, dest_width, anti_alias, /*bNative=*/false);
@@ -272,7 +272,7 @@ CFX_TypeFace* CFX_GlyphCache::GetDeviceCache(const CFX_Font* pFont) {
 }
 #endif  // defined(PDF_USE_SKIA)
 
-CFX_GlyphBitmap* CFX_GlyphCache::LookUpGlyphBitmap(
+RetainPtr<const CFX_GlyphBitmap> CFX_GlyphCache::LookUpGlyphBitmap(
     const CFX_Font* pFont,
     const CFX_Matrix& matrix,
     const ByteString& FaceGlyphsKey,
@@ -280,6 +280,27 @@ CFX_GlyphBitmap* CFX_GlyphCache::LookUpGlyphBitmap(
     bool bFontStyle,
     int dest_width,
     int anti_alias) {
+  // Substitute fonts render differently depending on what they substitute,
+  // so only glyphs of the font programs themselves get shared.
+  const ByteString& font_key =
+      pFont->GetSubstFont() ? ByteString() : GetFontKey(pFont);
+  if (!font_key.IsEmpty()) {
+    ByteString key = font_key + FaceGlyphsKey;
+    key += ByteString(reinterpret_cast<const uint8_t*>(&glyph_index),
+                      sizeof(glyph_index));
+    CFX_GlyphBitmapCache* bitmap_cache =
+        CFX_GEModule::Get()->GetFontCache()->GetGlyphBitmapCache();
+    absl::optional<RetainPtr<const CFX_GlyphBitmap>> cached =
+        bitmap_cache->Get(key);
+    if (cached.has_value())
+      return cached.value();
+
+    RetainPtr<const CFX_GlyphBitmap> pGlyphBitmap = RenderGlyph(
+        pFont, glyph_index, bFontStyle, matrix, dest_width, anti_alias);
+    bitmap_cache->Add(key, pGlyphBitmap);
+    return pGlyphBitmap;
+  }
+
   SizeGlyphCache* pSizeCache;
   auto it = m_SizeMap.find(FaceGlyphsKey);
   if (it == m_SizeMap.end()) {
@@ -291,11 +312,22 @@ CFX_GlyphBitmap* CFX_GlyphCache::LookUpGlyphBitmap(
 
   auto it2 = pSizeCache->find(glyph_index);
   if (it2 != pSizeCache->end())
-    return it2->second.get();
+    return it2->second;
 
-  std::unique_ptr<CFX_GlyphBitmap> pGlyphBitmap = RenderGlyph(
+  RetainPtr<CFX_GlyphBitmap> pGlyphBitmap = RenderGlyph(
       pFont, glyph_index, bFontStyle, matrix, dest_width, anti_alias);
-  CFX_GlyphBitmap* pResult = pGlyphBitmap.get();
-  (*pSizeCache)[glyph_index] = std::move(pGlyphBitmap);
-  return pResult;
+  (*pSizeCache)[glyph_index] = pGlyphBitmap;
+  return pGlyphBitmap;
+}
+
+const ByteString& CFX_GlyphCache::GetFontKey(const CFX_Font* pFont) {
+  if (!m_FontKey.has_value()) {
+    pdfium::span<const uint8_t> font_data = pFont->GetFontSpan();
+    m_FontKey =
+        m_Face && !font_data.empty()
+            ? CFX_GlyphBitmapCache::GetFontKey(
+                  font_data, static_cast<int>(m_Face->GetRec()->face_index))
+            : ByteString();
+  }
+  return m_FontKey.value();
 }
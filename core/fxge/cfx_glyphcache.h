@@ -15,6 +15,7 @@
 #include "core/fxcrt/observed_ptr.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxge/cfx_face.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 #if defined(PDF_USE_SKIA)
 #include "core/fxge/fx_font.h"
@@ -31,13 +32,17 @@ class CFX_GlyphCache final : public Retainable, public Observable {
  public:
   CONSTRUCT_VIA_MAKE_RETAIN;
 
-  const CFX_GlyphBitmap* LoadGlyphBitmap(const CFX_Font* pFont,
-                                         uint32_t glyph_index,
-                                         bool bFontStyle,
-                                         const CFX_Matrix& matrix,
-                                         int dest_width,
-                                         int anti_alias,
-                                         CFX_TextRenderOptions* text_options);
+  // Glyph bitmaps of fonts with font data, other than substitute fonts, are
+  // kept in the process-wide CFX_GlyphBitmapCache, and shared with all fonts
+  // with the same data.
+  RetainPtr<const CFX_GlyphBitmap> LoadGlyphBitmap(
+      const CFX_Font* pFont,
+      uint32_t glyph_index,
+      bool bFontStyle,
+      const CFX_Matrix& matrix,
+      int dest_width,
+      int anti_alias,
+      CFX_TextRenderOptions* text_options);
   const CFX_Path* LoadGlyphPath(const CFX_Font* pFont,
                                 uint32_t glyph_index,
                                 int dest_width);
@@ -59,32 +64,37 @@ class CFX_GlyphCache final : public Retainable, public Observable {
   explicit CFX_GlyphCache(RetainPtr<CFX_Face> face);
   ~CFX_GlyphCache() override;
 
-  using SizeGlyphCache = std::map<uint32_t, std::unique_ptr<CFX_GlyphBitmap>>;
+  using SizeGlyphCache = std::map<uint32_t, RetainPtr<CFX_GlyphBitmap>>;
   // <glyph_index, width, weight, angle, vertical>
   using PathMapKey = std::tuple<uint32_t, int, int, int, bool>;
   // <glyph_index, dest_width, weight>
   using WidthMapKey = std::tuple<uint32_t, int, int>;
 
-  std::unique_ptr<CFX_GlyphBitmap> RenderGlyph(const CFX_Font* pFont,
-                                               uint32_t glyph_index,
-                                               bool bFontStyle,
-                                               const CFX_Matrix& matrix,
-                                               int dest_width,
-                                               int anti_alias);
-  std::unique_ptr<CFX_GlyphBitmap> RenderGlyph_Nativetext(
+  RetainPtr<CFX_GlyphBitmap> RenderGlyph(const CFX_Font* pFont,
+                                         uint32_t glyph_index,
+                                         bool bFontStyle,
+                                         const CFX_Matrix& matrix,
+                                         int dest_width,
+                                         int anti_alias);
+  RetainPtr<CFX_GlyphBitmap> RenderGlyph_Nativetext(const CFX_Font* pFont,
+                                                    uint32_t glyph_index,
+                                                    const CFX_Matrix& matrix,
+                                                    int dest_width,
+                                                    int anti_alias);
+  RetainPtr<const CFX_GlyphBitmap> LookUpGlyphBitmap(
       const CFX_Font* pFont,
-      uint32_t glyph_index,
       const CFX_Matrix& matrix,
+      const ByteString& FaceGlyphsKey,
+      uint32_t glyph_index,
+      bool bFontStyle,
       int dest_width,
       int anti_alias);
-  CFX_GlyphBitmap* LookUpGlyphBitmap(const CFX_Font* pFont,
-                                     const CFX_Matrix& matrix,
-                                     const ByteString& FaceGlyphsKey,
-                                     uint32_t glyph_index,
-                                     bool bFontStyle,
-                                     int dest_width,
-                                     int anti_alias);
+  // Returns the CFX_GlyphBitmapCache font key for the data of `pFont`, or an
+  // empty string if the font has no data to share glyphs by.
+  const ByteString& GetFontKey(const CFX_Font* pFont);
+
   RetainPtr<CFX_Face> const m_Face;
+  absl::optional<ByteString> m_FontKey;
   std::map<ByteString, SizeGlyphCache> m_SizeMap;
   std::map<PathMapKey, std::unique_ptr<CFX_Path>> m_PathMap;
   std::map<WidthMapKey, int> m_WidthMap;
@@ -6,8 +6,11 @@
 
 #include "core/fxge/cfx_unicodeencoding.h"
 
+#include <mutex>
+
 #include "core/fxcrt/fx_codepage.h"
 #include "core/fxge/cfx_font.h"
+#include "core/fxge/cfx_gemodule.h"
 #include "core/fxge/cfx_substfont.h"
 #include "core/fxge/fx_font.h"
 #include "core/fxge/fx_fontencoding.h"
@@ -22,6 +25,8 @@ uint32_t CFX_UnicodeEncoding::GlyphFromCharCode(uint32_t charcode) {
   if (!face)
     return charcode;
 
+  // The face may be shared with other fonts, which select other charmaps.
+  std::lock_guard<std::recursive_mutex> lock(CFX_GEModule::GetFontLock());
   if (face->SelectCharMap(fxge::FontEncoding::kUnicode)) {
     return face->GetCharIndex(charcode);
   }
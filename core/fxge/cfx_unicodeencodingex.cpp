@@ -7,8 +7,10 @@
 #include "core/fxge/cfx_unicodeencodingex.h"
 
 #include <memory>
+#include <mutex>
 
 #include "core/fxge/cfx_font.h"
+#include "core/fxge/cfx_gemodule.h"
 #include "core/fxge/freetype/fx_freetype.h"
 #include "core/fxge/fx_font.h"
 #include "core/fxge/fx_fontencoding.h"
@@ -44,6 +46,9 @@ CFX_UnicodeEncodingEx::~CFX_UnicodeEncodingEx() = default;
 
 uint32_t CFX_UnicodeEncodingEx::GlyphFromCharCode(uint32_t charcode) {
   RetainPtr<CFX_Face> face = m_pFont->GetFace();
+  // The face may be shared with other fonts, which select other charmaps.
+  std::lock_guard<std::recursive_mutex> lock(CFX_GEModule::GetFontLock());
+  face->SelectCharMap(encoding_id_);
   FT_UInt nIndex = face->GetCharIndex(charcode);
   if (nIndex > 0)
     return nIndex;
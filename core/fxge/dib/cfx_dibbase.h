@@ -29,8 +29,9 @@ struct FX_RECT;
 class SkImage;
 #endif  // defined(PDF_USE_SKIA)
 
-// Base class for all Device-Independent Bitmaps.
-class CFX_DIBBase : public Retainable {
+// Base class for all Device-Independent Bitmaps. The ref count is atomic, as
+// cached glyph and image bitmaps get drawn from several threads at once.
+class CFX_DIBBase : public RetainableThreadSafe {
  public:
 #if BUILDFLAG(IS_APPLE)
   // Matches Apple's kCGBitmapByteOrder32Little in fx_quartz_device.cpp.
@@ -0,0 +1,167 @@
+// Copyright 2024 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/dib/cfx_scanlinecompositor.h"
+
+#include <stdint.h>
+
+#include <iterator>
+#include <vector>
+
+#include "core/fxge/dib/fx_dib.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// These tests check the common cases that have SIMD versions against a plain
+// per-pixel implementation. Widths that are not multiples of the vector size
+// cover the leftover pixels.
+
+namespace {
+
+constexpr int kMaxWidth = 19;
+
+// Destination alphas that make some groups of 4 pixels all opaque, and others
+// mixed.
+constexpr uint8_t kDestAlphas[] = {255, 255, 255, 255, 0,   255, 128, 255,
+                                   255, 255, 255, 255, 255, 1,   255, 255};
+
+uint8_t GetTestByte(int index, int salt) {
+  return static_cast<uint8_t>(index * 97 + salt * 31 + (index >> 3) * 7);
+}
+
+std::vector<uint8_t> MakeArgbLine(int width, int salt) {
+  std::vector<uint8_t> line(width * 4);
+  for (size_t i = 0; i < line.size(); ++i)
+    line[i] = GetTestByte(i, salt);
+  return line;
+}
+
+std::vector<uint8_t> MakeDestLine(int width, int salt) {
+  std::vector<uint8_t> line = MakeArgbLine(width, salt);
+  for (int i = 0; i < width; ++i)
+    line[i * 4 + 3] = kDestAlphas[i % std::size(kDestAlphas)];
+  return line;
+}
+
+std::vector<uint8_t> MakeByteLine(int width, int salt) {
+  std::vector<uint8_t> line(width);
+  for (int i = 0; i < width; ++i)
+    line[i] = GetTestByte(i, salt);
+  // Also cover fully transparent and fully opaque pixels.
+  for (int i = 0; i < width; i += 5)
+    line[i] = i % 2 ? 255 : 0;
+  return line;
+}
+
+uint8_t Merge(int back, int src, int alpha) {
+  return (back * (255 - alpha) + src * alpha) / 255;
+}
+
+// Composites a pixel with BGR `src` and `src_alpha` over ARGB `dest`.
+void CompositeArgbPixel(uint8_t* dest, const uint8_t* src, int src_alpha) {
+  int back_alpha = dest[3];
+  if (back_alpha == 0) {
+    dest[0] = src[0];
+    dest[1] = src[1];
+    dest[2] = src[2];
+    dest[3] = src_alpha;
+    return;
+  }
+  if (src_alpha == 0)
+    return;
+
+  uint8_t dest_alpha = back_alpha + src_alpha - back_alpha * src_alpha / 255;
+  int alpha_ratio = src_alpha * 255 / dest_alpha;
+  for (int i = 0; i < 3; ++i)
+    dest[i] = Merge(dest[i], src[i], alpha_ratio);
+  dest[3] = dest_alpha;
+}
+
+void CompositeRgbPixel(uint8_t* dest, const uint8_t* src, int src_alpha) {
+  for (int i = 0; i < 3; ++i)
+    dest[i] = Merge(dest[i], src[i], src_alpha);
+}
+
+}  // namespace
+
+TEST(CFXScanlineCompositor, ArgbToArgb) {
+  for (bool use_clip : {false, true}) {
+    CFX_ScanlineCompositor compositor;
+    ASSERT_TRUE(compositor.Init(FXDIB_Format::kArgb, FXDIB_Format::kArgb, {},
+                                0, BlendMode::kNormal, use_clip, false));
+    for (int width = 0; width <= kMaxWidth; ++width) {
+      std::vector<uint8_t> src = MakeArgbLine(width, 1);
+      std::vector<uint8_t> dest = MakeDestLine(width, 2);
+      std::vector<uint8_t> clip =
+          use_clip ? MakeByteLine(width, 3) : std::vector<uint8_t>();
+      std::vector<uint8_t> expected = dest;
+      for (int i = 0; i < width; ++i) {
+        int src_alpha = src[i * 4 + 3];
+        if (use_clip)
+          src_alpha = clip[i] * src_alpha / 255;
+        CompositeArgbPixel(&expected[i * 4], &src[i * 4], src_alpha);
+      }
+      compositor.CompositeRgbBitmapLine(dest, src, width, clip);
+      EXPECT_EQ(expected, dest) << "width " << width << ", clip " << use_clip;
+    }
+  }
+}
+
+TEST(CFXScanlineCompositor, ArgbToRgb32) {
+  for (bool use_clip : {false, true}) {
+    CFX_ScanlineCompositor compositor;
+    ASSERT_TRUE(compositor.Init(FXDIB_Format::kRgb32, FXDIB_Format::kArgb, {},
+                                0, BlendMode::kNormal, use_clip, false));
+    for (int width = 0; width <= kMaxWidth; ++width) {
+      std::vector<uint8_t> src = MakeArgbLine(width, 4);
+      std::vector<uint8_t> dest = MakeDestLine(width, 5);
+      std::vector<uint8_t> clip =
+          use_clip ? MakeByteLine(width, 6) : std::vector<uint8_t>();
+      std::vector<uint8_t> expected = dest;
+      for (int i = 0; i < width; ++i) {
+        int src_alpha = src[i * 4 + 3];
+        if (use_clip)
+          src_alpha = clip[i] * src_alpha / 255;
+        CompositeRgbPixel(&expected[i * 4], &src[i * 4], src_alpha);
+      }
+      compositor.CompositeRgbBitmapLine(dest, src, width, clip);
+      EXPECT_EQ(expected, dest) << "width " << width << ", clip " << use_clip;
+    }
+  }
+}
+
+TEST(CFXScanlineCompositor, ByteMaskToArgbAndRgb32) {
+  constexpr uint8_t kColor[] = {0x12, 0xab, 0xf0};  // BGR.
+  for (FXDIB_Format dest_format : {FXDIB_Format::kArgb, FXDIB_Format::kRgb32}) {
+    for (int mask_alpha : {255, 200}) {
+      for (bool use_clip : {false, true}) {
+        CFX_ScanlineCompositor compositor;
+        ASSERT_TRUE(compositor.Init(
+            dest_format, FXDIB_Format::k8bppMask, {},
+            ArgbEncode(mask_alpha, kColor[2], kColor[1], kColor[0]),
+            BlendMode::kNormal, use_clip, false));
+        for (int width = 0; width <= kMaxWidth; ++width) {
+          std::vector<uint8_t> src = MakeByteLine(width, 7);
+          std::vector<uint8_t> dest = MakeDestLine(width, 8);
+          std::vector<uint8_t> clip =
+              use_clip ? MakeByteLine(width, 9) : std::vector<uint8_t>();
+          std::vector<uint8_t> expected = dest;
+          for (int i = 0; i < width; ++i) {
+            int src_alpha = mask_alpha * src[i];
+            if (use_clip)
+              src_alpha = src_alpha * clip[i] / 255;
+            src_alpha /= 255;
+            if (dest_format == FXDIB_Format::kArgb)
+              CompositeArgbPixel(&expected[i * 4], kColor, src_alpha);
+            else
+              CompositeRgbPixel(&expected[i * 4], kColor, src_alpha);
+          }
+          compositor.CompositeByteMaskLine(dest, src, width, clip);
+          EXPECT_EQ(expected, dest)
+              << "width " << width << ", mask alpha " << mask_alpha
+              << ", clip " << use_clip;
+        }
+      }
+    }
+  }
+}
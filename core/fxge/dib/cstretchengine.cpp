@@ -22,10 +22,54 @@
 #include "core/fxge/dib/scanlinecomposer_iface.h"
 #include "third_party/base/check.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 static_assert(
     std::is_trivially_destructible<CStretchEngine::PixelWeight>::value,
     "PixelWeight storage may be re-used without invoking its destructor");
 
+namespace {
+
+// Adds `weight` times every byte of `src` to the corresponding entry of
+// `sums`.
+void AccumulateWeightedRow(pdfium::span<uint32_t> sums,
+                           pdfium::span<const uint8_t> src,
+                           uint32_t weight) {
+  DCHECK_GE(sums.size(), src.size());
+  size_t i = 0;
+#if defined(__SSE2__)
+  // Multiplies 8 bytes at a time as 16-bit lanes. The low and high halves of
+  // the 32-bit products come from separate multiplications, so `weight` must
+  // fit in 16 bits.
+  if (weight <= 0xffff) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i weights = _mm_set1_epi16(static_cast<int16_t>(weight));
+    for (; i + 8 <= src.size(); i += 8) {
+      __m128i values = _mm_unpacklo_epi8(
+          _mm_loadl_epi64(
+              reinterpret_cast<const __m128i*>(src.subspan(i).data())),
+          zero);
+      __m128i products_lo = _mm_mullo_epi16(values, weights);
+      __m128i products_hi = _mm_mulhi_epu16(values, weights);
+      __m128i* sum = reinterpret_cast<__m128i*>(sums.subspan(i).data());
+      _mm_storeu_si128(
+          sum, _mm_add_epi32(_mm_loadu_si128(sum),
+                             _mm_unpacklo_epi16(products_lo, products_hi)));
+      _mm_storeu_si128(
+          sum + 1,
+          _mm_add_epi32(_mm_loadu_si128(sum + 1),
+                        _mm_unpackhi_epi16(products_lo, products_hi)));
+    }
+  }
+#endif
+  for (; i < src.size(); ++i)
+    sums[i] += weight * src[i];
+}
+
+}  // namespace
+
 // static
 bool CStretchEngine::UseInterpolateBilinear(
     const FXDIB_ResampleOptions& options,
@@ -321,12 +365,13 @@ bool CStretchEngine::ContinueStretchHorz(PauseIndicatorIface* pPause) {
       case TransformMethod::k1BppTo8Bpp:
       case TransformMethod::k1BppToManyBpp: {
         for (int col = m_DestClip.left; col < m_DestClip.right; ++col) {
-          PixelWeight* pWeights = m_WeightTable.GetPixelWeight(col);
+          const PixelWeight* pWeights = m_WeightTable.GetPixelWeight(col);
           uint32_t dest_a = 0;
-          for (int j = pWeights->m_SrcStart; j <= pWeights->m_SrcEnd; ++j) {
-            uint32_t pixel_weight = pWeights->GetWeightForPosition(j);
+          int j = pWeights->m_SrcStart;
+          for (uint32_t pixel_weight : pWeights->GetWeights()) {
             if (src_scan[j / 8] & (1 << (7 - j % 8)))
               dest_a += pixel_weight * 255;
+            ++j;
           }
           dest_span[dest_span_index++] = PixelFromFixed(dest_a);
         }
@@ -334,25 +379,24 @@ bool CStretchEngine::ContinueStretchHorz(PauseIndicatorIface* pPause) {
       }
       case TransformMethod::k8BppTo8Bpp: {
         for (int col = m_DestClip.left; col < m_DestClip.right; ++col) {
-          PixelWeight* pWeights = m_WeightTable.GetPixelWeight(col);
+          const PixelWeight* pWeights = m_WeightTable.GetPixelWeight(col);
+          const uint8_t* src_pixel = src_scan + pWeights->m_SrcStart;
           uint32_t dest_a = 0;
-          for (int j = pWeights->m_SrcStart; j <= pWeights->m_SrcEnd; ++j) {
-            uint32_t pixel_weight = pWeights->GetWeightForPosition(j);
-            dest_a += pixel_weight * src_scan[j];
-          }
+          for (uint32_t pixel_weight : pWeights->GetWeights())
+            dest_a += pixel_weight * (*src_pixel++);
           dest_span[dest_span_index++] = PixelFromFixed(dest_a);
         }
         break;
       }
       case TransformMethod::k8BppToManyBpp: {
         for (int col = m_DestClip.left; col < m_DestClip.right; ++col) {
-          PixelWeight* pWeights = m_WeightTable.GetPixelWeight(col);
+          const PixelWeight* pWeights = m_WeightTable.GetPixelWeight(col);
+          const uint8_t* src_pixel = src_scan + pWeights->m_SrcStart;
           uint32_t dest_r = 0;
           uint32_t dest_g = 0;
           uint32_t dest_b = 0;
-          for (int j = pWeights->m_SrcStart; j <= pWeights->m_SrcEnd; ++j) {
-            uint32_t pixel_weight = pWeights->GetWeightForPosition(j);
-            unsigned long argb = m_pSrcPalette[src_scan[j]];
+          for (uint32_t pixel_weight : pWeights->GetWeights()) {
+            unsigned long argb = m_pSrcPalette[*src_pixel++];
             if (m_DestFormat == FXDIB_Format::kRgb) {
               dest_r += pixel_weight * static_cast<uint8_t>(argb >> 16);
               dest_g += pixel_weight * static_cast<uint8_t>(argb >> 8);
@@ -371,16 +415,16 @@ bool CStretchEngine::ContinueStretchHorz(PauseIndicatorIface* pPause) {
       }
       case TransformMethod::kManyBpptoManyBpp: {
         for (int col = m_DestClip.left; col < m_DestClip.right; ++col) {
-          PixelWeight* pWeights = m_WeightTable.GetPixelWeight(col);
+          const PixelWeight* pWeights = m_WeightTable.GetPixelWeight(col);
+          const uint8_t* src_pixel = src_scan + pWeights->m_SrcStart * Bpp;
           uint32_t dest_r = 0;
           uint32_t dest_g = 0;
           uint32_t dest_b = 0;
-          for (int j = pWeights->m_SrcStart; j <= pWeights->m_SrcEnd; ++j) {
-            uint32_t pixel_weight = pWeights->GetWeightForPosition(j);
-            const uint8_t* src_pixel = src_scan + j * Bpp;
-            dest_b += pixel_weight * (*src_pixel++);
-            dest_g += pixel_weight * (*src_pixel++);
-            dest_r += pixel_weight * (*src_pixel);
+          for (uint32_t pixel_weight : pWeights->GetWeights()) {
+            dest_b += pixel_weight * src_pixel[0];
+            dest_g += pixel_weight * src_pixel[1];
+            dest_r += pixel_weight * src_pixel[2];
+            src_pixel += Bpp;
           }
           dest_span[dest_span_index++] = PixelFromFixed(dest_b);
           dest_span[dest_span_index++] = PixelFromFixed(dest_g);
@@ -392,19 +436,19 @@ bool CStretchEngine::ContinueStretchHorz(PauseIndicatorIface* pPause) {
       case TransformMethod::kManyBpptoManyBppWithAlpha: {
         DCHECK(m_bHasAlpha);
         for (int col = m_DestClip.left; col < m_DestClip.right; ++col) {
-          PixelWeight* pWeights = m_WeightTable.GetPixelWeight(col);
+          const PixelWeight* pWeights = m_WeightTable.GetPixelWeight(col);
+          const uint8_t* src_pixel = src_scan + pWeights->m_SrcStart * Bpp;
           uint32_t dest_a = 0;
           uint32_t dest_r = 0;
           uint32_t dest_g = 0;
           uint32_t dest_b = 0;
-          for (int j = pWeights->m_SrcStart; j <= pWeights->m_SrcEnd; ++j) {
-            const uint8_t* src_pixel = src_scan + j * Bpp;
-            uint32_t pixel_weight =
-                pWeights->GetWeightForPosition(j) * src_pixel[3] / 255;
-            dest_b += pixel_weight * (*src_pixel++);
-            dest_g += pixel_weight * (*src_pixel++);
-            dest_r += pixel_weight * (*src_pixel);
+          for (uint32_t weight : pWeights->GetWeights()) {
+            uint32_t pixel_weight = weight * src_pixel[3] / 255;
+            dest_b += pixel_weight * src_pixel[0];
+            dest_g += pixel_weight * src_pixel[1];
+            dest_r += pixel_weight * src_pixel[2];
             dest_a += pixel_weight;
+            src_pixel += Bpp;
           }
           dest_span[dest_span_index++] = PixelFromFixed(dest_b);
           dest_span[dest_span_index++] = PixelFromFixed(dest_g);
@@ -431,74 +475,54 @@ void CStretchEngine::StretchVert() {
     return;
   }
 
+  // Sums up the weighted intermediate rows a whole row at a time, rather than
+  // a pixel at a time, so that the intermediate buffer gets read in order.
   const int DestBpp = m_DestBpp / 8;
+  const size_t row_bytes = static_cast<size_t>(m_DestClip.Width()) * DestBpp;
+  DataVector<uint32_t> sums(row_bytes);
   for (int row = m_DestClip.top; row < m_DestClip.bottom; ++row) {
+    const PixelWeight* pWeights = table.GetPixelWeight(row);
+    std::fill(sums.begin(), sums.end(), 0);
+    int src_row = pWeights->m_SrcStart - m_SrcClip.top;
+    for (uint32_t pixel_weight : pWeights->GetWeights()) {
+      if (pixel_weight) {
+        AccumulateWeightedRow(
+            sums,
+            m_InterBuf.span().subspan(src_row * m_InterPitch, row_bytes),
+            pixel_weight);
+      }
+      ++src_row;
+    }
+
     unsigned char* dest_scan = m_DestScanline.data();
-    PixelWeight* pWeights = table.GetPixelWeight(row);
     switch (m_TransMethod) {
       case TransformMethod::k1BppTo8Bpp:
       case TransformMethod::k1BppToManyBpp:
       case TransformMethod::k8BppTo8Bpp: {
-        for (int col = m_DestClip.left; col < m_DestClip.right; ++col) {
-          pdfium::span<const uint8_t> src_span =
-              m_InterBuf.span().subspan((col - m_DestClip.left) * DestBpp);
-          uint32_t dest_a = 0;
-          for (int j = pWeights->m_SrcStart; j <= pWeights->m_SrcEnd; ++j) {
-            uint32_t pixel_weight = pWeights->GetWeightForPosition(j);
-            dest_a +=
-                pixel_weight * src_span[(j - m_SrcClip.top) * m_InterPitch];
-          }
-          *dest_scan = PixelFromFixed(dest_a);
+        for (size_t i = 0; i < row_bytes; i += DestBpp) {
+          *dest_scan = PixelFromFixed(sums[i]);
           dest_scan += DestBpp;
         }
         break;
       }
       case TransformMethod::k8BppToManyBpp:
       case TransformMethod::kManyBpptoManyBpp: {
-        for (int col = m_DestClip.left; col < m_DestClip.right; ++col) {
-          pdfium::span<const uint8_t> src_span =
-              m_InterBuf.span().subspan((col - m_DestClip.left) * DestBpp);
-          uint32_t dest_r = 0;
-          uint32_t dest_g = 0;
-          uint32_t dest_b = 0;
-          for (int j = pWeights->m_SrcStart; j <= pWeights->m_SrcEnd; ++j) {
-            uint32_t pixel_weight = pWeights->GetWeightForPosition(j);
-            pdfium::span<const uint8_t> src_pixel =
-                src_span.subspan((j - m_SrcClip.top) * m_InterPitch, 3);
-            dest_b += pixel_weight * src_pixel[0];
-            dest_g += pixel_weight * src_pixel[1];
-            dest_r += pixel_weight * src_pixel[2];
-          }
-          dest_scan[0] = PixelFromFixed(dest_b);
-          dest_scan[1] = PixelFromFixed(dest_g);
-          dest_scan[2] = PixelFromFixed(dest_r);
+        for (size_t i = 0; i < row_bytes; i += DestBpp) {
+          dest_scan[0] = PixelFromFixed(sums[i]);
+          dest_scan[1] = PixelFromFixed(sums[i + 1]);
+          dest_scan[2] = PixelFromFixed(sums[i + 2]);
           dest_scan += DestBpp;
         }
         break;
       }
       case TransformMethod::kManyBpptoManyBppWithAlpha: {
         DCHECK(m_bHasAlpha);
-        for (int col = m_DestClip.left; col < m_DestClip.right; ++col) {
-          pdfium::span<const uint8_t> src_span =
-              m_InterBuf.span().subspan((col - m_DestClip.left) * DestBpp);
-          uint32_t dest_a = 0;
-          uint32_t dest_r = 0;
-          uint32_t dest_g = 0;
-          uint32_t dest_b = 0;
-          constexpr size_t kPixelBytes = 4;
-          for (int j = pWeights->m_SrcStart; j <= pWeights->m_SrcEnd; ++j) {
-            uint32_t pixel_weight = pWeights->GetWeightForPosition(j);
-            pdfium::span<const uint8_t> src_pixel = src_span.subspan(
-                (j - m_SrcClip.top) * m_InterPitch, kPixelBytes);
-            dest_b += pixel_weight * src_pixel[0];
-            dest_g += pixel_weight * src_pixel[1];
-            dest_r += pixel_weight * src_pixel[2];
-            dest_a += pixel_weight * src_pixel[3];
-          }
+        for (size_t i = 0; i < row_bytes; i += DestBpp) {
+          uint32_t dest_a = sums[i + 3];
           if (dest_a) {
-            int r = static_cast<uint32_t>(dest_r) * 255 / dest_a;
-            int g = static_cast<uint32_t>(dest_g) * 255 / dest_a;
-            int b = static_cast<uint32_t>(dest_b) * 255 / dest_a;
+            int r = sums[i + 2] * 255 / dest_a;
+            int g = sums[i + 1] * 255 / dest_a;
+            int b = sums[i] * 255 / dest_a;
             dest_scan[0] = std::clamp(b, 0, 255);
             dest_scan[1] = std::clamp(g, 0, 255);
             dest_scan[2] = std::clamp(r, 0, 255);
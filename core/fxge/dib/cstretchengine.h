@@ -57,6 +57,13 @@ class CStretchEngine {
       m_SrcEnd = src_end;
     }
 
+    // Returns the weights for positions `m_SrcStart` to `m_SrcEnd`, for loops
+    // over all of them.
+    pdfium::span<const uint32_t> GetWeights() const {
+      return pdfium::make_span(m_Weights,
+                               static_cast<size_t>(m_SrcEnd - m_SrcStart + 1));
+    }
+
     uint32_t GetWeightForPosition(int position) const {
       CHECK_GE(position, m_SrcStart);
       CHECK_LE(position, m_SrcEnd);
@@ -4,12 +4,16 @@
 
 #include "core/fxge/dib/cstretchengine.h"
 
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "core/fpdfapi/page/cpdf_dib.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_number.h"
 #include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fxge/dib/cfx_bitmapstorer.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
 #include "core/fxge/dib/fx_dib.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -66,6 +70,97 @@ void ExecuteStretchTests(const FXDIB_ResampleOptions& options) {
   }
 }
 
+RetainPtr<CFX_DIBitmap> CreateTestBitmap(int width,
+                                         int height,
+                                         FXDIB_Format format) {
+  auto bitmap = pdfium::MakeRetain<CFX_DIBitmap>();
+  if (!bitmap->Create(width, height, format))
+    return nullptr;
+
+  for (int row = 0; row < height; ++row) {
+    pdfium::span<uint8_t> scanline = bitmap->GetWritableScanline(row);
+    for (size_t i = 0; i < scanline.size(); ++i)
+      scanline[i] = static_cast<uint8_t>(row * 31 + i * 7 + (i / 5) * 53);
+  }
+  return bitmap;
+}
+
+// Returns the sum of `weights` times the `channel` bytes of the `bpp` byte
+// pixels that start at `data` and are `stride` bytes apart. For pixels with
+// alpha, also weighs the colors by the alpha byte, like CStretchEngine.
+uint32_t WeighPixels(const CStretchEngine::PixelWeight* weights,
+                     const uint8_t* data,
+                     size_t stride,
+                     int channel,
+                     bool weigh_by_alpha) {
+  uint32_t sum = 0;
+  for (int j = weights->m_SrcStart; j <= weights->m_SrcEnd; ++j) {
+    const uint8_t* pixel = data + j * stride;
+    uint32_t weight = weights->GetWeightForPosition(j);
+    if (weigh_by_alpha)
+      weight = weight * pixel[3] / 255;
+    sum += weight * (channel == 3 && weigh_by_alpha ? 255 : pixel[channel]);
+  }
+  return sum;
+}
+
+// Stretches `src` one pixel at a time, in the same way as CStretchEngine.
+std::vector<uint8_t> ReferenceStretch(const RetainPtr<CFX_DIBitmap>& src,
+                                      int dest_width,
+                                      int dest_height,
+                                      const FXDIB_ResampleOptions& options) {
+  const int bpp = src->GetBPP() / 8;
+  const bool has_alpha = src->IsAlphaFormat();
+  const int color_channels = bpp == 1 ? 1 : 3;
+  CStretchEngine::WeightTable horz;
+  CStretchEngine::WeightTable vert;
+  EXPECT_TRUE(horz.CalculateWeights(dest_width, 0, dest_width,
+                                    src->GetWidth(), 0, src->GetWidth(),
+                                    options));
+  EXPECT_TRUE(vert.CalculateWeights(dest_height, 0, dest_height,
+                                    src->GetHeight(), 0, src->GetHeight(),
+                                    options));
+
+  const size_t inter_pitch = dest_width * bpp;
+  std::vector<uint8_t> inter(src->GetHeight() * inter_pitch);
+  for (int row = 0; row < src->GetHeight(); ++row) {
+    const uint8_t* src_scan = src->GetScanline(row).data();
+    for (int col = 0; col < dest_width; ++col) {
+      for (int c = 0; c < (has_alpha ? 4 : color_channels); ++c) {
+        inter[row * inter_pitch + col * bpp + c] =
+            CStretchEngine::PixelFromFixed(WeighPixels(
+                horz.GetPixelWeight(col), src_scan, bpp, c, has_alpha));
+      }
+    }
+  }
+
+  std::vector<uint8_t> result(dest_height * inter_pitch,
+                              bpp == 4 && !has_alpha ? 255 : 0);
+  for (int row = 0; row < dest_height; ++row) {
+    const CStretchEngine::PixelWeight* weights = vert.GetPixelWeight(row);
+    for (int col = 0; col < dest_width; ++col) {
+      uint8_t* dest = &result[row * inter_pitch + col * bpp];
+      const uint8_t* column = &inter[col * bpp];
+      if (!has_alpha) {
+        for (int c = 0; c < color_channels; ++c) {
+          dest[c] = CStretchEngine::PixelFromFixed(
+              WeighPixels(weights, column, inter_pitch, c, false));
+        }
+        continue;
+      }
+      uint32_t alpha = WeighPixels(weights, column, inter_pitch, 3, false);
+      if (alpha) {
+        for (int c = 0; c < 3; ++c) {
+          uint32_t color = WeighPixels(weights, column, inter_pitch, c, false);
+          dest[c] = std::min<uint32_t>(color * 255 / alpha, 255);
+        }
+      }
+      dest[3] = CStretchEngine::PixelFromFixed(alpha);
+    }
+  }
+  return result;
+}
+
 }  // namespace
 
 TEST(CStretchEngine, OverflowInCtor) {
@@ -150,3 +245,43 @@ TEST(CStretchEngine, TooManyWeights) {
                                       kTooBigSrcLen, 0, kTooBigSrcLen,
                                       options));
 }
+
+TEST(CStretchEngine, MatchesReference) {
+  constexpr int kSrcWidth = 97;
+  constexpr int kSrcHeight = 53;
+  // Common down-scale ratios, plus an up-scale one.
+  constexpr int kDestSizes[][2] = {{48, 26}, {32, 17}, {21, 12},
+                                   {12, 6},  {5, 3},   {145, 79}};
+  for (FXDIB_Format format :
+       {FXDIB_Format::k8bppMask, FXDIB_Format::kRgb, FXDIB_Format::kRgb32,
+        FXDIB_Format::kArgb}) {
+    RetainPtr<CFX_DIBitmap> src =
+        CreateTestBitmap(kSrcWidth, kSrcHeight, format);
+    ASSERT_TRUE(src);
+    for (const auto& dest_size : kDestSizes) {
+      const int dest_width = dest_size[0];
+      const int dest_height = dest_size[1];
+      CFX_BitmapStorer storer;
+      ASSERT_TRUE(storer.SetInfo(dest_width, dest_height, format, {}));
+      CStretchEngine engine(&storer, format, dest_width, dest_height,
+                            FX_RECT(0, 0, dest_width, dest_height), src,
+                            FXDIB_ResampleOptions());
+      ASSERT_TRUE(engine.StartStretchHorz());
+      engine.Continue(nullptr);
+
+      std::vector<uint8_t> expected =
+          ReferenceStretch(src, dest_width, dest_height,
+                           engine.GetResampleOptionsForTest());
+      RetainPtr<CFX_DIBitmap> result = storer.GetBitmap();
+      const size_t row_bytes = dest_width * result->GetBPP() / 8;
+      for (int row = 0; row < dest_height; ++row) {
+        pdfium::span<const uint8_t> scanline =
+            result->GetScanline(row).first(row_bytes);
+        EXPECT_TRUE(std::equal(scanline.begin(), scanline.end(),
+                               expected.begin() + row * row_bytes))
+            << "format " << static_cast<int>(format) << ", size "
+            << dest_width << "x" << dest_height << ", row " << row;
+      }
+    }
+  }
+}
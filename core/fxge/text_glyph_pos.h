@@ -8,12 +8,10 @@
 #define CORE_FXGE_TEXT_GLYPH_POS_H_
 
 #include "core/fxcrt/fx_coordinates.h"
-
-#include "core/fxcrt/unowned_ptr.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "core/fxge/cfx_glyphbitmap.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
 
-class CFX_GlyphBitmap;
-
 class TextGlyphPos {
  public:
   TextGlyphPos();
@@ -22,7 +20,7 @@ class TextGlyphPos {
 
   absl::optional<CFX_Point> GetOrigin(const CFX_Point& offset) const;
 
-  UnownedPtr<const CFX_GlyphBitmap> m_pGlyph;
+  RetainPtr<const CFX_GlyphBitmap> m_pGlyph;
   CFX_Point m_Origin;
   CFX_PointF m_fDeviceOrigin;
 };
@@ -10,6 +10,7 @@
 #include <utility>
 
 #include "core/fpdfapi/page/cpdf_pageimagecache.h"
+#include "core/fpdfapi/render/cpdf_pagedisplaylist.h"
 #include "core/fpdfapi/render/cpdf_pagerendercontext.h"
 #include "core/fpdfapi/render/cpdf_progressiverenderer.h"
 #include "core/fpdfapi/render/cpdf_renderoptions.h"
@@ -61,6 +62,8 @@ void RenderPageImpl(CPDF_PageRenderContext* pContext,
   pContext->m_pContext = std::make_unique<CPDF_RenderContext>(
       pPage->GetDocument(), pPage->GetMutablePageResources(),
       pPage->GetPageImageCache());
+  pContext->m_pContext->SetDisplayList(
+      static_cast<CPDF_PageDisplayList*>(pPage->GetDisplayList()));
 
   pContext->m_pContext->AppendLayer(pPage, matrix);
 
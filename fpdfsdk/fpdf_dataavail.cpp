@@ -204,6 +204,18 @@ FPDF_EXPORT int FPDF_CALLCONV FPDFAvail_IsPageAvail(FPDF_AVAIL avail,
   return avail_context->data_avail()->IsPageAvail(page_index, &hints_context);
 }
 
+FPDF_EXPORT int FPDF_CALLCONV
+FPDFAvail_RequestPageData(FPDF_AVAIL avail,
+                          int page_index,
+                          FX_DOWNLOADHINTS* hints) {
+  auto* avail_context = FPDFAvailContextFromFPDFAvail(avail);
+  if (!avail_context || page_index < 0)
+    return PDF_DATA_ERROR;
+  FPDF_DownloadHintsContext hints_context(hints);
+  return avail_context->data_avail()->RequestPageData(page_index,
+                                                      &hints_context);
+}
+
 FPDF_EXPORT int FPDF_CALLCONV FPDFAvail_IsFormAvail(FPDF_AVAIL avail,
                                                     FX_DOWNLOADHINTS* hints) {
   auto* avail_context = FPDFAvailContextFromFPDFAvail(avail);
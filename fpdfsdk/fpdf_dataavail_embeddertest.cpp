@@ -282,6 +282,58 @@ TEST_F(FPDFDataAvailEmbedderTest, LoadSecondPageIfLinearizedWithHints) {
   EXPECT_TRUE(page);
 }
 
+TEST_F(FPDFDataAvailEmbedderTest, RequestSecondPageDataIfLinearized) {
+  TestAsyncLoader loader("feature_linearized_loading.pdf");
+  CreateAvail(loader.file_avail(), loader.file_access());
+  ASSERT_EQ(PDF_DATA_AVAIL, FPDFAvail_IsDocAvail(avail(), loader.hints()));
+  SetDocumentFromAvail();
+  ASSERT_TRUE(document());
+
+  static constexpr uint32_t kSecondPageNum = 1;
+
+  loader.set_is_new_data_available(false);
+  loader.ClearRequestedSegments();
+  EXPECT_EQ(PDF_DATA_NOTAVAIL,
+            FPDFAvail_RequestPageData(avail(), kSecondPageNum, loader.hints()));
+
+  // The requests are sorted, and do not overlap or touch.
+  const auto& segments = loader.requested_segments();
+  ASSERT_FALSE(segments.empty());
+  for (size_t i = 1; i < segments.size(); ++i) {
+    EXPECT_LT(segments[i - 1].first + segments[i - 1].second,
+              segments[i].first);
+  }
+
+  loader.FlushRequestedData();
+  EXPECT_EQ(PDF_DATA_AVAIL,
+            FPDFAvail_RequestPageData(avail(), kSecondPageNum, loader.hints()));
+  EXPECT_TRUE(loader.requested_segments().empty());
+
+  int status = PDF_DATA_NOTAVAIL;
+  while (status == PDF_DATA_NOTAVAIL) {
+    loader.FlushRequestedData();
+    status = FPDFAvail_IsPageAvail(avail(), kSecondPageNum, loader.hints());
+  }
+  EXPECT_EQ(PDF_DATA_AVAIL, status);
+
+  loader.set_is_new_data_available(false);
+  ScopedFPDFPage page(FPDF_LoadPage(document(), kSecondPageNum));
+  EXPECT_TRUE(page);
+
+  EXPECT_EQ(PDF_DATA_ERROR,
+            FPDFAvail_RequestPageData(avail(), 100, loader.hints()));
+}
+
+TEST_F(FPDFDataAvailEmbedderTest, RequestPageDataIfNotLinearized) {
+  TestAsyncLoader loader("hello_world.pdf");
+  CreateAvail(loader.file_avail(), loader.file_access());
+  ASSERT_EQ(PDF_DATA_AVAIL, FPDFAvail_IsDocAvail(avail(), loader.hints()));
+  SetDocumentFromAvail();
+  ASSERT_TRUE(document());
+  EXPECT_EQ(PDF_DATA_ERROR,
+            FPDFAvail_RequestPageData(avail(), 0, loader.hints()));
+}
+
 TEST_F(FPDFDataAvailEmbedderTest, LoadInfoAfterReceivingWholeDocument) {
   TestAsyncLoader loader("linearized.pdf");
   loader.set_is_new_data_available(false);
@@ -398,6 +450,7 @@ TEST_F(FPDFDataAvailEmbedderTest, BadInputsToAPIs) {
   EXPECT_FALSE(FPDFAvail_GetDocument(nullptr, nullptr));
   EXPECT_EQ(0, FPDFAvail_GetFirstPageNum(nullptr));
   EXPECT_EQ(PDF_DATA_ERROR, FPDFAvail_IsPageAvail(nullptr, 0, nullptr));
+  EXPECT_EQ(PDF_DATA_ERROR, FPDFAvail_RequestPageData(nullptr, 0, nullptr));
   EXPECT_EQ(PDF_FORM_ERROR, FPDFAvail_IsFormAvail(nullptr, nullptr));
   EXPECT_EQ(PDF_LINEARIZATION_UNKNOWN, FPDFAvail_IsLinearized(nullptr));
 }
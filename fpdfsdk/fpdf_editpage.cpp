@@ -281,6 +281,8 @@ FPDF_EXPORT int FPDF_CALLCONV FPDFPage_CountObjects(FPDF_PAGE page) {
   if (!IsPageObject(pPage))
     return -1;
 
+  // Pages from FPDF_LoadPageForProgressiveRender() may not be fully parsed.
+  pPage->ParseContent();
   return pdfium::base::checked_cast<int>(pPage->GetPageObjectCount());
 }
 
@@ -290,12 +292,18 @@ FPDF_EXPORT FPDF_PAGEOBJECT FPDF_CALLCONV FPDFPage_GetObject(FPDF_PAGE page,
   if (!IsPageObject(pPage))
     return nullptr;
 
+  pPage->ParseContent();
   return FPDFPageObjectFromCPDFPageObject(pPage->GetPageObjectByIndex(index));
 }
 
 FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDFPage_HasTransparency(FPDF_PAGE page) {
   CPDF_Page* pPage = CPDFPageFromFPDFPage(page);
-  return pPage && pPage->BackgroundAlphaNeeded();
+  if (!pPage)
+    return false;
+
+  // Parsing the page finds out whether it needs a background alpha.
+  pPage->ParseContent();
+  return pPage->BackgroundAlphaNeeded();
 }
 
 FPDF_EXPORT void FPDF_CALLCONV
@@ -616,8 +624,18 @@ FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDFPage_GenerateContent(FPDF_PAGE page) {
   if (!IsPageObject(pPage))
     return false;
 
+  // Pages from FPDF_LoadPageForProgressiveRender() may not be fully parsed
+  // yet, and with a visible rect they never have all of their objects.
+  if (pPage->GetCullRect().has_value())
+    return false;
+
+  pPage->ParseContent();
   CPDF_PageContentGenerator CG(pPage);
   CG.GenerateContent();
+
+  // Generating the content makes the page objects clean again, so the display
+  // list can no longer tell which of them changed since it was built.
+  pPage->SetDisplayList(nullptr);
   return true;
 }
 
@@ -9,7 +9,10 @@
 #include <memory>
 #include <utility>
 
+#include "core/fpdfapi/page/cpdf_contentparser.h"
 #include "core/fpdfapi/page/cpdf_page.h"
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_document.h"
 #include "core/fpdfapi/render/cpdf_pagerendercontext.h"
 #include "core/fpdfapi/render/cpdf_progressiverenderer.h"
 #include "core/fxge/cfx_defaultrenderdevice.h"
@@ -38,6 +41,39 @@ int ToFPDFStatus(CPDF_ProgressiveRenderer::Status status) {
 
 }  // namespace
 
+FPDF_EXPORT FPDF_PAGE FPDF_CALLCONV
+FPDF_LoadPageForProgressiveRender(FPDF_DOCUMENT document,
+                                  int page_index,
+                                  const FS_RECTF* visible_rect) {
+  auto* pDoc = CPDFDocumentFromFPDFDocument(document);
+  if (!pDoc)
+    return nullptr;
+
+#ifdef PDF_ENABLE_XFA
+  // XFA pages get parsed up front.
+  if (pDoc->GetExtension())
+    return FPDF_LoadPage(document, page_index);
+#endif  // PDF_ENABLE_XFA
+
+  CPDF_Document::ScopedSharedAccess shared_access(pDoc);
+  if (page_index < 0 || page_index >= FPDF_GetPageCount(document))
+    return nullptr;
+
+  RetainPtr<CPDF_Dictionary> pDict = pDoc->GetMutablePageDictionary(page_index);
+  if (!pDict)
+    return nullptr;
+
+  auto pPage = pdfium::MakeRetain<CPDF_Page>(pDoc, std::move(pDict));
+  pPage->AddPageImageCache();
+  if (visible_rect) {
+    CFX_FloatRect cull_rect = CFXFloatRectFromFSRectF(*visible_rect);
+    cull_rect.Normalize();
+    pPage->SetCullRect(cull_rect);
+  }
+  pPage->StartParse(std::make_unique<CPDF_ContentParser>(pPage.Get()));
+  return FPDFPageFromIPDFPage(pPage.Leak());
+}
+
 FPDF_EXPORT int FPDF_CALLCONV
 FPDF_RenderPageBitmapWithColorScheme_Start(FPDF_BITMAP bitmap,
                                            FPDF_PAGE page,
@@ -42,6 +42,12 @@ FPDF_EXPORT FPDF_TEXTPAGE FPDF_CALLCONV FPDFText_LoadPage(FPDF_PAGE page) {
   if (!pPDFPage)
     return nullptr;
 
+  // Pages from FPDF_LoadPageForProgressiveRender() with a visible rect lack
+  // the text outside of it, and others may not be fully parsed.
+  if (pPDFPage->GetCullRect().has_value())
+    return nullptr;
+
+  pPDFPage->ParseContent();
   CPDF_ViewerPreferences viewRef(pPDFPage->GetDocument());
   auto textpage =
       std::make_unique<CPDF_TextPage>(pPDFPage, viewRef.IsDirectionR2L());
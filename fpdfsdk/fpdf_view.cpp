@@ -16,6 +16,7 @@
 #include "core/fpdfapi/page/cpdf_page.h"
 #include "core/fpdfapi/page/cpdf_pageimagecache.h"
 #include "core/fpdfapi/page/cpdf_pagemodule.h"
+#include "core/fpdfapi/page/cpdf_streamprefetcher.h"
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
@@ -25,6 +26,7 @@
 #include "core/fpdfapi/parser/cpdf_string.h"
 #include "core/fpdfapi/parser/fpdf_parser_decode.h"
 #include "core/fpdfapi/render/cpdf_docrenderdata.h"
+#include "core/fpdfapi/render/cpdf_pagedisplaylist.h"
 #include "core/fpdfapi/render/cpdf_pagerendercontext.h"
 #include "core/fpdfapi/render/cpdf_rendercontext.h"
 #include "core/fpdfapi/render/cpdf_renderoptions.h"
@@ -32,6 +34,7 @@
 #include "core/fpdfdoc/cpdf_viewerpreferences.h"
 #include "core/fxcrt/cfx_read_only_span_stream.h"
 #include "core/fxcrt/cfx_timer.h"
+#include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fx_safe_types.h"
 #include "core/fxcrt/fx_stream.h"
 #include "core/fxcrt/fx_system.h"
@@ -39,7 +42,9 @@
 #include "core/fxcrt/stl_util.h"
 #include "core/fxcrt/unowned_ptr.h"
 #include "core/fxge/cfx_defaultrenderdevice.h"
+#include "core/fxge/cfx_fontcache.h"
 #include "core/fxge/cfx_gemodule.h"
+#include "core/fxge/cfx_glyphbitmapcache.h"
 #include "core/fxge/cfx_glyphcache.h"
 #include "core/fxge/cfx_renderdevice.h"
 #include "core/fxge/dib/cfx_dibitmap.h"
@@ -197,8 +202,10 @@ std::vector<XFAPacket> GetXFAPackets(RetainPtr<const CPDF_Object> xfa_object) {
   return packets;
 }
 
-FPDF_DOCUMENT LoadDocumentImpl(RetainPtr<IFX_SeekableReadStream> pFileAccess,
-                               FPDF_BYTESTRING password) {
+FPDF_DOCUMENT LoadDocumentImpl(
+    RetainPtr<IFX_SeekableReadStream> pFileAccess,
+    FPDF_BYTESTRING password,
+    pdfium::span<const uint8_t> cross_ref_index = {}) {
   if (!pFileAccess) {
     ProcessParseError(CPDF_Parser::FILE_ERROR);
     return nullptr;
@@ -209,7 +216,10 @@ FPDF_DOCUMENT LoadDocumentImpl(RetainPtr<IFX_SeekableReadStream> pFileAccess,
                                       std::make_unique<CPDF_DocPageData>());
 
   CPDF_Parser::Error error =
-      pDocument->LoadDoc(std::move(pFileAccess), password);
+      cross_ref_index.empty()
+          ? pDocument->LoadDoc(std::move(pFileAccess), password)
+          : pDocument->LoadDocWithCrossRefIndex(std::move(pFileAccess),
+                                                password, cross_ref_index);
   if (error != CPDF_Parser::SUCCESS) {
     ProcessParseError(error);
     return nullptr;
@@ -303,6 +313,95 @@ FPDF_LoadDocument(FPDF_STRING file_path, FPDF_BYTESTRING password) {
                           password);
 }
 
+FPDF_EXPORT FPDF_DOCUMENT FPDF_CALLCONV
+FPDF_LoadMappedDocument(FPDF_STRING file_path, FPDF_BYTESTRING password) {
+  RetainPtr<IFX_SeekableReadStream> file =
+      IFX_SeekableReadStream::CreateMappedFromFilename(file_path);
+  if (!file)
+    return FPDF_LoadDocument(file_path, password);
+
+  return LoadDocumentImpl(std::move(file), password);
+}
+
+FPDF_EXPORT void FPDF_CALLCONV FPDF_SetRebuildCrossRefThreadCount(int count) {
+  CPDF_Parser::SetRebuildCrossRefThreadCount(count > 0 ? count : 1);
+}
+
+FPDF_EXPORT void FPDF_CALLCONV FPDF_SetPagePrefetchThreadCount(int count) {
+  CPDF_StreamPrefetcher::SetThreadCount(count > 0 ? count : 1);
+}
+
+FPDF_EXPORT void FPDF_CALLCONV FPDF_SetObjectArenaEnabled(FPDF_BOOL enabled) {
+  CPDF_Document::SetObjectArenaEnabled(!!enabled);
+}
+
+FPDF_EXPORT void FPDF_CALLCONV
+FPDF_SetObjectStreamCacheBudget(unsigned long bytes) {
+  CPDF_Parser::SetObjectStreamCacheBudget(bytes);
+}
+
+FPDF_EXPORT void FPDF_CALLCONV FPDF_SetGlyphCacheBudget(unsigned long bytes) {
+  CFX_GEModule::Get()->GetFontCache()->GetGlyphBitmapCache()->SetBudget(bytes);
+}
+
+FPDF_EXPORT void FPDF_CALLCONV FPDF_GetGlyphCacheStats(unsigned long* hits,
+                                                       unsigned long* misses,
+                                                       unsigned long* bytes) {
+  const CFX_GlyphBitmapCache* cache =
+      CFX_GEModule::Get()->GetFontCache()->GetGlyphBitmapCache();
+  const CFX_GlyphBitmapCache::Stats stats = cache->stats();
+  if (hits)
+    *hits = pdfium::base::saturated_cast<unsigned long>(stats.hits);
+  if (misses)
+    *misses = pdfium::base::saturated_cast<unsigned long>(stats.misses);
+  if (bytes)
+    *bytes = pdfium::base::saturated_cast<unsigned long>(cache->cached_bytes());
+}
+
+FPDF_EXPORT void FPDF_CALLCONV FPDF_SetImageCacheBudget(unsigned long bytes) {
+  CPDF_PageImageCache::SetGlobalBudget(bytes);
+}
+
+FPDF_EXPORT void FPDF_CALLCONV
+FPDF_GetImageCacheStats(unsigned long* evictions,
+                        unsigned long* redecodes,
+                        unsigned long* bytes) {
+  const CPDF_PageImageCache::Stats stats =
+      CPDF_PageImageCache::GetGlobalStats();
+  if (evictions)
+    *evictions = pdfium::base::saturated_cast<unsigned long>(stats.evictions);
+  if (redecodes)
+    *redecodes = pdfium::base::saturated_cast<unsigned long>(stats.redecodes);
+  if (bytes) {
+    *bytes = pdfium::base::saturated_cast<unsigned long>(
+        CPDF_PageImageCache::GetGlobalCacheSize());
+  }
+}
+
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_EnableSharedDocumentAccess(FPDF_DOCUMENT document) {
+  CPDF_Document* pDoc = CPDFDocumentFromFPDFDocument(document);
+  if (!pDoc || pDoc->GetExtension())
+    return false;
+
+  pDoc->EnableSharedAccess();
+  return true;
+}
+
+FPDF_EXPORT FPDF_DOCUMENT FPDF_CALLCONV
+FPDF_LoadDocumentWithCrossRefIndex(FPDF_STRING file_path,
+                                   FPDF_BYTESTRING password,
+                                   const void* index,
+                                   unsigned long index_size) {
+  pdfium::span<const uint8_t> index_span;
+  if (index) {
+    index_span = pdfium::make_span(static_cast<const uint8_t*>(index),
+                                   static_cast<size_t>(index_size));
+  }
+  return LoadDocumentImpl(IFX_SeekableReadStream::CreateFromFilename(file_path),
+                          password, index_span);
+}
+
 FPDF_EXPORT int FPDF_CALLCONV FPDF_GetFormType(FPDF_DOCUMENT document) {
   const CPDF_Document* pDoc = CPDFDocumentFromFPDFDocument(document);
   if (!pDoc)
@@ -386,6 +485,43 @@ FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDF_GetFileVersion(FPDF_DOCUMENT doc,
   return true;
 }
 
+FPDF_EXPORT unsigned long FPDF_CALLCONV
+FPDF_GetCrossRefIndex(FPDF_DOCUMENT document,
+                      void* buffer,
+                      unsigned long buflen) {
+  CPDF_Document* pDoc = CPDFDocumentFromFPDFDocument(document);
+  if (!pDoc)
+    return 0;
+
+  const pdfium::span<const uint8_t> index = pDoc->GetCrossRefIndex();
+  if (buffer && buflen >= index.size()) {
+    fxcrt::spancpy(pdfium::make_span(static_cast<uint8_t*>(buffer), buflen),
+                   index);
+  }
+  return pdfium::base::checked_cast<unsigned long>(index.size());
+}
+
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_GetObjectStreamCacheStats(FPDF_DOCUMENT document,
+                               unsigned long* hits,
+                               unsigned long* misses) {
+  CPDF_Document* pDoc = CPDFDocumentFromFPDFDocument(document);
+  if (!pDoc)
+    return false;
+
+  CPDF_Parser* pParser = pDoc->GetParser();
+  if (!pParser)
+    return false;
+
+  const CPDF_ObjectStreamCache::Stats& stats =
+      pParser->GetObjectStreamCacheStats();
+  if (hits)
+    *hits = pdfium::base::saturated_cast<unsigned long>(stats.hits);
+  if (misses)
+    *misses = pdfium::base::saturated_cast<unsigned long>(stats.misses);
+  return true;
+}
+
 FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
 FPDF_DocumentHasValidCrossReferenceTable(FPDF_DOCUMENT document) {
   CPDF_Document* pDoc = CPDFDocumentFromFPDFDocument(document);
@@ -419,6 +555,7 @@ FPDF_EXPORT int FPDF_CALLCONV FPDF_GetPageCount(FPDF_DOCUMENT document) {
   if (!pDoc)
     return 0;
 
+  CPDF_Document::ScopedSharedAccess shared_access(pDoc);
   auto* pExtension = pDoc->GetExtension();
   return pExtension ? pExtension->GetPageCount() : pDoc->GetPageCount();
 }
@@ -429,6 +566,7 @@ FPDF_EXPORT FPDF_PAGE FPDF_CALLCONV FPDF_LoadPage(FPDF_DOCUMENT document,
   if (!pDoc)
     return nullptr;
 
+  CPDF_Document::ScopedSharedAccess shared_access(pDoc);
   if (page_index < 0 || page_index >= FPDF_GetPageCount(document))
     return nullptr;
 
@@ -579,11 +717,16 @@ FPDF_EXPORT void FPDF_CALLCONV FPDF_RenderPage(HDC dc,
   if (!pPage)
     return;
 
+  CPDF_Document::ScopedSharedAccess shared_access(pPage->GetDocument());
   auto owned_context = std::make_unique<CPDF_PageRenderContext>();
   CPDF_PageRenderContext* context = owned_context.get();
   CPDF_Page::RenderContextClearer clearer(pPage);
   pPage->SetRenderContext(std::move(owned_context));
 
+  // The checks below need the whole page parsed, which pages from
+  // FPDF_LoadPageForProgressiveRender() may not be yet.
+  pPage->ParseContent();
+
   // Don't render the full page to bitmap for a mask unless there are a lot
   // of masks. Full page bitmaps result in large spool sizes, so they should
   // only be used when necessary. For large numbers of masks, rendering each
@@ -707,6 +850,7 @@ FPDF_EXPORT void FPDF_CALLCONV FPDF_RenderPageBitmap(FPDF_BITMAP bitmap,
   if (!pPage)
     return;
 
+  CPDF_Document::ScopedSharedAccess shared_access(pPage->GetDocument());
   auto owned_context = std::make_unique<CPDF_PageRenderContext>();
   CPDF_PageRenderContext* context = owned_context.get();
   CPDF_Page::RenderContextClearer clearer(pPage);
@@ -742,6 +886,7 @@ FPDF_RenderPageBitmapWithMatrix(FPDF_BITMAP bitmap,
   if (!pPage)
     return;
 
+  CPDF_Document::ScopedSharedAccess shared_access(pPage->GetDocument());
   auto owned_context = std::make_unique<CPDF_PageRenderContext>();
   CPDF_PageRenderContext* context = owned_context.get();
   CPDF_Page::RenderContextClearer clearer(pPage);
@@ -766,6 +911,31 @@ FPDF_RenderPageBitmapWithMatrix(FPDF_BITMAP bitmap,
                      /*color_scheme=*/nullptr);
 }
 
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDF_BuildPageDisplayList(FPDF_PAGE page) {
+  CPDF_Page* pPage = CPDFPageFromFPDFPage(page);
+  if (!pPage)
+    return false;
+
+  // Pages from FPDF_LoadPageForProgressiveRender() with a visible rect lack
+  // the objects outside of it, and others may not be fully parsed.
+  if (pPage->GetCullRect().has_value())
+    return false;
+
+  CPDF_Document::ScopedSharedAccess shared_access(pPage->GetDocument());
+  pPage->ParseContent();
+  pPage->SetDisplayList(std::make_unique<CPDF_PageDisplayList>(pPage));
+  return true;
+}
+
+FPDF_EXPORT void FPDF_CALLCONV FPDF_ClearPageDisplayList(FPDF_PAGE page) {
+  CPDF_Page* pPage = CPDFPageFromFPDFPage(page);
+  if (!pPage)
+    return;
+
+  CPDF_Document::ScopedSharedAccess shared_access(pPage->GetDocument());
+  pPage->SetDisplayList(nullptr);
+}
+
 #if defined(PDF_USE_SKIA)
 FPDF_EXPORT void FPDF_CALLCONV FPDF_RenderPageSkia(FPDF_SKIA_CANVAS canvas,
                                                    FPDF_PAGE page,
@@ -799,6 +969,10 @@ FPDF_EXPORT void FPDF_CALLCONV FPDF_ClosePage(FPDF_PAGE page) {
   if (!page)
     return;
 
+  // Destroying the page releases objects shared with other pages.
+  CPDF_Document::ScopedSharedAccess shared_access(
+      IPDFPageFromFPDFPage(page)->GetDocument());
+
   // Take it back across the API and hold for duration of this function.
   RetainPtr<IPDF_Page> pPage;
   pPage.Unleak(IPDFPageFromFPDFPage(page));
@@ -986,6 +1160,7 @@ FPDF_GetPageSizeByIndexF(FPDF_DOCUMENT document,
   if (!pDoc)
     return false;
 
+  CPDF_Document::ScopedSharedAccess shared_access(pDoc);
 #ifdef PDF_ENABLE_XFA
   if (page_index < 0 || page_index >= FPDF_GetPageCount(document))
     return false;
@@ -127,6 +127,7 @@ int CheckPDFiumCApi() {
     CHK(FPDFAvail_IsFormAvail);
     CHK(FPDFAvail_IsLinearized);
     CHK(FPDFAvail_IsPageAvail);
+    CHK(FPDFAvail_RequestPageData);
 
     // fpdf_doc.h
     CHK(FPDFAction_GetDest);
@@ -338,6 +339,7 @@ int CheckPDFiumCApi() {
     CHK(FPDF_NewXObjectFromPage);
 
     // fpdf_progressive.h
+    CHK(FPDF_LoadPageForProgressiveRender);
     CHK(FPDF_RenderPageBitmapWithColorScheme_Start);
     CHK(FPDF_RenderPageBitmap_Start);
     CHK(FPDF_RenderPage_Close);
@@ -477,21 +479,28 @@ int CheckPDFiumCApi() {
     CHK(FPDF_BStr_Init);
     CHK(FPDF_BStr_Set);
 #endif
+    CHK(FPDF_BuildPageDisplayList);
+    CHK(FPDF_ClearPageDisplayList);
     CHK(FPDF_CloseDocument);
     CHK(FPDF_ClosePage);
     CHK(FPDF_CountNamedDests);
     CHK(FPDF_DestroyLibrary);
     CHK(FPDF_DeviceToPage);
     CHK(FPDF_DocumentHasValidCrossReferenceTable);
+    CHK(FPDF_EnableSharedDocumentAccess);
 #ifdef PDF_ENABLE_V8
     CHK(FPDF_GetArrayBufferAllocatorSharedInstance);
 #endif
+    CHK(FPDF_GetCrossRefIndex);
     CHK(FPDF_GetDocPermissions);
     CHK(FPDF_GetDocUserPermissions);
     CHK(FPDF_GetFileVersion);
+    CHK(FPDF_GetGlyphCacheStats);
+    CHK(FPDF_GetImageCacheStats);
     CHK(FPDF_GetLastError);
     CHK(FPDF_GetNamedDest);
     CHK(FPDF_GetNamedDestByName);
+    CHK(FPDF_GetObjectStreamCacheStats);
     CHK(FPDF_GetPageBoundingBox);
     CHK(FPDF_GetPageCount);
     CHK(FPDF_GetPageHeight);
@@ -512,6 +521,8 @@ int CheckPDFiumCApi() {
     CHK(FPDF_InitLibraryWithConfig);
     CHK(FPDF_LoadCustomDocument);
     CHK(FPDF_LoadDocument);
+    CHK(FPDF_LoadDocumentWithCrossRefIndex);
+    CHK(FPDF_LoadMappedDocument);
     CHK(FPDF_LoadMemDocument);
     CHK(FPDF_LoadMemDocument64);
     CHK(FPDF_LoadPage);
@@ -524,9 +535,15 @@ int CheckPDFiumCApi() {
 #if defined(PDF_USE_SKIA)
     CHK(FPDF_RenderPageSkia);
 #endif
+    CHK(FPDF_SetGlyphCacheBudget);
+    CHK(FPDF_SetImageCacheBudget);
+    CHK(FPDF_SetObjectArenaEnabled);
+    CHK(FPDF_SetObjectStreamCacheBudget);
+    CHK(FPDF_SetPagePrefetchThreadCount);
 #if defined(_WIN32)
     CHK(FPDF_SetPrintMode);
 #endif
+    CHK(FPDF_SetRebuildCrossRefThreadCount);
     CHK(FPDF_SetSandBoxPolicy);
     CHK(FPDF_VIEWERREF_GetDuplex);
     CHK(FPDF_VIEWERREF_GetName);
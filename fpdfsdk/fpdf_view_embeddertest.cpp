@@ -5,9 +5,11 @@
 #include <math.h>
 
 #include <algorithm>
+#include <iterator>
 #include <limits>
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -17,6 +19,8 @@
 #include "fpdfsdk/cpdfsdk_helpers.h"
 #include "fpdfsdk/fpdf_view_c_api_test.h"
 #include "public/cpp/fpdf_scopers.h"
+#include "public/fpdf_annot.h"
+#include "public/fpdf_edit.h"
 #include "public/fpdfview.h"
 #include "testing/embedder_test.h"
 #include "testing/embedder_test_constants.h"
@@ -521,12 +525,423 @@ TEST_F(FPDFViewEmbedderTest, LoadDocument64) {
   EXPECT_EQ(14, version);
 }
 
+TEST_F(FPDFViewEmbedderTest, LoadMappedDocument) {
+  std::string file_path = PathService::GetTestFilePath("hello_world.pdf");
+  ASSERT_FALSE(file_path.empty());
+
+  ScopedFPDFDocument doc(FPDF_LoadMappedDocument(file_path.c_str(), nullptr));
+  ASSERT_TRUE(doc);
+
+  int version;
+  EXPECT_TRUE(FPDF_GetFileVersion(doc.get(), &version));
+  EXPECT_EQ(17, version);
+
+  ScopedFPDFPage page(FPDF_LoadPage(doc.get(), 0));
+  ASSERT_TRUE(page);
+  ScopedFPDFBitmap bitmap = RenderPage(page.get());
+  CompareBitmap(bitmap.get(), 200, 200, pdfium::HelloWorldChecksum());
+}
+
 TEST_F(FPDFViewEmbedderTest, LoadNonexistentDocument) {
   FPDF_DOCUMENT doc = FPDF_LoadDocument("nonexistent_document.pdf", "");
   ASSERT_FALSE(doc);
   EXPECT_EQ(static_cast<int>(FPDF_GetLastError()), FPDF_ERR_FILE);
 }
 
+TEST_F(FPDFViewEmbedderTest, LoadNonexistentMappedDocument) {
+  FPDF_DOCUMENT doc = FPDF_LoadMappedDocument("nonexistent_document.pdf", "");
+  ASSERT_FALSE(doc);
+  EXPECT_EQ(static_cast<int>(FPDF_GetLastError()), FPDF_ERR_FILE);
+}
+
+TEST_F(FPDFViewEmbedderTest, LoadDocumentWithCrossRefIndex) {
+  std::string file_path = PathService::GetTestFilePath("hello_world.pdf");
+  ASSERT_FALSE(file_path.empty());
+
+  std::vector<uint8_t> index;
+  {
+    ScopedFPDFDocument doc(FPDF_LoadDocument(file_path.c_str(), nullptr));
+    ASSERT_TRUE(doc);
+    unsigned long size = FPDF_GetCrossRefIndex(doc.get(), nullptr, 0);
+    ASSERT_GT(size, 0u);
+    index.resize(size);
+    EXPECT_EQ(size, FPDF_GetCrossRefIndex(doc.get(), index.data(), size));
+  }
+
+  ScopedFPDFDocument doc(FPDF_LoadDocumentWithCrossRefIndex(
+      file_path.c_str(), nullptr, index.data(), index.size()));
+  ASSERT_TRUE(doc);
+
+  // An index created from the index is the same.
+  std::vector<uint8_t> index_again(index.size());
+  ASSERT_EQ(index.size(), FPDF_GetCrossRefIndex(doc.get(), index_again.data(),
+                                                index_again.size()));
+  EXPECT_EQ(index, index_again);
+
+  ScopedFPDFPage page(FPDF_LoadPage(doc.get(), 0));
+  ASSERT_TRUE(page);
+  ScopedFPDFBitmap bitmap = RenderPage(page.get());
+  CompareBitmap(bitmap.get(), 200, 200, pdfium::HelloWorldChecksum());
+}
+
+TEST_F(FPDFViewEmbedderTest, LoadDocumentWithCrossRefIndexObjectStreams) {
+  std::string file_path =
+      PathService::GetTestFilePath("annotation_stamp_with_ap.pdf");
+  ASSERT_FALSE(file_path.empty());
+
+  std::vector<uint8_t> index;
+  int object_count;
+  {
+    ScopedFPDFDocument doc(FPDF_LoadDocument(file_path.c_str(), nullptr));
+    ASSERT_TRUE(doc);
+    index.resize(FPDF_GetCrossRefIndex(doc.get(), nullptr, 0));
+    ASSERT_FALSE(index.empty());
+    FPDF_GetCrossRefIndex(doc.get(), index.data(), index.size());
+
+    ScopedFPDFPage page(FPDF_LoadPage(doc.get(), 0));
+    ASSERT_TRUE(page);
+    object_count = FPDFPage_CountObjects(page.get());
+  }
+
+  ScopedFPDFDocument doc(FPDF_LoadDocumentWithCrossRefIndex(
+      file_path.c_str(), nullptr, index.data(), index.size()));
+  ASSERT_TRUE(doc);
+  ScopedFPDFPage page(FPDF_LoadPage(doc.get(), 0));
+  ASSERT_TRUE(page);
+  EXPECT_EQ(object_count, FPDFPage_CountObjects(page.get()));
+  EXPECT_EQ(2, FPDFPage_GetAnnotCount(page.get()));
+}
+
+TEST_F(FPDFViewEmbedderTest, ObjectStreamCacheBudget) {
+  std::string file_path =
+      PathService::GetTestFilePath("annotation_stamp_with_ap.pdf");
+  ASSERT_FALSE(file_path.empty());
+
+  EXPECT_FALSE(FPDF_GetObjectStreamCacheStats(nullptr, nullptr, nullptr));
+
+  int object_count;
+  unsigned long unlimited_misses;
+  {
+    ScopedFPDFDocument doc(FPDF_LoadDocument(file_path.c_str(), nullptr));
+    ASSERT_TRUE(doc);
+    ScopedFPDFPage page(FPDF_LoadPage(doc.get(), 0));
+    ASSERT_TRUE(page);
+    object_count = FPDFPage_CountObjects(page.get());
+
+    unsigned long hits;
+    ASSERT_TRUE(
+        FPDF_GetObjectStreamCacheStats(doc.get(), &hits, &unlimited_misses));
+    EXPECT_GT(hits, 0u);
+    EXPECT_GT(unlimited_misses, 0u);
+  }
+
+  // With a tiny budget, only the last used object stream is kept, and the
+  // others get decoded again.
+  FPDF_SetObjectStreamCacheBudget(1);
+  {
+    ScopedFPDFDocument doc(FPDF_LoadDocument(file_path.c_str(), nullptr));
+    ASSERT_TRUE(doc);
+    ScopedFPDFPage page(FPDF_LoadPage(doc.get(), 0));
+    ASSERT_TRUE(page);
+    EXPECT_EQ(object_count, FPDFPage_CountObjects(page.get()));
+    EXPECT_EQ(2, FPDFPage_GetAnnotCount(page.get()));
+
+    unsigned long misses;
+    ASSERT_TRUE(FPDF_GetObjectStreamCacheStats(doc.get(), nullptr, &misses));
+    EXPECT_GE(misses, unlimited_misses);
+  }
+  FPDF_SetObjectStreamCacheBudget(0);
+}
+
+TEST_F(FPDFViewEmbedderTest, SharedDocumentAccess) {
+  // Both pages use the same font from a shared resources dictionary.
+  std::string file_path = PathService::GetTestFilePath(
+      "hello_world_2_pages_shared_resources_dict.pdf");
+  ASSERT_FALSE(file_path.empty());
+
+  EXPECT_FALSE(FPDF_EnableSharedDocumentAccess(nullptr));
+
+  ScopedFPDFDocument doc(FPDF_LoadDocument(file_path.c_str(), nullptr));
+  ASSERT_TRUE(doc);
+  ASSERT_EQ(2, FPDF_GetPageCount(doc.get()));
+  ASSERT_TRUE(FPDF_EnableSharedDocumentAccess(doc.get()));
+
+  auto render_page = [&doc](int page_index) -> std::string {
+    ScopedFPDFPage page(FPDF_LoadPage(doc.get(), page_index));
+    if (!page)
+      return std::string();
+
+    const int width = static_cast<int>(FPDF_GetPageWidthF(page.get()));
+    const int height = static_cast<int>(FPDF_GetPageHeightF(page.get()));
+    ScopedFPDFBitmap bitmap(FPDFBitmap_Create(width, height, /*alpha=*/0));
+    FPDFBitmap_FillRect(bitmap.get(), 0, 0, width, height, 0xFFFFFFFF);
+    FPDF_RenderPageBitmap(bitmap.get(), page.get(), 0, 0, width, height,
+                          /*rotate=*/0, /*flags=*/0);
+    return HashBitmap(bitmap.get());
+  };
+
+  const std::string expected_hashes[] = {render_page(0), render_page(1)};
+  ASSERT_FALSE(expected_hashes[0].empty());
+  ASSERT_FALSE(expected_hashes[1].empty());
+
+  // Every thread renders both pages several times, with threads starting on
+  // different pages.
+  constexpr int kThreadCount = 4;
+  constexpr int kRendersPerThread = 8;
+  std::vector<std::vector<std::string>> hashes(kThreadCount);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreadCount; ++i) {
+    threads.emplace_back([i, &hashes, &render_page]() {
+      for (int j = 0; j < kRendersPerThread; ++j)
+        hashes[i].push_back(render_page((i + j) % 2));
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+
+  for (int i = 0; i < kThreadCount; ++i) {
+    ASSERT_EQ(static_cast<size_t>(kRendersPerThread), hashes[i].size());
+    for (int j = 0; j < kRendersPerThread; ++j)
+      EXPECT_EQ(expected_hashes[(i + j) % 2], hashes[i][j]);
+  }
+}
+
+TEST_F(FPDFViewEmbedderTest, SharedDocumentAccessMultipleDocuments) {
+  // One document with text, one with images.
+  const char* const kFileNames[] = {
+      "hello_world_2_pages_shared_resources_dict.pdf", "embedded_images.pdf"};
+  constexpr int kDocCount = std::size(kFileNames);
+
+  std::vector<ScopedFPDFDocument> docs;
+  for (const char* name : kFileNames) {
+    std::string file_path = PathService::GetTestFilePath(name);
+    ASSERT_FALSE(file_path.empty());
+    docs.emplace_back(FPDF_LoadDocument(file_path.c_str(), nullptr));
+    ASSERT_TRUE(docs.back());
+    ASSERT_TRUE(FPDF_EnableSharedDocumentAccess(docs.back().get()));
+  }
+
+  auto render_page = [&docs](int doc_index) -> std::string {
+    ScopedFPDFPage page(FPDF_LoadPage(docs[doc_index].get(), 0));
+    if (!page)
+      return std::string();
+
+    const int width = static_cast<int>(FPDF_GetPageWidthF(page.get()));
+    const int height = static_cast<int>(FPDF_GetPageHeightF(page.get()));
+    ScopedFPDFBitmap bitmap(FPDFBitmap_Create(width, height, /*alpha=*/0));
+    FPDFBitmap_FillRect(bitmap.get(), 0, 0, width, height, 0xFFFFFFFF);
+    FPDF_RenderPageBitmap(bitmap.get(), page.get(), 0, 0, width, height,
+                          /*rotate=*/0, /*flags=*/0);
+    return HashBitmap(bitmap.get());
+  };
+
+  std::string expected_hashes[kDocCount];
+  for (int i = 0; i < kDocCount; ++i) {
+    expected_hashes[i] = render_page(i);
+    ASSERT_FALSE(expected_hashes[i].empty());
+  }
+
+  // A tiny image budget makes threads evict each other's images.
+  FPDF_SetImageCacheBudget(1);
+
+  // Each thread renders one document, two threads per document.
+  constexpr int kThreadCount = 2 * kDocCount;
+  constexpr int kRendersPerThread = 8;
+  std::vector<std::vector<std::string>> hashes(kThreadCount);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreadCount; ++i) {
+    threads.emplace_back([i, &hashes, &render_page]() {
+      for (int j = 0; j < kRendersPerThread; ++j)
+        hashes[i].push_back(render_page(i % kDocCount));
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+
+  FPDF_SetImageCacheBudget(0);
+
+  for (int i = 0; i < kThreadCount; ++i) {
+    ASSERT_EQ(static_cast<size_t>(kRendersPerThread), hashes[i].size());
+    for (const std::string& hash : hashes[i])
+      EXPECT_EQ(expected_hashes[i % kDocCount], hash);
+  }
+}
+
+TEST_F(FPDFViewEmbedderTest, GlyphCacheSharedAcrossDocuments) {
+  // The document embeds its font program.
+  std::string expected_hash;
+  unsigned long first_misses;
+  {
+    ASSERT_TRUE(OpenDocument("text_font.pdf"));
+    FPDF_PAGE page = LoadPage(0);
+    ASSERT_TRUE(page);
+    ScopedFPDFBitmap bitmap = RenderLoadedPage(page);
+    expected_hash = HashBitmap(bitmap.get());
+    UnloadPage(page);
+    CloseDocument();
+
+    unsigned long bytes;
+    FPDF_GetGlyphCacheStats(nullptr, &first_misses, &bytes);
+    EXPECT_GT(first_misses, 0u);
+    EXPECT_GT(bytes, 0u);
+  }
+
+  // Opening the document again reuses the glyphs of the closed one.
+  {
+    unsigned long first_hits;
+    FPDF_GetGlyphCacheStats(&first_hits, nullptr, nullptr);
+    ASSERT_TRUE(OpenDocument("text_font.pdf"));
+    FPDF_PAGE page = LoadPage(0);
+    ASSERT_TRUE(page);
+    ScopedFPDFBitmap bitmap = RenderLoadedPage(page);
+    EXPECT_EQ(expected_hash, HashBitmap(bitmap.get()));
+    UnloadPage(page);
+    CloseDocument();
+
+    unsigned long hits;
+    unsigned long misses;
+    FPDF_GetGlyphCacheStats(&hits, &misses, nullptr);
+    EXPECT_GT(hits, first_hits);
+    EXPECT_EQ(first_misses, misses);
+  }
+
+  // With a tiny budget, only the last used glyph is kept, and rendering still
+  // gives the same result.
+  FPDF_SetGlyphCacheBudget(1);
+  {
+    ASSERT_TRUE(OpenDocument("text_font.pdf"));
+    FPDF_PAGE page = LoadPage(0);
+    ASSERT_TRUE(page);
+    ScopedFPDFBitmap bitmap = RenderLoadedPage(page);
+    EXPECT_EQ(expected_hash, HashBitmap(bitmap.get()));
+    UnloadPage(page);
+    CloseDocument();
+
+    unsigned long bytes;
+    FPDF_GetGlyphCacheStats(nullptr, nullptr, &bytes);
+    EXPECT_LT(bytes, 64u * 1024u);
+  }
+  FPDF_SetGlyphCacheBudget(32 * 1024 * 1024);
+}
+
+TEST_F(FPDFViewEmbedderTest, ImageCacheBudget) {
+  ASSERT_TRUE(OpenDocument("embedded_images.pdf"));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+
+  unsigned long initial_bytes;
+  FPDF_GetImageCacheStats(nullptr, nullptr, &initial_bytes);
+  std::string expected_hash;
+  unsigned long unlimited_bytes;
+  {
+    ScopedFPDFBitmap bitmap = RenderLoadedPage(page);
+    expected_hash = HashBitmap(bitmap.get());
+    FPDF_GetImageCacheStats(nullptr, nullptr, &unlimited_bytes);
+    EXPECT_GT(unlimited_bytes, initial_bytes);
+  }
+  UnloadPage(page);
+
+  // The images of closed pages are released.
+  unsigned long bytes;
+  FPDF_GetImageCacheStats(nullptr, nullptr, &bytes);
+  EXPECT_EQ(initial_bytes, bytes);
+
+  // With a tiny budget, only the last drawn image is kept, and the others get
+  // decoded again when the page renders again.
+  FPDF_SetImageCacheBudget(1);
+  page = LoadPage(0);
+  ASSERT_TRUE(page);
+  unsigned long first_evictions;
+  unsigned long first_redecodes;
+  FPDF_GetImageCacheStats(&first_evictions, &first_redecodes, nullptr);
+  for (int i = 0; i < 2; ++i) {
+    ScopedFPDFBitmap bitmap = RenderLoadedPage(page);
+    EXPECT_EQ(expected_hash, HashBitmap(bitmap.get()));
+  }
+  unsigned long evictions;
+  unsigned long redecodes;
+  FPDF_GetImageCacheStats(&evictions, &redecodes, &bytes);
+  EXPECT_GT(evictions, first_evictions);
+  EXPECT_GT(redecodes, first_redecodes);
+  EXPECT_LT(bytes, unlimited_bytes);
+  UnloadPage(page);
+  FPDF_SetImageCacheBudget(0);
+}
+
+TEST_F(FPDFViewEmbedderTest, PagePrefetchThreadCount) {
+  for (const char* name : {"embedded_images.pdf", "hebrew_mirrored.pdf"}) {
+    SCOPED_TRACE(name);
+    std::string expected_hash;
+    ASSERT_TRUE(OpenDocument(name));
+    {
+      FPDF_PAGE page = LoadPage(0);
+      ASSERT_TRUE(page);
+      ScopedFPDFBitmap bitmap = RenderLoadedPage(page);
+      expected_hash = HashBitmap(bitmap.get());
+      UnloadPage(page);
+    }
+    CloseDocument();
+
+    // Decoding the page's streams ahead of time does not change the result.
+    FPDF_SetPagePrefetchThreadCount(4);
+    ASSERT_TRUE(OpenDocument(name));
+    {
+      FPDF_PAGE page = LoadPage(0);
+      ASSERT_TRUE(page);
+      ScopedFPDFBitmap bitmap = RenderLoadedPage(page);
+      EXPECT_EQ(expected_hash, HashBitmap(bitmap.get()));
+      UnloadPage(page);
+    }
+    CloseDocument();
+    FPDF_SetPagePrefetchThreadCount(1);
+  }
+}
+
+TEST_F(FPDFViewEmbedderTest, LoadDocumentWithMismatchedCrossRefIndex) {
+  std::string hello_world_path =
+      PathService::GetTestFilePath("hello_world.pdf");
+  ASSERT_FALSE(hello_world_path.empty());
+  std::string rectangles_path = PathService::GetTestFilePath("rectangles.pdf");
+  ASSERT_FALSE(rectangles_path.empty());
+
+  std::vector<uint8_t> index;
+  {
+    ScopedFPDFDocument doc(
+        FPDF_LoadDocument(rectangles_path.c_str(), nullptr));
+    ASSERT_TRUE(doc);
+    index.resize(FPDF_GetCrossRefIndex(doc.get(), nullptr, 0));
+    ASSERT_FALSE(index.empty());
+    FPDF_GetCrossRefIndex(doc.get(), index.data(), index.size());
+  }
+
+  // The index belongs to another file, so it gets ignored.
+  {
+    ScopedFPDFDocument doc(FPDF_LoadDocumentWithCrossRefIndex(
+        hello_world_path.c_str(), nullptr, index.data(), index.size()));
+    ASSERT_TRUE(doc);
+    ScopedFPDFPage page(FPDF_LoadPage(doc.get(), 0));
+    ASSERT_TRUE(page);
+    ScopedFPDFBitmap bitmap = RenderPage(page.get());
+    CompareBitmap(bitmap.get(), 200, 200, pdfium::HelloWorldChecksum());
+  }
+
+  // So does a truncated index.
+  {
+    ScopedFPDFDocument doc(FPDF_LoadDocumentWithCrossRefIndex(
+        rectangles_path.c_str(), nullptr, index.data(), index.size() - 1));
+    ASSERT_TRUE(doc);
+    EXPECT_EQ(1, FPDF_GetPageCount(doc.get()));
+  }
+
+  // And no index at all.
+  {
+    ScopedFPDFDocument doc(FPDF_LoadDocumentWithCrossRefIndex(
+        rectangles_path.c_str(), nullptr, nullptr, 0));
+    ASSERT_TRUE(doc);
+    EXPECT_EQ(1, FPDF_GetPageCount(doc.get()));
+  }
+}
+
 TEST_F(FPDFViewEmbedderTest, DocumentWithNoPageCount) {
   ASSERT_TRUE(OpenDocument("no_page_count.pdf"));
   ASSERT_EQ(6, FPDF_GetPageCount(document()));
@@ -1208,6 +1623,88 @@ TEST_F(FPDFViewEmbedderTest, FPDF_RenderPageBitmapWithMatrix) {
   UnloadPage(page);
 }
 
+TEST_F(FPDFViewEmbedderTest, PageDisplayList) {
+  EXPECT_FALSE(FPDF_BuildPageDisplayList(nullptr));
+  FPDF_ClearPageDisplayList(nullptr);
+
+  auto render_page = [](FPDF_PAGE page, float scale) {
+    int width = static_cast<int>(FPDF_GetPageWidthF(page) * scale);
+    int height = static_cast<int>(FPDF_GetPageHeightF(page) * scale);
+    ScopedFPDFBitmap bitmap(FPDFBitmap_Create(width, height, 0));
+    FPDFBitmap_FillRect(bitmap.get(), 0, 0, width, height, 0xFFFFFFFF);
+    FS_MATRIX matrix{scale, 0, 0, scale, 0, 0};
+    FS_RECTF rect{0, 0, static_cast<float>(width),
+                  static_cast<float>(height)};
+    FPDF_RenderPageBitmapWithMatrix(bitmap.get(), page, &matrix, &rect, 0);
+    return HashBitmap(bitmap.get());
+  };
+
+  for (const char* file : {"hello_world.pdf", "embedded_images.pdf",
+                           "text_form_multiple.pdf"}) {
+    SCOPED_TRACE(file);
+    ASSERT_TRUE(OpenDocument(file));
+    FPDF_PAGE page = LoadPage(0);
+    ASSERT_TRUE(page);
+
+    const std::string expected_1x = render_page(page, 1.0f);
+    const std::string expected_3x = render_page(page, 3.0f);
+
+    // Rendering with the display list looks the same, also at scales other
+    // than the one rendered first.
+    EXPECT_TRUE(FPDF_BuildPageDisplayList(page));
+    EXPECT_EQ(expected_3x, render_page(page, 3.0f));
+    EXPECT_EQ(expected_1x, render_page(page, 1.0f));
+    EXPECT_EQ(expected_3x, render_page(page, 3.0f));
+
+    // Building it again replaces it.
+    EXPECT_TRUE(FPDF_BuildPageDisplayList(page));
+    EXPECT_EQ(expected_1x, render_page(page, 1.0f));
+
+    FPDF_ClearPageDisplayList(page);
+    EXPECT_EQ(expected_1x, render_page(page, 1.0f));
+
+    UnloadPage(page);
+    CloseDocument();
+  }
+}
+
+TEST_F(FPDFViewEmbedderTest, PageDisplayListWithChangedText) {
+  ASSERT_TRUE(OpenDocument("hello_world.pdf"));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+
+  ASSERT_TRUE(FPDF_BuildPageDisplayList(page));
+  FPDF_PAGEOBJECT text_obj = FPDFPage_GetObject(page, 0);
+  ASSERT_EQ(FPDF_PAGEOBJ_TEXT, FPDFPageObj_GetType(text_obj));
+  ScopedFPDFWideString text = GetFPDFWideString(L"Changed");
+  ASSERT_TRUE(FPDFText_SetText(text_obj, text.get()));
+
+  // The display list does not use what it has for the changed text.
+  ScopedFPDFBitmap with_display_list = RenderLoadedPage(page);
+  FPDF_ClearPageDisplayList(page);
+  ScopedFPDFBitmap without_display_list = RenderLoadedPage(page);
+  EXPECT_EQ(HashBitmap(without_display_list.get()),
+            HashBitmap(with_display_list.get()));
+
+  // Generating the content leaves the changed text clean, and drops the
+  // display list, so that it does not get the old glyphs back.
+  ASSERT_TRUE(FPDF_BuildPageDisplayList(page));
+  ScopedFPDFWideString new_text = GetFPDFWideString(L"Changed again");
+  ASSERT_TRUE(FPDFText_SetText(text_obj, new_text.get()));
+  ASSERT_TRUE(FPDFPage_GenerateContent(page));
+  ScopedFPDFBitmap after_generate = RenderLoadedPage(page);
+  FPDF_ClearPageDisplayList(page);
+  ScopedFPDFBitmap expected = RenderLoadedPage(page);
+  EXPECT_EQ(HashBitmap(expected.get()), HashBitmap(after_generate.get()));
+
+  // A display list built from the generated content gives the same output.
+  ASSERT_TRUE(FPDF_BuildPageDisplayList(page));
+  ScopedFPDFBitmap rebuilt = RenderLoadedPage(page);
+  EXPECT_EQ(HashBitmap(expected.get()), HashBitmap(rebuilt.get()));
+
+  UnloadPage(page);
+}
+
 TEST_F(FPDFViewEmbedderTest, FPDF_GetPageSizeByIndexF) {
   ASSERT_TRUE(OpenDocument("rectangles.pdf"));
 
@@ -1958,6 +2455,50 @@ TEST_F(FPDFViewEmbedderTest, ImageMask) {
 }
 #endif  // BUILDFLAG(IS_WIN)
 
+TEST_F(FPDFViewEmbedderTest, JpegDecodedForDrawnSize) {
+  // The page shows a 64x32 JPEG image of alternating black and white 1 pixel
+  // wide columns.
+  ASSERT_TRUE(OpenDocument("jpeg_stripes.pdf"));
+  FPDF_PAGE page = LoadPage(0);
+  ASSERT_TRUE(page);
+
+  auto render_page = [page](float scale, int width, int height) {
+    ScopedFPDFBitmap bitmap(FPDFBitmap_Create(width, height, 0));
+    FPDFBitmap_FillRect(bitmap.get(), 0, 0, width, height, 0xFFFFFFFF);
+    const FS_MATRIX matrix{scale, 0, 0, scale, 0, 0};
+    const FS_RECTF rect{0, 0, static_cast<float>(width),
+                        static_cast<float>(height)};
+    FPDF_RenderPageBitmapWithMatrix(bitmap.get(), page, &matrix, &rect, 0);
+    return bitmap;
+  };
+  auto get_gray = [](FPDF_BITMAP bitmap, int x, int y) {
+    const uint8_t* buffer =
+        static_cast<const uint8_t*>(FPDFBitmap_GetBuffer(bitmap));
+    return buffer[y * FPDFBitmap_GetStride(bitmap) + x * 4];
+  };
+
+  {
+    // Drawn at 1/8 of its size, the image may get decoded at 1/8 of its size,
+    // and the columns blend into gray.
+    ScopedFPDFBitmap bitmap = render_page(0.125f, 8, 4);
+    for (int y = 0; y < 4; ++y) {
+      for (int x = 0; x < 8; ++x)
+        EXPECT_NEAR(128, get_gray(bitmap.get(), x, y), 32) << x << "," << y;
+    }
+  }
+  {
+    // Zoomed in 8 times, the image is drawn much larger than the bitmap, which
+    // shows its two leftmost columns. Those must stay black and white.
+    ScopedFPDFBitmap bitmap = render_page(8.0f, 16, 16);
+    for (int y = 0; y < 16; ++y) {
+      EXPECT_LT(get_gray(bitmap.get(), 3, y), 64) << y;
+      EXPECT_GT(get_gray(bitmap.get(), 11, y), 192) << y;
+    }
+  }
+
+  UnloadPage(page);
+}
+
 TEST_F(FPDFViewEmbedderTest, GetTrailerEnds) {
   ASSERT_TRUE(OpenDocument("two_signatures.pdf"));
 
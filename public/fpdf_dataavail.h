@@ -158,6 +158,32 @@ FPDF_EXPORT int FPDF_CALLCONV FPDFAvail_IsPageAvail(FPDF_AVAIL avail,
                                                     int page_index,
                                                     FX_DOWNLOADHINTS* hints);
 
+// Experimental API.
+// Request all of the data that |page_index| needs at once.
+//
+//   avail      - handle to document availability provider.
+//   page_index - index number of the page. Zero for the first page.
+//   hints      - pointer to a download hints interface. Populated with all of
+//                the missing data of |page_index|, sorted by offset, with
+//                overlapping and adjacent ranges merged.
+//
+// Returns one of:
+//   PDF_DATA_ERROR: The document is not linearized or has no usable hint
+//                   tables, or |page_index| is out of range.
+//   PDF_DATA_NOTAVAIL: Data not yet available.
+//   PDF_DATA_AVAIL: Data available.
+//
+// This function can be called only after FPDFAvail_GetDocument() is called.
+// FPDFAvail_IsPageAvail() requests data piece by piece as it finds it missing,
+// which can take many round trips for one page. Applications can call this
+// function first to fetch the page in one round trip, and then call
+// FPDFAvail_IsPageAvail() as usual, which still has to return |PDF_DATA_AVAIL|
+// before the page can be loaded.
+FPDF_EXPORT int FPDF_CALLCONV
+FPDFAvail_RequestPageData(FPDF_AVAIL avail,
+                          int page_index,
+                          FX_DOWNLOADHINTS* hints);
+
 // Check if form data is ready for initialization, if not, get the
 // |FX_DOWNLOADHINTS|.
 //
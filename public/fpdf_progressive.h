@@ -46,6 +46,33 @@ typedef struct _IFSDK_PAUSE {
   void* user;
 } IFSDK_PAUSE;
 
+// Experimental API.
+// Function: FPDF_LoadPageForProgressiveRender
+//          Load a page without parsing its content up front. The progressive
+//          rendering functions then parse the content while drawing it, so
+//          the first page objects get drawn before the rest is parsed.
+// Parameters:
+//          document     -   Handle to the document, as returned by
+//                           FPDF_LoadDocument() or similar.
+//          page_index   -   Index number of the page. 0 for the first page.
+//          visible_rect -   If not NULL, the area of the page, in page
+//                           coordinates, that is going to be rendered. Page
+//                           objects entirely outside of it do not get
+//                           created.
+// Return value:
+//          A handle to the loaded page, or NULL on failure. Close it with
+//          FPDF_ClosePage().
+// Comments:
+//          Functions that need all of the page objects, such as
+//          FPDFPage_CountObjects(), finish parsing the page first. With a
+//          |visible_rect|, the page never has the objects outside of it, so
+//          FPDFText_LoadPage(), FPDFPage_GenerateContent() and
+//          FPDF_BuildPageDisplayList() fail on it.
+FPDF_EXPORT FPDF_PAGE FPDF_CALLCONV
+FPDF_LoadPageForProgressiveRender(FPDF_DOCUMENT document,
+                                  int page_index,
+                                  const FS_RECTF* visible_rect);
+
 // Experimental API.
 // Function: FPDF_RenderPageBitmapWithColorScheme_Start
 //          Start to render page contents to a device independent bitmap
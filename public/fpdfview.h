@@ -388,6 +388,208 @@ FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDF_SetPrintMode(int mode);
 FPDF_EXPORT FPDF_DOCUMENT FPDF_CALLCONV
 FPDF_LoadDocument(FPDF_STRING file_path, FPDF_BYTESTRING password);
 
+// Experimental API.
+// Function: FPDF_LoadMappedDocument
+//          Open and load a PDF document by mapping the file into memory.
+// Parameters:
+//          file_path -  Path to the PDF file (including extension).
+//          password  -  A string used as the password for the PDF file.
+//                       If no password is needed, empty or NULL can be used.
+// Return value:
+//          A handle to the loaded document, or NULL on failure.
+// Comments:
+//          Behaves like FPDF_LoadDocument(), except that the file is mapped
+//          read-only into memory, and raw stream data is referenced in place
+//          instead of being copied. The file must not be modified while the
+//          document is open.
+//
+//          On platforms where the file cannot be mapped, this function falls
+//          back to FPDF_LoadDocument().
+//
+//          See the comments for FPDF_LoadDocument() regarding the encoding for
+//          |file_path| and |password|.
+FPDF_EXPORT FPDF_DOCUMENT FPDF_CALLCONV
+FPDF_LoadMappedDocument(FPDF_STRING file_path, FPDF_BYTESTRING password);
+
+// Experimental API.
+// Function: FPDF_SetRebuildCrossRefThreadCount
+//          Set how many threads may be used to rebuild the cross-reference
+//          table of a damaged document.
+// Parameters:
+//          count   -   The maximum number of threads, including the calling
+//                      thread. Values less than 1 are treated as 1, which is
+//                      also the default.
+// Return value:
+//          None.
+// Comments:
+//          The setting applies to the whole process. It only has an effect on
+//          documents loaded with FPDF_LoadMappedDocument() on platforms where
+//          the file could be mapped; documents loaded any other way are always
+//          rebuilt on the calling thread. The rebuilt table is the same
+//          regardless of the thread count.
+//
+//          Must not be called while a document is being loaded.
+FPDF_EXPORT void FPDF_CALLCONV FPDF_SetRebuildCrossRefThreadCount(int count);
+
+// Experimental API.
+// Function: FPDF_SetPagePrefetchThreadCount
+//          Set how many threads may be used to decode the streams of a page
+//          when it gets loaded.
+// Parameters:
+//          count   -   The maximum number of threads, including the calling
+//                      thread. Values less than 1 are treated as 1, which is
+//                      also the default, and means streams get decoded one at a
+//                      time as they are needed.
+// Return value:
+//          None.
+// Comments:
+//          The setting applies to the whole process. With more than one
+//          thread, loading a page first decodes its content streams, and the
+//          compressed streams of the images, forms and embedded fonts in its
+//          resources, at the same time. Decoded images are kept until they are
+//          rendered, or until the next page of the document is loaded.
+//
+//          Must not be called while a page is being loaded.
+FPDF_EXPORT void FPDF_CALLCONV FPDF_SetPagePrefetchThreadCount(int count);
+
+// Experimental API.
+// Function: FPDF_SetObjectArenaEnabled
+//          Set whether documents allocate the objects parsed from their files
+//          from a per-document arena.
+// Parameters:
+//          enabled -   Whether to use an arena. The default is false.
+// Return value:
+//          None.
+// Comments:
+//          The setting applies to the whole process, and to documents loaded
+//          or created afterwards. An arena makes loading and closing documents
+//          with many objects faster, but memory of parsed objects that are
+//          replaced while editing is only released together with that of the
+//          objects parsed around them, at the latest when the document closes.
+FPDF_EXPORT void FPDF_CALLCONV FPDF_SetObjectArenaEnabled(FPDF_BOOL enabled);
+
+// Experimental API.
+// Function: FPDF_SetObjectStreamCacheBudget
+//          Set how much memory each document may use to keep decoded object
+//          streams.
+// Parameters:
+//          bytes   -   The budget in bytes. 0, the default, means no limit.
+// Return value:
+//          None.
+// Comments:
+//          The setting applies to the whole process, and to documents loaded
+//          afterwards. When decoded object streams exceed the budget, the least
+//          recently used ones are released, and get decoded again if more
+//          objects are needed from them. The most recently used object stream
+//          is always kept.
+FPDF_EXPORT void FPDF_CALLCONV
+FPDF_SetObjectStreamCacheBudget(unsigned long bytes);
+
+// Experimental API.
+// Function: FPDF_SetGlyphCacheBudget
+//          Set how much memory may be used to keep rendered glyphs.
+// Parameters:
+//          bytes   -   The budget in bytes. 0 means no limit. The default is
+//                      32 MB.
+// Return value:
+//          None.
+// Comments:
+//          Must be called after FPDF_InitLibrary(). Glyphs of embedded fonts
+//          are kept for the whole process, keyed by the font program, so that
+//          documents embedding the same fonts share them, also after the
+//          documents that rendered them are closed. When the glyphs exceed the
+//          budget, the least recently used ones are released.
+FPDF_EXPORT void FPDF_CALLCONV FPDF_SetGlyphCacheBudget(unsigned long bytes);
+
+// Experimental API.
+// Function: FPDF_GetGlyphCacheStats
+//          Get how often rendered glyphs were reused from the glyph cache.
+// Parameters:
+//          hits        -   Receives how often a cached glyph was reused. May
+//                          be NULL.
+//          misses      -   Receives how often a glyph had to be rendered. May
+//                          be NULL.
+//          bytes       -   Receives how much memory the cached glyphs use.
+//                          May be NULL.
+// Return value:
+//          None.
+// Comments:
+//          Must be called after FPDF_InitLibrary(). The statistics cover the
+//          whole process. See FPDF_SetGlyphCacheBudget().
+FPDF_EXPORT void FPDF_CALLCONV FPDF_GetGlyphCacheStats(unsigned long* hits,
+                                                       unsigned long* misses,
+                                                       unsigned long* bytes);
+
+// Experimental API.
+// Function: FPDF_SetImageCacheBudget
+//          Set how much memory the decoded images of all pages may use.
+// Parameters:
+//          bytes   -   The budget in bytes. 0, the default, means no limit.
+// Return value:
+//          None.
+// Comments:
+//          The budget is shared by all pages of all documents. When the
+//          decoded images exceed it, the least recently drawn ones are
+//          released, and get decoded again when drawn again. The image that
+//          is being drawn is always kept. This applies in addition to the
+//          per-page limit that rendering with FPDF_RENDER_LIMITEDIMAGECACHE
+//          sets.
+FPDF_EXPORT void FPDF_CALLCONV FPDF_SetImageCacheBudget(unsigned long bytes);
+
+// Experimental API.
+// Function: FPDF_GetImageCacheStats
+//          Get how often the image cache budget released decoded images.
+// Parameters:
+//          evictions   -   Receives how often a decoded image was released to
+//                          stay within the budget. May be NULL.
+//          redecodes   -   Receives how often a released image had to be
+//                          decoded again. May be NULL.
+//          bytes       -   Receives how much memory the decoded images of all
+//                          pages use. May be NULL.
+// Return value:
+//          None.
+// Comments:
+//          The statistics cover the whole process. See
+//          FPDF_SetImageCacheBudget().
+FPDF_EXPORT void FPDF_CALLCONV
+FPDF_GetImageCacheStats(unsigned long* evictions,
+                        unsigned long* redecodes,
+                        unsigned long* bytes);
+
+// Experimental API.
+// Function: FPDF_LoadDocumentWithCrossRefIndex
+//          Open and load a PDF document, using a cross-reference index
+//          obtained from FPDF_GetCrossRefIndex() to skip parsing the
+//          document's cross-reference sections.
+// Parameters:
+//          file_path   -   Path to the PDF file (including extension).
+//          password    -   A string used as the password for the PDF file.
+//                          If no password is needed, empty or NULL can be
+//                          used.
+//          index       -   Pointer to the index data.
+//          index_size  -   Size of the index data in bytes.
+// Return value:
+//          A handle to the loaded document, or NULL on failure.
+// Comments:
+//          The index is only used if it was created for a file of the same
+//          size whose last kilobyte, which holds the trailer with the file ID,
+//          is identical. Otherwise, including when the index is malformed or
+//          NULL, the document is loaded like FPDF_LoadDocument() would.
+//
+//          The index is trusted beyond that check, so it must have been
+//          created for this very file, and the file must not have been
+//          modified in place since.
+//
+//          The index data is not used after this function returns.
+//
+//          See the comments for FPDF_LoadDocument() regarding the encoding for
+//          |file_path| and |password|.
+FPDF_EXPORT FPDF_DOCUMENT FPDF_CALLCONV
+FPDF_LoadDocumentWithCrossRefIndex(FPDF_STRING file_path,
+                                   FPDF_BYTESTRING password,
+                                   const void* index,
+                                   unsigned long index_size);
+
 // Function: FPDF_LoadMemDocument
 //          Open and load a PDF document from memory.
 // Parameters:
@@ -580,6 +782,86 @@ typedef struct FPDF_FILEHANDLER_ {
 FPDF_EXPORT FPDF_DOCUMENT FPDF_CALLCONV
 FPDF_LoadCustomDocument(FPDF_FILEACCESS* pFileAccess, FPDF_BYTESTRING password);
 
+// Experimental API.
+// Function: FPDF_GetCrossRefIndex
+//          Get an index of the document's cross-reference table and object
+//          streams for FPDF_LoadDocumentWithCrossRefIndex().
+// Parameters:
+//          document    -   Handle to a document.
+//          buffer      -   A buffer for the index. May be NULL.
+//          buflen      -   The length of |buffer| in bytes.
+// Return value:
+//          The size of the index in bytes, or 0 on failure, e.g. if
+//          |document| was created with FPDF_CreateNewDocument(), or is a
+//          linearized document loaded with FPDFAvail_GetDocument().
+// Comments:
+//          |buffer| is only modified if |buflen| is at least the size of the
+//          index. Call this function with |buffer| set to NULL to get the
+//          size first.
+//
+//          The index covers the document as it was loaded, not any changes
+//          made since. Creating it loads all of the document's object streams.
+FPDF_EXPORT unsigned long FPDF_CALLCONV
+FPDF_GetCrossRefIndex(FPDF_DOCUMENT document,
+                      void* buffer,
+                      unsigned long buflen);
+
+// Experimental API.
+// Function: FPDF_GetObjectStreamCacheStats
+//          Get how often objects were loaded from already decoded object
+//          streams.
+// Parameters:
+//          document    -   Handle to a document.
+//          hits        -   Receives how often a decoded object stream was
+//                          reused. May be NULL.
+//          misses      -   Receives how often an object stream had to be
+//                          decoded. May be NULL.
+// Return value:
+//          True on success, false if |document| was not loaded from a file.
+// Comments:
+//          See FPDF_SetObjectStreamCacheBudget().
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_GetObjectStreamCacheStats(FPDF_DOCUMENT document,
+                               unsigned long* hits,
+                               unsigned long* misses);
+
+// Experimental API.
+// Function: FPDF_EnableSharedDocumentAccess
+//          Allow multiple threads to load, render and close pages of a
+//          document at the same time, sharing its parsed objects, fonts and
+//          images instead of loading the document once per thread.
+// Parameters:
+//          document    -   Handle to a document.
+// Return value:
+//          True on success, false if |document| is NULL or an XFA document.
+// Comments:
+//          Must be called before other threads get to use |document|, and
+//          cannot be undone. Afterwards, these functions may be called for
+//          |document| and its pages from any thread, at the same time:
+//
+//            FPDF_GetPageCount()
+//            FPDF_GetPageSizeByIndex()
+//            FPDF_GetPageSizeByIndexF()
+//            FPDF_LoadPage()
+//            FPDF_ClosePage()
+//            FPDF_RenderPage()
+//            FPDF_RenderPageBitmap()
+//            FPDF_RenderPageBitmapWithMatrix()
+//
+//          as well as functions that only read the size or bounds of a
+//          loaded page. Each page must only be used by one thread at a time.
+//          Other functions, including all functions that modify the
+//          document, must not be called while other threads use it.
+//
+//          These functions take a lock of |document|, so calls for the same
+//          document run one at a time. Calls for different shared documents
+//          run in parallel, except while loading or drawing text, as fonts
+//          and glyphs are cached for the whole process behind a single lock.
+//          Documents that are not shared must still only be used by one
+//          thread at a time, and not while a shared document is in use.
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_EnableSharedDocumentAccess(FPDF_DOCUMENT document);
+
 // Function: FPDF_GetFileVersion
 //          Get the file version of the given PDF document.
 // Parameters:
@@ -935,6 +1217,36 @@ FPDF_RenderPageBitmapWithMatrix(FPDF_BITMAP bitmap,
                                 const FS_RECTF* clipping,
                                 int flags);
 
+// Experimental API.
+// Function: FPDF_BuildPageDisplayList
+//          Prepare a page to be rendered many times, e.g. at different zoom
+//          levels or in tiles. This does the work of rendering that does not
+//          depend on the output once: it resolves the glyphs of all the text
+//          on the page and decodes its images. The rendering functions above
+//          then reuse this work, and produce the same output as before.
+// Parameters:
+//          page        -   Handle to the page. Returned by FPDF_LoadPage.
+// Return value:
+//          True on success. A display list that already exists gets replaced.
+//          False for pages from FPDF_LoadPageForProgressiveRender() with a
+//          visible rect, which lack the objects outside of it.
+// Comments:
+//          If page objects change afterwards, their text gets resolved again
+//          when rendering, but call this function again to keep the benefit.
+//          FPDFPage_GenerateContent() releases the display list. The display
+//          list uses memory until the page is closed or
+//          FPDF_ClearPageDisplayList() is called.
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDF_BuildPageDisplayList(FPDF_PAGE page);
+
+// Experimental API.
+// Function: FPDF_ClearPageDisplayList
+//          Release the display list built by FPDF_BuildPageDisplayList().
+// Parameters:
+//          page        -   Handle to the page. Returned by FPDF_LoadPage.
+// Return value:
+//          None.
+FPDF_EXPORT void FPDF_CALLCONV FPDF_ClearPageDisplayList(FPDF_PAGE page);
+
 #if defined(PDF_USE_SKIA)
 // Experimental API.
 // Function: FPDF_RenderPageSkia
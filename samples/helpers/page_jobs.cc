@@ -0,0 +1,182 @@
+// Copyright 2024 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "samples/helpers/page_jobs.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <new>
+#include <vector>
+
+#include "third_party/base/check_op.h"
+
+namespace {
+
+static_assert(std::atomic<int>::is_always_lock_free,
+              "Page queues are shared between processes");
+
+size_t GetQueuesSize(size_t file_count) {
+  return std::max<size_t>(file_count, 1) * sizeof(std::atomic<int>);
+}
+
+// Returns the value at `percentile` in `sorted_values`, by the nearest-rank
+// method.
+double GetPercentile(const std::vector<double>& sorted_values,
+                     int percentile) {
+  size_t rank = (sorted_values.size() * percentile + 99) / 100;
+  return sorted_values[std::max<size_t>(rank, 1) - 1];
+}
+
+// Reads the page times that the workers write to `fd` until all of them
+// closed it.
+std::vector<double> ReadPageTimes(int fd) {
+  std::vector<double> page_times;
+  std::vector<char> pending;
+  char buffer[4096];
+  while (true) {
+    ssize_t bytes_read = read(fd, buffer, sizeof(buffer));
+    if (bytes_read < 0 && errno == EINTR)
+      continue;
+    if (bytes_read <= 0)
+      break;
+
+    pending.insert(pending.end(), buffer, buffer + bytes_read);
+    size_t record_count = pending.size() / sizeof(double);
+    for (size_t i = 0; i < record_count; ++i) {
+      double seconds;
+      memcpy(&seconds, pending.data() + i * sizeof(double), sizeof(double));
+      page_times.push_back(seconds);
+    }
+    pending.erase(pending.begin(),
+                  pending.begin() + record_count * sizeof(double));
+  }
+  return page_times;
+}
+
+long GetPeakChildRssKiB() {
+  rusage usage = {};
+  if (getrusage(RUSAGE_CHILDREN, &usage) != 0)
+    return 0;
+#if defined(__APPLE__)
+  return usage.ru_maxrss / 1024;  // Bytes on macOS.
+#else
+  return usage.ru_maxrss;
+#endif
+}
+
+}  // namespace
+
+// static
+std::unique_ptr<PageJobs> PageJobs::ForkWorkers(int job_count,
+                                                size_t file_count,
+                                                int* exit_code) {
+  DCHECK_GT(job_count, 0);
+  *exit_code = 1;
+
+  void* queues = mmap(nullptr, GetQueuesSize(file_count),
+                      PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS,
+                      -1, 0);
+  if (queues == MAP_FAILED) {
+    perror("mmap");
+    return nullptr;
+  }
+  auto* next_pages = static_cast<std::atomic<int>*>(queues);
+  for (size_t i = 0; i < std::max<size_t>(file_count, 1); ++i)
+    new (&next_pages[i]) std::atomic<int>(0);
+
+  int fds[2];
+  if (pipe(fds) != 0) {
+    perror("pipe");
+    munmap(queues, GetQueuesSize(file_count));
+    return nullptr;
+  }
+
+  // Do not let the workers write out what is still buffered here.
+  fflush(nullptr);
+
+  const auto start_time = std::chrono::steady_clock::now();
+  std::vector<pid_t> workers;
+  for (int i = 0; i < job_count; ++i) {
+    pid_t pid = fork();
+    if (pid == 0) {
+      close(fds[0]);
+      return std::unique_ptr<PageJobs>(
+          new PageJobs(next_pages, file_count, fds[1]));
+    }
+    if (pid < 0) {
+      perror("fork");
+      break;
+    }
+    workers.push_back(pid);
+  }
+  close(fds[1]);
+
+  std::vector<double> page_times = ReadPageTimes(fds[0]);
+  close(fds[0]);
+
+  bool workers_succeeded = !workers.empty();
+  for (pid_t pid : workers) {
+    int status = 0;
+    while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+    }
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+      workers_succeeded = false;
+  }
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start_time;
+  munmap(queues, GetQueuesSize(file_count));
+
+  fprintf(stderr, "Processed %zu pages with %zu jobs in %.3f s: %.1f pages/s",
+          page_times.size(), workers.size(), elapsed.count(),
+          page_times.size() / elapsed.count());
+  if (!page_times.empty()) {
+    std::sort(page_times.begin(), page_times.end());
+    fprintf(stderr, ", p50 %.2f ms, p99 %.2f ms",
+            GetPercentile(page_times, 50) * 1000,
+            GetPercentile(page_times, 99) * 1000);
+  }
+  fprintf(stderr, ", peak RSS per job %ld KiB\n", GetPeakChildRssKiB());
+
+  *exit_code = workers_succeeded ? 0 : 1;
+  return nullptr;
+}
+
+PageJobs::PageJobs(std::atomic<int>* next_pages,
+                   size_t file_count,
+                   int report_fd)
+    : next_pages_(next_pages), file_count_(file_count), report_fd_(report_fd) {}
+
+PageJobs::~PageJobs() {
+  close(report_fd_);
+  munmap(next_pages_, GetQueuesSize(file_count_));
+}
+
+void PageJobs::StartFile() {
+  if (started_)
+    ++file_index_;
+  started_ = true;
+  CHECK_LT(file_index_, file_count_);
+}
+
+int PageJobs::TakePage(int first_page) {
+  DCHECK(started_);
+  return first_page + next_pages_[file_index_].fetch_add(1);
+}
+
+void PageJobs::AddPageTime(double seconds) {
+  // Writes of up to PIPE_BUF bytes are atomic, so records from different
+  // workers do not interleave.
+  [[maybe_unused]] ssize_t written =
+      write(report_fd_, &seconds, sizeof(seconds));
+  DCHECK_EQ(written, static_cast<ssize_t>(sizeof(seconds)));
+}
@@ -0,0 +1,54 @@
+// Copyright 2024 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SAMPLES_HELPERS_PAGE_JOBS_H_
+#define SAMPLES_HELPERS_PAGE_JOBS_H_
+
+#include <stddef.h>
+
+#include <atomic>
+#include <memory>
+
+// Spreads the pages of the input files over worker processes. Every worker
+// loads each input file itself, and takes pages to render from a queue per
+// file that is shared by all workers. The original process only waits for the
+// workers and reports the throughput, the page latencies and the peak memory
+// use.
+//
+// Worker processes are used instead of threads, as PDFium must only be used
+// from one thread at a time.
+class PageJobs {
+ public:
+  // Forks `job_count` workers, which will process `file_count` input files.
+  // Returns the PageJobs to use in each worker. In the original process, waits
+  // for all workers to exit, prints a report to stderr, sets `exit_code` and
+  // returns nullptr.
+  static std::unique_ptr<PageJobs> ForkWorkers(int job_count,
+                                               size_t file_count,
+                                               int* exit_code);
+
+  ~PageJobs();
+
+  // Moves on to the next input file. Every worker must call this for the same
+  // files in the same order.
+  void StartFile();
+
+  // Returns the next page of the current file that no worker took yet,
+  // counting from `first_page`.
+  int TakePage(int first_page);
+
+  // Records that rendering a page took `seconds`.
+  void AddPageTime(double seconds);
+
+ private:
+  PageJobs(std::atomic<int>* next_pages, size_t file_count, int report_fd);
+
+  std::atomic<int>* const next_pages_;
+  const size_t file_count_;
+  const int report_fd_;
+  size_t file_index_ = 0;
+  bool started_ = false;
+};
+
+#endif  // SAMPLES_HELPERS_PAGE_JOBS_H_
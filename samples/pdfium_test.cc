@@ -10,6 +10,7 @@
 #include <string.h>
 
 #include <algorithm>
+#include <chrono>
 #include <functional>
 #include <iterator>
 #include <map>
@@ -57,6 +58,8 @@
 #include "third_party/base/win/scoped_select_object.h"
 #else
 #include <unistd.h>
+
+#include "samples/helpers/page_jobs.h"
 #endif  // _WIN32
 
 #ifdef ENABLE_CALLGRIND
@@ -155,6 +158,8 @@ struct Options {
   bool show_metadata = false;
   bool send_events = false;
   bool use_load_mem_document = false;
+  bool use_load_mapped_document = false;
+  bool use_object_arena = false;
   bool render_oneshot = false;
   bool lcd_text = false;
   bool no_nativetext = false;
@@ -199,6 +204,11 @@ struct Options {
   std::string font_directory;
   int first_page = 0;  // First 0-based page number to renderer.
   int last_page = 0;   // Last 0-based page number to renderer.
+  int rebuild_xref_threads = 0;
+  int object_stream_cache_budget = -1;
+  int glyph_cache_budget = -1;
+  int image_cache_budget = -1;
+  int jobs = 0;
   time_t time = -1;
 };
 
@@ -471,6 +481,10 @@ bool ParseCommandLine(const std::vector<std::string>& args,
       options->send_events = true;
     } else if (cur_arg == "--mem-document") {
       options->use_load_mem_document = true;
+    } else if (cur_arg == "--mapped-document") {
+      options->use_load_mapped_document = true;
+    } else if (cur_arg == "--object-arena") {
+      options->use_object_arena = true;
     } else if (cur_arg == "--render-oneshot") {
       options->render_oneshot = true;
     } else if (cur_arg == "--lcd-text") {
@@ -726,6 +740,70 @@ bool ParseCommandLine(const std::vector<std::string>& args,
         fprintf(stderr, "Invalid --time argument, must be non-negative\n");
         return false;
       }
+    } else if (ParseSwitchKeyValue(cur_arg, "--rebuild-xref-threads=",
+                                   &value)) {
+      if (options->rebuild_xref_threads > 0) {
+        fprintf(stderr, "Duplicate --rebuild-xref-threads argument\n");
+        return false;
+      }
+      const std::string threads_string = value;
+      std::stringstream(threads_string) >> options->rebuild_xref_threads;
+      if (options->rebuild_xref_threads < 1) {
+        fprintf(stderr,
+                "Invalid --rebuild-xref-threads argument, must be positive\n");
+        return false;
+      }
+    } else if (ParseSwitchKeyValue(cur_arg, "--object-stream-cache=",
+                                   &value)) {
+      if (options->object_stream_cache_budget > -1) {
+        fprintf(stderr, "Duplicate --object-stream-cache argument\n");
+        return false;
+      }
+      const std::string budget_string = value;
+      std::stringstream(budget_string) >> options->object_stream_cache_budget;
+      if (options->object_stream_cache_budget < 0) {
+        fprintf(stderr,
+                "Invalid --object-stream-cache argument, must be "
+                "non-negative\n");
+        return false;
+      }
+    } else if (ParseSwitchKeyValue(cur_arg, "--glyph-cache=", &value)) {
+      if (options->glyph_cache_budget > -1) {
+        fprintf(stderr, "Duplicate --glyph-cache argument\n");
+        return false;
+      }
+      const std::string budget_string = value;
+      std::stringstream(budget_string) >> options->glyph_cache_budget;
+      if (options->glyph_cache_budget < 0) {
+        fprintf(stderr,
+                "Invalid --glyph-cache argument, must be non-negative\n");
+        return false;
+      }
+    } else if (ParseSwitchKeyValue(cur_arg, "--image-cache=", &value)) {
+      if (options->image_cache_budget > -1) {
+        fprintf(stderr, "Duplicate --image-cache argument\n");
+        return false;
+      }
+      const std::string budget_string = value;
+      std::stringstream(budget_string) >> options->image_cache_budget;
+      if (options->image_cache_budget < 0) {
+        fprintf(stderr,
+                "Invalid --image-cache argument, must be non-negative\n");
+        return false;
+      }
+#ifndef _WIN32
+    } else if (ParseSwitchKeyValue(cur_arg, "--jobs=", &value)) {
+      if (options->jobs > 0) {
+        fprintf(stderr, "Duplicate --jobs argument\n");
+        return false;
+      }
+      const std::string jobs_string = value;
+      std::stringstream(jobs_string) >> options->jobs;
+      if (options->jobs < 1) {
+        fprintf(stderr, "Invalid --jobs argument, must be positive\n");
+        return false;
+      }
+#endif  // _WIN32
     } else if (cur_arg.size() >= 2 && cur_arg[0] == '-' && cur_arg[1] == '-') {
       fprintf(stderr, "Unrecognized argument %s\n", cur_arg.c_str());
       return false;
@@ -825,14 +903,41 @@ class Processor final {
   // Invokes `idler()`.
   void Idle() const { idler()(); }
 
+#ifndef _WIN32
+  // With --jobs, pages are taken from `page_jobs` instead of processing them
+  // all.
+  void set_page_jobs(PageJobs* page_jobs) { page_jobs_ = page_jobs; }
+#endif  // _WIN32
+
   void ProcessPdf(const std::string& name,
                   pdfium::span<const uint8_t> data,
                   const std::string& events);
 
  private:
+  // Returns the page to process after `page_index`, where the pages to
+  // process start at `first_page`.
+  int GetNextPage(int first_page, int page_index) {
+#ifndef _WIN32
+    if (page_jobs_)
+      return page_jobs_->TakePage(first_page);
+#endif  // _WIN32
+    return page_index + 1;
+  }
+
+  void AddPageTime(std::chrono::duration<double> page_time) {
+#ifndef _WIN32
+    if (page_jobs_)
+      page_jobs_->AddPageTime(page_time.count());
+#endif  // _WIN32
+  }
+
   const Options* options_;
   const std::function<void()>* idler_;
 
+#ifndef _WIN32
+  PageJobs* page_jobs_ = nullptr;
+#endif  // _WIN32
+
 #ifdef _WIN32
   ComFactory com_factory_;
 #endif  // _WIN32
@@ -1554,6 +1659,8 @@ void Processor::ProcessPdf(const std::string& name,
   bool is_linearized = false;
   if (options().use_load_mem_document) {
     doc.reset(FPDF_LoadMemDocument(data.data(), data.size(), password));
+  } else if (options().use_load_mapped_document) {
+    doc.reset(FPDF_LoadMappedDocument(name.c_str(), password));
   } else {
     if (FPDFAvail_IsLinearized(pdf_avail.get()) == PDF_LINEARIZED) {
       int avail_status = PDF_DATA_NOTAVAIL;
@@ -1665,7 +1772,8 @@ void Processor::ProcessPdf(const std::string& name,
   int last_page = options().pages ? options().last_page + 1 : page_count;
   PdfProcessor pdf_processor(this, &name, &events, doc.get(), form.get(),
                              &form_callbacks);
-  for (int i = first_page; i < last_page; ++i) {
+  for (int i = GetNextPage(first_page, first_page - 1); i < last_page;
+       i = GetNextPage(first_page, i)) {
     if (is_linearized) {
       int avail_status = PDF_DATA_NOTAVAIL;
       while (avail_status == PDF_DATA_NOTAVAIL)
@@ -1677,7 +1785,10 @@ void Processor::ProcessPdf(const std::string& name,
         return;
       }
     }
-    if (pdf_processor.ProcessPage(i)) {
+    const auto page_start_time = std::chrono::steady_clock::now();
+    const bool processed = pdf_processor.ProcessPage(i);
+    AddPageTime(std::chrono::steady_clock::now() - page_start_time);
+    if (processed) {
       ++processed_pages;
     } else {
       ++bad_pages;
@@ -1731,6 +1842,9 @@ constexpr char kUsageString[] =
     "document\n"
     "  --send-events          - send input described by .evt file\n"
     "  --mem-document         - load document with FPDF_LoadMemDocument()\n"
+    "  --mapped-document      - load document with FPDF_LoadMappedDocument()\n"
+    "  --object-arena         - allocate parsed objects from a per-document "
+    "arena\n"
     "  --render-oneshot       - render image without using progressive "
     "renderer\n"
     "  --lcd-text             - render text optimized for LCD displays\n"
@@ -1815,6 +1929,23 @@ constexpr char kUsageString[] =
 #endif  // PDF_ENABLE_SKIA
     "  --md5   - write output image paths and their md5 hashes to stdout.\n"
     "  --time=<number> - Seconds since the epoch to set system time.\n"
+    "  --rebuild-xref-threads=<number> - threads to use when rebuilding a "
+    "damaged\n"
+    "                    cross-reference table of a --mapped-document\n"
+    "  --object-stream-cache=<bytes> - decoded object streams to keep per "
+    "document,\n"
+    "                    0 for no limit\n"
+    "  --glyph-cache=<bytes> - rendered glyphs to keep across documents, 0 "
+    "for no\n"
+    "                    limit\n"
+    "  --image-cache=<bytes> - decoded images to keep across pages and "
+    "documents,\n"
+    "                    0 for no limit\n"
+#ifndef _WIN32
+    "  --jobs=<number> - render pages in <number> worker processes, and "
+    "report\n"
+    "                    pages/second, page latencies and peak memory use\n"
+#endif  // _WIN32
     "";
 
 void SetUpErrorHandling() {
@@ -1858,6 +1989,18 @@ int main(int argc, const char* argv[]) {
     return 1;
   }
 
+#ifndef _WIN32
+  // Fork before initializing anything, so that every worker sets up its own
+  // copy of PDFium and V8. Only the workers continue from here.
+  std::unique_ptr<PageJobs> page_jobs;
+  if (options.jobs > 0) {
+    int exit_code;
+    page_jobs = PageJobs::ForkWorkers(options.jobs, files.size(), &exit_code);
+    if (!page_jobs)
+      return exit_code;
+  }
+#endif  // _WIN32
+
   FPDF_LIBRARY_CONFIG config;
   config.version = 4;
   config.m_pUserFontPaths = nullptr;
@@ -1948,6 +2091,21 @@ int main(int argc, const char* argv[]) {
 
   FSDK_SetUnSpObjProcessHandler(&unsupported_info);
 
+  if (options.rebuild_xref_threads > 0)
+    FPDF_SetRebuildCrossRefThreadCount(options.rebuild_xref_threads);
+
+  if (options.use_object_arena)
+    FPDF_SetObjectArenaEnabled(true);
+
+  if (options.object_stream_cache_budget > -1)
+    FPDF_SetObjectStreamCacheBudget(options.object_stream_cache_budget);
+
+  if (options.glyph_cache_budget > -1)
+    FPDF_SetGlyphCacheBudget(options.glyph_cache_budget);
+
+  if (options.image_cache_budget > -1)
+    FPDF_SetImageCacheBudget(options.image_cache_budget);
+
   if (options.time > -1) {
     // This must be a static var to avoid explicit capture, so the lambda can be
     // converted to a function ptr.
@@ -1957,6 +2115,9 @@ int main(int argc, const char* argv[]) {
   }
 
   Processor processor(&options, &idler);
+#ifndef _WIN32
+  processor.set_page_jobs(page_jobs.get());
+#endif  // _WIN32
   for (const std::string& filename : files) {
     std::vector<uint8_t> file_contents = GetFileContents(filename.c_str());
     if (file_contents.empty()) {
@@ -1989,6 +2150,10 @@ int main(int argc, const char* argv[]) {
       }
     }
 
+#ifndef _WIN32
+    if (page_jobs)
+      page_jobs->StartFile();
+#endif  // _WIN32
     processor.ProcessPdf(filename, file_contents, events);
 
 #ifdef ENABLE_CALLGRIND
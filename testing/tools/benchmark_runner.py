@@ -0,0 +1,155 @@
+# Copyright 2024 The PDFium Authors
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+"""Times pdfium_test runs for the *_benchmark.py scripts.
+
+Each script generates or finds its PDFs and describes how to run pdfium_test
+on them as a list of Case objects. Runner times every case with the build in
+--build-dir, and when given a --baseline-build-dir, with that build too, and
+checks that both builds produce the same output.
+"""
+
+import os
+import re
+import subprocess
+import time
+
+from common import PrintErr
+
+PDFIUM_TEST = 'pdfium_test'
+
+
+def AddArguments(parser):
+  """Adds the arguments Runner takes to the argparse `parser`."""
+  parser.add_argument(
+      '--build-dir',
+      default=os.path.join('out', 'Release'),
+      help='relative path to the build directory with '
+      '%s' % PDFIUM_TEST)
+  parser.add_argument(
+      '--baseline-build-dir',
+      help='relative path to a build directory with a %s to compare '
+      'against' % PDFIUM_TEST)
+  parser.add_argument(
+      '--runs',
+      type=int,
+      default=3,
+      help='number of runs per case and build, the fastest one is reported')
+
+
+def _FormatSeconds(seconds):
+  return '%.3fs' % seconds
+
+
+class Case:
+  """One pdfium_test command line to time.
+
+  Attributes:
+    label: Name of the case in the results.
+    args: Arguments to time pdfium_test with, including the PDF.
+    md5_args: Arguments to render the pages with once after timing, with
+        '--png' and '--md5' added, to check the output.
+    verify: Used instead of `md5_args` to check the output. Gets called
+        without arguments after timing, and returns whether the output of the
+        last run is right.
+    describe: Turns the fastest time in seconds into the result to print,
+        e.g. a throughput. Defaults to printing the time.
+  """
+
+  def __init__(self, label, args, md5_args=None, verify=None, describe=None):
+    assert (md5_args is None) != (verify is None)
+    self.label = label
+    self.args = args
+    self.md5_args = md5_args
+    self.verify = verify
+    self.describe = describe
+
+
+class Runner:
+  """Times cases with one or two builds."""
+
+  def __init__(self, args):
+    self.runs = args.runs
+    self.pdfium_test_path = os.path.join(args.build_dir, PDFIUM_TEST)
+    self.baseline_pdfium_test_path = None
+    if args.baseline_build_dir:
+      self.baseline_pdfium_test_path = os.path.join(args.baseline_build_dir,
+                                                    PDFIUM_TEST)
+
+  def CheckExecutables(self):
+    """Returns whether the builds have a pdfium_test, and complains if not."""
+    for path in (self.pdfium_test_path, self.baseline_pdfium_test_path):
+      if path and not os.access(path, os.X_OK):
+        PrintErr("FAILURE: Can't run test executable '%s'" % path)
+        PrintErr('Use --build-dir and --baseline-build-dir to specify its '
+                 'location.')
+        return False
+    return True
+
+  def Run(self, cases, print_total=False):
+    """Times all `cases` and prints the results.
+
+    Returns:
+      Exit code for the script.
+    """
+    width = max(len(case.label) for case in cases)
+    total = 0.0
+    baseline_total = 0.0
+    for case in cases:
+      seconds = self._Measure(self.pdfium_test_path, case.args)
+      output = self._GetOutput(self.pdfium_test_path, case)
+      if not output:
+        PrintErr('FAILURE: Wrong or no output for %s' % case.label)
+        return 1
+      total += seconds
+      describe = case.describe or _FormatSeconds
+      if not self.baseline_pdfium_test_path:
+        result = _FormatSeconds(seconds)
+        if case.describe:
+          result += ', ' + case.describe(seconds)
+        print('%-*s best of %d: %s' % (width, case.label, self.runs, result))
+        continue
+
+      baseline_seconds = self._Measure(self.baseline_pdfium_test_path,
+                                       case.args)
+      if output != self._GetOutput(self.baseline_pdfium_test_path, case):
+        PrintErr('FAILURE: Baseline output for %s is wrong or differs' %
+                 case.label)
+        return 1
+      baseline_total += baseline_seconds
+      print('%-*s best of %d: %s, baseline %s (%.2fx)' %
+            (width, case.label, self.runs, describe(seconds),
+             describe(baseline_seconds), baseline_seconds / seconds))
+
+    if print_total:
+      if self.baseline_pdfium_test_path:
+        print('total: %s, baseline %s (%.2fx)' %
+              (_FormatSeconds(total), _FormatSeconds(baseline_total),
+               baseline_total / total))
+      else:
+        print('total: %s' % _FormatSeconds(total))
+    return 0
+
+  def _Measure(self, pdfium_test_path, args):
+    """Returns the fastest wall time to run pdfium_test with `args`."""
+    cmd = [pdfium_test_path] + args
+    best = None
+    for _ in range(self.runs):
+      start = time.perf_counter()
+      subprocess.check_output(cmd, stderr=subprocess.STDOUT)
+      elapsed = time.perf_counter() - start
+      best = elapsed if best is None else min(best, elapsed)
+    return best
+
+  def _GetOutput(self, pdfium_test_path, case):
+    """Returns the md5 of every rendered page, or whether `case.verify` passes.
+
+    Either way, the result is false if the output is missing or wrong.
+    """
+    if case.verify:
+      return case.verify()
+
+    cmd = [pdfium_test_path, '--png', '--md5'] + case.md5_args
+    output = subprocess.check_output(
+        cmd, stderr=subprocess.STDOUT).decode('utf-8')
+    return re.findall(r'^MD5:.*:([0-9a-f]{32})$', output, re.MULTILINE)
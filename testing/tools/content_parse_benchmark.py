@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+# Copyright 2024 The PDFium Authors
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+"""Measures how long pdfium_test takes to parse large content streams.
+
+Generates a PDF whose pages have long content streams with a mix of path,
+text, color and graphics state operators, or takes the given PDFs, and loads
+every page with --show-pageinfo, which parses the page content without
+rendering it. When given a --baseline-build-dir, parses the same files with
+that build too. Either way, the pages are also rendered once per build, and
+must render the same with both builds.
+"""
+
+import argparse
+import os
+import sys
+import tempfile
+
+import benchmark_runner
+
+# One group of operators, repeated to fill the content streams. Uses most
+# operator kinds, including ones with name, string and array operands.
+OPERATOR_GROUP = (b'q 1 0 0 1 %d %d cm 0.5 w [2 1] 0 d 0.2 0.4 0.6 rg '
+                  b'/GS0 gs 0 0 m 10 0 l 10 10 l 0 10 l h f 0 0 10 10 re S '
+                  b'0 0 5 5 re W n 1 0 0 RG 0 0 m 3 7 6 7 9 0 c S Q '
+                  b'BT /F1 6 Tf 1 0 0 1 %d %d Tm 2 Tc 100 Tz (Parse) Tj '
+                  b'[(A) -120 (B)] TJ 0 -8 Td (C) \' ET\n')
+
+
+def WritePdf(path, page_count, groups_per_page):
+  """Writes a PDF with `page_count` pages of `groups_per_page` groups each."""
+  offsets = []
+  with open(path, 'wb') as f:
+
+    def WriteObject(data):
+      offsets.append(f.tell())
+      f.write(b'%d 0 obj\n%s\nendobj\n' % (len(offsets), data))
+
+    f.write(b'%PDF-1.7\n')
+    WriteObject(b'<< /Type /Catalog /Pages 2 0 R >>')
+    kids = b' '.join(b'%d 0 R' % (5 + 2 * i) for i in range(page_count))
+    WriteObject(b'<< /Type /Pages /Kids [%s] /Count %d >>' %
+                (kids, page_count))
+    WriteObject(b'<< /Type /Font /Subtype /Type1 /BaseFont /Helvetica >>')
+    WriteObject(b'<< /Type /ExtGState /CA 0.8 /ca 0.8 >>')
+    for _ in range(page_count):
+      content = b''.join(OPERATOR_GROUP %
+                         (i % 580, i // 580 % 780, i % 550, i // 550 % 760)
+                         for i in range(groups_per_page))
+      WriteObject(b'<< /Type /Page /Parent 2 0 R /MediaBox [0 0 600 800] '
+                  b'/Contents %d 0 R /Resources << /Font << /F1 3 0 R >> '
+                  b'/ExtGState << /GS0 4 0 R >> >> >>' % (len(offsets) + 2))
+      WriteObject(b'<< /Length %d >>\nstream\n%s\nendstream' %
+                  (len(content), content))
+
+    xref_offset = f.tell()
+    f.write(b'xref\n0 %d\n0000000000 65535 f \n' % (len(offsets) + 1))
+    for offset in offsets:
+      f.write(b'%010d 00000 n \n' % offset)
+    f.write(b'trailer\n<< /Root 1 0 R /Size %d >>\nstartxref\n%d\n%%%%EOF\n' %
+            (len(offsets) + 1, xref_offset))
+
+
+def main():
+  parser = argparse.ArgumentParser()
+  parser.add_argument(
+      'inputs',
+      nargs='*',
+      help='PDF files to parse; defaults to a generated one')
+  benchmark_runner.AddArguments(parser)
+  parser.add_argument(
+      '--pages',
+      type=int,
+      default=20,
+      help='number of pages in the generated file')
+  parser.add_argument(
+      '--groups',
+      type=int,
+      default=20000,
+      help='number of operator groups per page in the generated file')
+  args = parser.parse_args()
+
+  runner = benchmark_runner.Runner(args)
+  if not runner.CheckExecutables():
+    return 1
+
+  with tempfile.TemporaryDirectory() as temp_dir:
+    inputs = args.inputs
+    if not inputs:
+      pdf_path = os.path.join(temp_dir, 'content.pdf')
+      WritePdf(pdf_path, args.pages, args.groups)
+      print('%s: %d bytes, %d pages of %d operator groups' %
+            (pdf_path, os.path.getsize(pdf_path), args.pages, args.groups))
+      inputs = [pdf_path]
+
+    # --show-pageinfo loads and parses every page without rendering it.
+    cases = [
+        benchmark_runner.Case(pdf_path, ['--show-pageinfo', pdf_path],
+                              md5_args=[pdf_path]) for pdf_path in inputs
+    ]
+    return runner.Run(cases)
+
+
+if __name__ == '__main__':
+  sys.exit(main())
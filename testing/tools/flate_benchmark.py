@@ -0,0 +1,134 @@
+#!/usr/bin/env python3
+# Copyright 2024 The PDFium Authors
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+"""Measures how fast pdfium_test inflates whole Flate streams.
+
+Generates PDFs whose pages each have a large Flate-compressed thumbnail
+stream of content-stream-like text, once with and once without a /DL entry
+giving the decoded size. Runs pdfium_test with --save-thumbs-dec and
+--show-pageinfo, which decodes every thumbnail stream twice, once for its size
+and once for its data, without rendering anything. Reports the throughput in
+MB of decoded data per second, and checks that every decoded thumbnail matches
+the generated data. When given a --baseline-build-dir, runs that build too.
+"""
+
+import argparse
+import glob
+import hashlib
+import os
+import random
+import sys
+import tempfile
+import zlib
+
+import benchmark_runner
+
+# Every thumbnail gets decoded once for its size and once for its data.
+DECODES_PER_THUMBNAIL = 2
+
+
+def MakeThumbnailData(size, seed):
+  """Returns `size` bytes of path operators with varying coordinates."""
+  rng = random.Random(seed)
+  lines = []
+  length = 0
+  while length < size:
+    line = b'%d %d m %d %d l %d %d %d %d re f\n' % tuple(
+        rng.randrange(1000) for _ in range(8))
+    lines.append(line)
+    length += len(line)
+  return b''.join(lines)[:size]
+
+
+def WritePdf(path, thumbnails, with_length):
+  """Writes a PDF with one page per thumbnail in `thumbnails`."""
+  offsets = []
+  with open(path, 'wb') as f:
+
+    def WriteObject(data):
+      offsets.append(f.tell())
+      f.write(b'%d 0 obj\n%s\nendobj\n' % (len(offsets), data))
+
+    page_count = len(thumbnails)
+    f.write(b'%PDF-1.7\n')
+    WriteObject(b'<< /Type /Catalog /Pages 2 0 R >>')
+    kids = b' '.join(b'%d 0 R' % (3 + 2 * i) for i in range(page_count))
+    WriteObject(b'<< /Type /Pages /Kids [%s] /Count %d >>' %
+                (kids, page_count))
+    for thumbnail in thumbnails:
+      data = zlib.compress(thumbnail, 6)
+      length = b'/DL %d ' % len(thumbnail) if with_length else b''
+      WriteObject(b'<< /Type /Page /Parent 2 0 R /MediaBox [0 0 100 100] '
+                  b'/Thumb %d 0 R >>' % (len(offsets) + 2))
+      WriteObject(b'<< /Filter /FlateDecode %s/Length %d >>\nstream\n%s\n'
+                  b'endstream' % (length, len(data), data))
+
+    xref_offset = f.tell()
+    f.write(b'xref\n0 %d\n0000000000 65535 f \n' % (len(offsets) + 1))
+    for offset in offsets:
+      f.write(b'%010d 00000 n \n' % offset)
+    f.write(b'trailer\n<< /Root 1 0 R /Size %d >>\nstartxref\n%d\n%%%%EOF\n' %
+            (len(offsets) + 1, xref_offset))
+
+
+def MakeVerifier(pdf_path, thumbnails):
+  """Returns a function that checks the decoded thumbnails of `pdf_path`.
+
+  It deletes them afterwards, so the next build has to write its own.
+  """
+  expected_md5s = sorted(
+      hashlib.md5(thumbnail).hexdigest() for thumbnail in thumbnails)
+
+  def Verify():
+    md5s = []
+    for path in glob.glob(glob.escape(pdf_path) + '.thumbnail.decoded.*'):
+      with open(path, 'rb') as f:
+        md5s.append(hashlib.md5(f.read()).hexdigest())
+      os.remove(path)
+    return sorted(md5s) == expected_md5s
+
+  return Verify
+
+
+def main():
+  parser = argparse.ArgumentParser()
+  benchmark_runner.AddArguments(parser)
+  parser.add_argument(
+      '--pages',
+      type=int,
+      default=20,
+      help='number of pages, each with a thumbnail, in the generated files')
+  parser.add_argument(
+      '--thumbnail-size',
+      type=int,
+      default=4000000,
+      help='decoded size of every thumbnail stream in bytes')
+  args = parser.parse_args()
+
+  runner = benchmark_runner.Runner(args)
+  if not runner.CheckExecutables():
+    return 1
+
+  thumbnails = [
+      MakeThumbnailData(args.thumbnail_size, page)
+      for page in range(args.pages)
+  ]
+  megabytes = (DECODES_PER_THUMBNAIL * args.pages * args.thumbnail_size / 1e6)
+  with tempfile.TemporaryDirectory() as temp_dir:
+    cases = []
+    for label, with_length in (('with /DL', True), ('without /DL', False)):
+      pdf_dir = os.path.join(temp_dir, 'dl' if with_length else 'no_dl')
+      os.mkdir(pdf_dir)
+      pdf_path = os.path.join(pdf_dir, 'thumbnails.pdf')
+      WritePdf(pdf_path, thumbnails, with_length)
+      cases.append(
+          benchmark_runner.Case(
+              label, ['--save-thumbs-dec', '--show-pageinfo', pdf_path],
+              verify=MakeVerifier(pdf_path, thumbnails),
+              describe=lambda seconds: '%.1f MB/s' % (megabytes / seconds)))
+    return runner.Run(cases)
+
+
+if __name__ == '__main__':
+  sys.exit(main())
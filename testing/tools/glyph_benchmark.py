@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+# Copyright 2024 The PDFium Authors
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+"""Measures how long pdfium_test takes to draw a glyph.
+
+Generates a PDF whose pages are full of text in a few fonts and sizes, renders
+it, and reports the time per drawn glyph. Most glyphs come from the glyph
+cache, so this mostly measures the cost of looking glyphs up and drawing them.
+Passing a small --glyph-cache budget measures the cost of rendering glyphs
+again after the cache evicted them. When given a --baseline-build-dir, renders
+the same file with that build too, and checks that both builds render every
+page the same.
+"""
+
+import argparse
+import os
+import sys
+import tempfile
+
+import benchmark_runner
+
+FONTS = [b'Helvetica', b'Times-Roman', b'Courier']
+FONT_SIZES = [6, 8, 9, 10, 12, 14]
+LINE_CHARS = 90
+
+
+def GetLine(index):
+  """Returns a line of printable ASCII text, varying with `index`."""
+  line = bytes(0x21 + (index * 7 + i) % 94 for i in range(LINE_CHARS))
+  for special in (b'\\', b'(', b')'):
+    line = line.replace(special, b'\\' + special)
+  return line
+
+
+def WritePdf(path, page_count, lines_per_page):
+  """Writes a PDF with `page_count` pages of `lines_per_page` text lines."""
+  offsets = []
+  with open(path, 'wb') as f:
+
+    def WriteObject(data):
+      offsets.append(f.tell())
+      f.write(b'%d 0 obj\n%s\nendobj\n' % (len(offsets), data))
+
+    f.write(b'%PDF-1.7\n')
+    WriteObject(b'<< /Type /Catalog /Pages 2 0 R >>')
+    first_page = 3 + len(FONTS)
+    kids = b' '.join(
+        b'%d 0 R' % (first_page + 2 * i) for i in range(page_count))
+    WriteObject(b'<< /Type /Pages /Kids [%s] /Count %d >>' %
+                (kids, page_count))
+    for font in FONTS:
+      WriteObject(b'<< /Type /Font /Subtype /Type1 /BaseFont /%s >>' % font)
+    fonts = b' '.join(
+        b'/F%d %d 0 R' % (i, 3 + i) for i in range(len(FONTS)))
+    for page in range(page_count):
+      content = b''.join(
+          b'BT /F%d %d Tf 20 %d Td (%s) Tj ET\n' %
+          ((page + i) % len(FONTS), FONT_SIZES[i % len(FONT_SIZES)],
+           780 - i * 760 // lines_per_page, GetLine(page + i))
+          for i in range(lines_per_page))
+      WriteObject(b'<< /Type /Page /Parent 2 0 R /MediaBox [0 0 600 800] '
+                  b'/Contents %d 0 R /Resources << /Font << %s >> >> >>' %
+                  (len(offsets) + 2, fonts))
+      WriteObject(b'<< /Length %d >>\nstream\n%s\nendstream' %
+                  (len(content), content))
+
+    xref_offset = f.tell()
+    f.write(b'xref\n0 %d\n0000000000 65535 f \n' % (len(offsets) + 1))
+    for offset in offsets:
+      f.write(b'%010d 00000 n \n' % offset)
+    f.write(b'trailer\n<< /Root 1 0 R /Size %d >>\nstartxref\n%d\n%%%%EOF\n' %
+            (len(offsets) + 1, xref_offset))
+
+
+def main():
+  parser = argparse.ArgumentParser()
+  benchmark_runner.AddArguments(parser)
+  parser.add_argument(
+      '--pages',
+      type=int,
+      default=20,
+      help='number of pages in the generated file')
+  parser.add_argument(
+      '--lines',
+      type=int,
+      default=60,
+      help='number of text lines per page in the generated file')
+  parser.add_argument(
+      '--glyph-cache',
+      type=int,
+      help='glyph cache budget in bytes to pass to %s; both builds must '
+      'support it' % benchmark_runner.PDFIUM_TEST)
+  args = parser.parse_args()
+
+  runner = benchmark_runner.Runner(args)
+  if not runner.CheckExecutables():
+    return 1
+
+  with tempfile.TemporaryDirectory() as temp_dir:
+    pdf_path = os.path.join(temp_dir, 'glyphs.pdf')
+    WritePdf(pdf_path, args.pages, args.lines)
+    glyph_count = args.pages * args.lines * LINE_CHARS
+    print('%s: %d pages, %d glyphs' % (pdf_path, args.pages, glyph_count))
+    pdf_args = [pdf_path]
+    if args.glyph_cache is not None:
+      pdf_args.insert(0, '--glyph-cache=%d' % args.glyph_cache)
+    case = benchmark_runner.Case(
+        'glyphs',
+        pdf_args,
+        md5_args=pdf_args,
+        describe=lambda seconds: '%.3f us per glyph' %
+        (seconds * 1e6 / glyph_count))
+    return runner.Run([case])
+
+
+if __name__ == '__main__':
+  sys.exit(main())
@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+# Copyright 2024 The PDFium Authors
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+"""Measures how long pdfium_test takes to render PDFs with JBIG2 images.
+
+Renders every page of each file in a corpus of PDFs that use JBIG2Decode,
+which spends most of its time in the JBIG2 generic region decoder. When given
+a --baseline-build-dir, renders the same files with that build too, and
+checks that both render every page the same.
+"""
+
+import argparse
+import os
+import sys
+
+import benchmark_runner
+from common import PrintErr
+
+# Files in testing/resources with JBIG2 images, used when no corpus is given.
+DEFAULT_CORPUS = [
+    'bug_552046.pdf',
+    'bug_631912.pdf',
+    'bug_674771.pdf',
+    os.path.join('pixel', 'bug_1087.pdf'),
+    os.path.join('pixel', 'bug_867501.pdf'),
+]
+
+
+def UsesJbig2(path):
+  with open(path, 'rb') as f:
+    return b'JBIG2Decode' in f.read()
+
+
+def FindCorpus(inputs):
+  """Returns the PDFs with JBIG2 images among `inputs` and their directories."""
+  corpus = []
+  for path in inputs:
+    if not os.path.isdir(path):
+      corpus.append(path)
+      continue
+    for root, _, files in os.walk(path):
+      for name in sorted(files):
+        file_path = os.path.join(root, name)
+        if name.lower().endswith('.pdf') and UsesJbig2(file_path):
+          corpus.append(file_path)
+  return corpus
+
+
+def main():
+  parser = argparse.ArgumentParser()
+  parser.add_argument(
+      'inputs',
+      nargs='*',
+      help='PDF files, or directories to search for PDFs with JBIG2 images; '
+      'defaults to the ones in testing/resources')
+  benchmark_runner.AddArguments(parser)
+  args = parser.parse_args()
+
+  if not args.inputs:
+    resources_dir = os.path.join(
+        os.path.dirname(os.path.realpath(__file__)), os.pardir, 'resources')
+    args.inputs = [
+        os.path.join(resources_dir, name) for name in DEFAULT_CORPUS
+    ]
+
+  runner = benchmark_runner.Runner(args)
+  if not runner.CheckExecutables():
+    return 1
+
+  corpus = FindCorpus(args.inputs)
+  if not corpus:
+    PrintErr('FAILURE: No PDFs with JBIG2 images found')
+    return 1
+
+  cases = [
+      benchmark_runner.Case(pdf_path, [pdf_path], md5_args=[pdf_path])
+      for pdf_path in corpus
+  ]
+  return runner.Run(cases, print_total=True)
+
+
+if __name__ == '__main__':
+  sys.exit(main())
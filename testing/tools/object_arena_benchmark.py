@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+# Copyright 2024 The PDFium Authors
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+"""Measures the effect of --object-arena on loading and closing a large PDF.
+
+Generates a PDF whose single page has many small link annotations, so that
+pdfium_test has to parse all of them to render the page, and then runs
+pdfium_test on it with and without the object arena. The rendered page must
+be the same in both modes.
+
+Allocation counts are covered by the ObjectArenaTest unit tests. This script
+reports wall time, which includes tearing down the object graph, and the
+peak resident set size.
+"""
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+import tempfile
+import time
+
+from common import PrintErr
+
+PDFIUM_TEST = 'pdfium_test'
+
+
+def WritePdf(path, annot_count):
+  """Writes a PDF with one page and `annot_count` link annotations.
+
+  Each annotation consists of 11 objects: dictionaries, arrays, names,
+  numbers and a string.
+  """
+  offsets = []
+  with open(path, 'wb') as f:
+
+    def WriteObject(data):
+      offsets.append(f.tell())
+      f.write(b'%d 0 obj\n%s\nendobj\n' % (len(offsets), data))
+
+    content = b'BT /F1 24 Tf 20 100 Td (Arena) Tj ET'
+    f.write(b'%PDF-1.7\n')
+    WriteObject(b'<< /Type /Catalog /Pages 2 0 R >>')
+    WriteObject(b'<< /Type /Pages /Kids [3 0 R] /Count 1 >>')
+    annots = b' '.join(b'%d 0 R' % (6 + i) for i in range(annot_count))
+    WriteObject(b'<< /Type /Page /Parent 2 0 R /MediaBox [0 0 200 200] '
+                b'/Contents 4 0 R /Resources << /Font << /F1 5 0 R >> >> '
+                b'/Annots [%s] >>' % annots)
+    WriteObject(b'<< /Length %d >>\nstream\n%s\nendstream' %
+                (len(content), content))
+    WriteObject(b'<< /Type /Font /Subtype /Type1 /BaseFont /Helvetica >>')
+    for i in range(annot_count):
+      WriteObject(b'<< /Type /Annot /Subtype /Link /Rect [0 0 1 1] '
+                  b'/A << /S /URI /URI (https://example.com/%d) >> >>' % i)
+
+    xref_offset = f.tell()
+    f.write(b'xref\n0 %d\n0000000000 65535 f \n' % (len(offsets) + 1))
+    for offset in offsets:
+      f.write(b'%010d 00000 n \n' % offset)
+    f.write(b'trailer\n<< /Root 1 0 R /Size %d >>\nstartxref\n%d\n%%%%EOF\n' %
+            (len(offsets) + 1, xref_offset))
+
+
+class Benchmark:
+  """Runs pdfium_test with and without the object arena."""
+
+  def __init__(self, args):
+    self.args = args
+    self.pdfium_test_path = os.path.join(self.args.build_dir, PDFIUM_TEST)
+
+  def Run(self):
+    """Runs the benchmark.
+
+    Returns:
+      Exit code for the script.
+    """
+    if not os.access(self.pdfium_test_path, os.X_OK):
+      PrintErr("FAILURE: Can't run test executable '%s'" %
+               self.pdfium_test_path)
+      PrintErr('Use --build-dir to specify its location.')
+      return 1
+
+    with tempfile.TemporaryDirectory() as temp_dir:
+      pdf_path = os.path.join(temp_dir, 'objects.pdf')
+      WritePdf(pdf_path, self.args.annots)
+      print('%s: %d bytes, %d annotations' %
+            (pdf_path, os.path.getsize(pdf_path), self.args.annots))
+
+      reference_md5 = None
+      for use_arena in (False, True):
+        seconds, max_rss_kb, md5 = self._Measure(pdf_path, use_arena)
+        if md5 is None:
+          PrintErr('FAILURE: No output with arena=%s' % use_arena)
+          return 1
+        if reference_md5 is None:
+          reference_md5 = md5
+        elif md5 != reference_md5:
+          PrintErr('FAILURE: Output with the arena differs')
+          return 1
+        print('arena=%-5s best of %d: %.3fs, max RSS %d KiB' %
+              (use_arena, self.args.runs, seconds, max_rss_kb))
+    return 0
+
+  def _Measure(self, pdf_path, use_arena):
+    """Returns the fastest wall time, the peak RSS, and the page's md5."""
+    cmd = [self.pdfium_test_path]
+    if use_arena:
+      cmd.append('--object-arena')
+    cmd += ['--pages=0', '--png', '--md5', pdf_path]
+    best = None
+    max_rss_kb = 0
+    md5 = None
+    for _ in range(self.args.runs):
+      start = time.perf_counter()
+      process = subprocess.Popen(
+          cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+      output = process.stdout.read()
+      process.stdout.close()
+      # Reap the process here to get its own resource usage.
+      _, status, usage = os.wait4(process.pid, 0)
+      process.returncode = os.waitstatus_to_exitcode(status)
+      elapsed = time.perf_counter() - start
+      best = elapsed if best is None else min(best, elapsed)
+      max_rss_kb = max(max_rss_kb, usage.ru_maxrss)
+      matched = re.search(r'^MD5:.*:([0-9a-f]{32})$', output.decode('utf-8'),
+                          re.MULTILINE)
+      md5 = matched.group(1) if matched else None
+    return best, max_rss_kb, md5
+
+
+def main():
+  parser = argparse.ArgumentParser()
+  parser.add_argument(
+      '--build-dir',
+      default=os.path.join('out', 'Release'),
+      help='relative path to the build directory with '
+      '%s' % PDFIUM_TEST)
+  parser.add_argument(
+      '--annots',
+      type=int,
+      default=200000,
+      help='number of link annotations in the generated file')
+  parser.add_argument(
+      '--runs',
+      type=int,
+      default=3,
+      help='number of runs per mode, the fastest one is reported')
+  args = parser.parse_args()
+
+  return Benchmark(args).Run()
+
+
+if __name__ == '__main__':
+  sys.exit(main())
@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+# Copyright 2024 The PDFium Authors
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+"""Measures how fast pdfium_test undoes PNG and TIFF predictors.
+
+Generates PDFs whose single page shows one large Flate image with a
+/Predictor in its /DecodeParms: PNG predictors with every row using the same
+filter, for Sub, Up, Average and Paeth, and the TIFF predictor, each with 1, 3
+and 4 colors. Renders each page at a small --scale, so that decoding the image
+takes most of the time, and reports the throughput in MB of decoded image data
+per second. When given a --baseline-build-dir, renders the same files with
+that build too, and checks that both builds render every page the same.
+"""
+
+import argparse
+import os
+import random
+import sys
+import tempfile
+import zlib
+
+import benchmark_runner
+
+# Predictors: name, /Predictor value and PNG filter type of every row.
+PREDICTORS = [
+    ('sub', 15, 1),
+    ('up', 15, 2),
+    ('average', 15, 3),
+    ('paeth', 15, 4),
+    ('tiff', 2, None),
+]
+
+COLOR_SPACES = {
+    1: b'/DeviceGray',
+    3: b'/DeviceRGB',
+    4: b'/DeviceCMYK',
+}
+
+
+def MakeImageData(width, height, colors, png_filter):
+  """Returns predicted image data, with a filter byte per row for PNG.
+
+  The rows are random, but repeat a block of random bytes at varying offsets.
+  That keeps inflating them cheap next to undoing the predictor.
+  """
+  row_size = width * colors
+  block = random.Random(colors).randbytes(row_size + 4096)
+  tag = b'' if png_filter is None else bytes([png_filter])
+  return b''.join(tag + block[y * 7 % 4096:][:row_size] for y in range(height))
+
+
+def WritePdf(path, width, height, colors, predictor, png_filter):
+  """Writes a PDF with one `width` by `height` predicted image on its page."""
+  offsets = []
+  with open(path, 'wb') as f:
+
+    def WriteObject(data):
+      offsets.append(f.tell())
+      f.write(b'%d 0 obj\n%s\nendobj\n' % (len(offsets), data))
+
+    content = b'q %d 0 0 %d 0 0 cm /Im0 Do Q' % (width, height)
+    data = zlib.compress(MakeImageData(width, height, colors, png_filter), 6)
+    f.write(b'%PDF-1.7\n')
+    WriteObject(b'<< /Type /Catalog /Pages 2 0 R >>')
+    WriteObject(b'<< /Type /Pages /Kids [3 0 R] /Count 1 >>')
+    WriteObject(b'<< /Type /Page /Parent 2 0 R /MediaBox [0 0 %d %d] '
+                b'/Contents 4 0 R /Resources << /XObject << /Im0 5 0 R >> >> '
+                b'>>' % (width, height))
+    WriteObject(b'<< /Length %d >>\nstream\n%s\nendstream' %
+                (len(content), content))
+    WriteObject(b'<< /Type /XObject /Subtype /Image /Width %d /Height %d '
+                b'/ColorSpace %s /BitsPerComponent 8 /Filter /FlateDecode '
+                b'/DecodeParms << /Predictor %d /Colors %d /Columns %d >> '
+                b'/Length %d >>\nstream\n%s\nendstream' %
+                (width, height, COLOR_SPACES[colors], predictor, colors, width,
+                 len(data), data))
+
+    xref_offset = f.tell()
+    f.write(b'xref\n0 %d\n0000000000 65535 f \n' % (len(offsets) + 1))
+    for offset in offsets:
+      f.write(b'%010d 00000 n \n' % offset)
+    f.write(b'trailer\n<< /Root 1 0 R /Size %d >>\nstartxref\n%d\n%%%%EOF\n' %
+            (len(offsets) + 1, xref_offset))
+
+
+def MakeCase(label, pdf_path, scale, megabytes):
+  """Returns the case for rendering `pdf_path` with `megabytes` of image."""
+  pdf_args = ['--scale=%s' % scale, pdf_path]
+  return benchmark_runner.Case(
+      label,
+      pdf_args,
+      md5_args=pdf_args,
+      describe=lambda seconds: '%.1f MB/s' % (megabytes / seconds))
+
+
+def main():
+  parser = argparse.ArgumentParser()
+  benchmark_runner.AddArguments(parser)
+  parser.add_argument(
+      '--width', type=int, default=2000, help='width of the images')
+  parser.add_argument(
+      '--height', type=int, default=2000, help='height of the images')
+  parser.add_argument(
+      '--scale',
+      default='0.125',
+      help='scale to render the pages at; small scales keep rendering cheap')
+  args = parser.parse_args()
+
+  runner = benchmark_runner.Runner(args)
+  if not runner.CheckExecutables():
+    return 1
+
+  megabytes = args.width * args.height / 1e6
+  with tempfile.TemporaryDirectory() as temp_dir:
+    cases = []
+    for name, predictor, png_filter in PREDICTORS:
+      for colors in sorted(COLOR_SPACES):
+        pdf_path = os.path.join(temp_dir, '%s_%d.pdf' % (name, colors))
+        WritePdf(pdf_path, args.width, args.height, colors, predictor,
+                 png_filter)
+        cases.append(
+            MakeCase('%s %d colors' % (name, colors), pdf_path, args.scale,
+                     megabytes * colors))
+    return runner.Run(cases)
+
+
+if __name__ == '__main__':
+  sys.exit(main())
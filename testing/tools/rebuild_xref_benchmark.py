@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+# Copyright 2024 The PDFium Authors
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+"""Measures how long pdfium_test takes to open a large damaged PDF.
+
+Generates a PDF without a usable cross-reference table, so that loading it
+goes through CPDF_Parser::RebuildCrossRef(), and then loads it with each of the
+requested --rebuild-xref-threads values. The rendered first page must be the
+same for every thread count.
+"""
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+import tempfile
+import time
+
+from common import PrintErr
+
+PDFIUM_TEST = 'pdfium_test'
+
+# Stream data with a wrong /Length, so the parser has to search for
+# "endstream", like it does in many real damaged files.
+FILLER_STREAM_DATA = b'0123456789abcdef' * 64
+
+
+def WriteDamagedPdf(path, object_count):
+  """Writes a PDF with one page and `object_count` filler objects.
+
+  The file has neither an xref table nor a trailer at its end, only a trailer
+  in the middle, so the cross-reference table has to be rebuilt.
+  """
+  content = b'BT /F1 24 Tf 20 100 Td (Rebuilt) Tj ET'
+  with open(path, 'wb') as f:
+    f.write(b'%PDF-1.7\n')
+    f.write(b'1 0 obj\n<< /Type /Catalog /Pages 2 0 R >>\nendobj\n')
+    f.write(b'2 0 obj\n<< /Type /Pages /Kids [3 0 R] /Count 1 >>\nendobj\n')
+    f.write(b'3 0 obj\n<< /Type /Page /Parent 2 0 R '
+            b'/MediaBox [0 0 200 200] /Contents 4 0 R '
+            b'/Resources << /Font << /F1 5 0 R >> >> >>\nendobj\n')
+    f.write(b'4 0 obj\n<< /Length %d >>\nstream\n%s\nendstream\nendobj\n' %
+            (len(content), content))
+    f.write(b'5 0 obj\n<< /Type /Font /Subtype /Type1 '
+            b'/BaseFont /Helvetica >>\nendobj\n')
+    for i in range(object_count):
+      obj_num = 6 + i
+      if i % 4 == 0:
+        f.write(b'%d 0 obj\n<< /Length 1 >>\nstream\n%s\nendstream\nendobj\n' %
+                (obj_num, FILLER_STREAM_DATA))
+      else:
+        f.write(b'%d 0 obj\n<< /Index %d /Name /Filler%d /Array [1 2 3] >>\n'
+                b'endobj\n' % (obj_num, i, i))
+      if i == object_count // 2:
+        f.write(b'trailer\n<< /Root 1 0 R /Size %d >>\n' %
+                (object_count + 6))
+    f.write(b'startxref\n1234567\n%%EOF\n')
+
+
+class Benchmark:
+  """Loads the generated file with different thread counts."""
+
+  def __init__(self, args):
+    self.args = args
+    self.pdfium_test_path = os.path.join(self.args.build_dir, PDFIUM_TEST)
+
+  def Run(self):
+    """Runs the benchmark.
+
+    Returns:
+      Exit code for the script.
+    """
+    if not os.access(self.pdfium_test_path, os.X_OK):
+      PrintErr("FAILURE: Can't run test executable '%s'" %
+               self.pdfium_test_path)
+      PrintErr('Use --build-dir to specify its location.')
+      return 1
+
+    with tempfile.TemporaryDirectory() as temp_dir:
+      pdf_path = os.path.join(temp_dir, 'damaged.pdf')
+      WriteDamagedPdf(pdf_path, self.args.objects)
+      print('%s: %d bytes, %d objects' % (pdf_path, os.path.getsize(pdf_path),
+                                          self.args.objects + 5))
+
+      reference_md5 = None
+      for threads in self.args.threads:
+        seconds, md5 = self._Measure(pdf_path, threads)
+        if md5 is None:
+          PrintErr('FAILURE: No output with %d threads' % threads)
+          return 1
+        if reference_md5 is None:
+          reference_md5 = md5
+        elif md5 != reference_md5:
+          PrintErr('FAILURE: Output with %d threads differs' % threads)
+          return 1
+        print('threads=%-3d best of %d: %.3fs' %
+              (threads, self.args.runs, seconds))
+    return 0
+
+  def _Measure(self, pdf_path, threads):
+    """Returns the fastest wall time and the rendered page's md5."""
+    cmd = [
+        self.pdfium_test_path, '--mapped-document',
+        '--rebuild-xref-threads=%d' % threads, '--pages=0', '--png', '--md5',
+        pdf_path
+    ]
+    best = None
+    md5 = None
+    for _ in range(self.args.runs):
+      start = time.perf_counter()
+      output = subprocess.check_output(
+          cmd, stderr=subprocess.STDOUT).decode('utf-8')
+      elapsed = time.perf_counter() - start
+      best = elapsed if best is None else min(best, elapsed)
+      matched = re.search(r'^MD5:.*:([0-9a-f]{32})$', output, re.MULTILINE)
+      md5 = matched.group(1) if matched else None
+    return best, md5
+
+
+def main():
+  parser = argparse.ArgumentParser()
+  parser.add_argument(
+      '--build-dir',
+      default=os.path.join('out', 'Release'),
+      help='relative path to the build directory with '
+      '%s' % PDFIUM_TEST)
+  parser.add_argument(
+      '--objects',
+      type=int,
+      default=2000000,
+      help='number of filler objects in the generated file')
+  parser.add_argument(
+      '--threads',
+      type=int,
+      nargs='+',
+      default=[1, 2, 4, 8],
+      help='thread counts to measure, the first one is the reference')
+  parser.add_argument(
+      '--runs',
+      type=int,
+      default=3,
+      help='number of runs per thread count, the fastest one is reported')
+  args = parser.parse_args()
+
+  return Benchmark(args).Run()
+
+
+if __name__ == '__main__':
+  sys.exit(main())
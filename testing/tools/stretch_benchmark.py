@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+# Copyright 2024 The PDFium Authors
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+"""Measures how long pdfium_test takes to render down-scaled images.
+
+Generates PDFs whose single page is covered by one large image, in 8bpp gray,
+24bpp RGB, and RGB with a soft mask, and renders each of them at the given
+--scales. Rendering an image smaller than its size goes through
+CStretchEngine, which then takes most of the time. When given a
+--baseline-build-dir, renders the same files with that build too, and checks
+that both builds render every page the same.
+"""
+
+import argparse
+import os
+import sys
+import tempfile
+import zlib
+
+import benchmark_runner
+
+# Image kinds: name, color space, components per pixel and whether to add a
+# soft mask.
+IMAGE_KINDS = [
+    ('gray', b'/DeviceGray', 1, False),
+    ('rgb', b'/DeviceRGB', 3, False),
+    ('argb', b'/DeviceRGB', 3, True),
+]
+
+
+def MakeImageData(width, height, components, seed):
+  """Returns image data with gradients, which are cheap to generate."""
+  base_row = bytes((x * 7 + seed) & 0xFF for x in range(
+      (width + height) * components))
+  return b''.join(base_row[y * components:(y + width) * components]
+                  for y in range(height))
+
+
+def WritePdf(path, width, height, color_space, components, with_mask):
+  """Writes a PDF with one `width` by `height` image covering its page."""
+  offsets = []
+  with open(path, 'wb') as f:
+
+    def WriteObject(data):
+      offsets.append(f.tell())
+      f.write(b'%d 0 obj\n%s\nendobj\n' % (len(offsets), data))
+
+    def WriteImage(image_color_space, image_components, seed, extra):
+      data = zlib.compress(
+          MakeImageData(width, height, image_components, seed), 1)
+      WriteObject(b'<< /Type /XObject /Subtype /Image /Width %d /Height %d '
+                  b'/ColorSpace %s /BitsPerComponent 8 /Filter /FlateDecode '
+                  b'%s/Length %d >>\nstream\n%s\nendstream' %
+                  (width, height, image_color_space, extra, len(data), data))
+
+    content = b'q %d 0 0 %d 0 0 cm /Im0 Do Q' % (width, height)
+    f.write(b'%PDF-1.7\n')
+    WriteObject(b'<< /Type /Catalog /Pages 2 0 R >>')
+    WriteObject(b'<< /Type /Pages /Kids [3 0 R] /Count 1 >>')
+    WriteObject(b'<< /Type /Page /Parent 2 0 R /MediaBox [0 0 %d %d] '
+                b'/Contents 4 0 R /Resources << /XObject << /Im0 5 0 R >> >> '
+                b'>>' % (width, height))
+    WriteObject(b'<< /Length %d >>\nstream\n%s\nendstream' %
+                (len(content), content))
+    WriteImage(color_space, components, 0, b'/SMask 6 0 R ' if with_mask else
+               b'')
+    if with_mask:
+      WriteImage(b'/DeviceGray', 1, 101, b'')
+
+    xref_offset = f.tell()
+    f.write(b'xref\n0 %d\n0000000000 65535 f \n' % (len(offsets) + 1))
+    for offset in offsets:
+      f.write(b'%010d 00000 n \n' % offset)
+    f.write(b'trailer\n<< /Root 1 0 R /Size %d >>\nstartxref\n%d\n%%%%EOF\n' %
+            (len(offsets) + 1, xref_offset))
+
+
+def main():
+  parser = argparse.ArgumentParser()
+  benchmark_runner.AddArguments(parser)
+  parser.add_argument(
+      '--width', type=int, default=2480, help='width of the images')
+  parser.add_argument(
+      '--height', type=int, default=3508, help='height of the images')
+  parser.add_argument(
+      '--scales',
+      nargs='+',
+      default=['0.5', '0.25', '0.125'],
+      help='scales to render the pages at')
+  args = parser.parse_args()
+
+  runner = benchmark_runner.Runner(args)
+  if not runner.CheckExecutables():
+    return 1
+
+  with tempfile.TemporaryDirectory() as temp_dir:
+    cases = []
+    for name, color_space, components, with_mask in IMAGE_KINDS:
+      pdf_path = os.path.join(temp_dir, '%s.pdf' % name)
+      WritePdf(pdf_path, args.width, args.height, color_space, components,
+               with_mask)
+      for scale in args.scales:
+        pdf_args = ['--scale=%s' % scale, pdf_path]
+        cases.append(
+            benchmark_runner.Case('%s at %s' % (name, scale),
+                                  pdf_args,
+                                  md5_args=pdf_args))
+    return runner.Run(cases)
+
+
+if __name__ == '__main__':
+  sys.exit(main())
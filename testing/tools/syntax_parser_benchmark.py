@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+# Copyright 2024 The PDFium Authors
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+"""Measures how fast CPDF_SyntaxParser scans PDF files.
+
+Takes a corpus of real-world PDFs and breaks the startxref offset of each, so
+that loading them rebuilds the cross-reference table, which runs every byte of
+the file through CPDF_SyntaxParser. Loads each damaged file --repeat times in
+one pdfium_test run, to keep the process start-up from dominating, and reports
+the throughput in MB of file data per second. When given a
+--baseline-build-dir, loads the same files with that build too, and checks
+that both builds render the first page of every file the same.
+"""
+
+import argparse
+import os
+import re
+import sys
+import tempfile
+
+import benchmark_runner
+from common import PrintErr
+
+# Files in testing/resources that did not get generated from a .in file, used
+# when no corpus is given.
+DEFAULT_CORPUS = [
+    'annotation_ink_multiple.pdf',
+    'annotation_stamp_with_ap.pdf',
+    'bug_1029.pdf',
+    'bug_650.pdf',
+    'bug_707673.pdf',
+    'bug_717.pdf',
+    'embedded_images.pdf',
+    os.path.join('pixel', 'xfa_specific', 'resolve_nodes_0.pdf'),
+]
+
+
+def FindCorpus(inputs):
+  """Returns the PDFs among `inputs` and in their directories."""
+  corpus = []
+  for path in inputs:
+    if not os.path.isdir(path):
+      corpus.append(path)
+      continue
+    for root, _, files in os.walk(path):
+      for name in sorted(files):
+        if name.lower().endswith('.pdf'):
+          corpus.append(os.path.join(root, name))
+  return corpus
+
+
+def WriteDamagedCopy(pdf_path, copy_path):
+  """Copies `pdf_path` with all startxref offsets pointing at the header.
+
+  Returns whether the file had an offset to break.
+  """
+  with open(pdf_path, 'rb') as f:
+    data = f.read()
+  data, count = re.subn(rb'startxref\s+\d+', b'startxref\n0', data)
+  with open(copy_path, 'wb') as f:
+    f.write(data)
+  return count > 0
+
+
+def main():
+  parser = argparse.ArgumentParser()
+  parser.add_argument(
+      'inputs',
+      nargs='*',
+      help='PDF files, or directories to search for PDFs; defaults to some '
+      'in testing/resources')
+  benchmark_runner.AddArguments(parser)
+  parser.add_argument(
+      '--repeat',
+      type=int,
+      default=20,
+      help='number of times to load every file per pdfium_test run')
+  args = parser.parse_args()
+
+  if not args.inputs:
+    resources_dir = os.path.join(
+        os.path.dirname(os.path.realpath(__file__)), os.pardir, 'resources')
+    args.inputs = [
+        os.path.join(resources_dir, name) for name in DEFAULT_CORPUS
+    ]
+
+  runner = benchmark_runner.Runner(args)
+  if not runner.CheckExecutables():
+    return 1
+
+  corpus = FindCorpus(args.inputs)
+  if not corpus:
+    PrintErr('FAILURE: No PDFs found')
+    return 1
+
+  with tempfile.TemporaryDirectory() as temp_dir:
+    cases = []
+    for i, pdf_path in enumerate(corpus):
+      copy_path = os.path.join(temp_dir,
+                               '%d_%s' % (i, os.path.basename(pdf_path)))
+      if not WriteDamagedCopy(pdf_path, copy_path):
+        print('Skipping %s without startxref' % pdf_path)
+        continue
+
+      megabytes = os.path.getsize(copy_path) * args.repeat / 1e6
+      # --show-pageinfo on the first page only keeps the work besides loading
+      # the document small.
+      cases.append(
+          benchmark_runner.Case(
+              pdf_path,
+              ['--show-pageinfo', '--pages=0'] + [copy_path] * args.repeat,
+              md5_args=['--pages=0', copy_path],
+              describe=lambda seconds, megabytes=megabytes: '%.1f MB/s' %
+              (megabytes / seconds)))
+    if not cases:
+      PrintErr('FAILURE: No PDFs with startxref found')
+      return 1
+    return runner.Run(cases, print_total=True)
+
+
+if __name__ == '__main__':
+  sys.exit(main())